@@ -19,14 +19,33 @@ Drawable::Drawable(std::shared_ptr<vertexdata::VertexData> vertexData,
 void Drawable::draw(igl::IDevice& device,
                     igl::IRenderCommandEncoder& commandEncoder,
                     const igl::RenderPipelineDesc& pipelineDesc) {
+  draw(device,
+       commandEncoder,
+       pipelineDesc,
+       std::hash<igl::RenderPipelineDesc>()(pipelineDesc),
+       nullptr);
+}
+
+void Drawable::draw(igl::IDevice& device,
+                    igl::IRenderCommandEncoder& commandEncoder,
+                    const igl::RenderPipelineDesc& pipelineDesc,
+                    size_t pipelineDescHash,
+                    pipelinecache::RenderPipelineCache* pipelineCache) {
   // Assumption: _vertexData and _material are immutable
-  size_t pipelineDescHash = std::hash<igl::RenderPipelineDesc>()(pipelineDesc);
   if (!_pipelineState || pipelineDescHash != _lastPipelineDescHash) {
     igl::RenderPipelineDesc mutablePipelineDesc = pipelineDesc;
     _vertexData->populatePipelineDescriptor(mutablePipelineDesc);
     _material->populatePipelineDescriptor(mutablePipelineDesc);
 
-    _pipelineState = device.createRenderPipeline(mutablePipelineDesc, nullptr);
+    if (pipelineCache) {
+      // Hashed once per change of 'pipelineDesc', the cache does not hash it again
+      const size_t mutablePipelineDescHash =
+          std::hash<igl::RenderPipelineDesc>()(mutablePipelineDesc);
+      _pipelineState =
+          pipelineCache->getOrCreate(device, mutablePipelineDesc, mutablePipelineDescHash, nullptr);
+    } else {
+      _pipelineState = device.createRenderPipeline(mutablePipelineDesc, nullptr);
+    }
     _lastPipelineDescHash = pipelineDescHash;
   }
 
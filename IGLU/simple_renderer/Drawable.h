@@ -8,6 +8,7 @@
 #pragma once
 
 #include <IGLU/simple_renderer/Material.h>
+#include <IGLU/simple_renderer/RenderPipelineCache.h>
 #include <IGLU/simple_renderer/VertexData.h>
 #include <memory>
 
@@ -26,6 +27,15 @@ class Drawable final {
             igl::IRenderCommandEncoder& commandEncoder,
             const igl::RenderPipelineDesc& pipelineDesc);
 
+  /// Same as above, but avoids hashing 'pipelineDesc' on every draw: 'pipelineDescHash' must be
+  /// std::hash<igl::RenderPipelineDesc>()(pipelineDesc), which callers compute once for all their
+  /// drawables. Pipelines are shared with other drawables through 'pipelineCache' (optional).
+  void draw(igl::IDevice& device,
+            igl::IRenderCommandEncoder& commandEncoder,
+            const igl::RenderPipelineDesc& pipelineDesc,
+            size_t pipelineDescHash,
+            pipelinecache::RenderPipelineCache* pipelineCache);
+
   /// A Drawable is "immutable" in that there's no API to modify its inputs after
   /// creation. They're lightweight objects and should be recreated instead of updated.
   Drawable(std::shared_ptr<vertexdata::VertexData> vertexData,
@@ -12,7 +12,8 @@
 namespace iglu {
 namespace renderpass {
 
-ForwardRenderPass::ForwardRenderPass(igl::IDevice& device) {
+ForwardRenderPass::ForwardRenderPass(igl::IDevice& device) :
+  _pipelineCache(std::make_shared<pipelinecache::RenderPipelineCache>()) {
   igl::CommandQueueDesc desc;
   _commandQueue = device.createCommandQueue(desc, nullptr);
   _backendType = device.getBackendType();
@@ -30,6 +31,8 @@ void ForwardRenderPass::begin(std::shared_ptr<igl::IFramebuffer> target,
   auto depthAttachment = _framebuffer->getDepthAttachment();
   _renderPipelineDesc.targetDesc.depthAttachmentFormat =
       depthAttachment ? depthAttachment->getFormat() : igl::TextureFormat::Invalid;
+  // Hashed once here instead of once per drawable
+  _renderPipelineDescHash = std::hash<igl::RenderPipelineDesc>()(_renderPipelineDesc);
 
   igl::RenderPassDesc defaultRenderPassDesc;
   defaultRenderPassDesc.colorAttachments.resize(1);
@@ -47,7 +50,11 @@ void ForwardRenderPass::begin(std::shared_ptr<igl::IFramebuffer> target,
 
 void ForwardRenderPass::draw(drawable::Drawable& drawable, igl::IDevice& device) const {
   IGL_ASSERT_MSG(isActive(), "Drawing not in progress");
-  drawable.draw(device, *_commandEncoder, _renderPipelineDesc);
+  drawable.draw(device,
+                *_commandEncoder,
+                _renderPipelineDesc,
+                _renderPipelineDescHash,
+                _pipelineCache.get());
 }
 
 void ForwardRenderPass::end(bool shouldPresent) {
@@ -86,5 +93,15 @@ std::shared_ptr<igl::IFramebuffer> ForwardRenderPass::activeTarget() {
   return _framebuffer;
 }
 
+void ForwardRenderPass::setPipelineCache(
+    std::shared_ptr<pipelinecache::RenderPipelineCache> pipelineCache) {
+  IGL_ASSERT(pipelineCache);
+  _pipelineCache = std::move(pipelineCache);
+}
+
+pipelinecache::RenderPipelineCache& ForwardRenderPass::pipelineCache() {
+  return *_pipelineCache;
+}
+
 } // namespace renderpass
 } // namespace iglu
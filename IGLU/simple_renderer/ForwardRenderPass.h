@@ -8,6 +8,7 @@
 #pragma once
 
 #include <IGLU/simple_renderer/Drawable.h>
+#include <IGLU/simple_renderer/RenderPipelineCache.h>
 #include <igl/IGL.h>
 #include <memory>
 #include <string>
@@ -45,6 +46,12 @@ class ForwardRenderPass final {
   bool isActive() const;
   std::shared_ptr<igl::IFramebuffer> activeTarget();
 
+  /// Drawables drawn through this render pass share render pipelines. By default every render
+  /// pass has its own cache; passing the same cache to several render passes shares pipelines
+  /// between them as well.
+  void setPipelineCache(std::shared_ptr<pipelinecache::RenderPipelineCache> pipelineCache);
+  pipelinecache::RenderPipelineCache& pipelineCache();
+
   explicit ForwardRenderPass(igl::IDevice& device);
   ~ForwardRenderPass() = default;
 
@@ -54,6 +61,8 @@ class ForwardRenderPass final {
   std::shared_ptr<igl::ICommandQueue> _commandQueue;
   std::shared_ptr<igl::IFramebuffer> _framebuffer;
   igl::RenderPipelineDesc _renderPipelineDesc;
+  size_t _renderPipelineDescHash = 0;
+  std::shared_ptr<pipelinecache::RenderPipelineCache> _pipelineCache;
 
   std::shared_ptr<igl::ICommandBuffer> _commandBuffer;
   std::unique_ptr<igl::IRenderCommandEncoder> _commandEncoder;
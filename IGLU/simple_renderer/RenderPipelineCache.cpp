@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "RenderPipelineCache.h"
+
+#include <utility>
+
+namespace iglu {
+namespace pipelinecache {
+
+RenderPipelineCache::RenderPipelineCache(size_t capacity) : _capacity(capacity) {
+  IGL_ASSERT(capacity > 0);
+}
+
+std::shared_ptr<igl::IRenderPipelineState> RenderPipelineCache::getOrCreate(
+    igl::IDevice& device,
+    const igl::RenderPipelineDesc& desc,
+    igl::Result* outResult) {
+  return getOrCreate(device, desc, std::hash<igl::RenderPipelineDesc>()(desc), outResult);
+}
+
+std::shared_ptr<igl::IRenderPipelineState> RenderPipelineCache::getOrCreate(
+    igl::IDevice& device,
+    const igl::RenderPipelineDesc& desc,
+    size_t descHash,
+    igl::Result* outResult) {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (auto pipelineState = find(desc, descHash)) {
+      _stats.numHits++;
+      igl::Result::setOk(outResult);
+      return pipelineState;
+    }
+    _stats.numMisses++;
+  }
+
+  // Pipelines are created without holding the lock so other threads are not blocked
+  igl::Result result;
+  std::shared_ptr<igl::IRenderPipelineState> pipelineState =
+      device.createRenderPipeline(desc, &result);
+  if (!pipelineState || !result.isOk()) {
+    igl::Result::setResult(outResult, std::move(result));
+    return nullptr;
+  }
+
+  igl::Result::setOk(outResult);
+
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  // Another thread might have created the same pipeline in the meantime
+  if (auto existingPipelineState = find(desc, descHash)) {
+    return existingPipelineState;
+  }
+
+  _entries.push_front({descHash, desc, pipelineState});
+  _lookup.emplace(descHash, _entries.begin());
+
+  evict();
+
+  return pipelineState;
+}
+
+std::shared_ptr<igl::IRenderPipelineState> RenderPipelineCache::find(
+    const igl::RenderPipelineDesc& desc,
+    size_t descHash) {
+  const auto range = _lookup.equal_range(descHash);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (it->second->desc == desc) {
+      // Mark the entry as the most recently used one
+      _entries.splice(_entries.begin(), _entries, it->second);
+      return it->second->pipelineState;
+    }
+  }
+  return nullptr;
+}
+
+void RenderPipelineCache::evict() {
+  while (_entries.size() > _capacity) {
+    const auto& entry = _entries.back();
+    const auto range = _lookup.equal_range(entry.hash);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (&*it->second == &entry) {
+        _lookup.erase(it);
+        break;
+      }
+    }
+    _entries.pop_back();
+    _stats.numEvictions++;
+  }
+}
+
+void RenderPipelineCache::setCapacity(size_t capacity) {
+  IGL_ASSERT(capacity > 0);
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  _capacity = capacity;
+  evict();
+}
+
+void RenderPipelineCache::clear() {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _lookup.clear();
+  _entries.clear();
+}
+
+RenderPipelineCache::Stats RenderPipelineCache::getStats() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  Stats stats = _stats;
+  stats.numPipelines = _entries.size();
+  return stats;
+}
+
+} // namespace pipelinecache
+} // namespace iglu
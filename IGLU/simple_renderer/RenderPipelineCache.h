@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <igl/IGL.h>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace iglu {
+namespace pipelinecache {
+
+/// A thread-safe cache of render pipeline states which can be shared by many drawables.
+///
+/// Pipelines are deduplicated by their fully populated descriptor. The hash of a descriptor is
+/// computed once by the caller and descriptors with equal hashes are compared to rule out
+/// collisions. Just like std::hash<igl::RenderPipelineDesc>, vertex input states and shader stages
+/// are compared by pointer, so drawables have to share them in order to share pipelines.
+///
+/// The least recently used pipelines are evicted once the capacity is exceeded. Evicted pipelines
+/// stay alive for as long as someone else holds a reference to them.
+class RenderPipelineCache final {
+ public:
+  static constexpr size_t kDefaultCapacity = 256;
+
+  struct Stats {
+    uint32_t numHits = 0;
+    uint32_t numMisses = 0;
+    uint32_t numEvictions = 0;
+    size_t numPipelines = 0;
+  };
+
+  /// Returns a cached pipeline for 'desc' or creates a new one.
+  /// @param descHash Must be std::hash<igl::RenderPipelineDesc>()(desc). It is not recomputed, so
+  /// callers can hash a descriptor once and reuse the hash while the descriptor is unchanged.
+  std::shared_ptr<igl::IRenderPipelineState> getOrCreate(igl::IDevice& device,
+                                                         const igl::RenderPipelineDesc& desc,
+                                                         size_t descHash,
+                                                         igl::Result* outResult = nullptr);
+  std::shared_ptr<igl::IRenderPipelineState> getOrCreate(igl::IDevice& device,
+                                                         const igl::RenderPipelineDesc& desc,
+                                                         igl::Result* outResult = nullptr);
+
+  /// Evicts the least recently used pipelines if there are more than 'capacity' of them.
+  void setCapacity(size_t capacity);
+  void clear();
+
+  Stats getStats() const;
+
+  explicit RenderPipelineCache(size_t capacity = kDefaultCapacity);
+  ~RenderPipelineCache() = default;
+
+ private:
+  struct Entry {
+    size_t hash = 0;
+    igl::RenderPipelineDesc desc;
+    std::shared_ptr<igl::IRenderPipelineState> pipelineState;
+  };
+  using EntryList = std::list<Entry>;
+
+  // Both require '_mutex' to be locked
+  std::shared_ptr<igl::IRenderPipelineState> find(const igl::RenderPipelineDesc& desc,
+                                                  size_t descHash);
+  void evict();
+
+ private:
+  mutable std::mutex _mutex;
+  size_t _capacity;
+  // The most recently used entries are at the front
+  EntryList _entries;
+  std::unordered_multimap<size_t, EntryList::iterator> _lookup;
+  Stats _stats;
+};
+
+} // namespace pipelinecache
+} // namespace iglu
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "ReadbackTextureAccessor.h"
+
+namespace iglu {
+namespace textureaccessor {
+
+ReadbackTextureAccessor::ReadbackTextureAccessor(std::shared_ptr<igl::ITexture> texture,
+                                                 igl::IDevice& device) :
+  ITextureAccessor(std::move(texture)) {
+  igl::FramebufferDesc framebufferDesc;
+  framebufferDesc.colorAttachments[0].texture = texture_;
+  frameBuffer_ = device.createFramebuffer(framebufferDesc, nullptr);
+
+  const auto dimensions = texture_->getDimensions();
+  textureWidth_ = dimensions.width;
+  textureHeight_ = dimensions.height;
+
+  latestBytesRead_.resize(texture_->getProperties().getBytesPerRange(texture_->getFullRange()));
+}
+
+void ReadbackTextureAccessor::requestBytes(igl::ICommandQueue& commandQueue,
+                                           std::shared_ptr<igl::ITexture> texture) {
+  if (texture) {
+    IGL_ASSERT(textureWidth_ == texture->getDimensions().width &&
+               textureHeight_ == texture->getDimensions().height);
+    texture_ = std::move(texture);
+    frameBuffer_->updateDrawable(texture_);
+  }
+
+  const auto range = igl::TextureRangeDesc::new2D(0, 0, textureWidth_, textureHeight_);
+  request_ = frameBuffer_->requestBytesColorAttachment(commandQueue, 0, range);
+
+  status_ = request_ ? RequestStatus::InProgress : RequestStatus::NotInitialized;
+}
+
+RequestStatus ReadbackTextureAccessor::getRequestStatus() {
+  if (status_ == RequestStatus::InProgress && request_->isReady()) {
+    request_->getBytes(latestBytesRead_.data());
+    request_ = nullptr;
+    status_ = RequestStatus::Ready;
+  }
+  return status_;
+}
+
+std::vector<unsigned char>& ReadbackTextureAccessor::getBytes() {
+  if (status_ == RequestStatus::InProgress) {
+    request_->getBytes(latestBytesRead_.data());
+    request_ = nullptr;
+    status_ = RequestStatus::Ready;
+  }
+  return latestBytesRead_;
+}
+
+} // namespace textureaccessor
+} // namespace iglu
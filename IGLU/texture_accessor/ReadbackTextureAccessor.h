@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include "ITextureAccessor.h"
+#include "igl/Framebuffer.h"
+#include <igl/CommandQueue.h>
+#include <igl/IGL.h>
+#include <igl/Texture.h>
+
+namespace iglu {
+namespace textureaccessor {
+
+/// Backend-agnostic: built on top of IFramebuffer::requestBytesColorAttachment(), which reads back
+/// the texture without stalling the CPU on backends that support asynchronous readbacks
+class ReadbackTextureAccessor : public ITextureAccessor {
+ public:
+  ReadbackTextureAccessor(std::shared_ptr<igl::ITexture> texture, igl::IDevice& device);
+
+  void requestBytes(igl::ICommandQueue& commandQueue,
+                    std::shared_ptr<igl::ITexture> texture = nullptr) override;
+  RequestStatus getRequestStatus() override;
+  std::vector<unsigned char>& getBytes() override;
+
+ private:
+  std::vector<unsigned char> latestBytesRead_;
+  RequestStatus status_ = RequestStatus::NotInitialized;
+  std::shared_ptr<igl::IFramebuffer> frameBuffer_;
+  std::shared_ptr<igl::IReadbackRequest> request_;
+  size_t textureWidth_ = 0;
+  size_t textureHeight_ = 0;
+};
+
+} // namespace textureaccessor
+} // namespace iglu
@@ -8,6 +8,7 @@
 #include "TextureAccessorFactory.h"
 #include "ITextureAccessor.h"
 #include "OpenGLTextureAccessor.h"
+#include "ReadbackTextureAccessor.h"
 #include <memory>
 #if IGL_PLATFORM_APPLE
 #include "MetalTextureAccessor.h"
@@ -23,6 +24,8 @@ std::unique_ptr<ITextureAccessor> TextureAccessorFactory::createTextureAccessor(
   switch (backendType) {
   case igl::BackendType::OpenGL:
     return std::make_unique<OpenGLTextureAccessor>(texture, device);
+  case igl::BackendType::Vulkan:
+    return std::make_unique<ReadbackTextureAccessor>(texture, device);
 #if IGL_PLATFORM_APPLE
   case igl::BackendType::Metal:
     return std::make_unique<MetalTextureAccessor>(texture, device);
@@ -10,12 +10,14 @@
 #include <array>
 #include <igl/Common.h>
 #include <igl/ITrackedResource.h>
+#include <memory>
 #include <string>
 #include <vector>
 
 namespace igl {
 
 // class forward declaration
+class IBuffer;
 class ICommandBuffer;
 
 enum class IndexFormat : uint8_t {
@@ -59,6 +61,7 @@ struct BufferDesc {
     Bone = 1 << 3,
     Ring = 1 << 4, // Metal: Ring buffers with memory for each swapchain image
     NoCopy = 1 << 5, // Metal: The buffer should re-use previously allocated memory.
+    Pooled = 1 << 6, // Vulkan: Small buffers are sub-ranges of larger shared buffers.
   };
 
   using BufferAPIHint = uint8_t;
@@ -105,6 +108,19 @@ struct BufferDesc {
   }
 };
 
+/**
+ * @brief A range of GPU-visible memory returned by IDevice::allocateTransient(). It stays valid
+ * until the frame it was allocated in is retired.
+ */
+struct TransientAllocation {
+  /** @brief Write-only CPU pointer to `size` bytes of the allocation. */
+  void* IGL_NULLABLE data = nullptr;
+  /** @brief The buffer which contains the allocation. Bind it with `offset`. */
+  std::shared_ptr<IBuffer> buffer;
+  size_t offset = 0;
+  size_t size = 0;
+};
+
 class IBuffer : public ITrackedResource<IBuffer> {
  public:
   virtual ~IBuffer() = default;
@@ -122,6 +138,21 @@ class IBuffer : public ITrackedResource<IBuffer> {
    */
   virtual Result upload(const void* IGL_NULLABLE data, const BufferRange& range) = 0;
 
+  /**
+   * @brief Same as upload(), but never waits for the GPU to free up staging memory. Commands
+   * submitted after this call are ordered after the upload on the GPU, so no CPU wait is required
+   * before using the buffer. The default implementation calls upload().
+   *
+   * @return A handle which backends with asynchronous uploads let the application poll or wait on,
+   * e.g. vulkan::PlatformDevice::isUploadComplete(). Empty if the upload has already completed
+   */
+  virtual UploadHandle uploadAsync(const void* IGL_NULLABLE data,
+                                   const BufferRange& range,
+                                   Result* IGL_NULLABLE outResult = nullptr) {
+    Result::setResult(outResult, upload(data, range));
+    return {};
+  }
+
   /**
    * @brief Map a portion of the contents of a GPU Buffer into memory. Not efficient; intented
    * primarily for debug and test use. unmap() must be called before the buffer is used again in any
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/CacheFile.h>
+
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <igl/Common.h>
+#include <thread>
+
+#if IGL_PLATFORM_WIN
+#include <process.h>
+#else
+#include <unistd.h>
+#endif // IGL_PLATFORM_WIN
+
+namespace {
+
+std::string getTmpFileName(const std::string& fileName) {
+  static std::atomic<uint32_t> counter{0};
+
+#if IGL_PLATFORM_WIN
+  const auto pid = static_cast<uint64_t>(_getpid());
+#else
+  const auto pid = static_cast<uint64_t>(getpid());
+#endif // IGL_PLATFORM_WIN
+
+  // the process id tells processes apart, the thread id and the counter tell writers apart within
+  // the process
+  return fileName + "." + std::to_string(pid) + "." +
+         std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + "." +
+         std::to_string(counter++) + ".tmp";
+}
+
+} // namespace
+
+namespace igl {
+
+uint64_t hashCacheBytes(uint64_t hash, const void* data, size_t size) {
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  for (size_t i = 0; i != size; i++) {
+    hash ^= bytes[i];
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+bool writeCacheFile(const std::string& fileName,
+                    const std::vector<std::pair<const void*, size_t>>& chunks) {
+  const std::string tmpFileName = getTmpFileName(fileName);
+
+  {
+    std::ofstream file(tmpFileName, std::ios::binary | std::ios::trunc);
+    if (!file) {
+      IGL_LOG_ERROR("Cannot write the cache file %s\n", tmpFileName.c_str());
+      return false;
+    }
+
+    for (const auto& chunk : chunks) {
+      file.write(static_cast<const char*>(chunk.first), static_cast<std::streamsize>(chunk.second));
+    }
+
+    if (!file) {
+      IGL_LOG_ERROR("Cannot write the cache file %s\n", tmpFileName.c_str());
+      file.close();
+      std::remove(tmpFileName.c_str());
+      return false;
+    }
+  }
+
+#if IGL_PLATFORM_WIN
+  // std::rename() does not replace existing files on Windows
+  std::remove(fileName.c_str());
+#endif // IGL_PLATFORM_WIN
+
+  if (std::rename(tmpFileName.c_str(), fileName.c_str()) != 0) {
+    // the entry might have been written by another process in the meantime
+    std::remove(tmpFileName.c_str());
+  }
+
+  return true;
+}
+
+} // namespace igl
@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace igl {
+
+/// @brief The offset basis of hashCacheBytes()
+constexpr uint64_t kCacheHashOffsetBasis = 14695981039346656037ull;
+
+/// @brief 64-bit FNV-1a for cache keys: stable across runs and platforms, unlike std::hash
+uint64_t hashCacheBytes(uint64_t hash, const void* data, size_t size);
+
+/// @brief Writes a cache file as the concatenation of `chunks` (pointer and size pairs). The data
+/// goes into a temporary file, unique to this process and thread, which then replaces `fileName`,
+/// so other threads and processes never see a partially written file.
+/// @return false if the file could not be written
+bool writeCacheFile(const std::string& fileName,
+                    const std::vector<std::pair<const void*, size_t>>& chunks);
+
+} // namespace igl
@@ -10,20 +10,37 @@
 #include <igl/Buffer.h>
 #include <igl/Common.h>
 #include <igl/Framebuffer.h>
+#include <igl/ParallelRenderCommandEncoder.h>
 #include <igl/RenderCommandEncoder.h>
+#include <igl/TimestampQueryPool.h>
 
 namespace igl {
 
+class IBuffer;
+class ICommandBuffer;
 class IComputeCommandEncoder;
+class IQueryPool;
 class ISamplerState;
 class ITexture;
 struct RenderPassDesc;
 
-/**
- * Currently a no-op structure.
- */
 struct CommandBufferDesc {
   std::string debugName;
+  /**
+   * @brief Optional pool for automatic GPU timing. If set, the pool is reset when the command
+   * buffer is created, and every encoder and debug group is timed. See ITimestampQueryPool.
+   */
+  std::shared_ptr<ITimestampQueryPool> timestampQueryPool;
+  /**
+   * @brief Command buffers created by the same queue which have to execute before this one. On
+   * Vulkan, submitting this command buffer before all of its dependencies are submitted defers the
+   * submission until the last of them is submitted; ICommandQueue::submit() returns 0 in that
+   * case, and the command buffer cannot be waited on until it is submitted. Creating a command
+   * buffer with null dependencies or dependencies from another queue fails. A dependency destroyed
+   * without being submitted is an error. Other backends execute command buffers in submission
+   * order, so the dependencies have to be submitted first.
+   */
+  std::vector<std::shared_ptr<ICommandBuffer>> dependencies;
 };
 
 /**
@@ -70,6 +87,20 @@ class ICommandBuffer {
     return createRenderCommandEncoder(renderPass, std::move(framebuffer), nullptr);
   }
 
+  /**
+   * @brief Create an encoder which splits a render pass across several render command encoders
+   * recorded concurrently on different threads. See IParallelRenderCommandEncoder.
+   * @returns nullptr if DeviceFeatures::ParallelRenderEncoding is not supported
+   */
+  virtual std::unique_ptr<IParallelRenderCommandEncoder> createParallelRenderCommandEncoder(
+      const RenderPassDesc& /*renderPass*/,
+      std::shared_ptr<IFramebuffer> /*framebuffer*/,
+      Result* IGL_NULLABLE outResult) {
+    Result::setResult(
+        outResult, Result::Code::Unsupported, "Parallel render encoding is not supported");
+    return nullptr;
+  }
+
   /**
    * @brief Create a ComputeCommandEncoder for encoding compute commands into this CommandBuffer.
    * @returns a pointer to the ComputeCommandEncoder
@@ -116,6 +147,51 @@ class ICommandBuffer {
    */
   virtual void popDebugGroupLabel() const = 0;
 
+  /**
+   * @brief Resets all queries of a timestamp query pool. Queries have to be reset before they can
+   * be written again. Must not be called while a render command encoder is encoding.
+   * @see IDevice::createTimestampQueryPool()
+   */
+  virtual void resetTimestampQueries(ITimestampQueryPool& /*pool*/) {
+    IGL_ASSERT_NOT_IMPLEMENTED();
+  }
+
+  /**
+   * @brief Writes a GPU timestamp into the query with the index 'query' once all previously
+   * recorded commands have completed. Can be called while an encoder is encoding.
+   * @see IDevice::createTimestampQueryPool()
+   */
+  virtual void writeTimestamp(ITimestampQueryPool& /*pool*/, uint32_t /*query*/) {
+    IGL_ASSERT_NOT_IMPLEMENTED();
+  }
+
+  /**
+   * @brief Resets `queryCount` queries of an occlusion or pipeline statistics query pool starting
+   * at `firstQuery`. Queries have to be reset before every use. Must not be called while a render
+   * command encoder is encoding.
+   * @see IDevice::createQueryPool()
+   */
+  virtual void resetQueries(IQueryPool& /*pool*/,
+                            uint32_t /*firstQuery*/,
+                            uint32_t /*queryCount*/) {
+    IGL_ASSERT_NOT_IMPLEMENTED();
+  }
+
+  /**
+   * @brief Copies the results of `queryCount` queries starting at `firstQuery` into `buffer` at
+   * `bufferOffset` as tightly packed 64-bit values. The copy executes on the GPU once the queries
+   * are available, without stalling the CPU, and is made visible to subsequent indirect draws,
+   * vertex, fragment and compute shaders recorded into this and later command buffers. Must not
+   * be called while a render command encoder is encoding.
+   */
+  virtual void copyQueryResults(IQueryPool& /*pool*/,
+                                uint32_t /*firstQuery*/,
+                                uint32_t /*queryCount*/,
+                                IBuffer& /*buffer*/,
+                                size_t /*bufferOffset*/) {
+    IGL_ASSERT_NOT_IMPLEMENTED();
+  }
+
   /**
    * @returns the number of draw operations tracked by this CommandBuffer. This is tracked manually
    * via calls to incrementCurrentDrawCount().
@@ -139,6 +139,19 @@ struct Result {
   }
 };
 
+/**
+ * @brief Identifies an upload started by IBuffer::uploadAsync() or ITexture::uploadAsync().
+ * Uploads are submitted separately from command buffers, so an UploadHandle is deliberately not
+ * interchangeable with a SubmitHandle. An empty handle refers to an upload which has completed.
+ */
+struct UploadHandle {
+  uint64_t handle = 0;
+
+  [[nodiscard]] bool empty() const {
+    return handle == 0;
+  }
+};
+
 enum class BackendType {
   OpenGL,
   Metal,
@@ -239,6 +252,15 @@ constexpr typename std::underlying_type<E>::type EnumToValue(E enumerator) noexc
   return static_cast<typename std::underlying_type<E>::type>(enumerator);
 }
 
+///--------------------------------------
+/// MARK: - Hash utilities
+
+// Mixes `value` into `seed` like boost::hash_combine(): unlike XOR, the order of the values matters
+// and equal values do not cancel each other out
+inline void hashCombine(size_t& seed, size_t value) {
+  seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
 ///--------------------------------------
 /// MARK: - ScopeGuard
 
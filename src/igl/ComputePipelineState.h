@@ -14,6 +14,7 @@
 #include <igl/Texture.h>
 #include <map>
 #include <unordered_map>
+#include <vector>
 
 namespace igl {
 /*
@@ -28,7 +29,8 @@ struct ComputePipelineDesc {
  public:
   bool operator==(const ComputePipelineDesc& other) const {
     return shaderStages == other.shaderStages && imagesMap == other.imagesMap &&
-           buffersMap == other.buffersMap && debugName == other.debugName;
+           buffersMap == other.buffersMap &&
+           specializationConstants == other.specializationConstants && debugName == other.debugName;
   }
 
   /*
@@ -42,6 +44,11 @@ struct ComputePipelineDesc {
    */
   std::shared_ptr<IShaderStages> shaderStages;
 
+  /*
+   * @brief Values of the specialization constants used by the compute kernel.
+   */
+  std::vector<SpecializationConstant> specializationConstants;
+
   std::string debugName;
 };
 
@@ -71,6 +78,7 @@ struct hash<igl::ComputePipelineDesc> {
   size_t operator()(const igl::ComputePipelineDesc& desc) const {
     size_t hash = std::hash<uintptr_t>()(reinterpret_cast<uintptr_t>(desc.shaderStages.get()));
     hash ^= std::hash<std::string>()(desc.debugName);
+    hash ^= std::hash<std::vector<igl::SpecializationConstant>>()(desc.specializationConstants);
     for (const auto& p : desc.buffersMap) {
       hash ^= std::hash<size_t>()(p.first);
       hash ^= std::hash<std::string>()(p.second.toString());
@@ -6,7 +6,9 @@
  */
 
 #include <igl/Device.h>
+#include <igl/QueryPool.h>
 #include <igl/Shader.h>
+#include <igl/TimestampQueryPool.h>
 
 #include <algorithm>
 #include <utility>
@@ -27,6 +29,64 @@ bool IDevice::verifyScope() {
 
 void IDevice::updateSurface(void* nativeWindowType) {}
 
+std::shared_ptr<ITimestampQueryPool> IDevice::createTimestampQueryPool(
+    const TimestampQueryPoolDesc& /*desc*/,
+    Result* outResult) const {
+  Result::setResult(outResult, Result::Code::Unsupported, "Timestamp queries are not supported");
+  return nullptr;
+}
+
+std::vector<std::unique_ptr<IShaderStages>> IDevice::createShaderStagesBatch(
+    const std::vector<ShaderStagesModulesDesc>& descs,
+    std::vector<Result>* outResults) const {
+  std::vector<std::unique_ptr<IShaderStages>> stages(descs.size());
+
+  if (outResults) {
+    outResults->assign(descs.size(), Result());
+  }
+
+  for (size_t i = 0; i != descs.size(); i++) {
+    const ShaderStagesModulesDesc& desc = descs[i];
+    Result* outResult = outResults ? &(*outResults)[i] : nullptr;
+
+    ShaderStagesDesc stagesDesc;
+    stagesDesc.type = desc.type;
+
+    Result result;
+    if (desc.type == ShaderStagesType::Render) {
+      stagesDesc.vertexModule = createShaderModule(desc.vertexModule, &result);
+      if (result.isOk()) {
+        stagesDesc.fragmentModule = createShaderModule(desc.fragmentModule, &result);
+      }
+    } else {
+      stagesDesc.computeModule = createShaderModule(desc.computeModule, &result);
+    }
+
+    if (!result.isOk()) {
+      Result::setResult(outResult, std::move(result));
+      continue;
+    }
+
+    stages[i] = createShaderStages(stagesDesc, outResult);
+  }
+
+  return stages;
+}
+
+std::shared_ptr<IQueryPool> IDevice::createQueryPool(const QueryPoolDesc& /*desc*/,
+                                                     Result* outResult) const {
+  Result::setResult(outResult, Result::Code::Unsupported, "Queries are not supported");
+  return nullptr;
+}
+
+TransientAllocation IDevice::allocateTransient(BufferDesc::BufferType /*type*/,
+                                               size_t /*size*/,
+                                               Result* outResult) {
+  Result::setResult(
+      outResult, Result::Code::Unsupported, "Transient allocations are not supported");
+  return {};
+}
+
 TextureDesc IDevice::sanitize(const TextureDesc& desc) const {
   TextureDesc sanitized = desc;
   if (desc.width == 0 || desc.height == 0 || desc.depth == 0 || desc.numLayers == 0 ||
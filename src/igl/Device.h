@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <igl/Buffer.h>
 #include <igl/Common.h>
 #include <igl/DeviceFeatures.h>
 #include <igl/IResourceTracker.h>
@@ -22,12 +23,15 @@ struct CommandQueueDesc;
 struct ComputePipelineDesc;
 struct DepthStencilStateDesc;
 struct FramebufferDesc;
+struct QueryPoolDesc;
 struct RenderPipelineDesc;
 struct SamplerStateDesc;
 struct ShaderLibraryDesc;
 struct ShaderModuleDesc;
 struct ShaderStagesDesc;
+struct ShaderStagesModulesDesc;
 struct TextureDesc;
+struct TimestampQueryPoolDesc;
 struct VertexInputStateDesc;
 class IBuffer;
 class ICommandQueue;
@@ -36,12 +40,14 @@ class IComputePipelineState;
 class IDepthStencilState;
 class IDevice;
 class IFramebuffer;
+class IQueryPool;
 class IRenderPipelineState;
 class ISamplerState;
 class IShaderLibrary;
 class IShaderModule;
 class IShaderStages;
 class ITexture;
+class ITimestampQueryPool;
 class IVertexInputState;
 
 /**
@@ -168,6 +174,31 @@ class IDevice : public ICapabilities {
   virtual std::shared_ptr<IFramebuffer> createFramebuffer(const FramebufferDesc& desc,
                                                           Result* IGL_NULLABLE outResult) = 0;
 
+  /**
+   * @brief Creates a pool of GPU timestamp queries. Only available when the device supports
+   * DeviceFeatures::Timestamps.
+   * @see igl::TimestampQueryPoolDesc
+   * @param desc Description for the desired resource.
+   * @param outResult Pointer to where the result (success, failure, etc) is written. Can be null if
+   * no reporting is desired.
+   * @return Shared pointer to the created query pool.
+   */
+  virtual std::shared_ptr<ITimestampQueryPool> createTimestampQueryPool(
+      const TimestampQueryPoolDesc& desc,
+      Result* IGL_NULLABLE outResult) const;
+
+  /**
+   * @brief Creates a pool of occlusion or pipeline statistics queries. Only available when the
+   * device supports the DeviceFeatures matching the type of the queries.
+   * @see igl::QueryPoolDesc
+   * @param desc Description for the desired resource.
+   * @param outResult Pointer to where the result (success, failure, etc) is written. Can be null if
+   * no reporting is desired.
+   * @return Shared pointer to the created query pool.
+   */
+  virtual std::shared_ptr<IQueryPool> createQueryPool(const QueryPoolDesc& desc,
+                                                      Result* IGL_NULLABLE outResult) const;
+
   /**
    * @brief Returns a platform-specific device. If the requested device type does not match that of
    * the actual underlying device, then null is returned.
@@ -268,6 +299,39 @@ class IDevice : public ICapabilities {
                                                             Result* IGL_NULLABLE
                                                                 outResult) const = 0;
 
+  /**
+   * @brief Creates shader modules and shader stages for many programs at once. Backends compile
+   * the whole batch concurrently when they can, which is much faster than creating the stages one
+   * by one. The default implementation creates them sequentially.
+   * @see igl::ShaderStagesModulesDesc
+   * @param descs Descriptions of the shader stages and their modules.
+   * @param outResults Optional vector which receives a result for every element of `descs`.
+   * @return Shader stages in the order of `descs`. Elements which failed to compile are null.
+   */
+  virtual std::vector<std::unique_ptr<IShaderStages>> createShaderStagesBatch(
+      const std::vector<ShaderStagesModulesDesc>& descs,
+      std::vector<Result>* IGL_NULLABLE outResults) const;
+
+  /**
+   * @brief Allocates transient GPU-visible memory for dynamic per-draw data, e.g. uniforms or
+   * vertices which change every frame. Allocations are sub-ranges of persistently mapped buffers
+   * owned by the device, so writing the data is a plain memory write rather than an upload. An
+   * allocation may only be used by commands of the frame it was allocated in: the memory is reused
+   * once that frame has been retired by the GPU. On OpenGL, frames end with ICommandQueue::submit()
+   * and the data is uploaded when the next draw call or dispatch is encoded, so it has to be
+   * written before that; storage buffers are not supported. Backends which do not support transient
+   * allocations return an empty allocation and Result::Code::Unsupported.
+   * @param type How the allocation is going to be bound (one of BufferDesc::BufferTypeBits).
+   * @param size The number of bytes to allocate. Allocations are suitably aligned to be bound with
+   * their offset.
+   * @param outResult Pointer to where the result (success, failure, etc) is written. Can be null if
+   * no reporting is desired.
+   * @return The allocated memory, its buffer and its offset in the buffer.
+   */
+  virtual TransientAllocation allocateTransient(BufferDesc::BufferType type,
+                                                size_t size,
+                                                Result* IGL_NULLABLE outResult);
+
  protected:
   virtual void beginScope();
   virtual void endScope();
@@ -57,6 +57,14 @@ namespace igl {
  * TextureHalfFloat           Supports half float texture format
  * TextureNotPot              Supports non power-of-two textures
  * TexturePartialMipChain     Supports mip chains that do not go all the way to 1x1
+ * Timestamps                 Supports GPU timestamp queries
+ * OcclusionQueries           Supports binary occlusion queries (QueryType::BinaryOcclusion)
+ * PreciseOcclusionQueries    Supports occlusion queries with exact sample counts
+ * PipelineStatisticsQueries  Supports pipeline statistics queries (QueryType::PipelineStatistics)
+ * DrawInstanced              Supports instanced draws and VertexSampleFunction::Instance
+ * DrawBaseInstance           Supports non-zero baseVertex and baseInstance in instanced draws
+ * VertexInstanceStepRate     Supports per-instance vertex bindings with a sampleRate greater than 1
+ * ParallelRenderEncoding     Supports recording a render pass on several threads
  * UniformBlocks,             Supports uniform blocks
  * ValidationLayersEnabled,   Validation layers are enabled
  */
@@ -100,6 +108,14 @@ enum class DeviceFeatures {
   TextureHalfFloat,
   TextureNotPot,
   TexturePartialMipChain,
+  Timestamps,
+  OcclusionQueries,
+  PreciseOcclusionQueries,
+  PipelineStatisticsQueries,
+  DrawInstanced,
+  DrawBaseInstance,
+  VertexInstanceStepRate,
+  ParallelRenderEncoding,
   UniformBlocks,
   ValidationLayersEnabled,
 };
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/Framebuffer.h>
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <igl/Texture.h>
+#include <vector>
+
+namespace igl {
+
+namespace {
+
+/// The result of a readback which was performed synchronously
+class CompletedReadbackRequest final : public IReadbackRequest {
+ public:
+  CompletedReadbackRequest(std::vector<uint8_t> bytes, size_t bytesPerRow, size_t numRows) :
+    bytes_(std::move(bytes)), bytesPerRow_(bytesPerRow), numRows_(numRows) {}
+
+  [[nodiscard]] bool isReady() const override {
+    return true;
+  }
+
+  void getBytes(void* pixelBytes, size_t bytesPerRow) override {
+    copyRows(pixelBytes, bytesPerRow, bytes_.data(), bytesPerRow_, numRows_);
+  }
+
+ private:
+  std::vector<uint8_t> bytes_;
+  size_t bytesPerRow_ = 0;
+  size_t numRows_ = 0;
+};
+
+} // namespace
+
+void IReadbackRequest::copyRows(void* dst,
+                                size_t dstBytesPerRow,
+                                const void* src,
+                                size_t srcBytesPerRow,
+                                size_t numRows,
+                                bool flipVertical) {
+  if (!IGL_VERIFY(dst && src)) {
+    return;
+  }
+
+  if (dstBytesPerRow == 0) {
+    dstBytesPerRow = srcBytesPerRow;
+  }
+
+  if (dstBytesPerRow == srcBytesPerRow && !flipVertical) {
+    std::memcpy(dst, src, srcBytesPerRow * numRows);
+    return;
+  }
+
+  const size_t rowSize = std::min(dstBytesPerRow, srcBytesPerRow);
+
+  for (size_t row = 0; row != numRows; row++) {
+    const size_t srcRow = flipVertical ? numRows - 1 - row : row;
+    std::memcpy(static_cast<uint8_t*>(dst) + row * dstBytesPerRow,
+                static_cast<const uint8_t*>(src) + srcRow * srcBytesPerRow,
+                rowSize);
+  }
+}
+
+std::shared_ptr<IReadbackRequest> IFramebuffer::requestBytesColorAttachment(
+    ICommandQueue& cmdQueue,
+    size_t index,
+    const TextureRangeDesc& range) const {
+  const auto texture = getColorAttachment(index);
+  if (!IGL_VERIFY(texture)) {
+    return nullptr;
+  }
+
+  const auto& properties = texture->getProperties();
+  const size_t bytesPerRow = properties.getBytesPerRow(range);
+  const size_t numRows = properties.getRows(range);
+
+  std::vector<uint8_t> bytes(bytesPerRow * numRows);
+  copyBytesColorAttachment(cmdQueue, index, bytes.data(), range, bytesPerRow);
+
+  return std::make_shared<CompletedReadbackRequest>(std::move(bytes), bytesPerRow, numRows);
+}
+
+} // namespace igl
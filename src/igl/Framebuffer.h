@@ -48,6 +48,32 @@ struct FramebufferDesc {
   FramebufferMode mode = FramebufferMode::Mono;
 };
 
+/**
+ * @brief A pending asynchronous readback of GPU data into CPU memory. Every request owns its
+ * readback memory, so any number of requests can be in flight at the same time.
+ */
+class IReadbackRequest {
+ public:
+  virtual ~IReadbackRequest() = default;
+
+  /** @brief Returns true if the data has been copied into CPU-visible memory. Never blocks. */
+  [[nodiscard]] virtual bool isReady() const = 0;
+
+  /** @brief Copies the data into 'pixelBytes', waiting for the GPU if the request is not ready
+   * yet. If bytesPerRow is 0, it will be autocalculated assuming no padding. */
+  virtual void getBytes(void* pixelBytes, size_t bytesPerRow = 0) = 0;
+
+ protected:
+  /** @brief Copies 'numRows' rows of 'srcBytesPerRow' bytes each from 'src' into 'dst', optionally
+   * reversing the order of the rows. */
+  static void copyRows(void* dst,
+                       size_t dstBytesPerRow,
+                       const void* src,
+                       size_t srcBytesPerRow,
+                       size_t numRows,
+                       bool flipVertical = false);
+};
+
 /**
  * @brief Interface common to all frame buffers across all implementations
  */
@@ -92,6 +118,15 @@ class IFramebuffer : public ITrackedResource<IFramebuffer> {
                                           void* pixelBytes,
                                           const TextureRangeDesc& range,
                                           size_t bytesPerRow = 0) const = 0;
+  /** @brief Start copying color data from the color attachment at the specified index into CPU
+   * memory without waiting for the GPU. The data can be retrieved later from the returned request.
+   * The default implementation falls back to copyBytesColorAttachment() and returns a request
+   * which is already ready. Some implementations may only support index 0. */
+  virtual std::shared_ptr<IReadbackRequest> requestBytesColorAttachment(
+      ICommandQueue& cmdQueue,
+      size_t index,
+      const TextureRangeDesc& range) const;
+
   /** @brief Copy color data from the color attachment at the specified index into 'destTexture'.
    * Some implementations may only support index 0. */
   virtual void copyTextureColorAttachment(ICommandQueue& cmdQueue,
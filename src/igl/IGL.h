@@ -17,6 +17,8 @@
 #include <igl/Device.h>
 #include <igl/Framebuffer.h>
 #include <igl/HWDevice.h>
+#include <igl/ParallelRenderCommandEncoder.h>
+#include <igl/QueryPool.h>
 #include <igl/RenderCommandEncoder.h>
 #include <igl/RenderPass.h>
 #include <igl/RenderPipelineState.h>
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <igl/Common.h>
+#include <igl/RenderCommandEncoder.h>
+
+namespace igl {
+
+/**
+ * @brief IParallelRenderCommandEncoder splits a single render pass across several render command
+ * encoders which can be recorded concurrently on different threads.
+ *
+ * Every encoder returned by createRenderCommandEncoder() starts with the default viewport and
+ * scissor of the render pass and no bound state. The commands of all encoders are executed in the
+ * order the encoders were created, regardless of the order in which they were recorded.
+ *
+ * Typical usage:
+ *   1. Create one encoder per worker thread on the thread which owns the command buffer.
+ *   2. Record each encoder on its own thread and call endEncoding() on it.
+ *   3. Once all worker threads are done, call endEncoding() on the parallel encoder.
+ *
+ * Nothing else may be recorded into the command buffer while the parallel encoder is encoding.
+ */
+class IParallelRenderCommandEncoder {
+ public:
+  virtual ~IParallelRenderCommandEncoder() = default;
+
+  /**
+   * @brief Creates a render command encoder which records a part of the render pass. Thread-safe.
+   * The returned encoder can be recorded on any thread, but only on one thread at a time.
+   */
+  virtual std::unique_ptr<IRenderCommandEncoder> createRenderCommandEncoder(
+      Result* IGL_NULLABLE outResult) = 0;
+
+  /**
+   * @brief Ends the render pass. All encoders created by this parallel encoder must have ended
+   * encoding before this is called.
+   */
+  virtual void endEncoding() = 0;
+};
+
+} // namespace igl
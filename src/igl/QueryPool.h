@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <igl/Common.h>
+#include <string>
+
+namespace igl {
+
+/**
+ * @brief The kind of queries stored in an IQueryPool.
+ *
+ * Occlusion           Counts the number of samples which passed the depth and stencil tests
+ * BinaryOcclusion     Non-zero if any sample passed the depth and stencil tests. Cheaper than
+ *                     Occlusion on some GPUs
+ * PipelineStatistics  Counts the work done by the pipeline stages selected in
+ *                     QueryPoolDesc::pipelineStatistics
+ */
+enum class QueryType : uint8_t {
+  Occlusion,
+  BinaryOcclusion,
+  PipelineStatistics,
+};
+
+/**
+ * @brief Describes a pool of occlusion or pipeline statistics queries.
+ */
+struct QueryPoolDesc {
+  /**
+   * @brief Pipeline statistics counters. Every query of a PipelineStatistics pool produces one
+   * value per enabled counter, in the order of the bits below.
+   */
+  enum PipelineStatisticsBits : uint8_t {
+    InputAssemblyPrimitives = 1 << 0,
+    VertexShaderInvocations = 1 << 1,
+    ClippingPrimitives = 1 << 2,
+    FragmentShaderInvocations = 1 << 3,
+    ComputeShaderInvocations = 1 << 4,
+  };
+
+  using PipelineStatistics = uint8_t;
+
+  QueryType type = QueryType::Occlusion;
+  uint32_t queryCount = 0;
+  /** @brief A combination of PipelineStatisticsBits. Only used by PipelineStatistics pools */
+  PipelineStatistics pipelineStatistics = 0;
+  std::string debugName;
+};
+
+/**
+ * @brief IQueryPool holds the results of occlusion or pipeline statistics queries recorded with
+ * IRenderCommandEncoder::beginQuery() and IRenderCommandEncoder::endQuery().
+ *
+ * Queries have to be reset with ICommandBuffer::resetQueries() before they are used. Results can
+ * be read back on the CPU with getResults(), which never waits for the GPU, or copied into a
+ * buffer on the GPU timeline with ICommandBuffer::copyQueryResults(), e.g. to drive indirect draws
+ * of the next frame without a round trip to the CPU.
+ */
+class IQueryPool {
+ public:
+  virtual ~IQueryPool() = default;
+
+  [[nodiscard]] virtual QueryType getType() const = 0;
+  [[nodiscard]] virtual uint32_t getQueryCount() const = 0;
+
+  /**
+   * @brief Returns the number of 64-bit values produced by every query: one for occlusion queries
+   * and one per enabled counter for pipeline statistics queries.
+   */
+  [[nodiscard]] virtual uint32_t getValuesPerQuery() const = 0;
+
+  /**
+   * @brief Copies the results of `queryCount` queries into outValues, which must hold
+   * queryCount * getValuesPerQuery() values. Does not wait for the GPU.
+   * @return false if any of the requested results is not available yet.
+   */
+  [[nodiscard]] virtual bool getResults(uint32_t firstQuery,
+                                        uint32_t queryCount,
+                                        uint64_t* IGL_NONNULL outValues) const = 0;
+};
+
+} // namespace igl
@@ -17,6 +17,7 @@ namespace igl {
 
 class IBuffer;
 class IDepthStencilState;
+class IQueryPool;
 class IRenderPipelineState;
 class ISamplerState;
 class ITexture;
@@ -83,6 +84,31 @@ class IRenderCommandEncoder : public ICommandEncoder {
                            IndexFormat indexFormat,
                            IBuffer& indexBuffer,
                            size_t indexBufferOffset) = 0;
+  /**
+   * @brief Draws `instanceCount` instances of the same geometry in a single draw call. Vertex
+   * bindings with VertexSampleFunction::Instance advance once every VertexInputBinding::sampleRate
+   * instances, starting at instance `baseInstance`.
+   * Requires DeviceFeatures::DrawInstanced. A non-zero baseInstance requires
+   * DeviceFeatures::DrawBaseInstance.
+   */
+  virtual void drawInstanced(PrimitiveType primitiveType,
+                             size_t vertexStart,
+                             size_t vertexCount,
+                             uint32_t instanceCount,
+                             uint32_t baseInstance = 0) = 0;
+  /**
+   * @brief Indexed version of drawInstanced(). `baseVertex` is added to every index before
+   * fetching vertices. A non-zero baseVertex or baseInstance requires
+   * DeviceFeatures::DrawBaseInstance.
+   */
+  virtual void drawIndexedInstanced(PrimitiveType primitiveType,
+                                    size_t indexCount,
+                                    IndexFormat indexFormat,
+                                    IBuffer& indexBuffer,
+                                    size_t indexBufferOffset,
+                                    uint32_t instanceCount,
+                                    int32_t baseVertex = 0,
+                                    uint32_t baseInstance = 0) = 0;
   // NOTE: indexBufferOffset parameter is supported in Metal but not OpenGL
   virtual void drawIndexedIndirect(PrimitiveType primitiveType,
                                    IndexFormat indexFormat,
@@ -106,6 +132,21 @@ class IRenderCommandEncoder : public ICommandEncoder {
   virtual void setStencilReferenceValues(uint32_t frontValue, uint32_t backValue) = 0;
   virtual void setBlendColor(Color color) = 0;
   virtual void setDepthBias(float depthBias, float slopeScale, float clamp) = 0;
+
+  /**
+   * @brief Starts an occlusion or pipeline statistics query. The query must have been reset with
+   * ICommandBuffer::resetQueries(). Queries of the same type cannot be nested.
+   * @see IDevice::createQueryPool()
+   */
+  virtual void beginQuery(IQueryPool& /*pool*/, uint32_t /*query*/) {
+    IGL_ASSERT_NOT_IMPLEMENTED();
+  }
+  /**
+   * @brief Ends a query started with beginQuery().
+   */
+  virtual void endQuery(IQueryPool& /*pool*/, uint32_t /*query*/) {
+    IGL_ASSERT_NOT_IMPLEMENTED();
+  }
 };
 
 } // namespace igl
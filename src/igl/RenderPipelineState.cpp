@@ -82,6 +82,10 @@ bool RenderPipelineDesc::operator==(const RenderPipelineDesc& other) const {
     return false;
   }
 
+  if (specializationConstants != other.specializationConstants) {
+    return false;
+  }
+
   if (debugName != other.debugName) {
     return false;
   }
@@ -104,6 +108,8 @@ size_t std::hash<RenderPipelineDesc>::operator()(RenderPipelineDesc const& key)
   hash ^= std::hash<int>()(EnumToValue(key.polygonFillMode));
   hash ^= std::hash<igl::NameHandle>()(key.debugName);
 
+  hash ^= std::hash<std::vector<igl::SpecializationConstant>>()(key.specializationConstants);
+
   for (const auto& i : key.vertexUnitSamplerMap) {
     hash ^= std::hash<size_t>()(i.first);
     hash ^= std::hash<igl::NameHandle>()(i.second);
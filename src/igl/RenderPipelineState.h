@@ -199,6 +199,11 @@ struct RenderPipelineDesc {
 
   int sampleCount = 1;
 
+  /*
+   * @brief Values of the specialization constants used by the vertex and fragment shaders
+   */
+  std::vector<SpecializationConstant> specializationConstants;
+
   igl::NameHandle debugName;
 
   bool operator==(const RenderPipelineDesc& other) const;
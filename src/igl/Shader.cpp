@@ -10,6 +10,7 @@
 #include <cstring>
 #include <igl/Common.h>
 #include <type_traits>
+#include <utility>
 
 namespace {
 
@@ -71,6 +72,57 @@ bool ShaderModuleInfo::operator!=(const ShaderModuleInfo& other) const {
   return !operator==(other);
 }
 
+namespace {
+
+SpecializationConstant makeSpecializationConstant(uint32_t id,
+                                                  std::string name,
+                                                  SpecializationConstantType type,
+                                                  uint32_t value) {
+  SpecializationConstant constant;
+  constant.id = id;
+  constant.name = std::move(name);
+  constant.type = type;
+  constant.value = value;
+  return constant;
+}
+
+} // namespace
+
+SpecializationConstant SpecializationConstant::fromBool(uint32_t id, std::string name, bool value) {
+  return makeSpecializationConstant(
+      id, std::move(name), SpecializationConstantType::Bool, value ? 1u : 0u);
+}
+
+SpecializationConstant SpecializationConstant::fromInt(uint32_t id,
+                                                       std::string name,
+                                                       int32_t value) {
+  return makeSpecializationConstant(
+      id, std::move(name), SpecializationConstantType::Int, static_cast<uint32_t>(value));
+}
+
+SpecializationConstant SpecializationConstant::fromUInt(uint32_t id,
+                                                        std::string name,
+                                                        uint32_t value) {
+  return makeSpecializationConstant(id, std::move(name), SpecializationConstantType::UInt, value);
+}
+
+SpecializationConstant SpecializationConstant::fromFloat(uint32_t id,
+                                                         std::string name,
+                                                         float value) {
+  static_assert(sizeof(float) == sizeof(uint32_t));
+  uint32_t bits = 0;
+  memcpy(&bits, &value, sizeof(bits));
+  return makeSpecializationConstant(id, std::move(name), SpecializationConstantType::Float, bits);
+}
+
+bool SpecializationConstant::operator==(const SpecializationConstant& other) const {
+  return id == other.id && name == other.name && type == other.type && value == other.value;
+}
+
+bool SpecializationConstant::operator!=(const SpecializationConstant& other) const {
+  return !(*this == other);
+}
+
 bool ShaderInput::isValid() const noexcept {
   if (type == ShaderInputType::String) {
     return source != nullptr && data == nullptr && length == 0;
@@ -210,6 +262,24 @@ ShaderStagesDesc ShaderStagesDesc::fromComputeModule(std::shared_ptr<IShaderModu
   return desc;
 }
 
+ShaderStagesModulesDesc ShaderStagesModulesDesc::fromRenderModules(
+    ShaderModuleDesc vertexModule,
+    ShaderModuleDesc fragmentModule) {
+  ShaderStagesModulesDesc desc;
+  desc.type = ShaderStagesType::Render;
+  desc.vertexModule = std::move(vertexModule);
+  desc.fragmentModule = std::move(fragmentModule);
+  return desc;
+}
+
+ShaderStagesModulesDesc ShaderStagesModulesDesc::fromComputeModule(
+    ShaderModuleDesc computeModule) {
+  ShaderStagesModulesDesc desc;
+  desc.type = ShaderStagesType::Compute;
+  desc.computeModule = std::move(computeModule);
+  return desc;
+}
+
 IShaderStages::IShaderStages(ShaderStagesDesc desc) : desc_(std::move(desc)) {}
 
 ShaderStagesType IShaderStages::getType() const noexcept {
@@ -255,6 +325,24 @@ size_t std::hash<igl::ShaderModuleInfo>::operator()(igl::ShaderModuleInfo const&
   return hash;
 }
 
+size_t std::hash<igl::SpecializationConstant>::operator()(
+    igl::SpecializationConstant const& key) const {
+  size_t hash = std::hash<uint32_t>()(key.id);
+  igl::hashCombine(hash, std::hash<std::string>()(key.name));
+  igl::hashCombine(hash, std::hash<uint8_t>()(EnumToValue(key.type)));
+  igl::hashCombine(hash, std::hash<uint32_t>()(key.value));
+  return hash;
+}
+
+size_t std::hash<std::vector<igl::SpecializationConstant>>::operator()(
+    std::vector<igl::SpecializationConstant> const& key) const {
+  size_t hash = std::hash<size_t>()(key.size());
+  for (const auto& constant : key) {
+    igl::hashCombine(hash, std::hash<igl::SpecializationConstant>()(constant));
+  }
+  return hash;
+}
+
 size_t std::hash<igl::ShaderInput>::operator()(igl::ShaderInput const& key) const {
   static_assert(std::is_same_v<uint8_t, std::underlying_type<igl::ShaderInputType>::type>);
   size_t hash = safeCStrHash(key.source);
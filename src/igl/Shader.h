@@ -51,6 +51,44 @@ struct ShaderModuleInfo {
   bool operator!=(const ShaderModuleInfo& other) const;
 };
 
+/**
+ * @brief The type of a specialization constant. All types are 32 bits wide.
+ */
+enum class SpecializationConstantType : uint8_t {
+  Bool,
+  Int,
+  UInt,
+  Float,
+};
+
+/**
+ * @brief A shader constant whose value is provided when a pipeline is created rather than when
+ * the shader is compiled, so one shader can be turned into many optimized variants.
+ *
+ * Vulkan : `layout (constant_id = id) const int name = defaultValue;`
+ * Metal  : `constant int name [[function_constant(id)]];`
+ * OpenGL : `#define name value` is injected after the `#version` directive, so shaders should
+ *          provide defaults with `#ifndef name`.
+ */
+struct SpecializationConstant {
+  /** @brief The constant ID in SPIR-V and the function constant index in Metal. */
+  uint32_t id = 0;
+  /** @brief The name of the macro defined in OpenGL shaders. */
+  std::string name;
+  SpecializationConstantType type = SpecializationConstantType::Int;
+  /** @brief The bits of the value: 0 or 1 for Bool, a two's complement integer for Int and an
+   * IEEE 754 single precision number for Float. */
+  uint32_t value = 0;
+
+  static SpecializationConstant fromBool(uint32_t id, std::string name, bool value);
+  static SpecializationConstant fromInt(uint32_t id, std::string name, int32_t value);
+  static SpecializationConstant fromUInt(uint32_t id, std::string name, uint32_t value);
+  static SpecializationConstant fromFloat(uint32_t id, std::string name, float value);
+
+  bool operator==(const SpecializationConstant& other) const;
+  bool operator!=(const SpecializationConstant& other) const;
+};
+
 /**
  * @brief A enumeration of shader input types.
  */
@@ -265,6 +303,36 @@ struct ShaderStagesDesc {
   ShaderStagesType type = ShaderStagesType::Render;
 };
 
+/**
+ * @brief Describes shader stages by the descriptors of their shader modules, so the modules and the
+ * stages can be created together.
+ * @see igl::IDevice::createShaderStagesBatch
+ */
+struct ShaderStagesModulesDesc {
+  /**
+   * @brief Constructs a ShaderStagesModulesDesc for render shader stages.
+   * @param vertexModule The vertex shader module descriptor.
+   * @param fragmentModule The fragment shader module descriptor.
+   */
+  static ShaderStagesModulesDesc fromRenderModules(ShaderModuleDesc vertexModule,
+                                                   ShaderModuleDesc fragmentModule);
+
+  /**
+   * @brief Constructs a ShaderStagesModulesDesc for compute shader stages.
+   * @param computeModule The compute shader module descriptor.
+   */
+  static ShaderStagesModulesDesc fromComputeModule(ShaderModuleDesc computeModule);
+
+  /** @brief The vertex shader module to be used in a render pipeline state. */
+  ShaderModuleDesc vertexModule;
+  /** @brief The fragment shader module to be used in a render pipeline state. */
+  ShaderModuleDesc fragmentModule;
+  /** @brief The compute shader module to be used in a compute pipeline state. */
+  ShaderModuleDesc computeModule;
+  /** @brief The type of shader stages: render or compute. */
+  ShaderStagesType type = ShaderStagesType::Render;
+};
+
 /**
  * @brief A set of shader modules used to configure a render pipeline state.
  */
@@ -323,6 +391,16 @@ struct hash<igl::ShaderModuleInfo> {
   size_t operator()(igl::ShaderModuleInfo const& /*key*/) const;
 };
 
+template<>
+struct hash<igl::SpecializationConstant> {
+  size_t operator()(igl::SpecializationConstant const& /*key*/) const;
+};
+
+template<>
+struct hash<std::vector<igl::SpecializationConstant>> {
+  size_t operator()(std::vector<igl::SpecializationConstant> const& /*key*/) const;
+};
+
 template<>
 struct hash<igl::ShaderInput> {
   size_t operator()(igl::ShaderInput const& /*key*/) const;
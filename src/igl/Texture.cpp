@@ -295,6 +295,14 @@ bool TextureDesc::operator!=(const TextureDesc& rhs) const {
   return !operator==(rhs);
 }
 
+UploadHandle ITexture::uploadAsync(const TextureRangeDesc& range,
+                                   const void* IGL_NULLABLE data,
+                                   size_t bytesPerRow,
+                                   Result* IGL_NULLABLE outResult) const {
+  Result::setResult(outResult, upload(range, data, bytesPerRow));
+  return {};
+}
+
 float ITexture::getAspectRatio() const {
   const auto dimensions = getDimensions();
   return static_cast<float>(dimensions.width) / static_cast<float>(dimensions.height);
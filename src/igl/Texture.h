@@ -521,6 +521,19 @@ class ITexture : public ITrackedResource<ITexture> {
                             const void* IGL_NULLABLE data,
                             size_t bytesPerRow = 0) const = 0;
 
+  /**
+   * @brief Same as upload(), but never waits for the GPU to free up staging memory. Commands
+   * submitted after this call are ordered after the upload on the GPU, so no CPU wait is required
+   * before using the texture. The default implementation calls upload().
+   *
+   * @return A handle which backends with asynchronous uploads let the application poll or wait on,
+   * e.g. vulkan::PlatformDevice::isUploadComplete(). Empty if the upload has already completed
+   */
+  virtual UploadHandle uploadAsync(const TextureRangeDesc& range,
+                                   const void* IGL_NULLABLE data,
+                                   size_t bytesPerRow = 0,
+                                   Result* IGL_NULLABLE outResult = nullptr) const;
+
   // Texture Accessors Methods
   /**
    * @brief Returns the aspect ratio (width / height) of the texture.
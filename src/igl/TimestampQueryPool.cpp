@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/TimestampQueryPool.h>
+
+namespace igl {
+
+bool ITimestampQueryPool::getScopeTimings(std::vector<TimestampScopeTiming>& outTimings) const {
+  IGL_ASSERT_MSG(openScopes_.empty(), "Did you forget to call popDebugGroupLabel()?");
+
+  outTimings.clear();
+  outTimings.reserve(scopes_.size());
+
+  for (const Scope& scope : scopes_) {
+    if (!scope.isClosed) {
+      continue;
+    }
+    uint64_t timestamps[2] = {};
+    if (!getResults(scope.beginQuery, 2, timestamps)) {
+      outTimings.clear();
+      return false;
+    }
+    const uint64_t durationNs = timestamps[1] > timestamps[0] ? timestamps[1] - timestamps[0] : 0;
+    outTimings.push_back(TimestampScopeTiming{scope.label, scope.depth, durationNs});
+  }
+
+  return true;
+}
+
+void ITimestampQueryPool::resetScopes() {
+  scopes_.clear();
+  openScopes_.clear();
+  nextQuery_ = 0;
+}
+
+uint32_t ITimestampQueryPool::beginScope(const std::string& label) {
+  const auto depth = static_cast<uint32_t>(openScopes_.size());
+
+  if (nextQuery_ + 2 > getQueryCount()) {
+    openScopes_.push_back(kInvalidQuery);
+    return kInvalidQuery;
+  }
+
+  openScopes_.push_back(static_cast<uint32_t>(scopes_.size()));
+  scopes_.push_back(Scope{label, depth, nextQuery_, false});
+
+  nextQuery_ += 2;
+
+  return scopes_.back().beginQuery;
+}
+
+uint32_t ITimestampQueryPool::endScope() {
+  if (!IGL_VERIFY(!openScopes_.empty())) {
+    return kInvalidQuery;
+  }
+
+  const uint32_t index = openScopes_.back();
+  openScopes_.pop_back();
+
+  if (index == kInvalidQuery) {
+    return kInvalidQuery;
+  }
+
+  Scope& scope = scopes_[index];
+  scope.isClosed = true;
+
+  return scope.beginQuery + 1;
+}
+
+} // namespace igl
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <igl/Common.h>
+#include <string>
+#include <vector>
+
+namespace igl {
+
+/**
+ * @brief Describes a pool of GPU timestamp queries.
+ */
+struct TimestampQueryPoolDesc {
+  /** @brief The number of timestamps which can be written into the pool between two resets */
+  uint32_t queryCount = 0;
+  std::string debugName;
+};
+
+/**
+ * @brief The GPU time spent inside a debug group or an encoder, measured with a pair of timestamps.
+ */
+struct TimestampScopeTiming {
+  std::string label;
+  /** @brief Nesting depth of the scope; 0 for scopes which are not nested in other scopes */
+  uint32_t depth = 0;
+  uint64_t durationNs = 0;
+};
+
+/**
+ * @brief ITimestampQueryPool holds GPU timestamps written with ICommandBuffer::writeTimestamp().
+ *
+ * Results are retrieved without blocking: getResults() returns false until the GPU has written all
+ * the requested timestamps. Use one pool per frame in flight to read the timings of a previous
+ * frame while the current one is being recorded.
+ *
+ * When a pool is set in CommandBufferDesc::timestampQueryPool, the command buffer resets the pool
+ * and brackets every render and compute encoder, and every debug group pushed with
+ * pushDebugGroupLabel(), with a pair of timestamps. The resulting per-scope GPU timings are
+ * available via getScopeTimings() once the command buffer has completed execution. Such a pool
+ * should not be written into with ICommandBuffer::writeTimestamp().
+ */
+class ITimestampQueryPool {
+ public:
+  static constexpr uint32_t kInvalidQuery = 0xFFFFFFFF;
+
+  virtual ~ITimestampQueryPool() = default;
+
+  /**
+   * @brief Returns the number of queries in this pool.
+   */
+  [[nodiscard]] virtual uint32_t getQueryCount() const = 0;
+
+  /**
+   * @brief Copies timestamps, in nanoseconds, into outTimestampsNs without waiting for the GPU.
+   * Timestamps are only meaningful relative to other timestamps.
+   * @return false if any of the requested timestamps is not available yet.
+   */
+  [[nodiscard]] virtual bool getResults(uint32_t firstQuery,
+                                        uint32_t queryCount,
+                                        uint64_t* IGL_NONNULL outTimestampsNs) const = 0;
+
+  /**
+   * @brief Retrieves the GPU timings of all scopes recorded since the last reset, in the order the
+   * scopes were opened. Scopes which did not fit into the pool are skipped.
+   * @return false if the timings are not available yet.
+   */
+  [[nodiscard]] bool getScopeTimings(std::vector<TimestampScopeTiming>& outTimings) const;
+
+  /**
+   * @brief Forgets all recorded scopes. Called by the backends when the pool is reset.
+   */
+  void resetScopes();
+
+  /**
+   * @brief Opens a new scope. Called by the backends.
+   * @return the query for the timestamp at the beginning of the scope, or kInvalidQuery if the pool
+   * is full.
+   */
+  uint32_t beginScope(const std::string& label);
+
+  /**
+   * @brief Closes the innermost open scope. Called by the backends.
+   * @return the query for the timestamp at the end of the scope, or kInvalidQuery if the scope was
+   * not recorded.
+   */
+  uint32_t endScope();
+
+ private:
+  struct Scope {
+    std::string label;
+    uint32_t depth = 0;
+    // the ending timestamp is always written into beginQuery + 1
+    uint32_t beginQuery = kInvalidQuery;
+    bool isClosed = false;
+  };
+
+  std::vector<Scope> scopes_;
+  // indices into scopes_; kInvalidQuery for scopes which did not fit into the pool
+  std::vector<uint32_t> openScopes_;
+  uint32_t nextQuery_ = 0;
+};
+
+} // namespace igl
@@ -326,7 +326,15 @@ std::shared_ptr<igl::IComputePipelineState> Device::createComputePipeline(
 
   MTLComputePipelineDescriptor* descriptor = [[MTLComputePipelineDescriptor alloc] init];
   descriptor.computeFunction =
-      static_cast<ShaderModule*>(desc.shaderStages->getComputeModule().get())->get();
+      static_cast<ShaderModule*>(desc.shaderStages->getComputeModule().get())
+          ->getSpecializedFunction(desc.specializationConstants, &error);
+  if (!descriptor.computeFunction) {
+    Result::setResult(outResult,
+                      Result::Code::RuntimeError,
+                      error ? [error.localizedDescription UTF8String]
+                            : "Cannot specialize the compute function");
+    return nullptr;
+  }
   MTLComputePipelineReflection* reflection = nil;
   id<MTLComputePipelineState> metalObject =
       [device_ newComputePipelineStateWithDescriptor:descriptor
@@ -383,11 +391,14 @@ std::shared_ptr<igl::IRenderPipelineState> Device::createRenderPipeline(
   }
 
   auto vertexFunc = static_cast<ShaderModule*>(vertexModule.get());
-  metalDesc.vertexFunction = vertexFunc->get();
+  metalDesc.vertexFunction =
+      vertexFunc->getSpecializedFunction(desc.specializationConstants, &error);
 
-  if (!IGL_VERIFY(metalDesc.vertexFunction)) {
-    Result::setResult(
-        outResult, Result::Code::RuntimeError, "RenderPipeline requires non-null vertex function");
+  if (!metalDesc.vertexFunction) {
+    Result::setResult(outResult,
+                      Result::Code::RuntimeError,
+                      error ? [error.localizedDescription UTF8String]
+                            : "RenderPipeline requires non-null vertex function");
     return nullptr;
   }
 
@@ -395,7 +406,15 @@ std::shared_ptr<igl::IRenderPipelineState> Device::createRenderPipeline(
   auto fragmentModule = desc.shaderStages->getFragmentModule();
   if (fragmentModule) {
     auto fragmentFunc = static_cast<ShaderModule*>(fragmentModule.get());
-    metalDesc.fragmentFunction = fragmentFunc->get();
+    metalDesc.fragmentFunction =
+        fragmentFunc->getSpecializedFunction(desc.specializationConstants, &error);
+    if (!metalDesc.fragmentFunction) {
+      Result::setResult(outResult,
+                        Result::Code::RuntimeError,
+                        error ? [error.localizedDescription UTF8String]
+                              : "Cannot specialize the fragment function");
+      return nullptr;
+    }
   }
 
   // Framebuffer
@@ -498,7 +517,7 @@ std::unique_ptr<IShaderLibrary> Device::createShaderLibrary(const ShaderLibraryD
           outResult, Result::Code::RuntimeError, "Could not find function in library");
       return nullptr;
     }
-    modules.emplace_back(std::make_shared<metal::ShaderModule>(info, metalFunction));
+    modules.emplace_back(std::make_shared<metal::ShaderModule>(info, metalFunction, metalLibrary));
   }
 
   auto shaderLibrary = std::make_unique<ShaderLibrary>(std::move(modules));
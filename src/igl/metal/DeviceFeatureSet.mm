@@ -158,6 +158,23 @@ bool DeviceFeatureSet::hasFeature(DeviceFeatures feature) const {
     return false;
   case DeviceFeatures::TexturePartialMipChain:
     return true;
+  case DeviceFeatures::DrawInstanced:
+  case DeviceFeatures::VertexInstanceStepRate:
+    return true;
+  case DeviceFeatures::DrawBaseInstance:
+    /// Base vertex and base instance values are supported by MTLFeatureSet_iOS_GPUFamily3_v1 and
+    /// MTLFeatureSet_OSX_GPUFamily1_v1
+#if IGL_PLATFORM_IOS
+    return deviceFeatureDesc_.gpuFamily >= 3;
+#else
+    return deviceFeatureDesc_.gpuFamily >= 1;
+#endif
+  case DeviceFeatures::Timestamps:
+  case DeviceFeatures::OcclusionQueries:
+  case DeviceFeatures::PreciseOcclusionQueries:
+  case DeviceFeatures::PipelineStatisticsQueries:
+  case DeviceFeatures::ParallelRenderEncoding:
+    return false;
   case DeviceFeatures::BufferRing:
     return true;
   case DeviceFeatures::BufferNoCopy:
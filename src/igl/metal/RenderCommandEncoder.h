@@ -58,6 +58,19 @@ class RenderCommandEncoder final : public IRenderCommandEncoder {
                    IndexFormat indexFormat,
                    IBuffer& indexBuffer,
                    size_t indexBufferOffset) override;
+  void drawInstanced(PrimitiveType primitiveType,
+                     size_t vertexStart,
+                     size_t vertexCount,
+                     uint32_t instanceCount,
+                     uint32_t baseInstance = 0) override;
+  void drawIndexedInstanced(PrimitiveType primitiveType,
+                            size_t indexCount,
+                            IndexFormat indexFormat,
+                            IBuffer& indexBuffer,
+                            size_t indexBufferOffset,
+                            uint32_t instanceCount,
+                            int32_t baseVertex = 0,
+                            uint32_t baseInstance = 0) override;
   void drawIndexedIndirect(PrimitiveType primitiveType,
                            IndexFormat indexFormat,
                            IBuffer& indexBuffer,
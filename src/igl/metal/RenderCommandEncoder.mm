@@ -364,6 +364,61 @@ void RenderCommandEncoder::drawIndexed(PrimitiveType primitiveType,
                 indexBufferOffset:indexBufferOffset];
 }
 
+void RenderCommandEncoder::drawInstanced(PrimitiveType primitiveType,
+                                         size_t vertexStart,
+                                         size_t vertexCount,
+                                         uint32_t instanceCount,
+                                         uint32_t baseInstance) {
+  getCommandBuffer().incrementCurrentDrawCount();
+  IGL_ASSERT(encoder_);
+  MTLPrimitiveType metalPrimitive = convertPrimitiveType(primitiveType);
+  if (baseInstance == 0) {
+    [encoder_ drawPrimitives:metalPrimitive
+                 vertexStart:vertexStart
+                 vertexCount:vertexCount
+               instanceCount:instanceCount];
+  } else {
+    [encoder_ drawPrimitives:metalPrimitive
+                 vertexStart:vertexStart
+                 vertexCount:vertexCount
+               instanceCount:instanceCount
+                baseInstance:baseInstance];
+  }
+}
+
+void RenderCommandEncoder::drawIndexedInstanced(PrimitiveType primitiveType,
+                                                size_t indexCount,
+                                                IndexFormat indexFormat,
+                                                IBuffer& indexBuffer,
+                                                size_t indexBufferOffset,
+                                                uint32_t instanceCount,
+                                                int32_t baseVertex,
+                                                uint32_t baseInstance) {
+  getCommandBuffer().incrementCurrentDrawCount();
+  IGL_ASSERT(encoder_);
+  auto& buffer = (Buffer&)(indexBuffer);
+  MTLPrimitiveType metalPrimitive = convertPrimitiveType(primitiveType);
+  MTLIndexType indexType = convertIndexType(indexFormat);
+
+  if (baseVertex == 0 && baseInstance == 0) {
+    [encoder_ drawIndexedPrimitives:metalPrimitive
+                         indexCount:indexCount
+                          indexType:indexType
+                        indexBuffer:buffer.get()
+                  indexBufferOffset:indexBufferOffset
+                      instanceCount:instanceCount];
+  } else {
+    [encoder_ drawIndexedPrimitives:metalPrimitive
+                         indexCount:indexCount
+                          indexType:indexType
+                        indexBuffer:buffer.get()
+                  indexBufferOffset:indexBufferOffset
+                      instanceCount:instanceCount
+                         baseVertex:baseVertex
+                       baseInstance:baseInstance];
+  }
+}
+
 void RenderCommandEncoder::drawIndexedIndirect(PrimitiveType primitiveType,
                                                IndexFormat indexFormat,
                                                IBuffer& indexBuffer,
@@ -20,14 +20,21 @@ class ShaderModule final : public IShaderModule {
   friend class Device;
 
  public:
-  ShaderModule(ShaderModuleInfo info, id<MTLFunction> value);
+  ShaderModule(ShaderModuleInfo info, id<MTLFunction> value, id<MTLLibrary> library = nil);
   ~ShaderModule() override = default;
 
   IGL_INLINE id<MTLFunction> get() const {
     return value_;
   }
 
+  // Returns the function with the given function constant values, or the function itself if there
+  // are no constants. Returns nil on error.
+  id<MTLFunction> getSpecializedFunction(const std::vector<SpecializationConstant>& constants,
+                                         NSError** error) const;
+
   id<MTLFunction> value_;
+  // The library the function comes from, needed to create specialized functions
+  id<MTLLibrary> library_;
 };
 
 class ShaderLibrary final : public IShaderLibrary {
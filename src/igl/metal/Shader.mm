@@ -9,11 +9,55 @@
 
 #include <igl/metal/Shader.h>
 
+#include <cstring>
+
 namespace igl {
 namespace metal {
 
-metal::ShaderModule::ShaderModule(ShaderModuleInfo info, id<MTLFunction> value) :
-  IShaderModule(std::move(info)), value_(value) {}
+metal::ShaderModule::ShaderModule(ShaderModuleInfo info,
+                                  id<MTLFunction> value,
+                                  id<MTLLibrary> library) :
+  IShaderModule(std::move(info)), value_(value), library_(library) {}
+
+id<MTLFunction> metal::ShaderModule::getSpecializedFunction(
+    const std::vector<SpecializationConstant>& constants,
+    NSError** error) const {
+  if (constants.empty()) {
+    return value_;
+  }
+
+  if (!IGL_VERIFY(library_)) {
+    return nil;
+  }
+
+  MTLFunctionConstantValues* values = [MTLFunctionConstantValues new];
+
+  for (const auto& constant : constants) {
+    switch (constant.type) {
+    case SpecializationConstantType::Bool: {
+      const bool value = constant.value != 0;
+      [values setConstantValue:&value type:MTLDataTypeBool atIndex:constant.id];
+      break;
+    }
+    case SpecializationConstantType::Int: {
+      const int32_t value = static_cast<int32_t>(constant.value);
+      [values setConstantValue:&value type:MTLDataTypeInt atIndex:constant.id];
+      break;
+    }
+    case SpecializationConstantType::UInt:
+      [values setConstantValue:&constant.value type:MTLDataTypeUInt atIndex:constant.id];
+      break;
+    case SpecializationConstantType::Float: {
+      float value = 0.0f;
+      memcpy(&value, &constant.value, sizeof(value));
+      [values setConstantValue:&value type:MTLDataTypeFloat atIndex:constant.id];
+      break;
+    }
+    }
+  }
+
+  return [library_ newFunctionWithName:value_.name constantValues:values error:error];
+}
 
 metal::ShaderLibrary::ShaderLibrary(std::vector<std::shared_ptr<IShaderModule>> modules) :
   IShaderLibrary(std::move(modules)) {}
@@ -169,6 +169,16 @@ void ArrayBuffer::bindForTarget(GLenum target) {
   getContext().bindBuffer(target, iD_);
 }
 
+void ArrayBuffer::orphan() {
+  if (!isDynamic_) {
+    return;
+  }
+
+  getContext().bindBuffer(target_, iD_);
+  getContext().bufferData(target_, size_, nullptr, GL_DYNAMIC_DRAW);
+  getContext().bindBuffer(target_, 0);
+}
+
 void UniformBlockBuffer::setBlockBinding(GLuint pid, GLuint blockIndex, GLuint bindingPoint) {
   getContext().uniformBlockBinding(pid, blockIndex, bindingPoint);
 }
@@ -78,6 +78,10 @@ class ArrayBuffer : public Buffer {
 
   void bindForTarget(GLenum target);
 
+  // Replaces the storage of a dynamic buffer with new storage of the same size (buffer orphaning),
+  // so that uploads do not have to wait for pending draw calls which use the old contents
+  void orphan();
+
   Type getType() const noexcept override {
     return Type::Attribute;
   }
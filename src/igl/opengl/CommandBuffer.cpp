@@ -11,11 +11,17 @@
 #include <igl/opengl/Errors.h>
 #include <igl/opengl/IContext.h>
 #include <igl/opengl/RenderCommandEncoder.h>
+#include <igl/opengl/TimestampQueryPool.h>
 
 namespace igl {
 namespace opengl {
 
-CommandBuffer::CommandBuffer(std::shared_ptr<IContext> context) : context_(std::move(context)) {}
+CommandBuffer::CommandBuffer(std::shared_ptr<IContext> context, CommandBufferDesc desc) :
+  context_(std::move(context)), desc_(std::move(desc)) {
+  if (desc_.timestampQueryPool) {
+    resetTimestampQueries(*desc_.timestampQueryPool);
+  }
+}
 
 CommandBuffer::~CommandBuffer() = default;
 
@@ -27,7 +33,7 @@ std::unique_ptr<IRenderCommandEncoder> CommandBuffer::createRenderCommandEncoder
 }
 
 std::unique_ptr<IComputeCommandEncoder> CommandBuffer::createComputeCommandEncoder() {
-  return std::make_unique<ComputeCommandEncoder>(shared_from_this()->getContext());
+  return std::make_unique<ComputeCommandEncoder>(shared_from_this());
 }
 
 void CommandBuffer::present(std::shared_ptr<ITexture> surface) const {
@@ -46,12 +52,42 @@ void CommandBuffer::pushDebugGroupLabel(const std::string& label,
                                         const igl::Color& /*color*/) const {
   IGL_ASSERT(!label.empty());
   getContext().pushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, 0, label.length(), label.c_str());
+  beginTimestampScope(label);
 }
 
 void CommandBuffer::popDebugGroupLabel() const {
+  endTimestampScope();
   getContext().popDebugGroup();
 }
 
+void CommandBuffer::resetTimestampQueries(ITimestampQueryPool& pool) {
+  static_cast<TimestampQueryPool&>(pool).reset();
+}
+
+void CommandBuffer::writeTimestamp(ITimestampQueryPool& pool, uint32_t query) {
+  static_cast<TimestampQueryPool&>(pool).queryCounter(query);
+}
+
+void CommandBuffer::beginTimestampScope(const std::string& label) const {
+  if (desc_.timestampQueryPool) {
+    auto& pool = static_cast<TimestampQueryPool&>(*desc_.timestampQueryPool);
+    const uint32_t query = pool.beginScope(label);
+    if (query != ITimestampQueryPool::kInvalidQuery) {
+      pool.queryCounter(query);
+    }
+  }
+}
+
+void CommandBuffer::endTimestampScope() const {
+  if (desc_.timestampQueryPool) {
+    auto& pool = static_cast<TimestampQueryPool&>(*desc_.timestampQueryPool);
+    const uint32_t query = pool.endScope();
+    if (query != ITimestampQueryPool::kInvalidQuery) {
+      pool.queryCounter(query);
+    }
+  }
+}
+
 IContext& CommandBuffer::getContext() const {
   return *context_;
 }
@@ -20,7 +20,7 @@ class Texture;
 class CommandBuffer final : public ICommandBuffer,
                             public std::enable_shared_from_this<CommandBuffer> {
  public:
-  explicit CommandBuffer(std::shared_ptr<IContext> context);
+  CommandBuffer(std::shared_ptr<IContext> context, CommandBufferDesc desc);
   ~CommandBuffer() override;
 
   std::unique_ptr<IRenderCommandEncoder> createRenderCommandEncoder(
@@ -40,10 +40,20 @@ class CommandBuffer final : public ICommandBuffer,
 
   void popDebugGroupLabel() const override;
 
+  void resetTimestampQueries(ITimestampQueryPool& pool) override;
+
+  void writeTimestamp(ITimestampQueryPool& pool, uint32_t query) override;
+
   IContext& getContext() const;
 
+  // Used by the encoders to time their debug groups. No-ops unless a timestamp query pool was
+  // provided in CommandBufferDesc
+  void beginTimestampScope(const std::string& label) const;
+  void endTimestampScope() const;
+
  private:
   std::shared_ptr<IContext> context_;
+  CommandBufferDesc desc_;
 };
 
 } // namespace opengl
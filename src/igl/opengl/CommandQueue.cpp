@@ -13,6 +13,7 @@
 #include <igl/opengl/Errors.h>
 #include <igl/opengl/IContext.h>
 #include <igl/opengl/RenderPipelineState.h>
+#include <igl/opengl/TransientAllocator.h>
 
 namespace igl {
 namespace opengl {
@@ -21,7 +22,7 @@ void CommandQueue::setInitialContext(std::shared_ptr<IContext> context) {
   context_ = std::move(context);
 }
 
-std::shared_ptr<ICommandBuffer> CommandQueue::createCommandBuffer(const CommandBufferDesc& /*desc*/,
+std::shared_ptr<ICommandBuffer> CommandQueue::createCommandBuffer(const CommandBufferDesc& desc,
                                                                   Result* outResult) {
   //  IGL_ASSERT_MSG(
   //      activeCommandBuffers_ == 0,
@@ -31,7 +32,7 @@ std::shared_ptr<ICommandBuffer> CommandQueue::createCommandBuffer(const CommandB
     return nullptr;
   }
 
-  auto commandBuffer = std::make_shared<CommandBuffer>(context_);
+  auto commandBuffer = std::make_shared<CommandBuffer>(context_, desc);
   activeCommandBuffers_++;
   Result::setOk(outResult);
 
@@ -44,6 +45,11 @@ SubmitHandle CommandQueue::submit(const ICommandBuffer& commandBuffer, bool /* e
 
   activeCommandBuffers_--;
 
+  // the frame of transient allocations ends; their buffers can be reused without waiting
+  if (auto* transientAllocator = context_->getTransientAllocator()) {
+    transientAllocator->endFrame();
+  }
+
   return SubmitHandle{};
 }
 
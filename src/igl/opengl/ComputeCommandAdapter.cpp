@@ -21,6 +21,7 @@
 #include <igl/opengl/SamplerState.h>
 #include <igl/opengl/Shader.h>
 #include <igl/opengl/Texture.h>
+#include <igl/opengl/TransientAllocator.h>
 #include <igl/opengl/VertexArrayObject.h>
 #include <igl/opengl/VertexInputState.h>
 
@@ -98,6 +99,12 @@ void ComputeCommandAdapter::clearDependentResources(
 
 void ComputeCommandAdapter::willDispatch() {
   Result ret;
+
+  // the data of transient allocations is written by the CPU until a draw call or dispatch uses it
+  if (auto* transientAllocator = getContext().getTransientAllocator()) {
+    transientAllocator->flush();
+  }
+
   auto pipelineState = static_cast<ComputePipelineState*>(pipelineState_.get());
 
   IGL_ASSERT_MSG(pipelineState, "ComputePipelineState is nullptr");
@@ -10,6 +10,7 @@
 #include <algorithm>
 #include <array>
 #include <igl/opengl/Buffer.h>
+#include <igl/opengl/CommandBuffer.h>
 #include <igl/opengl/ComputeCommandAdapter.h>
 #include <igl/opengl/Device.h>
 #include <igl/opengl/Errors.h>
@@ -25,7 +26,8 @@ namespace opengl {
 ///----------------------------------------------------------------------------
 /// MARK: - ComputeCommandEncoder
 
-ComputeCommandEncoder::ComputeCommandEncoder(IContext& context) : WithContext(context) {
+ComputeCommandEncoder::ComputeCommandEncoder(const std::shared_ptr<CommandBuffer>& commandBuffer) :
+  WithContext(commandBuffer->getContext()), commandBuffer_(*commandBuffer) {
   auto& oglContext = getContext();
 
   auto& pool = oglContext.getComputeAdapterPool();
@@ -35,6 +37,8 @@ ComputeCommandEncoder::ComputeCommandEncoder(IContext& context) : WithContext(co
     adapter_ = std::move(pool[pool.size() - 1]);
     pool.pop_back();
   }
+
+  commandBuffer_.beginTimestampScope("ComputeCommandEncoder");
 }
 
 ComputeCommandEncoder::~ComputeCommandEncoder() = default;
@@ -43,6 +47,7 @@ void ComputeCommandEncoder::endEncoding() {
   if (IGL_VERIFY(adapter_)) {
     adapter_->endEncoding();
     getContext().getComputeAdapterPool().push_back(std::move(adapter_));
+    commandBuffer_.endTimestampScope();
   }
 }
 
@@ -64,6 +69,7 @@ void ComputeCommandEncoder::pushDebugGroupLabel(const std::string& label,
                                                 const igl::Color& /*color*/) const {
   IGL_ASSERT(!label.empty());
   getContext().pushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, 0, label.length(), label.c_str());
+  commandBuffer_.beginTimestampScope(label);
 }
 
 void ComputeCommandEncoder::insertDebugEventLabel(const std::string& label,
@@ -78,6 +84,7 @@ void ComputeCommandEncoder::insertDebugEventLabel(const std::string& label,
 }
 
 void ComputeCommandEncoder::popDebugGroupLabel() const {
+  commandBuffer_.endTimestampScope();
   getContext().popDebugGroup();
 }
 
@@ -23,11 +23,12 @@ namespace opengl {
 class ArrayBuffer;
 class Buffer;
 class UniformBuffer;
+class CommandBuffer;
 class ComputeCommandAdapter;
 
 class ComputeCommandEncoder final : public IComputeCommandEncoder, public WithContext {
  public:
-  explicit ComputeCommandEncoder(IContext& context);
+  explicit ComputeCommandEncoder(const std::shared_ptr<CommandBuffer>& commandBuffer);
   ~ComputeCommandEncoder() override;
   void bindComputePipelineState(
       const std::shared_ptr<IComputePipelineState>& pipelineState) override;
@@ -48,6 +49,7 @@ class ComputeCommandEncoder final : public IComputeCommandEncoder, public WithCo
   void bindPushConstants(size_t offset, const void* data, size_t length) override;
 
  private:
+  const CommandBuffer& commandBuffer_;
   std::unique_ptr<ComputeCommandAdapter> adapter_;
 };
 
@@ -30,6 +30,12 @@ Result ComputePipelineState::create(const ComputePipelineDesc& desc) {
     return result;
   }
   shaderStages_ = std::static_pointer_cast<ShaderStages>(desc.shaderStages);
+  if (!desc.specializationConstants.empty()) {
+    shaderStages_ = shaderStages_->getSpecialization(desc.specializationConstants, &result);
+    if (!result.isOk()) {
+      return result;
+    }
+  }
   reflection_ = std::make_shared<ComputePipelineReflection>(getContext(), *shaderStages_);
 
   for (const auto& unitSampler : desc.imagesMap) {
@@ -23,6 +23,8 @@
 #include <igl/opengl/Shader.h>
 #include <igl/opengl/TextureBuffer.h>
 #include <igl/opengl/TextureTarget.h>
+#include <igl/opengl/TimestampQueryPool.h>
+#include <igl/opengl/TransientAllocator.h>
 #include <igl/opengl/UniformBuffer.h>
 #include <igl/opengl/VertexInputState.h>
 
@@ -30,6 +32,9 @@ namespace igl {
 namespace opengl {
 
 namespace {
+// size of the buffers which back Device::allocateTransient()
+constexpr size_t kTransientBufferSize = 1024 * 1024;
+
 std::unique_ptr<Buffer> allocateBuffer(BufferDesc::BufferType bufferType,
                                        BufferDesc::BufferAPIHint requestedApiHints,
                                        IContext& context) {
@@ -93,7 +98,12 @@ std::unique_ptr<T> createUniqueResource(const Desc& desc,
 
 Device::Device(std::unique_ptr<IContext> context) :
   context_(std::move(context)), deviceFeatureSet_(getContext().deviceFeatures()) {}
-Device::~Device() = default;
+Device::~Device() {
+  if (transientAllocator_) {
+    context_->setTransientAllocator(nullptr);
+    transientAllocator_.reset();
+  }
+}
 
 // debug markers useful in GPU captures
 void Device::pushMarker(int len, const char* name) {
@@ -243,12 +253,117 @@ std::unique_ptr<IShaderStages> Device::createShaderStages(const ShaderStagesDesc
   return stages;
 }
 
+std::vector<std::unique_ptr<IShaderStages>> Device::createShaderStagesBatch(
+    const std::vector<ShaderStagesModulesDesc>& descs,
+    std::vector<Result>* outResults) const {
+  std::vector<Result> results(descs.size());
+  std::vector<ShaderStagesDesc> stagesDescs(descs.size());
+
+  struct PendingModule {
+    std::shared_ptr<ShaderModule> module;
+    const ShaderModuleDesc* desc = nullptr;
+    size_t stagesIndex = 0;
+  };
+  std::vector<PendingModule> pendingModules;
+  pendingModules.reserve(2 * descs.size());
+
+  auto compileModule = [&](const ShaderModuleDesc& desc, size_t i) {
+    auto module = std::make_shared<ShaderModule>(getContext(), desc.info);
+    if (auto resourceTracker = getResourceTracker(); resourceTracker) {
+      module->initResourceTracker(resourceTracker);
+    }
+    Result result = module->compile(desc);
+    if (result.isOk()) {
+      pendingModules.push_back({module, &desc, i});
+    } else {
+      results[i] = std::move(result);
+    }
+    return module;
+  };
+
+  // 1. submit all the shaders without waiting for any of them
+  for (size_t i = 0; i != descs.size(); i++) {
+    stagesDescs[i].type = descs[i].type;
+    if (descs[i].type == ShaderStagesType::Render) {
+      stagesDescs[i].vertexModule = compileModule(descs[i].vertexModule, i);
+      stagesDescs[i].fragmentModule = compileModule(descs[i].fragmentModule, i);
+    } else {
+      stagesDescs[i].computeModule = compileModule(descs[i].computeModule, i);
+    }
+  }
+
+  // 2. only now wait for the compilation results
+  for (const auto& pending : pendingModules) {
+    Result result = pending.module->finishCompilation(*pending.desc);
+    if (!result.isOk() && results[pending.stagesIndex].isOk()) {
+      results[pending.stagesIndex] = std::move(result);
+    }
+  }
+
+  // 3. submit all the programs whose shaders were compiled successfully
+  std::vector<std::unique_ptr<ShaderStages>> programs(descs.size());
+  for (size_t i = 0; i != descs.size(); i++) {
+    if (results[i].isOk()) {
+      programs[i] = std::make_unique<ShaderStages>(stagesDescs[i], getContext());
+      results[i] = programs[i]->link();
+    }
+  }
+
+  // 4. wait for the link results
+  std::vector<std::unique_ptr<IShaderStages>> stages(descs.size());
+  for (size_t i = 0; i != descs.size(); i++) {
+    if (!programs[i] || !results[i].isOk()) {
+      continue;
+    }
+    results[i] = programs[i]->finishLinking();
+    if (results[i].isOk()) {
+      if (auto resourceTracker = getResourceTracker(); resourceTracker) {
+        programs[i]->initResourceTracker(resourceTracker);
+      }
+      stages[i] = std::move(programs[i]);
+    }
+  }
+
+  if (outResults) {
+    *outResults = std::move(results);
+  }
+
+  return stages;
+}
+
 std::shared_ptr<IFramebuffer> Device::createFramebuffer(const FramebufferDesc& desc,
                                                         Result* outResult) {
   IGL_ASSERT(deviceFeatureSet_.hasInternalFeature(InternalFeatures::FramebufferObject));
   return getPlatformDevice().createFramebuffer(desc, outResult);
 }
 
+std::shared_ptr<ITimestampQueryPool> Device::createTimestampQueryPool(
+    const TimestampQueryPoolDesc& desc,
+    Result* outResult) const {
+  if (!deviceFeatureSet_.hasFeature(DeviceFeatures::Timestamps)) {
+    Result::setResult(outResult, Result::Code::Unsupported, "Timer queries are not supported");
+    return nullptr;
+  }
+  if (desc.queryCount == 0) {
+    Result::setResult(outResult, Result::Code::ArgumentInvalid, "queryCount must be non-zero");
+    return nullptr;
+  }
+
+  Result::setOk(outResult);
+  return std::make_shared<TimestampQueryPool>(getContext(), desc.queryCount);
+}
+
+TransientAllocation Device::allocateTransient(BufferDesc::BufferType type,
+                                              size_t size,
+                                              Result* outResult) {
+  if (!transientAllocator_) {
+    transientAllocator_ = std::make_unique<TransientAllocator>(getContext(), kTransientBufferSize);
+    getContext().setTransientAllocator(transientAllocator_.get());
+  }
+
+  return transientAllocator_->allocate(type, size, outResult);
+}
+
 bool Device::hasFeature(DeviceFeatures capability) const {
   return deviceFeatureSet_.hasFeature(capability);
 }
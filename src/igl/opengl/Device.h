@@ -20,6 +20,7 @@ namespace igl {
 namespace opengl {
 class CommandQueue;
 class Texture;
+class TransientAllocator;
 
 class Device : public IDevice {
   friend class HWDevice;
@@ -67,9 +68,26 @@ class Device : public IDevice {
   std::unique_ptr<IShaderStages> createShaderStages(const ShaderStagesDesc& desc,
                                                     Result* outResult) const override;
 
+  // Submits all the shaders and programs to the driver before querying the status of any of them,
+  // so drivers with GL_KHR_parallel_shader_compile (or threaded compilers) process them
+  // concurrently
+  std::vector<std::unique_ptr<IShaderStages>> createShaderStagesBatch(
+      const std::vector<ShaderStagesModulesDesc>& descs,
+      std::vector<Result>* outResults) const override;
+
   std::shared_ptr<IFramebuffer> createFramebuffer(const FramebufferDesc& desc,
                                                   Result* outResult) override;
 
+  std::shared_ptr<ITimestampQueryPool> createTimestampQueryPool(
+      const TimestampQueryPoolDesc& desc,
+      Result* outResult) const override;
+
+  // Bump-allocates from CPU copies of orphaned GL buffers which are uploaded before the next draw
+  // call or dispatch. Frames end with ICommandQueue::submit()
+  TransientAllocation allocateTransient(BufferDesc::BufferType type,
+                                        size_t size,
+                                        Result* outResult) override;
+
   // debug markers useful in GPU captures
   void pushMarker(int len, const char* name);
   void popMarker();
@@ -111,6 +129,8 @@ class Device : public IDevice {
   std::shared_ptr<CommandQueue> commandQueue_;
   const DeviceFeatureSet& deviceFeatureSet_;
   UnbindPolicy cachedUnbindPolicy_;
+  // created on demand
+  std::unique_ptr<TransientAllocator> transientAllocator_;
 };
 
 } // namespace opengl
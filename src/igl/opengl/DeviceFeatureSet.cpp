@@ -130,6 +130,8 @@ bool DeviceFeatureSet::isExtensionSupported(Extensions extension) const {
   switch (extension) {
   case Extensions::AppleRgb422:
     return hasDesktopOrESExtension(*this, "GL_APPLE_rgb_422");
+  case Extensions::BaseInstance:
+    return hasESExtension(*this, "GL_EXT_base_instance");
   case Extensions::BindlessTextureArb:
     return hasDesktopExtension(*this, "GL_ARB_bindless_texture");
   case Extensions::BindlessTextureNv:
@@ -146,6 +148,8 @@ bool DeviceFeatureSet::isExtensionSupported(Extensions extension) const {
     return hasESExtension(*this, "GL_OES_depth_texture");
   case Extensions::DiscardFramebuffer:
     return hasESExtension(*this, "GL_EXT_discard_framebuffer");
+  case Extensions::DisjointTimerQuery:
+    return hasESExtension(*this, "GL_EXT_disjoint_timer_query");
   case Extensions::DrawBuffers:
     return hasESExtension(*this, "GL_EXT_draw_buffers");
   case Extensions::Es2Compatibility:
@@ -166,6 +170,8 @@ bool DeviceFeatureSet::isExtensionSupported(Extensions extension) const {
     return hasESExtension(*this, "GL_EXT_multisampled_render_to_texture");
   case Extensions::MultiSampleImg:
     return hasESExtension(*this, "GL_IMG_multisampled_render_to_texture");
+  case Extensions::ParallelShaderCompile:
+    return hasDesktopOrESExtension(*this, "GL_KHR_parallel_shader_compile");
   case Extensions::RequiredInternalFormat:
     return hasESExtension(*this, "GL_OES_required_internalformat");
   case Extensions::ShaderImageLoadStore:
@@ -332,6 +338,26 @@ bool DeviceFeatureSet::isFeatureSupported(DeviceFeatures feature) const {
     return hasDesktopOrESVersion(*this, GLVersion::v2_0, GLVersion::v3_0_ES) ||
            hasESExtension(*this, "GL_APPLE_texture_max_level");
 
+  case DeviceFeatures::Timestamps:
+    return hasInternalFeature(InternalFeatures::TimerQuery);
+
+  case DeviceFeatures::OcclusionQueries:
+  case DeviceFeatures::PreciseOcclusionQueries:
+  case DeviceFeatures::PipelineStatisticsQueries:
+    return false;
+
+  case DeviceFeatures::ParallelRenderEncoding:
+    // OpenGL contexts can only be used by one thread at a time
+    return false;
+
+  case DeviceFeatures::DrawInstanced:
+  case DeviceFeatures::VertexInstanceStepRate:
+    return hasDesktopOrESVersion(*this, GLVersion::v3_3, GLVersion::v3_0_ES);
+
+  case DeviceFeatures::DrawBaseInstance:
+    return hasDesktopVersionOrExtension(*this, GLVersion::v4_2, "GL_ARB_base_instance") ||
+           hasExtension(Extensions::BaseInstance);
+
   case DeviceFeatures::BindUniform:
     return true;
   case DeviceFeatures::BufferRing:
@@ -405,6 +431,10 @@ bool DeviceFeatureSet::isInternalFeatureSupported(InternalFeatures feature) cons
   case InternalFeatures::PolygonFillMode:
     return hasDesktopVersion(*this, GLVersion::v2_0);
 
+  case InternalFeatures::ProgramBinary:
+    return hasDesktopOrESVersionOrExtension(
+        *this, GLVersion::v4_1, GLVersion::v3_0_ES, "GL_ARB_get_program_binary");
+
   case InternalFeatures::ProgramInterfaceQuery:
     return hasDesktopOrESVersion(*this, GLVersion::v4_3, GLVersion::v3_1_ES) ||
            hasDesktopExtension(*this, "GL_ARB_program_interface_query");
@@ -426,6 +456,10 @@ bool DeviceFeatureSet::isInternalFeatureSupported(InternalFeatures feature) cons
            hasDesktopExtension(*this, "GL_ARB_shader_image_load_store") ||
            hasExtension(Extensions::ShaderImageLoadStore);
 
+  case InternalFeatures::TimerQuery:
+    return hasDesktopVersionOrExtension(*this, GLVersion::v3_3, "GL_ARB_timer_query") ||
+           hasExtension(Extensions::DisjointTimerQuery);
+
   case InternalFeatures::TextureCompare:
     return hasDesktopOrESVersion(*this, GLVersion::v2_0, GLVersion::v3_0_ES) ||
            hasESExtension(*this, "GL_EXT_shadow_samplers");
@@ -903,6 +937,14 @@ bool DeviceFeatureSet::hasInternalRequirement(InternalRequirement requirement) c
   case InternalRequirement::SyncExtReq:
     return usesOpenGLES() && !hasESVersion(*this, GLVersion::v3_0_ES);
 
+  case InternalRequirement::BaseInstanceExtReq:
+    // OpenGL ES only supports base instances via GL_EXT_base_instance
+    return usesOpenGLES();
+
+  case InternalRequirement::TimerQueryExtReq:
+    // OpenGL ES only supports timer queries via GL_EXT_disjoint_timer_query
+    return usesOpenGLES();
+
   case InternalRequirement::SwizzleAlphaTexturesReq:
 
     return hasDesktopVersion(*this, GLVersion::v3_0);
@@ -21,6 +21,7 @@ class IContext;
 // clang-format off
 enum class Extensions {
   AppleRgb422,                // GL_APPLE_rgb_422 is supported
+  BaseInstance,               // GL_EXT_base_instance is supported
   BindlessTextureArb,         // GL_ARB_bindless_texture is supported
   BindlessTextureNv,          // GL_NV_bindless_texture is supported
   Debug,                      // GL_KHR_debug is supported
@@ -29,6 +30,7 @@ enum class Extensions {
   Depth32,                    // GL_OES_depth32 is supported
   DepthTexture,               // GL_OES_depth_texture is supported
   DiscardFramebuffer,         // GL_EXT_discard_framebuffer is supported
+  DisjointTimerQuery,         // GL_EXT_disjoint_timer_query is supported
   Es2Compatibility,           // GL_ARB_ES2_compatibility is supported
   DrawBuffers,                // GL_EXT_draw_buffers is supported
   FramebufferBlit,            // GL_EXT_framebuffer_blit is supported
@@ -39,6 +41,7 @@ enum class Extensions {
   MultiSampleApple,           // GL_APPLE_framebuffer_multisample is supported
   MultiSampleExt,             // GL_EXT_multisampled_render_to_texture is supported
   MultiSampleImg,             // GL_IMG_multisampled_render_to_texture is supported
+  ParallelShaderCompile,      // GL_KHR_parallel_shader_compile is supported
   RequiredInternalFormat,     // GL_OES_required_internalformat is supported
   ShaderImageLoadStore,       // GL_EXT_shader_image_load_store is supported
   Srgb,                       // GL_EXT_sRGB is supported
@@ -69,12 +72,14 @@ enum class InternalFeatures {
   MapBuffer,                 // glMapBuffer is supported
   PixelBufferObject,         // PBOs are available
   PolygonFillMode,           // glPolygonFillMode is supported
+  ProgramBinary,             // glGetProgramBinary and glProgramBinary are supported
   ProgramInterfaceQuery,     // Querying info about shader program interfaces is supported
   SeamlessCubeMap,           // GL_TEXTURE_CUBE_MAP_SEAMLESS is supported
   ShaderImageLoadStore,      // Shader image load/store is supported
   Sync,                      // Sync objects are supported
   TexStorage,                // glTexStorage* is available
   TextureCompare,            // GL_TEXTURE_COMPARE_MODE and GL_TEXTURE_COMPARE_FUNC are supported
+  TimerQuery,                // Timer queries are supported
   UnmapBuffer,               // glUnmapBuffer is supported
   VertexArrayObject,         // VAOS are available
 };
@@ -146,6 +151,7 @@ enum class TextureFeatures {
 // clang-format on
 
 enum class InternalRequirement {
+  BaseInstanceExtReq,
   ColorTexImageRgb10A2Unsized,
   ColorTexImageRgb5A1Unsized,
   ColorTexImageRgba4Unsized,
@@ -165,6 +171,7 @@ enum class InternalRequirement {
   TexStorageExtReq,
   Texture3DExtReq,
   TextureHalfFloatExtReq,
+  TimerQueryExtReq,
   UnmapBufferExtReq,
   VertexArrayObjectExtReq,
 };
@@ -71,6 +71,50 @@ Result checkFramebufferStatus(IContext& context) {
   return Result(code, message);
 }
 
+/// An asynchronous readback into a pixel pack buffer owned by the request
+class PixelBufferReadbackRequest final : public IReadbackRequest {
+ public:
+  PixelBufferReadbackRequest(IContext& context,
+                             GLuint pboId,
+                             GLsync sync,
+                             size_t bytesPerRow,
+                             size_t numRows) :
+    context_(context), pboId_(pboId), sync_(sync), bytesPerRow_(bytesPerRow), numRows_(numRows) {}
+
+  ~PixelBufferReadbackRequest() override {
+    if (sync_) {
+      context_.deleteSync(sync_);
+    }
+    context_.deleteBuffers(1, &pboId_);
+  }
+
+  [[nodiscard]] bool isReady() const override {
+    GLint status = 0;
+    GLsizei length = 0;
+    context_.getSynciv(sync_, GL_SYNC_STATUS, 1, &length, &status);
+    return status == GL_SIGNALED;
+  }
+
+  void getBytes(void* pixelBytes, size_t bytesPerRow) override {
+    // mapping the buffer waits for the GPU to finish writing into it
+    context_.bindBuffer(GL_PIXEL_PACK_BUFFER, pboId_);
+    const void* bytes = context_.mapBufferRange(
+        GL_PIXEL_PACK_BUFFER, 0, static_cast<GLsizeiptr>(bytesPerRow_ * numRows_), GL_MAP_READ_BIT);
+    if (IGL_VERIFY(bytes)) {
+      copyRows(pixelBytes, bytesPerRow, bytes, bytesPerRow_, numRows_);
+    }
+    context_.unmapBuffer(GL_PIXEL_PACK_BUFFER);
+    context_.bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+  }
+
+ private:
+  IContext& context_;
+  GLuint pboId_ = 0;
+  GLsync sync_ = nullptr;
+  size_t bytesPerRow_ = 0;
+  size_t numRows_ = 0;
+};
+
 } // namespace
 
 FramebufferBindingGuard::FramebufferBindingGuard(IContext& context) :
@@ -199,6 +243,45 @@ void Framebuffer::copyBytesColorAttachment(ICommandQueue& /* unused */,
   }
 }
 
+std::shared_ptr<IReadbackRequest> Framebuffer::requestBytesColorAttachment(
+    ICommandQueue& cmdQueue,
+    size_t index,
+    const TextureRangeDesc& range) const {
+  const auto& deviceFeatures = getContext().deviceFeatures();
+  const bool asyncReadbackSupported =
+      deviceFeatures.hasInternalFeature(InternalFeatures::PixelBufferObject) &&
+      deviceFeatures.hasInternalFeature(InternalFeatures::Sync) &&
+      deviceFeatures.hasFeature(DeviceFeatures::MapBufferRange);
+
+  auto itexture = getColorAttachment(index);
+  if (!asyncReadbackSupported || index != 0 || itexture == nullptr) {
+    return IFramebuffer::requestBytesColorAttachment(cmdQueue, index, range);
+  }
+
+  const auto& properties = itexture->getProperties();
+  const size_t bytesPerRow = properties.getBytesPerRow(range);
+  const size_t numRows = properties.getRows(range);
+
+  // every request owns its pixel pack buffer, so any number of requests can be in flight
+  GLuint pboId = 0;
+  getContext().genBuffers(1, &pboId);
+  getContext().bindBuffer(GL_PIXEL_PACK_BUFFER, pboId);
+  getContext().bufferData(GL_PIXEL_PACK_BUFFER,
+                          static_cast<GLsizeiptr>(bytesPerRow * numRows),
+                          nullptr,
+                          GL_STREAM_READ);
+
+  // With a pixel pack buffer bound, glReadPixels() treats the pointer as an offset into the buffer
+  // and returns without waiting for the GPU
+  copyBytesColorAttachment(cmdQueue, index, nullptr, range, bytesPerRow);
+  getContext().bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+  GLsync sync = getContext().fenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+  return std::make_shared<PixelBufferReadbackRequest>(
+      getContext(), pboId, sync, bytesPerRow, numRows);
+}
+
 void Framebuffer::copyBytesDepthAttachment(ICommandQueue& /* unused */,
                                            void* /*pixelBytes*/,
                                            const TextureRangeDesc& /*range*/,
@@ -383,6 +383,51 @@ void iglGetSyncivAPPLE(GLsync sync, GLenum pname, GLsizei bufSize, GLsizei* leng
                           values);
 }
 
+///--------------------------------------
+/// MARK: - GL_ARB_base_instance
+
+#if defined(GL_VERSION_4_2) || defined(GL_ARB_base_instance)
+#define CAN_CALL_glDrawArraysInstancedBaseInstance CAN_CALL_OPENGL
+#define CAN_CALL_glDrawElementsInstancedBaseVertexBaseInstance CAN_CALL_OPENGL
+#else
+#define CAN_CALL_glDrawArraysInstancedBaseInstance 0
+#define CAN_CALL_glDrawElementsInstancedBaseVertexBaseInstance 0
+#endif
+
+void iglDrawArraysInstancedBaseInstance(GLenum mode,
+                                        GLint first,
+                                        GLsizei count,
+                                        GLsizei instancecount,
+                                        GLuint baseinstance) {
+  GLEXTENSION_METHOD_BODY(CAN_CALL_glDrawArraysInstancedBaseInstance,
+                          glDrawArraysInstancedBaseInstance,
+                          PFNIGLDRAWARRAYSINSTANCEDBASEINSTANCEPROC,
+                          mode,
+                          first,
+                          count,
+                          instancecount,
+                          baseinstance);
+}
+
+void iglDrawElementsInstancedBaseVertexBaseInstance(GLenum mode,
+                                                    GLsizei count,
+                                                    GLenum type,
+                                                    const GLvoid* indices,
+                                                    GLsizei instancecount,
+                                                    GLint basevertex,
+                                                    GLuint baseinstance) {
+  GLEXTENSION_METHOD_BODY(CAN_CALL_glDrawElementsInstancedBaseVertexBaseInstance,
+                          glDrawElementsInstancedBaseVertexBaseInstance,
+                          PFNIGLDRAWELEMENTSINSTANCEDBASEVERTEXBASEINSTANCEPROC,
+                          mode,
+                          count,
+                          type,
+                          indices,
+                          instancecount,
+                          basevertex,
+                          baseinstance);
+}
+
 ///--------------------------------------
 /// MARK: - GL_ARB_bindless_texture
 
@@ -454,6 +499,42 @@ void iglDrawElementsIndirect(GLenum mode, GLenum type, const GLvoid* indirect) {
                           indirect);
 }
 
+///--------------------------------------
+/// MARK: - GL_ARB_draw_instanced
+
+#if defined(GL_VERSION_3_1) || defined(GL_ES_VERSION_3_0) || defined(GL_ARB_draw_instanced)
+#define CAN_CALL_glDrawArraysInstanced CAN_CALL
+#define CAN_CALL_glDrawElementsInstanced CAN_CALL
+#else
+#define CAN_CALL_glDrawArraysInstanced 0
+#define CAN_CALL_glDrawElementsInstanced 0
+#endif
+
+void iglDrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instancecount) {
+  GLEXTENSION_METHOD_BODY(CAN_CALL_glDrawArraysInstanced,
+                          glDrawArraysInstanced,
+                          PFNIGLDRAWARRAYSINSTANCEDPROC,
+                          mode,
+                          first,
+                          count,
+                          instancecount);
+}
+
+void iglDrawElementsInstanced(GLenum mode,
+                              GLsizei count,
+                              GLenum type,
+                              const GLvoid* indices,
+                              GLsizei instancecount) {
+  GLEXTENSION_METHOD_BODY(CAN_CALL_glDrawElementsInstanced,
+                          glDrawElementsInstanced,
+                          PFNIGLDRAWELEMENTSINSTANCEDPROC,
+                          mode,
+                          count,
+                          type,
+                          indices,
+                          instancecount);
+}
+
 ///--------------------------------------
 /// MARK: - GL_ARB_ES2_compatibility
 
@@ -701,6 +782,70 @@ void iglRenderbufferStorageMultisample(GLenum target,
                           height)
 }
 
+///--------------------------------------
+/// MARK: - GL_ARB_get_program_binary
+
+#if defined(GL_VERSION_4_1) || defined(GL_ES_VERSION_3_0) || defined(GL_ARB_get_program_binary)
+#define CAN_CALL_glGetProgramBinary CAN_CALL
+#define CAN_CALL_glProgramBinary CAN_CALL
+#define CAN_CALL_glProgramParameteri CAN_CALL
+#else
+#define CAN_CALL_glGetProgramBinary 0
+#define CAN_CALL_glProgramBinary 0
+#define CAN_CALL_glProgramParameteri 0
+#endif
+
+void iglGetProgramBinary(GLuint program,
+                         GLsizei bufSize,
+                         GLsizei* length,
+                         GLenum* binaryFormat,
+                         void* binary) {
+  GLEXTENSION_METHOD_BODY(CAN_CALL_glGetProgramBinary,
+                          glGetProgramBinary,
+                          PFNIGLGETPROGRAMBINARYPROC,
+                          program,
+                          bufSize,
+                          length,
+                          binaryFormat,
+                          binary);
+}
+
+void iglProgramBinary(GLuint program, GLenum binaryFormat, const void* binary, GLsizei length) {
+  GLEXTENSION_METHOD_BODY(CAN_CALL_glProgramBinary,
+                          glProgramBinary,
+                          PFNIGLPROGRAMBINARYPROC,
+                          program,
+                          binaryFormat,
+                          binary,
+                          length);
+}
+
+void iglProgramParameteri(GLuint program, GLenum pname, GLint value) {
+  GLEXTENSION_METHOD_BODY(CAN_CALL_glProgramParameteri,
+                          glProgramParameteri,
+                          PFNIGLPROGRAMPARAMETERIPROC,
+                          program,
+                          pname,
+                          value);
+}
+
+///--------------------------------------
+/// MARK: - GL_ARB_instanced_arrays
+
+#if defined(GL_VERSION_3_3) || defined(GL_ES_VERSION_3_0) || defined(GL_ARB_instanced_arrays)
+#define CAN_CALL_glVertexAttribDivisor CAN_CALL
+#else
+#define CAN_CALL_glVertexAttribDivisor 0
+#endif
+
+void iglVertexAttribDivisor(GLuint index, GLuint divisor) {
+  GLEXTENSION_METHOD_BODY(CAN_CALL_glVertexAttribDivisor,
+                          glVertexAttribDivisor,
+                          PFNIGLVERTEXATTRIBDIVISORPROC,
+                          index,
+                          divisor);
+}
+
 ///--------------------------------------
 /// MARK: - GL_ARB_invalidate_subdata
 
@@ -936,6 +1081,55 @@ void iglTexStorage3D(GLenum target,
                           depth);
 }
 
+///--------------------------------------
+/// MARK: - GL_ARB_timer_query
+
+#if defined(GL_VERSION_3_3) || defined(GL_ARB_timer_query)
+#define CAN_CALL_glDeleteQueries CAN_CALL_OPENGL
+#define CAN_CALL_glGenQueries CAN_CALL_OPENGL
+#define CAN_CALL_glGetQueryObjectiv CAN_CALL_OPENGL
+#define CAN_CALL_glGetQueryObjectui64v CAN_CALL_OPENGL
+#define CAN_CALL_glQueryCounter CAN_CALL_OPENGL
+#else
+#define CAN_CALL_glDeleteQueries 0
+#define CAN_CALL_glGenQueries 0
+#define CAN_CALL_glGetQueryObjectiv 0
+#define CAN_CALL_glGetQueryObjectui64v 0
+#define CAN_CALL_glQueryCounter 0
+#endif
+
+void iglDeleteQueries(GLsizei n, const GLuint* ids) {
+  GLEXTENSION_METHOD_BODY(
+      CAN_CALL_glDeleteQueries, glDeleteQueries, PFNIGLDELETEQUERIESPROC, n, ids);
+}
+
+void iglGenQueries(GLsizei n, GLuint* ids) {
+  GLEXTENSION_METHOD_BODY(CAN_CALL_glGenQueries, glGenQueries, PFNIGLGENQUERIESPROC, n, ids);
+}
+
+void iglGetQueryObjectiv(GLuint id, GLenum pname, GLint* params) {
+  GLEXTENSION_METHOD_BODY(CAN_CALL_glGetQueryObjectiv,
+                          glGetQueryObjectiv,
+                          PFNIGLGETQUERYOBJECTIVPROC,
+                          id,
+                          pname,
+                          params);
+}
+
+void iglGetQueryObjectui64v(GLuint id, GLenum pname, GLuint64* params) {
+  GLEXTENSION_METHOD_BODY(CAN_CALL_glGetQueryObjectui64v,
+                          glGetQueryObjectui64v,
+                          PFNIGLGETQUERYOBJECTUI64VPROC,
+                          id,
+                          pname,
+                          params);
+}
+
+void iglQueryCounter(GLuint id, GLenum target) {
+  GLEXTENSION_METHOD_BODY(
+      CAN_CALL_glQueryCounter, glQueryCounter, PFNIGLQUERYCOUNTERPROC, id, target);
+}
+
 ///--------------------------------------
 /// MARK: - GL_ARB_uniform_buffer_object
 
@@ -1066,6 +1260,51 @@ void iglGenVertexArrays(GLsizei n, GLuint* vertexArrays) {
       CAN_CALL_glGenVertexArrays, glGenVertexArrays, PFNIGLGENVERTEXARRAYSPROC, n, vertexArrays);
 }
 
+///--------------------------------------
+/// MARK: - GL_EXT_base_instance
+
+#if defined(GL_EXT_base_instance)
+#define CAN_CALL_glDrawArraysInstancedBaseInstanceEXT CAN_CALL_OPENGL_ES
+#define CAN_CALL_glDrawElementsInstancedBaseVertexBaseInstanceEXT CAN_CALL_OPENGL_ES
+#else
+#define CAN_CALL_glDrawArraysInstancedBaseInstanceEXT 0
+#define CAN_CALL_glDrawElementsInstancedBaseVertexBaseInstanceEXT 0
+#endif
+
+void iglDrawArraysInstancedBaseInstanceEXT(GLenum mode,
+                                           GLint first,
+                                           GLsizei count,
+                                           GLsizei instancecount,
+                                           GLuint baseinstance) {
+  GLEXTENSION_METHOD_BODY(CAN_CALL_glDrawArraysInstancedBaseInstanceEXT,
+                          glDrawArraysInstancedBaseInstanceEXT,
+                          PFNIGLDRAWARRAYSINSTANCEDBASEINSTANCEPROC,
+                          mode,
+                          first,
+                          count,
+                          instancecount,
+                          baseinstance);
+}
+
+void iglDrawElementsInstancedBaseVertexBaseInstanceEXT(GLenum mode,
+                                                       GLsizei count,
+                                                       GLenum type,
+                                                       const GLvoid* indices,
+                                                       GLsizei instancecount,
+                                                       GLint basevertex,
+                                                       GLuint baseinstance) {
+  GLEXTENSION_METHOD_BODY(CAN_CALL_glDrawElementsInstancedBaseVertexBaseInstanceEXT,
+                          glDrawElementsInstancedBaseVertexBaseInstanceEXT,
+                          PFNIGLDRAWELEMENTSINSTANCEDBASEVERTEXBASEINSTANCEPROC,
+                          mode,
+                          count,
+                          type,
+                          indices,
+                          instancecount,
+                          basevertex,
+                          baseinstance);
+}
+
 ///--------------------------------------
 /// MARK: - GL_EXT_debug_marker
 
@@ -1126,6 +1365,55 @@ void iglDiscardFramebufferEXT(GLenum target, GLsizei numAttachments, const GLenu
                           attachments);
 }
 
+///--------------------------------------
+/// MARK: - GL_EXT_disjoint_timer_query
+
+#if defined(GL_EXT_disjoint_timer_query)
+#define CAN_CALL_glDeleteQueriesEXT CAN_CALL_OPENGL_ES
+#define CAN_CALL_glGenQueriesEXT CAN_CALL_OPENGL_ES
+#define CAN_CALL_glGetQueryObjectivEXT CAN_CALL_OPENGL_ES
+#define CAN_CALL_glGetQueryObjectui64vEXT CAN_CALL_OPENGL_ES
+#define CAN_CALL_glQueryCounterEXT CAN_CALL_OPENGL_ES
+#else
+#define CAN_CALL_glDeleteQueriesEXT 0
+#define CAN_CALL_glGenQueriesEXT 0
+#define CAN_CALL_glGetQueryObjectivEXT 0
+#define CAN_CALL_glGetQueryObjectui64vEXT 0
+#define CAN_CALL_glQueryCounterEXT 0
+#endif
+
+void iglDeleteQueriesEXT(GLsizei n, const GLuint* ids) {
+  GLEXTENSION_METHOD_BODY(
+      CAN_CALL_glDeleteQueriesEXT, glDeleteQueriesEXT, PFNIGLDELETEQUERIESPROC, n, ids);
+}
+
+void iglGenQueriesEXT(GLsizei n, GLuint* ids) {
+  GLEXTENSION_METHOD_BODY(CAN_CALL_glGenQueriesEXT, glGenQueriesEXT, PFNIGLGENQUERIESPROC, n, ids);
+}
+
+void iglGetQueryObjectivEXT(GLuint id, GLenum pname, GLint* params) {
+  GLEXTENSION_METHOD_BODY(CAN_CALL_glGetQueryObjectivEXT,
+                          glGetQueryObjectivEXT,
+                          PFNIGLGETQUERYOBJECTIVPROC,
+                          id,
+                          pname,
+                          params);
+}
+
+void iglGetQueryObjectui64vEXT(GLuint id, GLenum pname, GLuint64* params) {
+  GLEXTENSION_METHOD_BODY(CAN_CALL_glGetQueryObjectui64vEXT,
+                          glGetQueryObjectui64vEXT,
+                          PFNIGLGETQUERYOBJECTUI64VPROC,
+                          id,
+                          pname,
+                          params);
+}
+
+void iglQueryCounterEXT(GLuint id, GLenum target) {
+  GLEXTENSION_METHOD_BODY(
+      CAN_CALL_glQueryCounterEXT, glQueryCounterEXT, PFNIGLQUERYCOUNTERPROC, id, target);
+}
+
 ///--------------------------------------
 /// MARK: - GL_EXT_draw_buffers
 
@@ -1517,6 +1805,22 @@ void iglPushDebugGroupKHR(GLenum source, GLuint id, GLsizei length, const GLchar
                           message);
 }
 
+///--------------------------------------
+/// MARK: - GL_KHR_parallel_shader_compile
+
+#if defined(GL_KHR_parallel_shader_compile)
+#define CAN_CALL_glMaxShaderCompilerThreadsKHR CAN_CALL
+#else
+#define CAN_CALL_glMaxShaderCompilerThreadsKHR 0
+#endif
+
+void iglMaxShaderCompilerThreadsKHR(GLuint count) {
+  GLEXTENSION_METHOD_BODY(CAN_CALL_glMaxShaderCompilerThreadsKHR,
+                          glMaxShaderCompilerThreadsKHR,
+                          PFNIGLMAXSHADERCOMPILERTHREADSPROC,
+                          count);
+}
+
 ///--------------------------------------
 /// MARK: - GL_NV_bindless_texture
 
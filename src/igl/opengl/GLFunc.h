@@ -86,6 +86,7 @@ using PFNIGLDEBUGMESSAGEINSERTPROC = void (*)(GLenum source,
                                               const GLchar* buf);
 using PFNIGLDELETEFRAMEBUFFERSPROC = void (*)(GLsizei n, const GLuint* framebuffers);
 using PFNIGLDELETEMEMORYOBJECTSPROC = void (*)(GLsizei n, const GLuint* memoryObjects);
+using PFNIGLDELETEQUERIESPROC = void (*)(GLsizei n, const GLuint* ids);
 using PFNIGLDELETERENDERBUFFERSPROC = void (*)(GLsizei n, const GLuint* renderbuffers);
 using PFNIGLDELETESYNCPROC = void (*)(GLsync sync);
 using PFNIGLDELETEVERTEXARRAYSPROC = void (*)(GLsizei n, const GLuint* vertexArrays);
@@ -95,8 +96,29 @@ using PFNIGLDISCARDFRAMEBUFFERPROC = void (*)(GLenum target,
 using PFNIGLDISPATCHCOMPUTEPROC = void (*)(GLuint num_groups_x,
                                            GLuint num_groups_y,
                                            GLuint num_groups_z);
+using PFNIGLDRAWARRAYSINSTANCEDPROC = void (*)(GLenum mode,
+                                               GLint first,
+                                               GLsizei count,
+                                               GLsizei instancecount);
+using PFNIGLDRAWARRAYSINSTANCEDBASEINSTANCEPROC = void (*)(GLenum mode,
+                                                           GLint first,
+                                                           GLsizei count,
+                                                           GLsizei instancecount,
+                                                           GLuint baseinstance);
 using PFNIGLDRAWBUFFERSPROC = void (*)(GLsizei, const GLenum*);
 using PFNIGLDRAWELEMENTSINDIRECTPROC = void (*)(GLenum mode, GLenum type, const GLvoid* indirect);
+using PFNIGLDRAWELEMENTSINSTANCEDPROC = void (*)(GLenum mode,
+                                                 GLsizei count,
+                                                 GLenum type,
+                                                 const GLvoid* indices,
+                                                 GLsizei instancecount);
+using PFNIGLDRAWELEMENTSINSTANCEDBASEVERTEXBASEINSTANCEPROC = void (*)(GLenum mode,
+                                                                       GLsizei count,
+                                                                       GLenum type,
+                                                                       const GLvoid* indices,
+                                                                       GLsizei instancecount,
+                                                                       GLint basevertex,
+                                                                       GLuint baseinstance);
 using PFNIGLFENCESYNCPROC = GLsync (*)(GLenum condition, GLbitfield flags);
 using PFNIGLFRAMEBUFFERRENDERBUFFERPROC = void (*)(GLenum target,
                                                    GLenum attachment,
@@ -127,6 +149,7 @@ using PFNIGLFRAMEBUFFERTEXTUREMULTIVIEWPROC = void (*)(GLenum target,
                                                        GLsizei numViews);
 using PFNIGLGENERATEMIPMAPPROC = void (*)(GLenum target);
 using PFNIGLGENFRAMEBUFFERSPROC = void (*)(GLsizei n, GLuint* framebuffers);
+using PFNIGLGENQUERIESPROC = void (*)(GLsizei n, GLuint* ids);
 using PFNIGLGENRENDERBUFFERSPROC = void (*)(GLsizei n, GLuint* renderbuffers);
 using PFNIGLGENVERTEXARRAYSPROC = void (*)(GLsizei n, GLuint* vertexArrays);
 using PFNIGLGETACTIVEUNIFORMSIVPROC = void (*)(GLuint program,
@@ -147,6 +170,11 @@ using PFNIGLGETFRAMEBUFFERATTACHMENTPARAMETERIVPROC = void (*)(GLenum target,
                                                                GLenum attachment,
                                                                GLenum pname,
                                                                GLint* params);
+using PFNIGLGETPROGRAMBINARYPROC = void (*)(GLuint program,
+                                            GLsizei bufSize,
+                                            GLsizei* length,
+                                            GLenum* binaryFormat,
+                                            void* binary);
 using PFNIGLGETPROGRAMINTERFACEIVPROC = void (*)(GLuint program,
                                                  GLenum programInterface,
                                                  GLenum pname,
@@ -168,6 +196,8 @@ using PFNIGLGETPROGRAMRESOURCENAMEPROC = void (*)(GLuint program,
                                                   GLsizei bufSize,
                                                   GLsizei* length,
                                                   char* name);
+using PFNIGLGETQUERYOBJECTIVPROC = void (*)(GLuint id, GLenum pname, GLint* params);
+using PFNIGLGETQUERYOBJECTUI64VPROC = void (*)(GLuint id, GLenum pname, GLuint64* params);
 using PFNIGLGETRENDERBUFFERPARAMETERIVPROC = void (*)(GLenum target, GLenum pname, GLint* params);
 using PFNIGLGETSTRINGIPROC = const GLubyte* (*)(GLenum name, GLint index);
 using PFNIGLGETSYNCIVPROC =
@@ -191,6 +221,7 @@ using PFNIGLMAPBUFFERRANGEPROC = void* (*)(GLenum target,
                                            GLintptr offset,
                                            GLsizeiptr length,
                                            GLbitfield access);
+using PFNIGLMAXSHADERCOMPILERTHREADSPROC = void (*)(GLuint count);
 using PFNIGLMEMORYBARRIERPROC = void (*)(GLbitfield barriers);
 using PFNIGLPOPDEBUGGROUPPROC = void (*)();
 using PFNIGLPOPGROUPMARKERPROC = void (*)();
@@ -198,7 +229,13 @@ using PFNIGLPUSHDEBUGGROUPPROC = void (*)(GLenum source,
                                           GLuint id,
                                           GLsizei length,
                                           const GLchar* message);
+using PFNIGLPROGRAMBINARYPROC = void (*)(GLuint program,
+                                         GLenum binaryFormat,
+                                         const void* binary,
+                                         GLsizei length);
+using PFNIGLPROGRAMPARAMETERIPROC = void (*)(GLuint program, GLenum pname, GLint value);
 using PFNIGLPUSHGROUPMARKERPROC = void (*)(GLsizei length, const GLchar* marker);
+using PFNIGLQUERYCOUNTERPROC = void (*)(GLuint id, GLenum target);
 using PFNIGLRENDERBUFFERSTORAGEPROC = void (*)(GLenum target,
                                                GLenum internalformat,
                                                GLsizei width,
@@ -257,6 +294,7 @@ using PFNIGLUNIFORMBLOCKBINDINGPROC = void (*)(GLuint pid,
                                                GLuint uniformBlockIndex,
                                                GLuint uniformBlockBinding);
 using PFNIGLUNMAPBUFFERPROC = void (*)(GLenum target);
+using PFNIGLVERTEXATTRIBDIVISORPROC = void (*)(GLuint index, GLuint divisor);
 
 ///--------------------------------------
 /// MARK: - OpenGL ES / OpenGL
@@ -332,6 +370,22 @@ void iglDeleteSyncAPPLE(GLsync sync);
 GLsync iglFenceSyncAPPLE(GLenum condition, GLbitfield flags);
 void iglGetSyncivAPPLE(GLsync sync, GLenum pname, GLsizei bufSize, GLsizei* length, GLint* values);
 
+///--------------------------------------
+/// MARK: - GL_ARB_base_instance
+
+void iglDrawArraysInstancedBaseInstance(GLenum mode,
+                                        GLint first,
+                                        GLsizei count,
+                                        GLsizei instancecount,
+                                        GLuint baseinstance);
+void iglDrawElementsInstancedBaseVertexBaseInstance(GLenum mode,
+                                                    GLsizei count,
+                                                    GLenum type,
+                                                    const GLvoid* indices,
+                                                    GLsizei instancecount,
+                                                    GLint basevertex,
+                                                    GLuint baseinstance);
+
 ///--------------------------------------
 /// MARK: - GL_ARB_bindless_texture
 
@@ -349,6 +403,16 @@ void iglDispatchCompute(GLuint num_groups_x, GLuint num_groups_y, GLuint num_gro
 
 void iglDrawElementsIndirect(GLenum mode, GLenum type, const GLvoid* indirect);
 
+///--------------------------------------
+/// MARK: - GL_ARB_draw_instanced
+
+void iglDrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instancecount);
+void iglDrawElementsInstanced(GLenum mode,
+                              GLsizei count,
+                              GLenum type,
+                              const GLvoid* indices,
+                              GLsizei instancecount);
+
 ///--------------------------------------
 /// MARK: - GL_ARB_ES2_compatibility
 
@@ -403,6 +467,22 @@ void iglRenderbufferStorageMultisample(GLenum target,
                                        GLsizei width,
                                        GLsizei height);
 
+///--------------------------------------
+/// MARK: - GL_ARB_get_program_binary
+
+void iglGetProgramBinary(GLuint program,
+                         GLsizei bufSize,
+                         GLsizei* length,
+                         GLenum* binaryFormat,
+                         void* binary);
+void iglProgramBinary(GLuint program, GLenum binaryFormat, const void* binary, GLsizei length);
+void iglProgramParameteri(GLuint program, GLenum pname, GLint value);
+
+///--------------------------------------
+/// MARK: - GL_ARB_instanced_arrays
+
+void iglVertexAttribDivisor(GLuint index, GLuint divisor);
+
 ///--------------------------------------
 /// MARK: - GL_ARB_invalidate_subdata
 
@@ -468,6 +548,15 @@ void iglTexStorage3D(GLenum target,
                      GLsizei height,
                      GLsizei depth);
 
+///--------------------------------------
+/// MARK: - GL_ARB_timer_query
+
+void iglDeleteQueries(GLsizei n, const GLuint* ids);
+void iglGenQueries(GLsizei n, GLuint* ids);
+void iglGetQueryObjectiv(GLuint id, GLenum pname, GLint* params);
+void iglGetQueryObjectui64v(GLuint id, GLenum pname, GLuint64* params);
+void iglQueryCounter(GLuint id, GLenum target);
+
 ///--------------------------------------
 /// MARK: - GL_ARB_uniform_buffer_object
 
@@ -498,6 +587,22 @@ void iglBindVertexArray(GLuint vao);
 void iglDeleteVertexArrays(GLsizei n, const GLuint* vertexArrays);
 void iglGenVertexArrays(GLsizei n, GLuint* vertexArrays);
 
+///--------------------------------------
+/// MARK: - GL_EXT_base_instance
+
+void iglDrawArraysInstancedBaseInstanceEXT(GLenum mode,
+                                           GLint first,
+                                           GLsizei count,
+                                           GLsizei instancecount,
+                                           GLuint baseinstance);
+void iglDrawElementsInstancedBaseVertexBaseInstanceEXT(GLenum mode,
+                                                       GLsizei count,
+                                                       GLenum type,
+                                                       const GLvoid* indices,
+                                                       GLsizei instancecount,
+                                                       GLint basevertex,
+                                                       GLuint baseinstance);
+
 ///--------------------------------------
 /// MARK: - GL_EXT_debug_marker
 
@@ -518,6 +623,15 @@ void iglPushGroupMarkerEXT(GLenum source, GLuint id, GLsizei length, const GLcha
 
 void iglDiscardFramebufferEXT(GLenum target, GLsizei numAttachments, const GLenum* attachments);
 
+///--------------------------------------
+/// MARK: - GL_EXT_disjoint_timer_query
+
+void iglDeleteQueriesEXT(GLsizei n, const GLuint* ids);
+void iglGenQueriesEXT(GLsizei n, GLuint* ids);
+void iglGetQueryObjectivEXT(GLuint id, GLenum pname, GLint* params);
+void iglGetQueryObjectui64vEXT(GLuint id, GLenum pname, GLuint64* params);
+void iglQueryCounterEXT(GLuint id, GLenum target);
+
 ///--------------------------------------
 /// MARK: - GL_EXT_draw_buffers
 
@@ -638,6 +752,11 @@ void iglDebugMessageInsertKHR(GLenum source,
 void iglPopDebugGroupKHR();
 void iglPushDebugGroupKHR(GLenum source, GLuint id, GLsizei length, const GLchar* message);
 
+///--------------------------------------
+/// MARK: - GL_KHR_parallel_shader_compile
+
+void iglMaxShaderCompilerThreadsKHR(GLuint count);
+
 ///--------------------------------------
 /// MARK: - GL_NV_bindless_texture
 
@@ -327,6 +327,8 @@ std::string GLenumToString(GLenum code) {
     RESULT_CASE(GL_PIXEL_UNPACK_BUFFER)
     RESULT_CASE(GL_POINTS)
     RESULT_CASE(GL_POLYGON_OFFSET_FILL)
+    RESULT_CASE(GL_QUERY_RESULT)
+    RESULT_CASE(GL_QUERY_RESULT_AVAILABLE)
     RESULT_CASE(GL_R16)
     RESULT_CASE(GL_R16F)
     RESULT_CASE(GL_R16UI)
@@ -451,6 +453,7 @@ std::string GLenumToString(GLenum code) {
     RESULT_CASE(GL_TEXTURE6)
     RESULT_CASE(GL_TEXTURE7)
     RESULT_CASE(GL_TEXTURE8)
+    RESULT_CASE(GL_TIMESTAMP)
     RESULT_CASE(GL_TRIANGLES)
     RESULT_CASE(GL_TRIANGLE_FAN)
     RESULT_CASE(GL_TRIANGLE_STRIP)
@@ -1228,6 +1231,22 @@ void IContext::deleteShader(GLuint shaderId) {
   }
 }
 
+void IContext::deleteQueries(GLsizei n, const GLuint* ids) {
+  if (deleteQueriesProc_ == nullptr) {
+    if (deviceFeatureSet_.hasInternalRequirement(InternalRequirement::TimerQueryExtReq)) {
+      if (deviceFeatureSet_.hasExtension(Extensions::DisjointTimerQuery)) {
+        deleteQueriesProc_ = iglDeleteQueriesEXT;
+      }
+    } else if (deviceFeatureSet_.hasInternalFeature(InternalFeatures::TimerQuery)) {
+      deleteQueriesProc_ = iglDeleteQueries;
+    }
+  }
+
+  GLCALL_PROC(deleteQueriesProc_, n, ids);
+  APILOG("glDeleteQueries(%u, %p)\n", n, ids);
+  GLCHECK_ERRORS();
+}
+
 void IContext::deleteSync(GLsync sync) {
   if (deleteSyncProc_ == nullptr) {
     if (deviceFeatureSet_.hasInternalRequirement(InternalRequirement::SyncExtReq)) {
@@ -1301,6 +1320,49 @@ void IContext::drawArrays(GLenum mode, GLint first, GLsizei count) {
   APILOG_DEC_DRAW_COUNT();
 }
 
+void IContext::drawArraysInstanced(GLenum mode,
+                                   GLint first,
+                                   GLsizei count,
+                                   GLsizei instancecount) {
+  drawCallCount_++;
+  IGLCALL(DrawArraysInstanced)(mode, first, count, instancecount);
+  APILOG("glDrawArraysInstanced(%s, %d, %u, %u)\n",
+         GL_ENUM_TO_STRING(mode),
+         first,
+         count,
+         instancecount);
+  GLCHECK_ERRORS();
+  APILOG_DEC_DRAW_COUNT();
+}
+
+void IContext::drawArraysInstancedBaseInstance(GLenum mode,
+                                               GLint first,
+                                               GLsizei count,
+                                               GLsizei instancecount,
+                                               GLuint baseinstance) {
+  if (drawArraysInstancedBaseInstanceProc_ == nullptr) {
+    if (deviceFeatureSet_.hasInternalRequirement(InternalRequirement::BaseInstanceExtReq)) {
+      if (deviceFeatureSet_.hasExtension(Extensions::BaseInstance)) {
+        drawArraysInstancedBaseInstanceProc_ = iglDrawArraysInstancedBaseInstanceEXT;
+      }
+    } else if (deviceFeatureSet_.hasFeature(DeviceFeatures::DrawBaseInstance)) {
+      drawArraysInstancedBaseInstanceProc_ = iglDrawArraysInstancedBaseInstance;
+    }
+  }
+
+  drawCallCount_++;
+  GLCALL_PROC(
+      drawArraysInstancedBaseInstanceProc_, mode, first, count, instancecount, baseinstance);
+  APILOG("glDrawArraysInstancedBaseInstance(%s, %d, %u, %u, %u)\n",
+         GL_ENUM_TO_STRING(mode),
+         first,
+         count,
+         instancecount,
+         baseinstance);
+  GLCHECK_ERRORS();
+  APILOG_DEC_DRAW_COUNT();
+}
+
 void IContext::drawBuffers(GLsizei n, GLenum* buffers) {
   if (drawBuffersProc_ == nullptr) {
     if (deviceFeatureSet_.hasFeature(DeviceFeatures::MultipleRenderTargets)) {
@@ -1343,6 +1405,63 @@ void IContext::drawElementsIndirect(GLenum mode, GLenum type, const GLvoid* indi
   APILOG_DEC_DRAW_COUNT();
 }
 
+void IContext::drawElementsInstanced(GLenum mode,
+                                     GLsizei count,
+                                     GLenum type,
+                                     const GLvoid* indices,
+                                     GLsizei instancecount) {
+  drawCallCount_++;
+  IGLCALL(DrawElementsInstanced)(mode, count, type, indices, instancecount);
+  APILOG("glDrawElementsInstanced(%s, %u, %s, %p, %u)\n",
+         GL_ENUM_TO_STRING(mode),
+         count,
+         GL_ENUM_TO_STRING(type),
+         indices,
+         instancecount);
+  GLCHECK_ERRORS();
+  APILOG_DEC_DRAW_COUNT();
+}
+
+void IContext::drawElementsInstancedBaseVertexBaseInstance(GLenum mode,
+                                                           GLsizei count,
+                                                           GLenum type,
+                                                           const GLvoid* indices,
+                                                           GLsizei instancecount,
+                                                           GLint basevertex,
+                                                           GLuint baseinstance) {
+  if (drawElementsInstancedBaseVertexBaseInstanceProc_ == nullptr) {
+    if (deviceFeatureSet_.hasInternalRequirement(InternalRequirement::BaseInstanceExtReq)) {
+      if (deviceFeatureSet_.hasExtension(Extensions::BaseInstance)) {
+        drawElementsInstancedBaseVertexBaseInstanceProc_ =
+            iglDrawElementsInstancedBaseVertexBaseInstanceEXT;
+      }
+    } else if (deviceFeatureSet_.hasFeature(DeviceFeatures::DrawBaseInstance)) {
+      drawElementsInstancedBaseVertexBaseInstanceProc_ =
+          iglDrawElementsInstancedBaseVertexBaseInstance;
+    }
+  }
+
+  drawCallCount_++;
+  GLCALL_PROC(drawElementsInstancedBaseVertexBaseInstanceProc_,
+              mode,
+              count,
+              type,
+              indices,
+              instancecount,
+              basevertex,
+              baseinstance);
+  APILOG("glDrawElementsInstancedBaseVertexBaseInstance(%s, %u, %s, %p, %u, %d, %u)\n",
+         GL_ENUM_TO_STRING(mode),
+         count,
+         GL_ENUM_TO_STRING(type),
+         indices,
+         instancecount,
+         basevertex,
+         baseinstance);
+  GLCHECK_ERRORS();
+  APILOG_DEC_DRAW_COUNT();
+}
+
 void IContext::enable(GLenum cap) {
   GLCALL(Enable)(cap);
   APILOG("glEnable(%s)\n", GL_ENUM_TO_STRING(cap));
@@ -1499,6 +1618,22 @@ void IContext::genBuffers(GLsizei n, GLuint* buffers) {
   GLCHECK_ERRORS();
 }
 
+void IContext::genQueries(GLsizei n, GLuint* ids) {
+  if (genQueriesProc_ == nullptr) {
+    if (deviceFeatureSet_.hasInternalRequirement(InternalRequirement::TimerQueryExtReq)) {
+      if (deviceFeatureSet_.hasExtension(Extensions::DisjointTimerQuery)) {
+        genQueriesProc_ = iglGenQueriesEXT;
+      }
+    } else if (deviceFeatureSet_.hasInternalFeature(InternalFeatures::TimerQuery)) {
+      genQueriesProc_ = iglGenQueries;
+    }
+  }
+
+  GLCALL_PROC(genQueriesProc_, n, ids);
+  APILOG("glGenQueries(%u, %p) = %u\n", n, ids, ids == nullptr ? 0 : *ids);
+  GLCHECK_ERRORS();
+}
+
 void IContext::genFramebuffers(GLsizei n, GLuint* framebuffers) {
   IGLCALL(GenFramebuffers)(n, framebuffers);
   APILOG("glGenFramebuffers(%u, %p) = %u\n",
@@ -1709,6 +1844,21 @@ void IContext::getIntegerv(GLenum pname, GLint* params) const {
   GLCHECK_ERRORS();
 }
 
+void IContext::getProgramBinary(GLuint program,
+                                GLsizei bufSize,
+                                GLsizei* length,
+                                GLenum* binaryFormat,
+                                void* binary) const {
+  IGLCALL(GetProgramBinary)(program, bufSize, length, binaryFormat, binary);
+  APILOG("glGetProgramBinary(%u, %d, %p, %p, %p)\n",
+         program,
+         bufSize,
+         length,
+         binaryFormat,
+         binary);
+  GLCHECK_ERRORS();
+}
+
 void IContext::getProgramiv(GLuint program, GLenum pname, GLint* params) const {
   GLCALL(GetProgramiv)(program, pname, params);
   APILOG("glGetProgramiv(%u, %s, %p) = %d\n",
@@ -1806,6 +1956,38 @@ void IContext::getProgramResourceName(GLuint program,
   GLCHECK_ERRORS();
 }
 
+void IContext::getQueryObjectiv(GLuint id, GLenum pname, GLint* params) const {
+  if (getQueryObjectivProc_ == nullptr) {
+    if (deviceFeatureSet_.hasInternalRequirement(InternalRequirement::TimerQueryExtReq)) {
+      if (deviceFeatureSet_.hasExtension(Extensions::DisjointTimerQuery)) {
+        getQueryObjectivProc_ = iglGetQueryObjectivEXT;
+      }
+    } else if (deviceFeatureSet_.hasInternalFeature(InternalFeatures::TimerQuery)) {
+      getQueryObjectivProc_ = iglGetQueryObjectiv;
+    }
+  }
+
+  GLCALL_PROC(getQueryObjectivProc_, id, pname, params);
+  APILOG("glGetQueryObjectiv(%u, %s, %p)\n", id, GL_ENUM_TO_STRING(pname), params);
+  GLCHECK_ERRORS();
+}
+
+void IContext::getQueryObjectui64v(GLuint id, GLenum pname, GLuint64* params) const {
+  if (getQueryObjectui64vProc_ == nullptr) {
+    if (deviceFeatureSet_.hasInternalRequirement(InternalRequirement::TimerQueryExtReq)) {
+      if (deviceFeatureSet_.hasExtension(Extensions::DisjointTimerQuery)) {
+        getQueryObjectui64vProc_ = iglGetQueryObjectui64vEXT;
+      }
+    } else if (deviceFeatureSet_.hasInternalFeature(InternalFeatures::TimerQuery)) {
+      getQueryObjectui64vProc_ = iglGetQueryObjectui64v;
+    }
+  }
+
+  GLCALL_PROC(getQueryObjectui64vProc_, id, pname, params);
+  APILOG("glGetQueryObjectui64v(%u, %s, %p)\n", id, GL_ENUM_TO_STRING(pname), params);
+  GLCHECK_ERRORS();
+}
+
 void IContext::getRenderbufferParameteriv(GLenum target, GLenum pname, GLint* params) const {
   IGLCALL(GetRenderbufferParameteriv)(target, pname, params);
   APILOG("glGetRenderbufferParameteriv(%s, %s, %p) = %d\n",
@@ -2128,6 +2310,18 @@ void* IContext::mapBuffer(GLenum target, GLbitfield access) {
   return ret;
 }
 
+void IContext::maxShaderCompilerThreads(GLuint count) {
+  if (maxShaderCompilerThreadsProc_ == nullptr) {
+    if (deviceFeatureSet_.hasExtension(Extensions::ParallelShaderCompile)) {
+      maxShaderCompilerThreadsProc_ = iglMaxShaderCompilerThreadsKHR;
+    }
+  }
+
+  GLCALL_PROC(maxShaderCompilerThreadsProc_, count);
+  APILOG("glMaxShaderCompilerThreadsKHR(%u)\n", count);
+  GLCHECK_ERRORS();
+}
+
 void* IContext::mapBufferRange(GLenum target,
                                GLintptr offset,
                                GLsizeiptr length,
@@ -2205,6 +2399,37 @@ void IContext::popDebugGroup() {
   GLCHECK_ERRORS();
 }
 
+void IContext::programBinary(GLuint program,
+                             GLenum binaryFormat,
+                             const void* binary,
+                             GLsizei length) {
+  IGLCALL(ProgramBinary)(program, binaryFormat, binary, length);
+  APILOG("glProgramBinary(%u, 0x%x, %p, %d)\n", program, binaryFormat, binary, length);
+  GLCHECK_ERRORS();
+}
+
+void IContext::programParameteri(GLuint program, GLenum pname, GLint value) {
+  IGLCALL(ProgramParameteri)(program, pname, value);
+  APILOG("glProgramParameteri(%u, %s, %d)\n", program, GL_ENUM_TO_STRING(pname), value);
+  GLCHECK_ERRORS();
+}
+
+void IContext::queryCounter(GLuint id, GLenum target) {
+  if (queryCounterProc_ == nullptr) {
+    if (deviceFeatureSet_.hasInternalRequirement(InternalRequirement::TimerQueryExtReq)) {
+      if (deviceFeatureSet_.hasExtension(Extensions::DisjointTimerQuery)) {
+        queryCounterProc_ = iglQueryCounterEXT;
+      }
+    } else if (deviceFeatureSet_.hasInternalFeature(InternalFeatures::TimerQuery)) {
+      queryCounterProc_ = iglQueryCounter;
+    }
+  }
+
+  GLCALL_PROC(queryCounterProc_, id, target);
+  APILOG("glQueryCounter(%u, %s)\n", id, GL_ENUM_TO_STRING(target));
+  GLCHECK_ERRORS();
+}
+
 void IContext::readPixels(GLint x,
                           GLint y,
                           GLsizei width,
@@ -3139,6 +3364,12 @@ void IContext::vertexAttribPointer(GLuint indx,
   GLCHECK_ERRORS();
 }
 
+void IContext::vertexAttribDivisor(GLuint index, GLuint divisor) {
+  IGLCALL(VertexAttribDivisor)(index, divisor);
+  APILOG("glVertexAttribDivisor(%u, %u)\n", index, divisor);
+  GLCHECK_ERRORS();
+}
+
 Result IContext::getLastError() const {
   return GL_ERROR_TO_RESULT(lastError_);
 }
@@ -3274,6 +3505,27 @@ void IContext::initialize(Result* result) {
   if (deviceFeatureSet_.hasInternalFeature(InternalFeatures::SeamlessCubeMap)) {
     enable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
   }
+
+  if (deviceFeatureSet_.hasExtension(Extensions::ParallelShaderCompile)) {
+    // let the driver pick the number of compiler threads; Device::createShaderStagesBatch() only
+    // queries the status of shaders and programs after the whole batch was submitted
+    maxShaderCompilerThreads(0xFFFFFFFF);
+  }
+
+  if (deviceFeatureSet_.hasInternalFeature(InternalFeatures::ProgramBinary)) {
+    // some drivers expose the entry points without supporting any binary format
+    GLint numFormats = 0;
+    getIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+    if (numFormats > 0) {
+      std::string driverId;
+      for (const GLenum name : {GL_VENDOR, GL_RENDERER, GL_VERSION}) {
+        const char* str = (char*)getString(name);
+        driverId += str ? str : "";
+        driverId += '\n';
+      }
+      programBinaryCache_ = std::make_unique<ProgramBinaryCache>(std::move(driverId));
+    }
+  }
 }
 
 const DeviceFeatureSet& IContext::deviceFeatures() const {
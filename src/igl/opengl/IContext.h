@@ -14,6 +14,7 @@
 #include <igl/opengl/DeviceFeatureSet.h>
 #include <igl/opengl/GLFunc.h>
 #include <igl/opengl/GLIncludes.h>
+#include <igl/opengl/ProgramBinaryCache.h>
 #include <igl/opengl/RenderCommandAdapter.h>
 #include <igl/opengl/UnbindPolicy.h>
 #include <igl/opengl/Version.h>
@@ -30,6 +31,8 @@ class ITexture;
 
 namespace igl::opengl {
 
+class TransientAllocator;
+
 // We might extend this to other enums presenting API versions on desktops, etc.
 // For the time being, we only need to differentiate gles2 and gles3
 enum class RenderingAPI { GLES2, GLES3, GL };
@@ -186,6 +189,7 @@ class IContext {
   void deleteRenderbuffers(GLsizei n, const GLuint* renderbuffers);
   void deleteVertexArrays(GLsizei n, const GLuint* vertexArrays);
   void deleteProgram(GLuint program);
+  void deleteQueries(GLsizei n, const GLuint* ids);
   void deleteShader(GLuint shaderId);
   void deleteSync(GLsync sync);
   void deleteTextures(const std::vector<GLuint>& textures);
@@ -196,9 +200,27 @@ class IContext {
   virtual void disable(GLenum cap);
   void disableVertexAttribArray(GLuint index);
   void drawArrays(GLenum mode, GLint first, GLsizei count);
+  void drawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instancecount);
+  void drawArraysInstancedBaseInstance(GLenum mode,
+                                       GLint first,
+                                       GLsizei count,
+                                       GLsizei instancecount,
+                                       GLuint baseinstance);
   void drawBuffers(GLsizei n, GLenum* buffers);
   void drawElements(GLenum mode, GLsizei count, GLenum type, const GLvoid* indices);
   void drawElementsIndirect(GLenum mode, GLenum type, const GLvoid* indirect);
+  void drawElementsInstanced(GLenum mode,
+                             GLsizei count,
+                             GLenum type,
+                             const GLvoid* indices,
+                             GLsizei instancecount);
+  void drawElementsInstancedBaseVertexBaseInstance(GLenum mode,
+                                                   GLsizei count,
+                                                   GLenum type,
+                                                   const GLvoid* indices,
+                                                   GLsizei instancecount,
+                                                   GLint basevertex,
+                                                   GLuint baseinstance);
   virtual void enable(GLenum cap);
   void enableVertexAttribArray(GLuint index);
   GLsync fenceSync(GLenum condition, GLbitfield flags);
@@ -229,6 +251,7 @@ class IContext {
   void generateMipmap(GLenum target);
   void genBuffers(GLsizei n, GLuint* buffers);
   void genFramebuffers(GLsizei n, GLuint* framebuffers);
+  void genQueries(GLsizei n, GLuint* ids);
   void genRenderbuffers(GLsizei n, GLuint* renderbuffers);
   void genTextures(GLsizei n, GLuint* textures);
   void genVertexArrays(GLsizei n, GLuint* vertexArrays);
@@ -269,6 +292,11 @@ class IContext {
                                            GLenum pname,
                                            GLint* params) const;
   void getIntegerv(GLenum pname, GLint* params) const;
+  void getProgramBinary(GLuint program,
+                        GLsizei bufSize,
+                        GLsizei* length,
+                        GLenum* binaryFormat,
+                        void* binary) const;
   void getProgramiv(GLuint program, GLenum pname, GLint* params) const;
   void getProgramInterfaceiv(GLuint program,
                              GLenum programInterface,
@@ -290,6 +318,8 @@ class IContext {
                               GLsizei bufSize,
                               GLsizei* length,
                               char* name) const;
+  void getQueryObjectiv(GLuint id, GLenum pname, GLint* params) const;
+  void getQueryObjectui64v(GLuint id, GLenum pname, GLuint64* params) const;
   void getRenderbufferParameteriv(GLenum target, GLenum pname, GLint* params) const;
   void getShaderiv(GLuint shader, GLenum pname, GLint* params) const;
   void getShaderInfoLog(GLuint shader, GLsizei maxLength, GLsizei* length, GLchar* infoLog) const;
@@ -322,11 +352,15 @@ class IContext {
   void lineWidth(GLfloat width);
   void linkProgram(GLuint program);
   void* mapBuffer(GLenum target, GLbitfield access);
+  void maxShaderCompilerThreads(GLuint count);
   void* mapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access);
   void pixelStorei(GLenum pname, GLint param);
   void polygonOffset(GLfloat factor, GLfloat units);
   void popDebugGroup();
+  void programBinary(GLuint program, GLenum binaryFormat, const void* binary, GLsizei length);
+  void programParameteri(GLuint program, GLenum pname, GLint value);
   void pushDebugGroup(GLenum source, GLuint id, GLsizei length, const GLchar* message);
+  void queryCounter(GLuint id, GLenum target);
   void readPixels(GLint x,
                   GLint y,
                   GLsizei width,
@@ -493,6 +527,7 @@ class IContext {
                            GLboolean normalized,
                            GLsizei stride,
                            const GLvoid* ptr);
+  void vertexAttribDivisor(GLuint index, GLuint divisor);
   void viewport(GLint x, GLint y, GLsizei width, GLsizei height);
 
   void dispatchCompute(GLuint num_groups_x, GLuint num_groups_y, GLuint num_groups_z);
@@ -577,6 +612,22 @@ class IContext {
     return computeAdapterPool_;
   }
 
+  /// Returns the cache of linked program binaries, or nullptr when the driver cannot retrieve them.
+  /// Programs are cached in memory; they are stored on disk once a directory is set with
+  /// setDirectory().
+  ProgramBinaryCache* getProgramBinaryCache() const {
+    return programBinaryCache_.get();
+  }
+
+  /// Transient allocations of the device which uses this context, see Device::allocateTransient().
+  /// Command adapters upload them before draw calls and dispatches. Not owned by the context.
+  void setTransientAllocator(TransientAllocator* allocator) {
+    transientAllocator_ = allocator;
+  }
+  TransientAllocator* getTransientAllocator() const {
+    return transientAllocator_;
+  }
+
   // Called to check if the last OGL call resulted in an error.
   GLenum checkForErrors(const char* callerName, size_t lineNum) const;
   Result getLastError() const;
@@ -606,22 +657,31 @@ class IContext {
   PFNIGLCOMPRESSEDTEXIMAGE3DPROC compressedTexImage3DProc_ = nullptr;
   PFNIGLCOMPRESSEDTEXSUBIMAGE3DPROC compressedTexSubImage3DProc_ = nullptr;
   PFNIGLDEBUGMESSAGEINSERTPROC debugMessageInsertProc_ = nullptr;
+  PFNIGLDELETEQUERIESPROC deleteQueriesProc_ = nullptr;
   PFNIGLDELETESYNCPROC deleteSyncProc_ = nullptr;
   PFNIGLDELETEVERTEXARRAYSPROC deleteVertexArraysProc_ = nullptr;
+  PFNIGLDRAWARRAYSINSTANCEDBASEINSTANCEPROC drawArraysInstancedBaseInstanceProc_ = nullptr;
   PFNIGLDRAWBUFFERSPROC drawBuffersProc_ = nullptr;
+  PFNIGLDRAWELEMENTSINSTANCEDBASEVERTEXBASEINSTANCEPROC
+      drawElementsInstancedBaseVertexBaseInstanceProc_ = nullptr;
   PFNIGLFENCESYNCPROC fenceSyncProc_ = nullptr;
   PFNIGLFRAMEBUFFERTEXTURE2DMULTISAMPLEPROC framebufferTexture2DMultisampleProc_ = nullptr;
   PFNIGLINVALIDATEFRAMEBUFFERPROC invalidateFramebufferProc_ = nullptr;
+  PFNIGLGENQUERIESPROC genQueriesProc_ = nullptr;
   PFNIGLGENVERTEXARRAYSPROC genVertexArraysProc_ = nullptr;
+  mutable PFNIGLGETQUERYOBJECTIVPROC getQueryObjectivProc_ = nullptr;
+  mutable PFNIGLGETQUERYOBJECTUI64VPROC getQueryObjectui64vProc_ = nullptr;
   mutable PFNIGLGETSYNCIVPROC getSyncivProc_ = nullptr;
   PFNIGLGETTEXTUREHANDLEPROC getTextureHandleProc_ = nullptr;
   PFNIGLMAKETEXTUREHANDLERESIDENTPROC makeTextureHandleResidentProc_ = nullptr;
   PFNIGLMAKETEXTUREHANDLENONRESIDENTPROC makeTextureHandleNonResidentProc_ = nullptr;
   PFNIGLMAPBUFFERPROC mapBufferProc_ = nullptr;
   PFNIGLMAPBUFFERRANGEPROC mapBufferRangeProc_ = nullptr;
+  PFNIGLMAXSHADERCOMPILERTHREADSPROC maxShaderCompilerThreadsProc_ = nullptr;
   PFNIGLMEMORYBARRIERPROC memoryBarrierProc_ = nullptr;
   PFNIGLPOPDEBUGGROUPPROC popDebugGroupProc_ = nullptr;
   PFNIGLPUSHDEBUGGROUPPROC pushDebugGroupProc_ = nullptr;
+  PFNIGLQUERYCOUNTERPROC queryCounterProc_ = nullptr;
   PFNIGLRENDERBUFFERSTORAGEMULTISAMPLEPROC renderbufferStorageMultisampleProc_ = nullptr;
   PFNIGLTEXIMAGE3DPROC texImage3DProc_ = nullptr;
   PFNIGLTEXSTORAGE1DPROC texStorage1DProc_ = nullptr;
@@ -687,6 +747,10 @@ class IContext {
 
   DeviceFeatureSet deviceFeatureSet_;
 
+  std::unique_ptr<ProgramBinaryCache> programBinaryCache_;
+
+  TransientAllocator* transientAllocator_ = nullptr;
+
   // For framebufferTexture2DMultisample
   GLint maxSamples_ = -1;
 
@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/opengl/ProgramBinaryCache.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <igl/CacheFile.h>
+#include <igl/Common.h>
+
+namespace {
+
+// bump this whenever the way programs are created changes
+constexpr uint32_t kCacheVersion = 1;
+constexpr uint32_t kCacheFileMagic = 0x50474C49; // 'IGLP'
+
+struct CacheFileHeader {
+  uint32_t magic = kCacheFileMagic;
+  uint32_t version = kCacheVersion;
+  uint64_t key = 0;
+  uint32_t format = 0;
+  uint32_t size = 0;
+};
+
+} // namespace
+
+namespace igl {
+namespace opengl {
+
+ProgramBinaryCache::ProgramBinaryCache(std::string driverId, size_t maxNumEntries) :
+  driverId_(std::move(driverId)), maxNumEntries_(maxNumEntries) {}
+
+void ProgramBinaryCache::setDirectory(std::string directory) {
+  if (!directory.empty() && directory.back() != '/' && directory.back() != '\\') {
+    directory += '/';
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  directory_ = std::move(directory);
+}
+
+bool ProgramBinaryCache::isDiskCacheEnabled() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return !directory_.empty();
+}
+
+uint64_t ProgramBinaryCache::hashSource(const char* source) {
+  return hashCacheBytes(kCacheHashOffsetBasis, source, strlen(source));
+}
+
+uint64_t ProgramBinaryCache::computeKey(
+    const std::vector<std::pair<GLenum, uint64_t>>& shaders) const {
+  uint64_t hash = kCacheHashOffsetBasis;
+
+  hash = hashCacheBytes(hash, &kCacheVersion, sizeof(kCacheVersion));
+  hash = hashCacheBytes(hash, driverId_.data(), driverId_.size());
+  for (const auto& shader : shaders) {
+    hash = hashCacheBytes(hash, &shader.first, sizeof(shader.first));
+    hash = hashCacheBytes(hash, &shader.second, sizeof(shader.second));
+  }
+
+  return hash;
+}
+
+bool ProgramBinaryCache::find(uint64_t key, Binary& outBinary, bool* outShouldStore) {
+  std::string directory;
+  bool isLinkedBefore = false;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    const auto it = index_.find(key);
+    if (it != index_.end()) {
+      // mark the entry as the most recently used one
+      entries_.splice(entries_.begin(), entries_, it->second);
+      if (!it->second->binary.data.empty()) {
+        outBinary = it->second->binary;
+        numHits_++;
+        return true;
+      }
+      isLinkedBefore = true;
+    }
+
+    directory = directory_;
+  }
+
+  // the file is read without holding the lock
+  if (load(directory, key, outBinary)) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    addLocked(Entry{key, outBinary});
+    numHits_++;
+    return true;
+  }
+
+  if (!isLinkedBefore) {
+    // remember the program, so its binary is stored when it is linked again
+    std::lock_guard<std::mutex> lock(mutex_);
+    addLocked(Entry{key, {}});
+  }
+
+  numMisses_++;
+
+  if (outShouldStore) {
+    *outShouldStore = isLinkedBefore || !directory.empty();
+  }
+
+  return false;
+}
+
+void ProgramBinaryCache::insert(uint64_t key, Binary binary) {
+  if (binary.data.empty()) {
+    return;
+  }
+
+  std::string directory;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    directory = directory_;
+    if (directory.empty()) {
+      addLocked(Entry{key, std::move(binary)});
+      return;
+    }
+    // copy the entry so the file can be written without holding the lock
+    addLocked(Entry{key, binary});
+  }
+
+  store(directory, key, binary);
+}
+
+void ProgramBinaryCache::remove(uint64_t key) {
+  std::string directory;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto it = index_.find(key);
+    if (it != index_.end()) {
+      entries_.erase(it->second);
+      index_.erase(it);
+    }
+    directory = directory_;
+  }
+
+  if (!directory.empty()) {
+    std::remove(getFileName(directory, key).c_str());
+  }
+}
+
+void ProgramBinaryCache::addLocked(Entry entry) {
+  const auto it = index_.find(entry.key);
+  if (it != index_.end()) {
+    entries_.erase(it->second);
+    index_.erase(it);
+  }
+
+  entries_.push_front(std::move(entry));
+  index_[entries_.front().key] = entries_.begin();
+
+  while (entries_.size() > maxNumEntries_) {
+    index_.erase(entries_.back().key);
+    entries_.pop_back();
+  }
+}
+
+std::string ProgramBinaryCache::getFileName(const std::string& directory, uint64_t key) const {
+  char name[20];
+  snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(key));
+  return directory + name + ".bin";
+}
+
+bool ProgramBinaryCache::load(const std::string& directory, uint64_t key, Binary& outBinary) const {
+  if (directory.empty()) {
+    return false;
+  }
+
+  std::ifstream file(getFileName(directory, key), std::ios::binary);
+  if (!file) {
+    return false;
+  }
+
+  CacheFileHeader header;
+  if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+    return false;
+  }
+
+  if (header.magic != kCacheFileMagic || header.version != kCacheVersion || header.key != key ||
+      header.size == 0) {
+    IGL_LOG_INFO("Ignoring an incompatible program binary cache file for key %016llx\n",
+                 static_cast<unsigned long long>(key));
+    return false;
+  }
+
+  Binary binary;
+  binary.format = header.format;
+  binary.data.resize(header.size);
+  if (!file.read(reinterpret_cast<char*>(binary.data.data()), binary.data.size())) {
+    IGL_LOG_INFO("Ignoring a truncated program binary cache file for key %016llx\n",
+                 static_cast<unsigned long long>(key));
+    return false;
+  }
+
+  outBinary = std::move(binary);
+
+  return true;
+}
+
+void ProgramBinaryCache::store(const std::string& directory,
+                               uint64_t key,
+                               const Binary& binary) const {
+  CacheFileHeader header;
+  header.key = key;
+  header.format = binary.format;
+  header.size = static_cast<uint32_t>(binary.data.size());
+
+  writeCacheFile(getFileName(directory, key),
+                 {
+                     {&header, sizeof(header)},
+                     {binary.data.data(), binary.data.size()},
+                 });
+}
+
+} // namespace opengl
+} // namespace igl
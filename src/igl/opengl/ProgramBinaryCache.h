@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <igl/opengl/GLIncludes.h>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace igl {
+namespace opengl {
+
+/// @brief Caches linked program binaries (glGetProgramBinary) so programs can be restored with
+/// glProgramBinary instead of being linked again. Retrieving a binary after linking is not free,
+/// so the in-memory layer only keeps the programs which are linked for the second time. It holds
+/// at most `maxNumEntries` entries and evicts the least recently used ones. The on-disk layer is
+/// opt-in: once a directory is set, every program is stored in one file which is reused across
+/// runs. Binaries are only valid for the driver which produced them, so the driver identification
+/// string is part of every key. Thread-safe.
+class ProgramBinaryCache final {
+ public:
+  static constexpr size_t kDefaultMaxNumEntries = 256;
+
+  struct Binary {
+    GLenum format = 0;
+    std::vector<uint8_t> data;
+  };
+
+  /// @param driverId Identifies the driver, e.g. GL_VENDOR, GL_RENDERER and GL_VERSION combined
+  explicit ProgramBinaryCache(std::string driverId, size_t maxNumEntries = kDefaultMaxNumEntries);
+  ProgramBinaryCache(const ProgramBinaryCache&) = delete;
+  ProgramBinaryCache& operator=(const ProgramBinaryCache&) = delete;
+
+  /// @brief Sets a directory where binaries are stored. An empty string disables the disk layer
+  void setDirectory(std::string directory);
+
+  /// @brief Returns true if binaries are stored on disk, i.e. a directory is set
+  bool isDiskCacheEnabled() const;
+
+  /// @brief Returns a stable hash of a shader source which can be passed to computeKey()
+  static uint64_t hashSource(const char* source);
+
+  /// @brief Computes the key of a program from the types and the source hashes of its shaders
+  uint64_t computeKey(const std::vector<std::pair<GLenum, uint64_t>>& shaders) const;
+
+  /// @brief Looks up the key in memory and then on disk
+  /// @param outShouldStore Set on a miss if the binary of the program should be retrieved after
+  /// linking and passed to insert(): when the disk layer is enabled or when the program has been
+  /// linked before
+  bool find(uint64_t key, Binary& outBinary, bool* outShouldStore = nullptr);
+  void insert(uint64_t key, Binary binary);
+  /// @brief Removes an entry which was rejected by the driver, both from memory and from disk
+  void remove(uint64_t key);
+
+  uint32_t getNumHits() const {
+    return numHits_;
+  }
+  uint32_t getNumMisses() const {
+    return numMisses_;
+  }
+  size_t getNumEntries() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+  }
+
+ private:
+  struct Entry {
+    uint64_t key = 0;
+    // empty for programs which have been linked only once
+    Binary binary;
+  };
+
+  std::string getFileName(const std::string& directory, uint64_t key) const;
+  bool load(const std::string& directory, uint64_t key, Binary& outBinary) const;
+  void store(const std::string& directory, uint64_t key, const Binary& binary) const;
+  // adds the entry as the most recently used one, replacing an entry with the same key, and evicts
+  // the least recently used ones. Expects mutex_ to be locked
+  void addLocked(Entry entry);
+
+ private:
+  const std::string driverId_;
+  const size_t maxNumEntries_;
+  std::string directory_;
+  mutable std::mutex mutex_;
+  // the most recently used entries are at the front
+  std::list<Entry> entries_;
+  std::unordered_map<uint64_t, std::list<Entry>::iterator> index_;
+  std::atomic<uint32_t> numHits_{0};
+  std::atomic<uint32_t> numMisses_{0};
+};
+
+} // namespace opengl
+} // namespace igl
@@ -21,6 +21,7 @@
 #include <igl/opengl/SamplerState.h>
 #include <igl/opengl/Shader.h>
 #include <igl/opengl/Texture.h>
+#include <igl/opengl/TransientAllocator.h>
 #include <igl/opengl/VertexArrayObject.h>
 #include <igl/opengl/VertexInputState.h>
 
@@ -278,6 +279,46 @@ void RenderCommandAdapter::drawElements(GLenum mode,
   didDraw();
 }
 
+void RenderCommandAdapter::drawArraysInstanced(GLenum mode,
+                                               GLint first,
+                                               GLsizei count,
+                                               GLsizei instanceCount,
+                                               GLuint baseInstance) {
+  willDraw();
+  if (baseInstance != 0) {
+    getContext().drawArraysInstancedBaseInstance(
+        toMockWireframeMode(mode), first, count, instanceCount, baseInstance);
+  } else {
+    getContext().drawArraysInstanced(toMockWireframeMode(mode), first, count, instanceCount);
+  }
+  didDraw();
+}
+
+void RenderCommandAdapter::drawElementsInstanced(GLenum mode,
+                                                 GLsizei indexCount,
+                                                 GLenum indexType,
+                                                 Buffer& indexBuffer,
+                                                 const GLvoid* indexOffset,
+                                                 GLsizei instanceCount,
+                                                 GLint baseVertex,
+                                                 GLuint baseInstance) {
+  willDraw();
+  bindBufferWithShaderStorageBufferOverride(indexBuffer, GL_ELEMENT_ARRAY_BUFFER);
+  if (baseVertex != 0 || baseInstance != 0) {
+    getContext().drawElementsInstancedBaseVertexBaseInstance(toMockWireframeMode(mode),
+                                                             indexCount,
+                                                             indexType,
+                                                             indexOffset,
+                                                             instanceCount,
+                                                             baseVertex,
+                                                             baseInstance);
+  } else {
+    getContext().drawElementsInstanced(
+        toMockWireframeMode(mode), indexCount, indexType, indexOffset, instanceCount);
+  }
+  didDraw();
+}
+
 void RenderCommandAdapter::drawElementsIndirect(GLenum mode,
                                                 GLenum indexType,
                                                 Buffer& indexBuffer,
@@ -317,6 +358,12 @@ void RenderCommandAdapter::endEncoding() {
 
 void RenderCommandAdapter::willDraw() {
   Result ret;
+
+  // the data of transient allocations is written by the CPU until a draw call or dispatch uses it
+  if (auto* transientAllocator = getContext().getTransientAllocator()) {
+    transientAllocator->flush();
+  }
+
   auto pipelineState = static_cast<RenderPipelineState*>(pipelineState_.get());
 
   // Vertex Buffers must be bound before pipelineState->bind()
@@ -100,6 +100,19 @@ class RenderCommandAdapter final : public WithContext {
                     GLenum indexType,
                     Buffer& indexBuffer,
                     const GLvoid* indexOffset);
+  void drawArraysInstanced(GLenum mode,
+                           GLint first,
+                           GLsizei count,
+                           GLsizei instanceCount,
+                           GLuint baseInstance);
+  void drawElementsInstanced(GLenum mode,
+                             GLsizei indexCount,
+                             GLenum indexType,
+                             Buffer& indexBuffer,
+                             const GLvoid* indexOffset,
+                             GLsizei instanceCount,
+                             GLint baseVertex,
+                             GLuint baseInstance);
   void drawElementsIndirect(GLenum mode,
                             GLenum indexType,
                             Buffer& indexBuffer,
@@ -25,7 +25,9 @@
 namespace igl {
 namespace opengl {
 RenderCommandEncoder::RenderCommandEncoder(const std::shared_ptr<CommandBuffer>& commandBuffer) :
-  IRenderCommandEncoder(commandBuffer), WithContext(commandBuffer->getContext()) {}
+  IRenderCommandEncoder(commandBuffer),
+  WithContext(commandBuffer->getContext()),
+  commandBuffer_(*commandBuffer) {}
 
 std::unique_ptr<RenderCommandEncoder> RenderCommandEncoder::create(
     const std::shared_ptr<CommandBuffer>& commandBuffer,
@@ -47,6 +49,9 @@ RenderCommandEncoder::~RenderCommandEncoder() = default;
 void RenderCommandEncoder::beginEncoding(const RenderPassDesc& renderPass,
                                          const std::shared_ptr<IFramebuffer>& framebuffer,
                                          Result* outResult) {
+  // the timing of the render pass includes the clears of its attachments
+  commandBuffer_.beginTimestampScope("RenderCommandEncoder");
+
   // Save caller state
   auto& context = getContext();
 
@@ -149,6 +154,8 @@ void RenderCommandEncoder::endEncoding() {
       }
     }
   }
+
+  commandBuffer_.endTimestampScope();
 }
 
 void RenderCommandEncoder::pushDebugGroupLabel(const std::string& label,
@@ -156,6 +163,7 @@ void RenderCommandEncoder::pushDebugGroupLabel(const std::string& label,
   IGL_ASSERT(adapter_);
   IGL_ASSERT(!label.empty());
   getContext().pushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, 0, label.length(), label.c_str());
+  commandBuffer_.beginTimestampScope(label);
 }
 
 void RenderCommandEncoder::insertDebugEventLabel(const std::string& label,
@@ -172,6 +180,7 @@ void RenderCommandEncoder::insertDebugEventLabel(const std::string& label,
 
 void RenderCommandEncoder::popDebugGroupLabel() const {
   IGL_ASSERT(adapter_);
+  commandBuffer_.endTimestampScope();
   getContext().popDebugGroup();
 }
 
@@ -328,6 +337,46 @@ void RenderCommandEncoder::drawIndexed(PrimitiveType primitiveType,
   }
 }
 
+void RenderCommandEncoder::drawInstanced(PrimitiveType primitiveType,
+                                         size_t vertexStart,
+                                         size_t vertexCount,
+                                         uint32_t instanceCount,
+                                         uint32_t baseInstance) {
+  if (IGL_VERIFY(adapter_)) {
+    getCommandBuffer().incrementCurrentDrawCount();
+    auto mode = toGlPrimitive(primitiveType);
+    adapter_->drawArraysInstanced(mode,
+                                  (GLsizei)vertexStart,
+                                  (GLsizei)vertexCount,
+                                  (GLsizei)instanceCount,
+                                  (GLuint)baseInstance);
+  }
+}
+
+void RenderCommandEncoder::drawIndexedInstanced(PrimitiveType primitiveType,
+                                                size_t indexCount,
+                                                IndexFormat indexFormat,
+                                                IBuffer& indexBuffer,
+                                                size_t indexBufferOffset,
+                                                uint32_t instanceCount,
+                                                int32_t baseVertex,
+                                                uint32_t baseInstance) {
+  if (IGL_VERIFY(adapter_)) {
+    getCommandBuffer().incrementCurrentDrawCount();
+    auto mode = toGlPrimitive(primitiveType);
+    auto type = toGlType(indexFormat);
+    auto offset = reinterpret_cast<void*>(indexBufferOffset);
+    adapter_->drawElementsInstanced(mode,
+                                    (GLsizei)indexCount,
+                                    type,
+                                    (Buffer&)indexBuffer,
+                                    offset,
+                                    (GLsizei)instanceCount,
+                                    (GLint)baseVertex,
+                                    (GLuint)baseInstance);
+  }
+}
+
 void RenderCommandEncoder::drawIndexedIndirect(PrimitiveType primitiveType,
                                                IndexFormat indexFormat,
                                                IBuffer& indexBuffer,
@@ -74,6 +74,19 @@ class RenderCommandEncoder final : public IRenderCommandEncoder, public WithCont
                    IndexFormat indexFormat,
                    IBuffer& indexBuffer,
                    size_t indexBufferOffset) override;
+  void drawInstanced(PrimitiveType primitiveType,
+                     size_t vertexStart,
+                     size_t vertexCount,
+                     uint32_t instanceCount,
+                     uint32_t baseInstance = 0) override;
+  void drawIndexedInstanced(PrimitiveType primitiveType,
+                            size_t indexCount,
+                            IndexFormat indexFormat,
+                            IBuffer& indexBuffer,
+                            size_t indexBufferOffset,
+                            uint32_t instanceCount,
+                            int32_t baseVertex = 0,
+                            uint32_t baseInstance = 0) override;
   void drawIndexedIndirect(PrimitiveType primitiveType,
                            IndexFormat indexFormat,
                            IBuffer& indexBuffer,
@@ -99,6 +112,7 @@ class RenderCommandEncoder final : public IRenderCommandEncoder, public WithCont
 
  private:
   std::unique_ptr<RenderCommandAdapter> adapter_;
+  const CommandBuffer& commandBuffer_;
   bool scissorEnabled_ = false;
   std::shared_ptr<igl::opengl::Framebuffer> resolveFramebuffer_;
   std::shared_ptr<igl::opengl::Framebuffer> framebuffer_;
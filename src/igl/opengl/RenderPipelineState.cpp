@@ -113,6 +113,14 @@ Result RenderPipelineState::create(const RenderPipelineDesc& desc) {
     return Result(Result::Code::ArgumentInvalid, "Missing required shader module(s).");
   }
 
+  if (!desc.specializationConstants.empty()) {
+    Result result;
+    shaderStages_ = shaderStages_->getSpecialization(desc.specializationConstants, &result);
+    if (!result.isOk()) {
+      return result;
+    }
+  }
+
   reflection_ = std::make_shared<RenderPipelineReflection>(getContext(), *shaderStages_);
 
   mFramebufferDesc = desc.targetDesc;
@@ -291,6 +299,12 @@ void RenderPipelineState::bindVertexAttributes(size_t bufferIndex, size_t buffer
         attribute.normalized,
         attribute.stride,
         reinterpret_cast<const char*>(attribute.bufferOffset) + bufferOffset);
+
+    if (attribute.divisor != 0 &&
+        IGL_VERIFY(getContext().deviceFeatures().hasFeature(DeviceFeatures::DrawInstanced))) {
+      instancedAttributesLocations_.push_back(location);
+      getContext().vertexAttribDivisor(location, attribute.divisor);
+    }
   }
 }
 
@@ -299,6 +313,11 @@ void RenderPipelineState::unbindVertexAttributes() {
     getContext().disableVertexAttribArray(l);
   }
   activeAttributesLocations_.clear();
+  // the divisor is not part of the attribute array state which is reset by disabling it
+  for (const auto& l : instancedAttributesLocations_) {
+    getContext().vertexAttribDivisor(l, 0);
+  }
+  instancedAttributesLocations_.clear();
 }
 
 // Looks up the location the of the specified texture unit via its name,
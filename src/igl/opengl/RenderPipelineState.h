@@ -84,6 +84,8 @@ class RenderPipelineState final : public WithContext, public IRenderPipelineStat
   std::unordered_map<int, size_t> uniformBlockBindingMap_;
   std::array<GLboolean, 4> colorMask_ = {GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE};
   std::vector<int> activeAttributesLocations_;
+  // locations of the active attributes with a non-zero divisor
+  std::vector<int> instancedAttributesLocations_;
   BlendMode blendMode_ = {GL_FUNC_ADD, GL_FUNC_ADD, GL_ONE, GL_ZERO, GL_ONE, GL_ZERO};
   CullMode cullMode_ = igl::CullMode::Back;
   WindingMode frontFaceWinding_ = igl::WindingMode::CounterClockwise;
@@ -9,9 +9,11 @@
 
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <igl/opengl/CommandBuffer.h>
 #include <igl/opengl/Device.h>
 #include <igl/opengl/Errors.h>
+#include <iterator>
 #include <string>
 
 #if IGL_SHADER_DUMP
@@ -22,10 +24,65 @@
 namespace igl {
 namespace opengl {
 
+namespace {
+
+std::string getSpecializationConstantValue(const SpecializationConstant& constant) {
+  char value[32] = {};
+
+  switch (constant.type) {
+  case SpecializationConstantType::Bool:
+    return constant.value ? "true" : "false";
+  case SpecializationConstantType::Int:
+    snprintf(value, sizeof(value), "%d", static_cast<int32_t>(constant.value));
+    break;
+  case SpecializationConstantType::UInt:
+    snprintf(value, sizeof(value), "%uu", constant.value);
+    break;
+  case SpecializationConstantType::Float: {
+    float f = 0.0f;
+    memcpy(&f, &constant.value, sizeof(f));
+    snprintf(value, sizeof(value), "%.9g", f);
+    // GLSL needs a decimal point to treat the literal as a float
+    if (!strpbrk(value, ".eEn")) {
+      return std::string(value) + ".0";
+    }
+    break;
+  }
+  }
+
+  return value;
+}
+
+// The defines go right after the #version directive, which has to come first
+std::string injectSpecializationConstants(const std::string& source,
+                                          const std::vector<SpecializationConstant>& constants) {
+  std::string defines;
+  for (const auto& constant : constants) {
+    defines += "#define " + constant.name + " " + getSpecializationConstantValue(constant) + "\n";
+  }
+
+  const size_t versionPos = source.find("#version");
+  if (versionPos == std::string::npos) {
+    return defines + source;
+  }
+
+  const size_t endOfLine = source.find('\n', versionPos);
+  if (endOfLine == std::string::npos) {
+    return source + "\n" + defines;
+  }
+
+  return source.substr(0, endOfLine + 1) + defines + source.substr(endOfLine + 1);
+}
+
+} // namespace
+
 ShaderStages::ShaderStages(const ShaderStagesDesc& desc, IContext& context) :
   IShaderStages(desc), WithContext(context), programID_(0) {}
 
 ShaderStages::~ShaderStages() {
+  if (pendingProgram_.programID != 0) {
+    getContext().deleteProgram(pendingProgram_.programID);
+  }
   if (programID_ != 0) {
     getContext().deleteProgram(programID_);
     programID_ = 0;
@@ -49,15 +106,35 @@ void ShaderStages::createRenderProgram(Result* result) {
 
   const auto& vertexShader = static_cast<ShaderModule&>(*getVertexModule());
   const auto& fragmentShader = static_cast<ShaderModule&>(*getFragmentModule());
-  GLuint vertexShaderID = vertexShader.getShaderID();
-  GLuint fragmentShaderID = fragmentShader.getShaderID();
 
-  if (vertexShaderID == 0 || fragmentShaderID == 0) {
+  if (vertexShader.getShaderID() == 0 || fragmentShader.getShaderID() == 0) {
     // we need valid shaders in order to link the program
     Result::setResult(result, Result::Code::ArgumentInvalid, "Missing required shader stages");
     return;
   }
 
+  linkProgram({&vertexShader, &fragmentShader}, result);
+}
+
+void ShaderStages::createComputeProgram(Result* result) {
+  if (!IGL_VERIFY(getComputeModule())) {
+    // we need a vertex shader and a fragment shader in order to link the program
+    Result::setResult(result, Result::Code::ArgumentInvalid, "Missing required compute shader");
+    return;
+  }
+
+  const auto& shader = static_cast<ShaderModule&>(*getComputeModule());
+
+  if (shader.getShaderID() == 0) {
+    // we need valid shaders in order to link the program
+    Result::setResult(result, Result::Code::ArgumentInvalid, "Missing required compute stage");
+    return;
+  }
+
+  linkProgram({&shader}, result);
+}
+
+void ShaderStages::linkProgram(const std::vector<const ShaderModule*>& shaders, Result* result) {
   // always create a new temp program ID
   // we'll set or update this object's program ID after the linking succeeds
   // otherwise we won't modify this program, so we can still use it
@@ -67,79 +144,114 @@ void ShaderStages::createRenderProgram(Result* result) {
     return;
   }
 
-  // attach the shaders and link them
-  getContext().attachShader(programID, vertexShaderID);
-  getContext().attachShader(programID, fragmentShaderID);
-  getContext().linkProgram(programID);
+  ProgramBinaryCache* cache = getContext().getProgramBinaryCache();
+  uint64_t cacheKey = 0;
+  if (cache) {
+    std::vector<std::pair<GLenum, uint64_t>> sources;
+    sources.reserve(shaders.size());
+    for (const ShaderModule* shader : shaders) {
+      sources.emplace_back(shader->getShaderType(), shader->getSourceHash());
+    }
+    cacheKey = cache->computeKey(sources);
+  }
+  bool storeBinary = false;
+  const bool isCached = cache && loadProgramBinary(*cache, programID, cacheKey, storeBinary);
 
-  // detach the shaders now that they've been linked
-  getContext().detachShader(programID, vertexShaderID);
-  getContext().detachShader(programID, fragmentShaderID);
+  if (!isCached) {
+    if (storeBinary) {
+      // the hint is not free: drivers can do extra work when linking retrievable programs
+      getContext().programParameteri(programID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
 
-  // check to see if the linking succeeded
-  GLint status;
-  getContext().getProgramiv(programID, GL_LINK_STATUS, &status);
-  if (status == GL_FALSE) {
-    // Get the size of log
-    GLsizei logSize = 0;
-    getContext().getProgramiv(programID, GL_INFO_LOG_LENGTH, &logSize);
+    // attach the shaders and link them
+    for (const ShaderModule* shader : shaders) {
+      getContext().attachShader(programID, shader->getShaderID());
+    }
+    getContext().linkProgram(programID);
 
-    // Pre-allocate vector for storage
-    std::vector<GLchar> log(logSize);
-    getContext().getProgramInfoLog(programID, logSize, nullptr, log.data());
+    // detach the shaders now that they've been linked
+    for (const ShaderModule* shader : shaders) {
+      getContext().detachShader(programID, shader->getShaderID());
+    }
+  }
 
-    // Create actual string from it
-    const std::string errorLog(log.begin(), log.end());
-    IGL_LOG_ERROR("failed to link shaders:\n%s\n", errorLog.c_str());
+  // the link status is checked by finishLinking(), so several programs can be linked concurrently
+  pendingProgram_.programID = programID;
+  pendingProgram_.cacheKey = cacheKey;
+  pendingProgram_.storeBinary = storeBinary;
 
-    getContext().deleteProgram(programID);
-    Result::setResult(result, Result::Code::RuntimeError, errorLog);
-    return;
+  Result::setResult(result, Result::Code::Ok);
+}
+
+bool ShaderStages::loadProgramBinary(ProgramBinaryCache& cache,
+                                     GLuint programID,
+                                     uint64_t key,
+                                     bool& outShouldStore) {
+  ProgramBinaryCache::Binary binary;
+  if (!cache.find(key, binary, &outShouldStore)) {
+    return false;
   }
 
-  // now that the program successfully linked, set the program
-  if (programID_ != 0) {
-    getContext().deleteProgram(programID_);
+  getContext().programBinary(
+      programID, binary.format, binary.data.data(), static_cast<GLsizei>(binary.data.size()));
+
+  GLint status = GL_FALSE;
+  getContext().getProgramiv(programID, GL_LINK_STATUS, &status);
+  if (status == GL_FALSE) {
+    // the driver rejects binaries produced by other builds of itself; link from the sources
+    IGL_LOG_INFO("Program binary was rejected by the driver, linking from sources\n");
+    cache.remove(key);
+    outShouldStore = true;
+    return false;
   }
-  programID_ = programID;
 
-  Result::setResult(result, Result::Code::Ok);
+  return true;
 }
 
-void ShaderStages::createComputeProgram(Result* result) {
-  if (!IGL_VERIFY(getComputeModule())) {
-    // we need a vertex shader and a fragment shader in order to link the program
-    Result::setResult(result, Result::Code::ArgumentInvalid, "Missing required compute shader");
+void ShaderStages::storeProgramBinary(ProgramBinaryCache& cache, GLuint programID, uint64_t key) {
+  GLint length = 0;
+  getContext().getProgramiv(programID, GL_PROGRAM_BINARY_LENGTH, &length);
+  if (length <= 0) {
     return;
   }
 
-  const auto& shader = static_cast<ShaderModule&>(*getComputeModule());
-
-  GLuint shaderID = shader.getShaderID();
+  ProgramBinaryCache::Binary binary;
+  binary.data.resize(length);
 
-  if (shaderID == 0) {
-    // we need valid shaders in order to link the program
-    Result::setResult(result, Result::Code::ArgumentInvalid, "Missing required compute stage");
+  GLsizei size = 0;
+  getContext().getProgramBinary(programID, length, &size, &binary.format, binary.data.data());
+  if (size <= 0) {
     return;
   }
+  binary.data.resize(size);
 
-  // always create a new temp program ID
-  // we'll set or update this object's program ID after the linking succeeds
-  // otherwise we won't modify this program, so we can still use it
-  GLuint programID = getContext().createProgram();
-  if (programID == 0) {
-    Result::setResult(result, Result::Code::RuntimeError, "Failed to create compute GL program");
-    return;
+  cache.insert(key, std::move(binary));
+}
+
+Result ShaderStages::link() {
+  Result result;
+  if (getType() == ShaderStagesType::Render) {
+    createRenderProgram(&result);
+  } else if (getType() == ShaderStagesType::Compute) {
+    createComputeProgram(&result);
+  } else {
+    IGL_ASSERT_NOT_REACHED();
   }
 
-  // attach the shaders and link them
-  getContext().attachShader(programID, shaderID);
-  getContext().linkProgram(programID);
+  return result;
+}
+
+Result ShaderStages::finishLinking() {
+  const PendingProgram pending = pendingProgram_;
+  pendingProgram_ = {};
+
+  if (!IGL_VERIFY(pending.programID != 0)) {
+    return Result(Result::Code::InvalidOperation, "The program is not being linked");
+  }
 
-  // detach the shaders now that they've been linked
-  getContext().detachShader(programID, shaderID);
+  const GLuint programID = pending.programID;
 
-  // check to see if the linking succeeded
+  // check to see if the linking succeeded; this waits for the driver
   GLint status;
   getContext().getProgramiv(programID, GL_LINK_STATUS, &status);
   if (status == GL_FALSE) {
@@ -153,11 +265,16 @@ void ShaderStages::createComputeProgram(Result* result) {
 
     // Create actual string from it
     const std::string errorLog(log.begin(), log.end());
-    IGL_LOG_ERROR("failed to link compute shaders:\n%s\n", errorLog.c_str());
+    IGL_LOG_ERROR("failed to link %s:\n%s\n",
+                  getType() == ShaderStagesType::Compute ? "compute shaders" : "shaders",
+                  errorLog.c_str());
 
     getContext().deleteProgram(programID);
-    Result::setResult(result, Result::Code::RuntimeError, errorLog);
-    return;
+    return Result(Result::Code::RuntimeError, errorLog);
+  }
+
+  if (pending.storeBinary) {
+    storeProgramBinary(*getContext().getProgramBinaryCache(), programID, pending.cacheKey);
   }
 
   // now that the program successfully linked, set the program
@@ -166,21 +283,17 @@ void ShaderStages::createComputeProgram(Result* result) {
   }
   programID_ = programID;
 
-  Result::setResult(result, Result::Code::Ok);
+  return Result();
 }
 
 // link the given shaders into this shader program
 Result ShaderStages::create(const ShaderStagesDesc& /*desc*/) {
-  Result result;
-  if (getType() == ShaderStagesType::Render) {
-    createRenderProgram(&result);
-  } else if (getType() == ShaderStagesType::Compute) {
-    createComputeProgram(&result);
-  } else {
-    IGL_ASSERT_NOT_REACHED();
+  Result result = link();
+  if (!result.isOk()) {
+    return result;
   }
 
-  return result;
+  return finishLinking();
 }
 
 void ShaderStages::bind() {
@@ -191,10 +304,101 @@ void ShaderStages::unbind() {
   getContext().useProgram(0);
 }
 
+std::shared_ptr<ShaderStages> ShaderStages::getSpecialization(
+    const std::vector<SpecializationConstant>& constants,
+    Result* outResult) {
+  const auto it = specializations_.find(constants);
+  if (it != specializations_.end()) {
+    Result::setOk(outResult);
+    return it->second;
+  }
+
+  for (const auto& constant : constants) {
+    if (constant.name.empty()) {
+      Result::setResult(outResult,
+                        Result::Code::ArgumentInvalid,
+                        "OpenGL requires names for all specialization constants");
+      return nullptr;
+    }
+  }
+
+  // the sources are fetched from the driver, so they don't have to be kept around for this
+  auto specialize = [this, &constants](const std::shared_ptr<IShaderModule>& module,
+                                       Result* result) -> std::shared_ptr<IShaderModule> {
+    const GLuint shaderID = static_cast<const ShaderModule&>(*module).getShaderID();
+
+    GLint length = 0;
+    getContext().getShaderiv(shaderID, GL_SHADER_SOURCE_LENGTH, &length);
+    if (length <= 0) {
+      Result::setResult(result, Result::Code::RuntimeError, "Cannot get the shader source");
+      return nullptr;
+    }
+
+    std::vector<GLchar> source(length);
+    getContext().getShaderSource(shaderID, length, nullptr, source.data());
+
+    const std::string specializedSource =
+        injectSpecializationConstants(std::string(source.data()), constants);
+
+    auto specializedModule = std::make_shared<ShaderModule>(getContext(), module->info());
+    *result = specializedModule->create(
+        ShaderModuleDesc::fromStringInput(specializedSource.c_str(), module->info(), ""));
+
+    return result->isOk() ? specializedModule : nullptr;
+  };
+
+  Result result;
+  ShaderStagesDesc desc;
+
+  if (getType() == ShaderStagesType::Render) {
+    auto vertexModule = specialize(getVertexModule(), &result);
+    if (!result.isOk()) {
+      Result::setResult(outResult, std::move(result));
+      return nullptr;
+    }
+    auto fragmentModule = specialize(getFragmentModule(), &result);
+    if (!result.isOk()) {
+      Result::setResult(outResult, std::move(result));
+      return nullptr;
+    }
+    desc = ShaderStagesDesc::fromRenderModules(std::move(vertexModule), std::move(fragmentModule));
+  } else {
+    auto computeModule = specialize(getComputeModule(), &result);
+    if (!result.isOk()) {
+      Result::setResult(outResult, std::move(result));
+      return nullptr;
+    }
+    desc = ShaderStagesDesc::fromComputeModule(std::move(computeModule));
+  }
+
+  auto stages = std::make_shared<ShaderStages>(desc, getContext());
+  result = stages->create(desc);
+  if (!result.isOk()) {
+    Result::setResult(outResult, std::move(result));
+    return nullptr;
+  }
+
+  if (specializations_.size() >= kMaxCachedSpecializations) {
+    // forget the specializations which are only referenced by this cache
+    for (auto i = specializations_.begin(); i != specializations_.end();) {
+      i = i->second.use_count() == 1 ? specializations_.erase(i) : std::next(i);
+    }
+  }
+
+  specializations_.emplace(constants, stages);
+
+  Result::setOk(outResult);
+  return stages;
+}
+
 ShaderModule::ShaderModule(IContext& context, ShaderModuleInfo info) :
   WithContext(context), IShaderModule(std::move(info)) {}
 
 ShaderModule::~ShaderModule() {
+  if (getContext().isDestructionAllowed() && pendingShaderID_ != 0) {
+    getContext().deleteShader(pendingShaderID_);
+    pendingShaderID_ = 0;
+  }
   if (getContext().isDestructionAllowed() && shaderID_ != 0) {
     getContext().deleteShader(shaderID_);
     shaderID_ = 0;
@@ -203,6 +407,15 @@ ShaderModule::~ShaderModule() {
 
 // compile the shader from the given src shader code
 Result ShaderModule::create(const ShaderModuleDesc& desc) {
+  Result result = compile(desc);
+  if (!result.isOk()) {
+    return result;
+  }
+
+  return finishCompilation(desc);
+}
+
+Result ShaderModule::compile(const ShaderModuleDesc& desc) {
   if (desc.input.type == ShaderInputType::Binary) {
     IGL_ASSERT_NOT_IMPLEMENTED();
     return Result(Result::Code::Unimplemented);
@@ -272,7 +485,24 @@ Result ShaderModule::create(const ShaderModuleDesc& desc) {
   getContext().shaderSource(shaderID, 1, &src, nullptr);
   getContext().compileShader(shaderID);
 
-  // see if the compilation succeeded
+  // the compile status is checked by finishCompilation(), so several shaders can be compiled
+  // concurrently
+  pendingShaderID_ = shaderID;
+
+  return Result();
+}
+
+Result ShaderModule::finishCompilation(const ShaderModuleDesc& desc) {
+  const GLuint shaderID = pendingShaderID_;
+  pendingShaderID_ = 0;
+
+  if (!IGL_VERIFY(shaderID != 0)) {
+    return Result(Result::Code::InvalidOperation, "The shader is not being compiled");
+  }
+
+  const GLchar* src = (GLchar*)desc.input.source;
+
+  // see if the compilation succeeded; this waits for the driver
   GLint status;
   getContext().getShaderiv(shaderID, GL_COMPILE_STATUS, &status);
   if (status == GL_FALSE) {
@@ -307,6 +537,10 @@ Result ShaderModule::create(const ShaderModuleDesc& desc) {
   hash_ =
       std::hash<std::string_view>()(std::string_view(desc.input.source, strlen(desc.input.source)));
 
+  if (getContext().getProgramBinaryCache()) {
+    sourceHash_ = ProgramBinaryCache::hashSource(desc.input.source);
+  }
+
   return Result();
 }
 } // namespace opengl
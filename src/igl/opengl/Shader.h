@@ -14,7 +14,10 @@
 #include <igl/Shader.h>
 #include <igl/opengl/GLIncludes.h>
 #include <igl/opengl/IContext.h>
+#include <memory>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace igl {
 class ICommandBuffer;
@@ -27,6 +30,11 @@ class ShaderModule : public WithContext, public IShaderModule {
   ~ShaderModule() override;
   Result create(const ShaderModuleDesc& desc);
 
+  // create() is split into these two steps, so the driver can compile many shaders concurrently:
+  // compile() submits the source without waiting, and finishCompilation() waits for the status
+  Result compile(const ShaderModuleDesc& desc);
+  Result finishCompilation(const ShaderModuleDesc& desc);
+
   inline GLenum getShaderType() const {
     return shaderType_;
   }
@@ -39,6 +47,11 @@ class ShaderModule : public WithContext, public IShaderModule {
     return hash_;
   }
 
+  // Stable hash of the shader source; only computed when the program binary cache is available
+  inline uint64_t getSourceHash() const {
+    return sourceHash_;
+  }
+
   ShaderModule(IContext& context, ShaderModuleInfo info);
 
  private:
@@ -48,8 +61,14 @@ class ShaderModule : public WithContext, public IShaderModule {
   // The GL shader object ID
   GLuint shaderID_ = 0;
 
+  // The GL shader object which is being compiled
+  GLuint pendingShaderID_ = 0;
+
   // Hash of the shader source
   size_t hash_ = 0;
+
+  // Stable hash of the shader source, used by program binary cache keys
+  uint64_t sourceHash_ = 0;
 };
 
 class ShaderStages final : public IShaderStages, public WithContext {
@@ -61,6 +80,11 @@ class ShaderStages final : public IShaderStages, public WithContext {
 
   Result create(const ShaderStagesDesc& /*desc*/);
 
+  // create() is split into these two steps, so the driver can link many programs concurrently:
+  // link() submits the program without waiting, and finishLinking() waits for the status
+  Result link();
+  Result finishLinking();
+
   void bind();
   void unbind();
 
@@ -68,12 +92,43 @@ class ShaderStages final : public IShaderStages, public WithContext {
     return programID_;
   }
 
+  // Returns shader stages compiled from the same sources with the constants injected as #defines.
+  // Specializations are cached, so pipelines with the same constants share one program. At most
+  // kMaxCachedSpecializations specializations which are not used elsewhere are kept
+  std::shared_ptr<ShaderStages> getSpecialization(
+      const std::vector<SpecializationConstant>& constants,
+      Result* outResult);
+
  private:
   void createRenderProgram(Result* result);
   void createComputeProgram(Result* result);
 
+  void linkProgram(const std::vector<const ShaderModule*>& shaders, Result* result);
+
+  // Restores the program from the program binary cache. Returns false if it has to be linked, and
+  // sets `outShouldStore` if its binary should be stored once it is linked
+  bool loadProgramBinary(ProgramBinaryCache& cache,
+                         GLuint programID,
+                         uint64_t key,
+                         bool& outShouldStore);
+  void storeProgramBinary(ProgramBinaryCache& cache, GLuint programID, uint64_t key);
+
   // the GL shader program ID
   GLuint programID_;
+
+  struct PendingProgram {
+    // the program which is being linked
+    GLuint programID = 0;
+    uint64_t cacheKey = 0;
+    // the binary should be added to the program binary cache once the link succeeds
+    bool storeBinary = false;
+  };
+  PendingProgram pendingProgram_;
+
+  static constexpr size_t kMaxCachedSpecializations = 16;
+
+  std::unordered_map<std::vector<SpecializationConstant>, std::shared_ptr<ShaderStages>>
+      specializations_;
 };
 
 } // namespace opengl
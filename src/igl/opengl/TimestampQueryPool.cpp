@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/opengl/TimestampQueryPool.h>
+
+#include <algorithm>
+#include <igl/opengl/IContext.h>
+
+namespace igl {
+namespace opengl {
+
+TimestampQueryPool::TimestampQueryPool(IContext& context, uint32_t queryCount) :
+  WithContext(context), queries_(queryCount, 0), isIssued_(queryCount, false) {
+  getContext().genQueries(static_cast<GLsizei>(queries_.size()), queries_.data());
+}
+
+TimestampQueryPool::~TimestampQueryPool() {
+  getContext().deleteQueries(static_cast<GLsizei>(queries_.size()), queries_.data());
+}
+
+uint32_t TimestampQueryPool::getQueryCount() const {
+  return static_cast<uint32_t>(queries_.size());
+}
+
+bool TimestampQueryPool::getResults(uint32_t firstQuery,
+                                    uint32_t queryCount,
+                                    uint64_t* outTimestampsNs) const {
+  if (!IGL_VERIFY(firstQuery + queryCount <= queries_.size())) {
+    return false;
+  }
+
+  // check the last query first: queries complete in order
+  for (uint32_t i = queryCount; i-- > 0;) {
+    if (!isIssued_[firstQuery + i]) {
+      return false;
+    }
+    GLint isAvailable = GL_FALSE;
+    getContext().getQueryObjectiv(
+        queries_[firstQuery + i], GL_QUERY_RESULT_AVAILABLE, &isAvailable);
+    if (isAvailable == GL_FALSE) {
+      return false;
+    }
+  }
+
+  for (uint32_t i = 0; i != queryCount; i++) {
+    GLuint64 timestamp = 0;
+    getContext().getQueryObjectui64v(queries_[firstQuery + i], GL_QUERY_RESULT, &timestamp);
+    outTimestampsNs[i] = timestamp;
+  }
+
+  return true;
+}
+
+void TimestampQueryPool::reset() {
+  std::fill(isIssued_.begin(), isIssued_.end(), false);
+  resetScopes();
+}
+
+void TimestampQueryPool::queryCounter(uint32_t query) {
+  if (!IGL_VERIFY(query < queries_.size())) {
+    return;
+  }
+  getContext().queryCounter(queries_[query], GL_TIMESTAMP);
+  isIssued_[query] = true;
+}
+
+} // namespace opengl
+} // namespace igl
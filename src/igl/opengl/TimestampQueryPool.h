@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <igl/TimestampQueryPool.h>
+#include <igl/opengl/GLIncludes.h>
+#include <igl/opengl/WithContext.h>
+#include <vector>
+
+namespace igl {
+namespace opengl {
+
+class TimestampQueryPool final : public WithContext, public ITimestampQueryPool {
+ public:
+  TimestampQueryPool(IContext& context, uint32_t queryCount);
+  ~TimestampQueryPool() override;
+
+  [[nodiscard]] uint32_t getQueryCount() const override;
+  [[nodiscard]] bool getResults(uint32_t firstQuery,
+                                uint32_t queryCount,
+                                uint64_t* outTimestampsNs) const override;
+
+  void reset();
+  void queryCounter(uint32_t query);
+
+ private:
+  std::vector<GLuint> queries_;
+  // GL queries can only be read back after they have been issued at least once
+  std::vector<bool> isIssued_;
+};
+
+} // namespace opengl
+} // namespace igl
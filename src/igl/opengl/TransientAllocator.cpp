@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/opengl/TransientAllocator.h>
+
+#include <algorithm>
+
+#include <igl/opengl/Buffer.h>
+#include <igl/opengl/IContext.h>
+
+namespace igl {
+namespace opengl {
+
+namespace {
+enum StreamIndex : size_t {
+  kStream_UniformBlock = 0,
+  kStream_Attribute = 1,
+};
+} // namespace
+
+TransientAllocator::TransientAllocator(IContext& context, size_t bufferSize) :
+  WithContext(context), bufferSize_(bufferSize) {
+  streams_[kStream_UniformBlock].type = BufferDesc::BufferTypeBits::Uniform;
+  streams_[kStream_Attribute].type = BufferDesc::BufferTypeBits::Vertex;
+
+  // allocations can be bound with glBindBufferRange()
+#ifdef GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT
+  if (context.deviceFeatures().hasFeature(DeviceFeatures::UniformBlocks)) {
+    GLint alignment = 0;
+    context.getIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    alignment_ = std::max(alignment_, static_cast<size_t>(alignment));
+  }
+#endif
+}
+
+TransientAllocator::~TransientAllocator() = default;
+
+TransientAllocation TransientAllocator::allocate(BufferDesc::BufferType type,
+                                                 size_t size,
+                                                 Result* outResult) {
+  if (type == 0 || size == 0) {
+    Result::setResult(outResult, Result::Code::ArgumentInvalid, "Invalid type or size");
+    return {};
+  }
+
+  // storage buffers are bound with glBindBufferBase(), which cannot bind an offset
+  if (type & BufferDesc::BufferTypeBits::Storage) {
+    Result::setResult(outResult, Result::Code::Unsupported, "Unsupported buffer type");
+    return {};
+  }
+
+  // the same precedence as ArrayBuffer::initialize()
+  const StreamIndex streamIndex = (type & BufferDesc::BufferTypeBits::Uniform)
+                                      ? kStream_UniformBlock
+                                      : kStream_Attribute;
+
+  if (streamIndex == kStream_UniformBlock &&
+      !getContext().deviceFeatures().hasFeature(DeviceFeatures::UniformBlocks)) {
+    Result::setResult(outResult, Result::Code::Unsupported, "Unsupported buffer type");
+    return {};
+  }
+
+  Stream& stream = streams_[streamIndex];
+
+  for (;;) {
+    if (stream.currentPage == stream.pages.size()) {
+      const bool isUniformBlock = streamIndex == kStream_UniformBlock;
+      const BufferDesc desc(stream.type,
+                            nullptr,
+                            std::max(bufferSize_, size),
+                            ResourceStorage::Shared,
+                            isUniformBlock ? BufferDesc::BufferAPIHintBits::UniformBlock : 0,
+                            "Buffer: transient");
+      Page page;
+      page.buffer = isUniformBlock ? std::make_shared<UniformBlockBuffer>(getContext(), desc.hint)
+                                   : std::make_shared<ArrayBuffer>(getContext(), desc.hint);
+      Result result;
+      page.buffer->initialize(desc, &result);
+      if (!IGL_VERIFY(result.isOk())) {
+        Result::setResult(outResult, std::move(result));
+        return {};
+      }
+      page.data.resize(desc.length);
+      stream.pages.push_back(std::move(page));
+    }
+
+    Page& page = stream.pages[stream.currentPage];
+    const size_t offset = (page.usedSize + alignment_ - 1) / alignment_ * alignment_;
+
+    if (offset + size <= page.data.size()) {
+      page.usedSize = offset + size;
+      Result::setOk(outResult);
+      return TransientAllocation{page.data.data() + offset, page.buffer, offset, size};
+    }
+
+    // continue in the next buffer; this one is uploaded before the next draw call or dispatch
+    stream.currentPage++;
+  }
+}
+
+void TransientAllocator::flush() {
+  for (Stream& stream : streams_) {
+    flush(stream);
+  }
+}
+
+void TransientAllocator::flush(Stream& stream) {
+  const size_t numUsedPages = std::min(stream.pages.size(), stream.currentPage + 1);
+  for (size_t i = 0; i != numUsedPages; i++) {
+    Page& page = stream.pages[i];
+    if (page.usedSize > page.flushedSize) {
+      page.buffer->upload(page.data.data() + page.flushedSize,
+                          BufferRange(page.usedSize - page.flushedSize, page.flushedSize));
+      page.flushedSize = page.usedSize;
+    }
+  }
+}
+
+void TransientAllocator::endFrame() {
+  for (Stream& stream : streams_) {
+    for (Page& page : stream.pages) {
+      if (page.usedSize) {
+        page.buffer->orphan();
+      }
+      page.usedSize = 0;
+      page.flushedSize = 0;
+    }
+    stream.currentPage = 0;
+  }
+}
+
+} // namespace opengl
+} // namespace igl
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include <igl/Buffer.h>
+#include <igl/opengl/WithContext.h>
+
+namespace igl {
+namespace opengl {
+
+class ArrayBuffer;
+
+// Linear allocator behind Device::allocateTransient(). Allocations are bump-allocated from CPU
+// memory which mirrors a set of GL buffers; the data written since the last draw call or dispatch
+// is uploaded right before the next one. At the end of a frame, the buffers are orphaned so that
+// the next frame can reuse them without waiting for the GPU. Storage buffers are not supported
+// because their bindings ignore offsets.
+class TransientAllocator final : public WithContext {
+ public:
+  TransientAllocator(IContext& context, size_t bufferSize);
+  ~TransientAllocator() override;
+
+  TransientAllocation allocate(BufferDesc::BufferType type, size_t size, Result* outResult);
+
+  // Uploads the data of the allocations made since the last flush
+  void flush();
+
+  // Orphans all buffers used in the current frame and starts a new frame
+  void endFrame();
+
+ private:
+  struct Page {
+    std::shared_ptr<ArrayBuffer> buffer;
+    std::vector<uint8_t> data;
+    size_t usedSize = 0;
+    size_t flushedSize = 0;
+  };
+  // GL buffers are bound according to their type, so every kind of binding has its own buffers
+  struct Stream {
+    BufferDesc::BufferType type = 0;
+    std::vector<Page> pages;
+    size_t currentPage = 0;
+  };
+
+  void flush(Stream& stream);
+
+  const size_t bufferSize_;
+  size_t alignment_ = 16;
+  std::array<Stream, 2> streams_;
+};
+
+} // namespace opengl
+} // namespace igl
@@ -303,6 +303,9 @@ Result VertexInputState::create(const VertexInputStateDesc& desc) {
     attribInfo.name = desc.attributes[i].name;
     attribInfo.stride = desc.inputBindings[bufferIndex].stride;
     attribInfo.bufferOffset = desc.attributes[i].offset;
+    if (desc.inputBindings[bufferIndex].sampleFunction == VertexSampleFunction::Instance) {
+      attribInfo.divisor = static_cast<GLuint>(desc.inputBindings[bufferIndex].sampleRate);
+    }
 
     toOGLAttribute(desc.attributes[i],
                    attribInfo.numComponents,
@@ -26,6 +26,8 @@ struct OGLAttribute {
   GLint numComponents = 0;
   GLenum componentType = GL_FLOAT;
   GLboolean normalized = false;
+  // non-zero for per-instance attributes: the number of instances sharing each element
+  GLuint divisor = 0;
 
   OGLAttribute() = default;
 };
@@ -496,6 +496,47 @@ TEST_F(FramebufferTest, blitFramebufferColor) {
   }
 }
 
+//
+// Framebuffer Request Bytes Test
+//
+// This test clears the framebuffer twice and requests asynchronous readbacks after each clear
+// without waiting for the GPU. Both requests are in flight at the same time and must return the
+// color of their respective clear.
+//
+TEST_F(FramebufferTest, RequestBytesColorAttachment) {
+  Result ret;
+
+  const auto rangeDesc = TextureRangeDesc::new2D(0, 0, OFFSCREEN_RT_WIDTH, OFFSCREEN_RT_HEIGHT);
+
+  std::vector<std::shared_ptr<IReadbackRequest>> requests;
+
+  for (const float clearValue : {0.501f, 0.0f}) {
+    cmdBuf_ = cmdQueue_->createCommandBuffer(cbDesc_, &ret);
+    ASSERT_TRUE(ret.isOk());
+    ASSERT_TRUE(cmdBuf_ != nullptr);
+
+    renderPass_.colorAttachments[0].clearColor = {clearValue, clearValue, clearValue, clearValue};
+
+    auto cmds = cmdBuf_->createRenderCommandEncoder(renderPass_, framebuffer_);
+    cmds->endEncoding();
+
+    cmdQueue_->submit(*cmdBuf_);
+
+    requests.push_back(framebuffer_->requestBytesColorAttachment(*cmdQueue_, 0, rangeDesc));
+    ASSERT_TRUE(requests.back() != nullptr);
+  }
+
+  auto pixels = std::vector<uint32_t>(OFFSCREEN_RT_WIDTH * OFFSCREEN_RT_HEIGHT);
+
+  requests[0]->getBytes(pixels.data());
+  ASSERT_EQ(pixels[0], 0x80808080);
+  ASSERT_EQ(pixels.back(), 0x80808080);
+
+  requests[1]->getBytes(pixels.data());
+  ASSERT_EQ(pixels[0], 0);
+  ASSERT_EQ(pixels.back(), 0);
+}
+
 //
 // Framebuffer Drawable Unbind Test
 //
@@ -236,5 +236,23 @@ TEST_F(HashTest, DepthStencilState1) {
             std::hash<DepthStencilStateDesc>()(descTwo));
 }
 
+//
+// SpecializationConstants1
+//
+// Check that the hash of specialization constants depends on their order and that equal
+// constants do not cancel each other out.
+//
+TEST_F(HashTest, SpecializationConstants1) {
+  using Hash = std::hash<std::vector<SpecializationConstant>>;
+
+  const SpecializationConstant a = SpecializationConstant::fromInt(0, "A", 1);
+  const SpecializationConstant b = SpecializationConstant::fromInt(1, "B", 2);
+
+  ASSERT_EQ(Hash()({a, b}), Hash()({a, b}));
+  ASSERT_NE(Hash()({a, b}), Hash()({b, a}));
+  ASSERT_NE(Hash()({a, a}), Hash()({}));
+  ASSERT_NE(Hash()({a, a, b}), Hash()({b}));
+}
+
 } // namespace tests
 } // namespace igl
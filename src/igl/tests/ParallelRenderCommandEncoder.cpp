@@ -0,0 +1,253 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "data/ShaderData.h"
+#include "data/TextureData.h"
+#include "util/Common.h"
+
+#include <igl/IGL.h>
+#include <igl/NameHandle.h>
+
+namespace igl {
+namespace tests {
+
+namespace {
+constexpr uint32_t kOffscreenWidth = 4;
+constexpr uint32_t kOffscreenHeight = 4;
+constexpr uint32_t kBackgroundColorHex = 0x80808080;
+constexpr float kBackgroundColor = 0.501f;
+} // namespace
+
+//
+// ParallelRenderCommandEncoderTest
+//
+// Unit tests for render passes recorded on several threads.
+//
+class ParallelRenderCommandEncoderTest : public ::testing::Test {
+ public:
+  // Set up common resources. This will create a device, a command queue, an offscreen framebuffer
+  // and a render pipeline which draws a textured full-screen quad
+  void SetUp() override {
+    setDebugBreakEnabled(false);
+
+    util::createDeviceAndQueue(iglDev_, cmdQueue_);
+    ASSERT_TRUE(iglDev_ != nullptr);
+    ASSERT_TRUE(cmdQueue_ != nullptr);
+
+    if (!iglDev_->hasFeature(DeviceFeatures::ParallelRenderEncoding)) {
+      GTEST_SKIP() << "Parallel render encoding is not supported";
+    }
+
+    Result ret;
+
+    const TextureDesc offscreenDesc =
+        TextureDesc::new2D(TextureFormat::RGBA_UNorm8,
+                           kOffscreenWidth,
+                           kOffscreenHeight,
+                           TextureDesc::TextureUsageBits::Sampled |
+                               TextureDesc::TextureUsageBits::Attachment);
+    auto offscreenTexture = iglDev_->createTexture(offscreenDesc, &ret);
+    ASSERT_TRUE(ret.isOk());
+    ASSERT_TRUE(offscreenTexture != nullptr);
+
+    FramebufferDesc framebufferDesc;
+    framebufferDesc.colorAttachments[0].texture = offscreenTexture;
+    framebuffer_ = iglDev_->createFramebuffer(framebufferDesc, &ret);
+    ASSERT_TRUE(ret.isOk());
+    ASSERT_TRUE(framebuffer_ != nullptr);
+
+    renderPass_.colorAttachments.resize(1);
+    renderPass_.colorAttachments[0].loadAction = LoadAction::Clear;
+    renderPass_.colorAttachments[0].storeAction = StoreAction::Store;
+    renderPass_.colorAttachments[0].clearColor = {
+        kBackgroundColor, kBackgroundColor, kBackgroundColor, kBackgroundColor};
+
+    std::unique_ptr<IShaderStages> stages;
+    util::createSimpleShaderStages(iglDev_, stages);
+    ASSERT_TRUE(stages != nullptr);
+
+    VertexInputStateDesc inputDesc;
+    inputDesc.attributes[0].format = VertexAttributeFormat::Float4;
+    inputDesc.attributes[0].offset = 0;
+    inputDesc.attributes[0].bufferIndex = data::shader::simplePosIndex;
+    inputDesc.attributes[0].name = data::shader::simplePos;
+    inputDesc.attributes[0].location = 0;
+    inputDesc.inputBindings[0].stride = sizeof(float) * 4;
+    inputDesc.attributes[1].format = VertexAttributeFormat::Float2;
+    inputDesc.attributes[1].offset = 0;
+    inputDesc.attributes[1].bufferIndex = data::shader::simpleUvIndex;
+    inputDesc.attributes[1].name = data::shader::simpleUv;
+    inputDesc.attributes[1].location = 1;
+    inputDesc.inputBindings[1].stride = sizeof(float) * 2;
+    inputDesc.numAttributes = inputDesc.numInputBindings = 2;
+    auto vertexInputState = iglDev_->createVertexInputState(inputDesc, &ret);
+    ASSERT_TRUE(ret.isOk());
+
+    RenderPipelineDesc pipelineDesc;
+    pipelineDesc.vertexInputState = vertexInputState;
+    pipelineDesc.shaderStages = std::move(stages);
+    pipelineDesc.targetDesc.colorAttachments.resize(1);
+    pipelineDesc.targetDesc.colorAttachments[0].textureFormat = offscreenTexture->getFormat();
+    pipelineDesc.fragmentUnitSamplerMap[0] = IGL_NAMEHANDLE(data::shader::simpleSampler);
+    pipelineDesc.cullMode = CullMode::Disabled;
+    pipelineState_ = iglDev_->createRenderPipeline(pipelineDesc, &ret);
+    ASSERT_TRUE(ret.isOk());
+    ASSERT_TRUE(pipelineState_ != nullptr);
+
+    sampler_ = iglDev_->createSamplerState(SamplerStateDesc(), &ret);
+    ASSERT_TRUE(ret.isOk());
+
+    texture_ = iglDev_->createTexture(
+        TextureDesc::new2D(TextureFormat::RGBA_UNorm8,
+                           kOffscreenWidth,
+                           kOffscreenHeight,
+                           TextureDesc::TextureUsageBits::Sampled),
+        &ret);
+    ASSERT_TRUE(ret.isOk());
+    texture_->upload(TextureRangeDesc::new2D(0, 0, kOffscreenWidth, kOffscreenHeight),
+                     data::texture::TEX_RGBA_GRAY_4x4);
+
+    // a full-screen quad drawn as a triangle strip
+    const float positions[] = {-1, -1, 0, 1, 1, -1, 0, 1, -1, 1, 0, 1, 1, 1, 0, 1};
+    const float uvs[] = {0, 0, 1, 0, 0, 1, 1, 1};
+    vb_ = iglDev_->createBuffer(
+        BufferDesc(BufferDesc::BufferTypeBits::Vertex, positions, sizeof(positions)), &ret);
+    ASSERT_TRUE(ret.isOk());
+    uv_ = iglDev_->createBuffer(BufferDesc(BufferDesc::BufferTypeBits::Vertex, uvs, sizeof(uvs)),
+                                &ret);
+    ASSERT_TRUE(ret.isOk());
+  }
+
+  // Binds all the state needed to draw the quad. The scissor rect limits drawing to one column
+  void bindState(IRenderCommandEncoder& encoder, uint32_t column) const {
+    encoder.bindRenderPipelineState(pipelineState_);
+    encoder.bindTexture(0, BindTarget::kFragment, texture_);
+    encoder.bindSamplerState(0, BindTarget::kFragment, sampler_);
+    encoder.bindBuffer(data::shader::simplePosIndex, BindTarget::kVertex, vb_, 0);
+    encoder.bindBuffer(data::shader::simpleUvIndex, BindTarget::kVertex, uv_, 0);
+    encoder.bindScissorRect({column, 0, 1, kOffscreenHeight});
+  }
+
+  std::vector<uint32_t> readPixels() const {
+    std::vector<uint32_t> pixels(kOffscreenWidth * kOffscreenHeight);
+    framebuffer_->copyBytesColorAttachment(
+        *cmdQueue_,
+        0,
+        pixels.data(),
+        TextureRangeDesc::new2D(0, 0, kOffscreenWidth, kOffscreenHeight));
+    return pixels;
+  }
+
+ protected:
+  std::shared_ptr<IDevice> iglDev_;
+  std::shared_ptr<ICommandQueue> cmdQueue_;
+  std::shared_ptr<IFramebuffer> framebuffer_;
+  RenderPassDesc renderPass_;
+  std::shared_ptr<IRenderPipelineState> pipelineState_;
+  std::shared_ptr<ISamplerState> sampler_;
+  std::shared_ptr<ITexture> texture_;
+  std::shared_ptr<IBuffer> vb_;
+  std::shared_ptr<IBuffer> uv_;
+};
+
+TEST_F(ParallelRenderCommandEncoderTest, EncodersDoNotShareState) {
+  Result ret;
+  auto cmdBuf = cmdQueue_->createCommandBuffer({}, &ret);
+  ASSERT_TRUE(ret.isOk());
+
+  auto parallelEncoder =
+      cmdBuf->createParallelRenderCommandEncoder(renderPass_, framebuffer_, &ret);
+  ASSERT_TRUE(ret.isOk());
+  ASSERT_TRUE(parallelEncoder != nullptr);
+
+  // every encoder covers one column; only the encoders for even columns draw anything
+  std::vector<std::unique_ptr<IRenderCommandEncoder>> encoders;
+  for (uint32_t i = 0; i != kOffscreenWidth; i++) {
+    encoders.push_back(parallelEncoder->createRenderCommandEncoder(&ret));
+    ASSERT_TRUE(ret.isOk());
+    ASSERT_TRUE(encoders.back() != nullptr);
+  }
+
+  std::vector<std::thread> threads;
+  for (uint32_t i = 0; i != kOffscreenWidth; i++) {
+    threads.emplace_back([this, &encoder = *encoders[i], i]() {
+      bindState(encoder, i);
+      if (i % 2 == 0) {
+        encoder.draw(PrimitiveType::TriangleStrip, 0, 4);
+      }
+      encoder.endEncoding();
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  parallelEncoder->endEncoding();
+
+  cmdQueue_->submit(*cmdBuf);
+  cmdBuf->waitUntilCompleted();
+
+  const auto pixels = readPixels();
+  for (uint32_t y = 0; y != kOffscreenHeight; y++) {
+    for (uint32_t x = 0; x != kOffscreenWidth; x++) {
+      const uint32_t expected = x % 2 == 0 ? data::texture::TEX_RGBA_GRAY_4x4[0]
+                                           : kBackgroundColorHex;
+      ASSERT_EQ(pixels[y * kOffscreenWidth + x], expected);
+    }
+  }
+}
+
+TEST_F(ParallelRenderCommandEncoderTest, ManyDrawsOnManyThreads) {
+  constexpr uint32_t kNumThreads = 8;
+  constexpr uint32_t kNumDraws = 5000;
+
+  // recycled secondary command buffers must work the same way as new ones
+  for (uint32_t frame = 0; frame != 3; frame++) {
+    Result ret;
+    auto cmdBuf = cmdQueue_->createCommandBuffer({}, &ret);
+    ASSERT_TRUE(ret.isOk());
+
+    auto parallelEncoder =
+        cmdBuf->createParallelRenderCommandEncoder(renderPass_, framebuffer_, &ret);
+    ASSERT_TRUE(ret.isOk());
+    ASSERT_TRUE(parallelEncoder != nullptr);
+
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i != kNumThreads; i++) {
+      threads.emplace_back([this, &parallelEncoder, i]() {
+        auto encoder = parallelEncoder->createRenderCommandEncoder(nullptr);
+        bindState(*encoder, i % kOffscreenWidth);
+        for (uint32_t draw = i; draw < kNumDraws; draw += kNumThreads) {
+          // a new texture binding requires new uniforms on every draw
+          encoder->bindTexture(0, BindTarget::kFragment, texture_);
+          encoder->draw(PrimitiveType::TriangleStrip, 0, 4);
+        }
+        encoder->endEncoding();
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    parallelEncoder->endEncoding();
+
+    cmdQueue_->submit(*cmdBuf);
+    cmdBuf->waitUntilCompleted();
+
+    for (const uint32_t pixel : readPixels()) {
+      ASSERT_EQ(pixel, data::texture::TEX_RGBA_GRAY_4x4[0]);
+    }
+  }
+}
+
+} // namespace tests
+} // namespace igl
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "util/Common.h"
+#include "util/TestDevice.h"
+
+#include <igl/QueryPool.h>
+
+namespace igl {
+namespace tests {
+
+namespace {
+constexpr size_t kOffscreenWidth = 4;
+constexpr size_t kOffscreenHeight = 4;
+constexpr uint32_t kQueryCount = 2;
+} // namespace
+
+//
+// QueryPoolTest
+//
+// Unit tests for occlusion queries recorded by render command encoders.
+//
+class QueryPoolTest : public ::testing::Test {
+ public:
+  // Set up common resources. This will create a device, a command queue and an offscreen
+  // framebuffer
+  void SetUp() override {
+    setDebugBreakEnabled(false);
+
+    util::createDeviceAndQueue(iglDev_, cmdQueue_);
+    ASSERT_TRUE(iglDev_ != nullptr);
+    ASSERT_TRUE(cmdQueue_ != nullptr);
+
+    if (!iglDev_->hasFeature(DeviceFeatures::OcclusionQueries)) {
+      GTEST_SKIP() << "Occlusion queries are not supported";
+    }
+
+    const TextureDesc texDesc = TextureDesc::new2D(TextureFormat::RGBA_UNorm8,
+                                                   kOffscreenWidth,
+                                                   kOffscreenHeight,
+                                                   TextureDesc::TextureUsageBits::Sampled |
+                                                       TextureDesc::TextureUsageBits::Attachment);
+    Result ret;
+    auto texture = iglDev_->createTexture(texDesc, &ret);
+    ASSERT_TRUE(ret.isOk());
+    ASSERT_TRUE(texture != nullptr);
+
+    FramebufferDesc framebufferDesc;
+    framebufferDesc.colorAttachments[0].texture = texture;
+    framebuffer_ = iglDev_->createFramebuffer(framebufferDesc, &ret);
+    ASSERT_TRUE(ret.isOk());
+    ASSERT_TRUE(framebuffer_ != nullptr);
+
+    renderPass_.colorAttachments.resize(1);
+    renderPass_.colorAttachments[0].loadAction = LoadAction::Clear;
+    renderPass_.colorAttachments[0].storeAction = StoreAction::Store;
+  }
+
+ protected:
+  std::shared_ptr<IDevice> iglDev_;
+  std::shared_ptr<ICommandQueue> cmdQueue_;
+  std::shared_ptr<IFramebuffer> framebuffer_;
+  RenderPassDesc renderPass_;
+};
+
+TEST_F(QueryPoolTest, InvalidDesc) {
+  Result ret;
+  auto pool = iglDev_->createQueryPool({QueryType::BinaryOcclusion, 0}, &ret);
+  ASSERT_EQ(ret.code, Result::Code::ArgumentInvalid);
+  ASSERT_TRUE(pool == nullptr);
+}
+
+TEST_F(QueryPoolTest, EmptyRenderPassIsOccluded) {
+  Result ret;
+  auto pool = iglDev_->createQueryPool(
+      {QueryType::BinaryOcclusion, kQueryCount, 0, "QueryPoolTest"}, &ret);
+  ASSERT_EQ(ret.code, Result::Code::Ok);
+  ASSERT_TRUE(pool != nullptr);
+  ASSERT_EQ(pool->getType(), QueryType::BinaryOcclusion);
+  ASSERT_EQ(pool->getValuesPerQuery(), 1u);
+
+  const BufferDesc bufferDesc(BufferDesc::BufferTypeBits::Storage,
+                              nullptr,
+                              kQueryCount * sizeof(uint64_t),
+                              ResourceStorage::Shared);
+  std::shared_ptr<IBuffer> buffer = iglDev_->createBuffer(bufferDesc, &ret);
+  ASSERT_EQ(ret.code, Result::Code::Ok);
+  ASSERT_TRUE(buffer != nullptr);
+
+  auto cmdBuf = cmdQueue_->createCommandBuffer({}, &ret);
+  ASSERT_EQ(ret.code, Result::Code::Ok);
+  ASSERT_TRUE(cmdBuf != nullptr);
+
+  cmdBuf->resetQueries(*pool, 0, kQueryCount);
+
+  auto encoder = cmdBuf->createRenderCommandEncoder(renderPass_, framebuffer_, &ret);
+  ASSERT_EQ(ret.code, Result::Code::Ok);
+  ASSERT_TRUE(encoder != nullptr);
+  for (uint32_t query = 0; query != kQueryCount; query++) {
+    encoder->beginQuery(*pool, query);
+    encoder->endQuery(*pool, query);
+  }
+  encoder->endEncoding();
+
+  cmdBuf->copyQueryResults(*pool, 0, kQueryCount, *buffer, 0);
+
+  cmdQueue_->submit(*cmdBuf);
+  cmdBuf->waitUntilCompleted();
+
+  uint64_t results[kQueryCount] = {~0ull, ~0ull};
+  ASSERT_TRUE(pool->getResults(0, kQueryCount, results));
+  EXPECT_EQ(results[0], 0u);
+  EXPECT_EQ(results[1], 0u);
+
+  const auto* copied = static_cast<const uint64_t*>(
+      buffer->map(BufferRange(kQueryCount * sizeof(uint64_t), 0), &ret));
+  ASSERT_EQ(ret.code, Result::Code::Ok);
+  ASSERT_TRUE(copied != nullptr);
+  EXPECT_EQ(copied[0], 0u);
+  EXPECT_EQ(copied[1], 0u);
+  buffer->unmap();
+}
+
+} // namespace tests
+} // namespace igl
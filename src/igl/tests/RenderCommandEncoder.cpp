@@ -136,6 +136,7 @@ class RenderCommandEncoderTest : public ::testing::Test {
 
     // numAttributes has to equal to bindings when using more than 1 buffer
     inputDesc.numAttributes = inputDesc.numInputBindings = 2;
+    vertexInputDesc_ = inputDesc;
 
     vertexInputState_ = iglDev_->createVertexInputState(inputDesc, &ret);
     ASSERT_TRUE(ret.isOk());
@@ -282,6 +283,34 @@ class RenderCommandEncoderTest : public ::testing::Test {
     ASSERT_TRUE(uv_ != nullptr);
   }
 
+  /**
+   * @brief Recreates the render pipeline with the position and uv bindings sampled once every
+   * posSampleRate and uvSampleRate instances. A rate of 0 keeps the binding per-vertex.
+   */
+  void createInstancedPipeline(size_t posSampleRate, size_t uvSampleRate) {
+    VertexInputStateDesc inputDesc = vertexInputDesc_;
+    if (posSampleRate != 0) {
+      inputDesc.inputBindings[data::shader::simplePosIndex].sampleFunction =
+          VertexSampleFunction::Instance;
+      inputDesc.inputBindings[data::shader::simplePosIndex].sampleRate = posSampleRate;
+    }
+    if (uvSampleRate != 0) {
+      inputDesc.inputBindings[data::shader::simpleUvIndex].sampleFunction =
+          VertexSampleFunction::Instance;
+      inputDesc.inputBindings[data::shader::simpleUvIndex].sampleRate = uvSampleRate;
+    }
+
+    Result ret;
+    vertexInputState_ = iglDev_->createVertexInputState(inputDesc, &ret);
+    ASSERT_TRUE(ret.isOk());
+    ASSERT_TRUE(vertexInputState_ != nullptr);
+
+    renderPipelineDesc_.vertexInputState = vertexInputState_;
+    renderPipelineState_ = iglDev_->createRenderPipeline(renderPipelineDesc_, &ret);
+    ASSERT_TRUE(ret.isOk());
+    ASSERT_TRUE(renderPipelineState_ != nullptr);
+  }
+
   void TearDown() override {}
 
  public:
@@ -296,6 +325,7 @@ class RenderCommandEncoderTest : public ::testing::Test {
 
   std::shared_ptr<IShaderStages> shaderStages_;
 
+  VertexInputStateDesc vertexInputDesc_;
   std::shared_ptr<IVertexInputState> vertexInputState_;
   std::shared_ptr<IBuffer> vb_, uv_;
 
@@ -495,5 +525,133 @@ TEST_F(RenderCommandEncoderTest, shouldNotDraw) {
   });
 }
 
+TEST_F(RenderCommandEncoderTest, shouldDrawInstanced) {
+  if (!iglDev_->hasFeature(DeviceFeatures::DrawInstanced)) {
+    GTEST_SKIP() << "Instanced draws are unsupported";
+  }
+
+  // every instance draws a point at its own position; the last position is never used
+  initializeBuffers(
+      // clang-format off
+      {
+        -0.75f, -0.75f, 0.0f, 1.0f,
+        -0.25f, -0.25f, 0.0f, 1.0f,
+         0.25f,  0.25f, 0.0f, 1.0f,
+         0.75f,  0.75f, 0.0f, 1.0f,
+      },
+      { 0.5, 0.5 } // clang-format on
+  );
+  createInstancedPipeline(1, 0);
+
+  encodeAndSubmit([](const std::unique_ptr<igl::IRenderCommandEncoder>& encoder) {
+    // zero instances should not draw anything
+    encoder->drawInstanced(PrimitiveType::Point, 0, 1, 0);
+    encoder->drawInstanced(PrimitiveType::Point, 0, 1, 3);
+  });
+
+  auto grayColor = data::texture::TEX_RGBA_GRAY_4x4[0];
+  // clang-format off
+  std::vector<uint32_t> expectedPixels {
+    backgroundColorHex, backgroundColorHex, backgroundColorHex, backgroundColorHex,
+    backgroundColorHex, backgroundColorHex, grayColor,          backgroundColorHex,
+    backgroundColorHex, grayColor,          backgroundColorHex, backgroundColorHex,
+    grayColor,          backgroundColorHex, backgroundColorHex, backgroundColorHex,
+  };
+  // clang-format on
+
+  verifyFrameBuffer(expectedPixels);
+}
+
+TEST_F(RenderCommandEncoderTest, shouldDrawIndexedInstancedWithBaseVertex) {
+  if (!iglDev_->hasFeature(DeviceFeatures::DrawBaseInstance)) {
+    GTEST_SKIP() << "Base vertex and base instance are unsupported";
+  }
+
+  // positions are per-instance and uvs per-vertex: baseInstance skips the first position and
+  // baseVertex skips the first uv, which would sample a black texel
+  initializeBuffers(
+      // clang-format off
+      {
+        -0.75f,  0.75f, 0.0f, 1.0f,
+         0.25f, -0.25f, 0.0f, 1.0f,
+         0.75f, -0.75f, 0.0f, 1.0f,
+      },
+      {
+        0.125, 0.125,
+        0.625, 0.375,
+      } // clang-format on
+  );
+  createInstancedPipeline(1, 0);
+  texture_->upload(TextureRangeDesc::new2D(0, 0, OFFSCREEN_TEX_WIDTH, OFFSCREEN_TEX_HEIGHT),
+                   data::texture::TEX_RGBA_MISC1_4x4);
+
+  const std::vector<uint16_t> indices = {0};
+  Result ret;
+  auto ib = iglDev_->createBuffer(
+      BufferDesc(BufferDesc::BufferTypeBits::Index, indices.data(), sizeof(uint16_t)), &ret);
+  ASSERT_TRUE(ret.isOk());
+  ASSERT_TRUE(ib != nullptr);
+
+  encodeAndSubmit([&ib](const std::unique_ptr<igl::IRenderCommandEncoder>& encoder) {
+    encoder->drawIndexedInstanced(PrimitiveType::Point, 1, IndexFormat::UInt16, *ib, 0, 2, 1, 1);
+  });
+
+  auto color = data::texture::TEX_RGBA_MISC1_4x4[6];
+  // clang-format off
+  std::vector<uint32_t> expectedPixels {
+    backgroundColorHex, backgroundColorHex, backgroundColorHex, backgroundColorHex,
+    backgroundColorHex, backgroundColorHex, backgroundColorHex, backgroundColorHex,
+    backgroundColorHex, backgroundColorHex, color,              backgroundColorHex,
+    backgroundColorHex, backgroundColorHex, backgroundColorHex, color,
+  };
+  // clang-format on
+
+  verifyFrameBuffer(expectedPixels);
+}
+
+TEST_F(RenderCommandEncoderTest, shouldDrawInstancedWithStepRate) {
+  if (!iglDev_->hasFeature(DeviceFeatures::VertexInstanceStepRate)) {
+    GTEST_SKIP() << "Per-instance step rates are unsupported";
+  }
+
+  // positions advance every 2 instances and uvs every instance, so the second instance of each
+  // pair overwrites the first one; only the first 2 positions are used
+  initializeBuffers(
+      // clang-format off
+      {
+        -0.75f, -0.75f, 0.0f, 1.0f,
+         0.75f,  0.75f, 0.0f, 1.0f,
+        -0.75f,  0.75f, 0.0f, 1.0f,
+         0.75f, -0.75f, 0.0f, 1.0f,
+      },
+      {
+        0.125, 0.125,
+        0.375, 0.125,
+        0.625, 0.125,
+        0.875, 0.125,
+      } // clang-format on
+  );
+  createInstancedPipeline(2, 1);
+  texture_->upload(TextureRangeDesc::new2D(0, 0, OFFSCREEN_TEX_WIDTH, OFFSCREEN_TEX_HEIGHT),
+                   data::texture::TEX_RGBA_MISC1_4x4);
+
+  encodeAndSubmit([](const std::unique_ptr<igl::IRenderCommandEncoder>& encoder) {
+    encoder->drawInstanced(PrimitiveType::Point, 0, 1, 4);
+  });
+
+  auto color1 = data::texture::TEX_RGBA_MISC1_4x4[1];
+  auto color3 = data::texture::TEX_RGBA_MISC1_4x4[3];
+  // clang-format off
+  std::vector<uint32_t> expectedPixels {
+    backgroundColorHex, backgroundColorHex, backgroundColorHex, color3,
+    backgroundColorHex, backgroundColorHex, backgroundColorHex, backgroundColorHex,
+    backgroundColorHex, backgroundColorHex, backgroundColorHex, backgroundColorHex,
+    color1,             backgroundColorHex, backgroundColorHex, backgroundColorHex,
+  };
+  // clang-format on
+
+  verifyFrameBuffer(expectedPixels);
+}
+
 } // namespace tests
 } // namespace igl
@@ -119,5 +119,52 @@ TEST_F(ShaderModuleTest, CompileShaderModuleNoResult) {
       *iglDev_, source, {ShaderStage::Vertex, "vertexShader"}, "", nullptr);
   ASSERT_TRUE(shaderModule != nullptr);
 }
+
+TEST_F(ShaderModuleTest, CreateShaderStagesBatch) {
+  const char* vertexSource = nullptr;
+  const char* fragmentSource = nullptr;
+  if (backend_ == util::BACKEND_OGL) {
+    vertexSource = data::shader::OGL_SIMPLE_VERT_SHADER;
+    fragmentSource = data::shader::OGL_SIMPLE_FRAG_SHADER;
+  } else if (backend_ == util::BACKEND_VUL) {
+    vertexSource = data::shader::VULKAN_SIMPLE_VERT_SHADER;
+    fragmentSource = data::shader::VULKAN_SIMPLE_FRAG_SHADER;
+  } else {
+    GTEST_SKIP() << "Metal shaders are created from libraries";
+  }
+
+  const ShaderStagesModulesDesc desc = ShaderStagesModulesDesc::fromRenderModules(
+      ShaderModuleDesc::fromStringInput(
+          vertexSource, {ShaderStage::Vertex, data::shader::shaderFunc}, "vertexShader"),
+      ShaderModuleDesc::fromStringInput(
+          fragmentSource, {ShaderStage::Fragment, data::shader::shaderFunc}, "fragmentShader"));
+
+  std::vector<ShaderStagesModulesDesc> descs(16, desc);
+
+  // Vulkan backend has hard coded asserts on invalid shaders
+  const size_t invalidIndex = descs.size() / 2;
+  if (backend_ == util::BACKEND_OGL) {
+    descs[invalidIndex].fragmentModule.input.source = "hello world";
+  }
+
+  std::vector<Result> results;
+  auto stages = iglDev_->createShaderStagesBatch(descs, &results);
+  ASSERT_EQ(stages.size(), descs.size());
+  ASSERT_EQ(results.size(), descs.size());
+
+  for (size_t i = 0; i != descs.size(); i++) {
+    if (backend_ == util::BACKEND_OGL && i == invalidIndex) {
+      EXPECT_FALSE(results[i].isOk());
+      EXPECT_TRUE(stages[i] == nullptr);
+    } else {
+      EXPECT_TRUE(results[i].isOk()) << results[i].message;
+      ASSERT_TRUE(stages[i] != nullptr);
+      EXPECT_TRUE(stages[i]->isValid());
+    }
+  }
+
+  // results are optional
+  EXPECT_EQ(iglDev_->createShaderStagesBatch({desc}, nullptr).size(), 1u);
+}
 } // namespace tests
 } // namespace igl
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "util/Common.h"
+#include "util/TestDevice.h"
+
+#include <igl/TimestampQueryPool.h>
+
+namespace igl {
+namespace tests {
+
+//
+// TimestampQueryPoolTest
+//
+// Unit tests for GPU timestamp queries and the automatic timing of debug groups.
+//
+class TimestampQueryPoolTest : public ::testing::Test {
+ public:
+  // Set up common resources. This will create a device, a command queue and a query pool
+  void SetUp() override {
+    setDebugBreakEnabled(false);
+
+    util::createDeviceAndQueue(iglDev_, cmdQueue_);
+    ASSERT_TRUE(iglDev_ != nullptr);
+    ASSERT_TRUE(cmdQueue_ != nullptr);
+
+    if (!iglDev_->hasFeature(DeviceFeatures::Timestamps)) {
+      GTEST_SKIP() << "Timestamp queries are not supported";
+    }
+
+    Result ret;
+    pool_ = iglDev_->createTimestampQueryPool({kQueryCount, "TimestampQueryPoolTest"}, &ret);
+    ASSERT_EQ(ret.code, Result::Code::Ok);
+    ASSERT_TRUE(pool_ != nullptr);
+    ASSERT_EQ(pool_->getQueryCount(), kQueryCount);
+  }
+
+ protected:
+  static constexpr uint32_t kQueryCount = 6;
+
+  std::shared_ptr<IDevice> iglDev_;
+  std::shared_ptr<ICommandQueue> cmdQueue_;
+  std::shared_ptr<ITimestampQueryPool> pool_;
+};
+
+TEST_F(TimestampQueryPoolTest, EmptyPoolIsInvalid) {
+  Result ret;
+  auto pool = iglDev_->createTimestampQueryPool({}, &ret);
+  ASSERT_EQ(ret.code, Result::Code::ArgumentInvalid);
+  ASSERT_TRUE(pool == nullptr);
+}
+
+TEST_F(TimestampQueryPoolTest, DebugGroupTimings) {
+  Result ret;
+  CommandBufferDesc desc;
+  desc.timestampQueryPool = pool_;
+  auto cmdBuf = cmdQueue_->createCommandBuffer(desc, &ret);
+  ASSERT_EQ(ret.code, Result::Code::Ok);
+  ASSERT_TRUE(cmdBuf != nullptr);
+
+  // the third scope does not fit into the pool and is not timed
+  cmdBuf->pushDebugGroupLabel("Outer");
+  cmdBuf->pushDebugGroupLabel("Inner");
+  cmdBuf->popDebugGroupLabel();
+  cmdBuf->pushDebugGroupLabel("Inner2");
+  cmdBuf->pushDebugGroupLabel("Skipped");
+  cmdBuf->popDebugGroupLabel();
+  cmdBuf->popDebugGroupLabel();
+  cmdBuf->popDebugGroupLabel();
+
+  cmdQueue_->submit(*cmdBuf);
+  cmdBuf->waitUntilCompleted();
+
+  std::vector<TimestampScopeTiming> timings;
+  ASSERT_TRUE(pool_->getScopeTimings(timings));
+  ASSERT_EQ(timings.size(), 3u);
+  EXPECT_EQ(timings[0].label, "Outer");
+  EXPECT_EQ(timings[0].depth, 0u);
+  EXPECT_EQ(timings[1].label, "Inner");
+  EXPECT_EQ(timings[1].depth, 1u);
+  EXPECT_EQ(timings[2].label, "Inner2");
+  EXPECT_EQ(timings[2].depth, 1u);
+  EXPECT_GE(timings[0].durationNs, timings[1].durationNs);
+}
+
+} // namespace tests
+} // namespace igl
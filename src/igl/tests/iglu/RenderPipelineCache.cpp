@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "../data/ShaderData.h"
+#include "../util/Common.h"
+#include "../util/TestDevice.h"
+
+#include <IGLU/simple_renderer/RenderPipelineCache.h>
+#include <gtest/gtest.h>
+#include <igl/IGL.h>
+#include <igl/NameHandle.h>
+
+namespace igl {
+namespace tests {
+
+//
+// RenderPipelineCacheTest
+//
+// Unit tests for iglu::pipelinecache::RenderPipelineCache.
+//
+class RenderPipelineCacheTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    setDebugBreakEnabled(false);
+
+    util::createDeviceAndQueue(iglDev_, cmdQueue_);
+    ASSERT_TRUE(iglDev_ != nullptr);
+
+    std::unique_ptr<IShaderStages> stages;
+    util::createSimpleShaderStages(iglDev_, stages);
+    ASSERT_TRUE(stages != nullptr);
+
+    VertexInputStateDesc inputDesc;
+    inputDesc.attributes[0].format = VertexAttributeFormat::Float4;
+    inputDesc.attributes[0].offset = 0;
+    inputDesc.attributes[0].location = 0;
+    inputDesc.attributes[0].bufferIndex = data::shader::simplePosIndex;
+    inputDesc.attributes[0].name = data::shader::simplePos;
+    inputDesc.inputBindings[0].stride = sizeof(float) * 4;
+    inputDesc.attributes[1].format = VertexAttributeFormat::Float2;
+    inputDesc.attributes[1].offset = 0;
+    inputDesc.attributes[1].location = 1;
+    inputDesc.attributes[1].bufferIndex = data::shader::simpleUvIndex;
+    inputDesc.attributes[1].name = data::shader::simpleUv;
+    inputDesc.inputBindings[1].stride = sizeof(float) * 2;
+    inputDesc.numAttributes = inputDesc.numInputBindings = 2;
+
+    Result ret;
+    auto vertexInputState = iglDev_->createVertexInputState(inputDesc, &ret);
+    ASSERT_TRUE(ret.isOk());
+
+    desc_.vertexInputState = std::move(vertexInputState);
+    desc_.shaderStages = std::move(stages);
+    desc_.targetDesc.colorAttachments.resize(1);
+    desc_.targetDesc.colorAttachments[0].textureFormat = TextureFormat::RGBA_UNorm8;
+    desc_.fragmentUnitSamplerMap[0] = IGL_NAMEHANDLE(data::shader::simpleSampler);
+    desc_.cullMode = CullMode::Disabled;
+  }
+
+  void TearDown() override {}
+
+ public:
+  std::shared_ptr<IDevice> iglDev_;
+  std::shared_ptr<ICommandQueue> cmdQueue_;
+  RenderPipelineDesc desc_;
+};
+
+TEST_F(RenderPipelineCacheTest, IdenticalDescsShareOnePipeline) {
+  iglu::pipelinecache::RenderPipelineCache cache;
+
+  Result ret;
+  auto ps1 = cache.getOrCreate(*iglDev_, desc_, &ret);
+  ASSERT_TRUE(ret.isOk());
+  ASSERT_TRUE(ps1 != nullptr);
+
+  // A copy of the descriptor with a precomputed hash
+  const RenderPipelineDesc otherDesc = desc_;
+  auto ps2 =
+      cache.getOrCreate(*iglDev_, otherDesc, std::hash<RenderPipelineDesc>()(otherDesc), &ret);
+  ASSERT_TRUE(ret.isOk());
+  EXPECT_EQ(ps1, ps2);
+
+  desc_.cullMode = CullMode::Back;
+  auto ps3 = cache.getOrCreate(*iglDev_, desc_, &ret);
+  ASSERT_TRUE(ret.isOk());
+  ASSERT_TRUE(ps3 != nullptr);
+  EXPECT_NE(ps1, ps3);
+
+  const auto stats = cache.getStats();
+  EXPECT_EQ(stats.numHits, 1u);
+  EXPECT_EQ(stats.numMisses, 2u);
+  EXPECT_EQ(stats.numEvictions, 0u);
+  EXPECT_EQ(stats.numPipelines, 2u);
+}
+
+TEST_F(RenderPipelineCacheTest, LeastRecentlyUsedPipelinesAreEvicted) {
+  iglu::pipelinecache::RenderPipelineCache cache(2);
+
+  RenderPipelineDesc desc1 = desc_;
+  RenderPipelineDesc desc2 = desc_;
+  RenderPipelineDesc desc3 = desc_;
+  desc2.cullMode = CullMode::Front;
+  desc3.cullMode = CullMode::Back;
+
+  auto ps1 = cache.getOrCreate(*iglDev_, desc1);
+  auto ps2 = cache.getOrCreate(*iglDev_, desc2);
+  ASSERT_TRUE(ps1 != nullptr);
+  ASSERT_TRUE(ps2 != nullptr);
+
+  // Make desc2 the least recently used one
+  EXPECT_EQ(cache.getOrCreate(*iglDev_, desc1), ps1);
+
+  auto ps3 = cache.getOrCreate(*iglDev_, desc3);
+  ASSERT_TRUE(ps3 != nullptr);
+  EXPECT_EQ(cache.getStats().numEvictions, 1u);
+  EXPECT_EQ(cache.getStats().numPipelines, 2u);
+
+  EXPECT_EQ(cache.getOrCreate(*iglDev_, desc1), ps1);
+  EXPECT_EQ(cache.getOrCreate(*iglDev_, desc3), ps3);
+  // An evicted pipeline is created again
+  EXPECT_NE(cache.getOrCreate(*iglDev_, desc2), ps2);
+
+  cache.setCapacity(1);
+  EXPECT_EQ(cache.getStats().numPipelines, 1u);
+
+  cache.clear();
+  EXPECT_EQ(cache.getStats().numPipelines, 0u);
+}
+
+} // namespace tests
+} // namespace igl
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "../util/Common.h"
+#include "../util/TestDevice.h"
+
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <igl/opengl/Device.h>
+#include <igl/opengl/IContext.h>
+#include <igl/opengl/ProgramBinaryCache.h>
+#include <igl/opengl/Shader.h>
+
+namespace igl {
+namespace tests {
+
+namespace {
+const char kVertexSource[] = "void main() { gl_Position = vec4(0.0); }";
+const char kFragmentSource[] = "void main() { gl_FragColor = vec4(1.0); }";
+} // namespace
+
+//
+// ProgramBinaryCacheOGLTest
+//
+// Unit tests for igl::opengl::ProgramBinaryCache.
+//
+class ProgramBinaryCacheOGLTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    setDebugBreakEnabled(false);
+
+    directory_ = std::filesystem::temp_directory_path() / "igl_program_binary_cache_test";
+    std::filesystem::remove_all(directory_);
+    std::filesystem::create_directories(directory_);
+  }
+
+  void TearDown() override {
+    std::filesystem::remove_all(directory_);
+  }
+
+  static uint64_t computeKey(const opengl::ProgramBinaryCache& cache) {
+    return cache.computeKey(
+        {{GL_VERTEX_SHADER, opengl::ProgramBinaryCache::hashSource(kVertexSource)},
+         {GL_FRAGMENT_SHADER, opengl::ProgramBinaryCache::hashSource(kFragmentSource)}});
+  }
+
+ protected:
+  std::filesystem::path directory_;
+};
+
+TEST_F(ProgramBinaryCacheOGLTest, KeyDependsOnDriverAndSources) {
+  const opengl::ProgramBinaryCache cache("driver");
+  const opengl::ProgramBinaryCache otherCache("other driver");
+
+  EXPECT_EQ(computeKey(cache), computeKey(opengl::ProgramBinaryCache("driver")));
+  EXPECT_NE(computeKey(cache), computeKey(otherCache));
+
+  // the same sources used by different stages
+  EXPECT_NE(computeKey(cache),
+            cache.computeKey(
+                {{GL_FRAGMENT_SHADER, opengl::ProgramBinaryCache::hashSource(kVertexSource)},
+                 {GL_VERTEX_SHADER, opengl::ProgramBinaryCache::hashSource(kFragmentSource)}}));
+}
+
+TEST_F(ProgramBinaryCacheOGLTest, MemoryAndDiskCache) {
+  const opengl::ProgramBinaryCache::Binary binary = {0x1234, {1, 2, 3, 4, 5}};
+
+  uint64_t key = 0;
+
+  {
+    opengl::ProgramBinaryCache cache("driver");
+    cache.setDirectory(directory_.string());
+    key = computeKey(cache);
+
+    // every program is stored when the disk layer is enabled
+    opengl::ProgramBinaryCache::Binary result;
+    bool shouldStore = false;
+    EXPECT_FALSE(cache.find(key, result, &shouldStore));
+    EXPECT_TRUE(shouldStore);
+    EXPECT_EQ(cache.getNumMisses(), 1u);
+
+    cache.insert(key, binary);
+    ASSERT_TRUE(cache.find(key, result));
+    EXPECT_EQ(result.format, binary.format);
+    EXPECT_EQ(result.data, binary.data);
+    EXPECT_EQ(cache.getNumHits(), 1u);
+  }
+
+  // a new cache finds the entry on disk
+  opengl::ProgramBinaryCache cache("driver");
+  cache.setDirectory(directory_.string());
+
+  opengl::ProgramBinaryCache::Binary result;
+  ASSERT_TRUE(cache.find(key, result));
+  EXPECT_EQ(result.format, binary.format);
+  EXPECT_EQ(result.data, binary.data);
+
+  // rejected binaries are removed from memory and disk
+  cache.remove(key);
+  EXPECT_FALSE(cache.find(key, result));
+  EXPECT_TRUE(std::filesystem::is_empty(directory_));
+}
+
+TEST_F(ProgramBinaryCacheOGLTest, MemoryCacheKeepsProgramsLinkedTwice) {
+  const opengl::ProgramBinaryCache::Binary binary = {0x1234, {1, 2, 3, 4, 5}};
+
+  opengl::ProgramBinaryCache cache("driver", 2);
+  opengl::ProgramBinaryCache::Binary result;
+
+  bool shouldStore = true;
+  EXPECT_FALSE(cache.find(1, result, &shouldStore));
+  EXPECT_FALSE(shouldStore);
+  EXPECT_FALSE(cache.find(1, result, &shouldStore));
+  EXPECT_TRUE(shouldStore);
+
+  cache.insert(1, binary);
+  cache.insert(2, binary);
+  ASSERT_TRUE(cache.find(1, result));
+  EXPECT_EQ(result.data, binary.data);
+
+  // the least recently used entry is evicted
+  cache.insert(3, binary);
+  EXPECT_EQ(cache.getNumEntries(), 2u);
+  EXPECT_TRUE(cache.find(1, result));
+  EXPECT_TRUE(cache.find(3, result));
+  EXPECT_FALSE(cache.find(2, result));
+}
+
+TEST_F(ProgramBinaryCacheOGLTest, ProgramsAreRestoredFromCache) {
+  auto device = util::createTestDevice();
+  ASSERT_TRUE(device != nullptr);
+  auto& context = static_cast<opengl::Device&>(*device).getContext();
+
+  opengl::ProgramBinaryCache* cache = context.getProgramBinaryCache();
+  if (!cache) {
+    GTEST_SKIP() << "Program binaries are not supported";
+  }
+
+  // programs linked only once are not stored
+  const uint32_t numMisses = cache->getNumMisses();
+  std::unique_ptr<IShaderStages> stages;
+  util::createSimpleShaderStages(device, stages);
+  ASSERT_TRUE(stages != nullptr);
+  EXPECT_EQ(cache->getNumMisses(), numMisses + 1);
+
+  // the second link stores the binary in memory
+  std::unique_ptr<IShaderStages> relinkedStages;
+  util::createSimpleShaderStages(device, relinkedStages);
+  ASSERT_TRUE(relinkedStages != nullptr);
+  EXPECT_EQ(cache->getNumMisses(), numMisses + 2);
+
+  const uint32_t numHits = cache->getNumHits();
+
+  std::unique_ptr<IShaderStages> cachedStages;
+  util::createSimpleShaderStages(device, cachedStages);
+  ASSERT_TRUE(cachedStages != nullptr);
+
+  EXPECT_EQ(cache->getNumHits(), numHits + 1);
+  EXPECT_NE(static_cast<opengl::ShaderStages&>(*cachedStages).getProgramID(), 0u);
+
+  // the disk layer is opt-in
+  EXPECT_FALSE(cache->isDiskCacheEnabled());
+  EXPECT_TRUE(std::filesystem::is_empty(directory_));
+}
+
+} // namespace tests
+} // namespace igl
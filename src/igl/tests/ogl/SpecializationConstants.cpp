@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "../util/Common.h"
+#include "../util/TestDevice.h"
+
+#include <gtest/gtest.h>
+#include <igl/IGL.h>
+#include <igl/ShaderCreator.h>
+#include <igl/opengl/Device.h>
+#include <igl/opengl/Shader.h>
+#include <string>
+#include <vector>
+
+namespace igl {
+namespace tests {
+
+namespace {
+const char kVertexSource[] = R"(
+attribute vec4 position_in;
+void main() {
+  gl_Position = position_in;
+}
+)";
+const char kFragmentSource[] = R"(
+#ifdef GL_ES
+precision mediump float;
+#endif
+#ifndef kRed
+#define kRed 0.0
+#endif
+void main() {
+  gl_FragColor = vec4(kRed, 0.0, 0.0, 1.0);
+}
+)";
+} // namespace
+
+//
+// SpecializationConstantsOGLTest
+//
+// Unit tests for specialization constants, which are injected as #defines on OpenGL.
+//
+class SpecializationConstantsOGLTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    setDebugBreakEnabled(false);
+
+    util::createDeviceAndQueue(iglDev_, cmdQueue_);
+    ASSERT_TRUE(iglDev_ != nullptr);
+
+    Result ret;
+    std::unique_ptr<IShaderStages> stages = ShaderStagesCreator::fromModuleStringInput(
+        *iglDev_, kVertexSource, "main", "", kFragmentSource, "main", "", &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message;
+    ASSERT_TRUE(stages != nullptr);
+    stages_ = std::move(stages);
+  }
+
+  opengl::ShaderStages& getStages() const {
+    return static_cast<opengl::ShaderStages&>(*stages_);
+  }
+
+  std::string getFragmentSource(const IShaderStages& stages) const {
+    const auto& context = static_cast<opengl::Device&>(*iglDev_).getContext();
+    const GLuint shaderID =
+        static_cast<const opengl::ShaderModule&>(*stages.getFragmentModule()).getShaderID();
+    GLint length = 0;
+    context.getShaderiv(shaderID, GL_SHADER_SOURCE_LENGTH, &length);
+    std::vector<GLchar> source(length > 0 ? length : 1);
+    context.getShaderSource(shaderID, static_cast<GLsizei>(source.size()), nullptr, source.data());
+    return source.data();
+  }
+
+ protected:
+  std::shared_ptr<IDevice> iglDev_;
+  std::shared_ptr<ICommandQueue> cmdQueue_;
+  std::shared_ptr<IShaderStages> stages_;
+};
+
+TEST_F(SpecializationConstantsOGLTest, SpecializationsAreCached) {
+  const std::vector<SpecializationConstant> red = {
+      SpecializationConstant::fromFloat(0, "kRed", 1.0f)};
+  const std::vector<SpecializationConstant> darkRed = {
+      SpecializationConstant::fromFloat(0, "kRed", 0.5f)};
+
+  Result ret;
+  auto redStages = getStages().getSpecialization(red, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message;
+  ASSERT_TRUE(redStages != nullptr);
+  EXPECT_NE(redStages->getProgramID(), getStages().getProgramID());
+  EXPECT_NE(getFragmentSource(*redStages).find("#define kRed 1.0\n"), std::string::npos);
+  EXPECT_EQ(getFragmentSource(*stages_).find("#define kRed 1.0"), std::string::npos);
+
+  EXPECT_EQ(getStages().getSpecialization(red, &ret), redStages);
+
+  auto darkRedStages = getStages().getSpecialization(darkRed, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message;
+  ASSERT_TRUE(darkRedStages != nullptr);
+  EXPECT_NE(darkRedStages, redStages);
+  EXPECT_NE(getFragmentSource(*darkRedStages).find("#define kRed 0.5\n"), std::string::npos);
+}
+
+TEST_F(SpecializationConstantsOGLTest, RenderPipeline) {
+  RenderPipelineDesc desc;
+  desc.shaderStages = stages_;
+  desc.targetDesc.colorAttachments.resize(1);
+  desc.targetDesc.colorAttachments[0].textureFormat = TextureFormat::RGBA_UNorm8;
+  desc.specializationConstants = {SpecializationConstant::fromFloat(0, "kRed", 1.0f)};
+
+  Result ret;
+  auto pipelineState = iglDev_->createRenderPipeline(desc, &ret);
+  EXPECT_TRUE(ret.isOk()) << ret.message;
+  EXPECT_TRUE(pipelineState != nullptr);
+
+  // OpenGL needs names to inject the constants
+  desc.specializationConstants = {SpecializationConstant::fromFloat(0, "", 1.0f)};
+  pipelineState = iglDev_->createRenderPipeline(desc, &ret);
+  EXPECT_EQ(ret.code, Result::Code::ArgumentInvalid);
+}
+
+} // namespace tests
+} // namespace igl
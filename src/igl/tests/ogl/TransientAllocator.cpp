@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <igl/IGL.h>
+#include <igl/opengl/Buffer.h>
+
+#include "../util/Common.h"
+
+namespace igl {
+namespace tests {
+
+class TransientAllocatorOGLTest : public ::testing::Test {
+ public:
+  TransientAllocatorOGLTest() = default;
+  ~TransientAllocatorOGLTest() override = default;
+
+  // Set up common resources. This will create a device and a command queue
+  void SetUp() override {
+    // Turn off debug break so unit tests can run
+    igl::setDebugBreakEnabled(false);
+
+    util::createDeviceAndQueue(iglDev_, cmdQueue_);
+    ASSERT_TRUE(iglDev_ != nullptr);
+    ASSERT_TRUE(cmdQueue_ != nullptr);
+  }
+
+  void TearDown() override {}
+
+  // Member variables
+ public:
+  std::shared_ptr<IDevice> iglDev_;
+  std::shared_ptr<ICommandQueue> cmdQueue_;
+};
+
+TEST_F(TransientAllocatorOGLTest, AllocationsResetEveryFrame) {
+  Result ret;
+  const TransientAllocation first =
+      iglDev_->allocateTransient(BufferDesc::BufferTypeBits::Vertex, 12, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message;
+  ASSERT_TRUE(first.data != nullptr);
+  ASSERT_TRUE(first.buffer != nullptr);
+  EXPECT_EQ(static_cast<opengl::Buffer&>(*first.buffer).getType(),
+            opengl::Buffer::Type::Attribute);
+
+  const TransientAllocation second =
+      iglDev_->allocateTransient(BufferDesc::BufferTypeBits::Vertex, 12, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message;
+  EXPECT_EQ(second.buffer, first.buffer);
+  EXPECT_GE(second.offset, first.offset + first.size);
+
+  // submitting a command buffer ends the frame
+  auto cmdBuf = cmdQueue_->createCommandBuffer({}, &ret);
+  ASSERT_TRUE(ret.isOk());
+  cmdQueue_->submit(*cmdBuf);
+
+  const TransientAllocation third =
+      iglDev_->allocateTransient(BufferDesc::BufferTypeBits::Vertex, 12, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message;
+  EXPECT_EQ(third.buffer, first.buffer);
+  EXPECT_EQ(third.offset, first.offset);
+}
+
+TEST_F(TransientAllocatorOGLTest, UniformBlocks) {
+  Result ret;
+  const TransientAllocation allocation =
+      iglDev_->allocateTransient(BufferDesc::BufferTypeBits::Uniform, 64, &ret);
+
+  if (!iglDev_->hasFeature(DeviceFeatures::UniformBlocks)) {
+    EXPECT_EQ(ret.code, Result::Code::Unsupported);
+    return;
+  }
+
+  ASSERT_TRUE(ret.isOk()) << ret.message;
+  ASSERT_TRUE(allocation.buffer != nullptr);
+  EXPECT_EQ(static_cast<opengl::Buffer&>(*allocation.buffer).getType(),
+            opengl::Buffer::Type::UniformBlock);
+}
+
+TEST_F(TransientAllocatorOGLTest, StorageBuffersAreUnsupported) {
+  Result ret;
+  const TransientAllocation allocation = iglDev_->allocateTransient(
+      BufferDesc::BufferTypeBits::Storage | BufferDesc::BufferTypeBits::Uniform, 64, &ret);
+  EXPECT_EQ(ret.code, Result::Code::Unsupported);
+  EXPECT_EQ(allocation.buffer, nullptr);
+  EXPECT_EQ(allocation.data, nullptr);
+}
+
+} // namespace tests
+} // namespace igl
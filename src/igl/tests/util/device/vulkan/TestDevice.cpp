@@ -23,12 +23,39 @@
 
 namespace igl::tests::util::device::vulkan {
 
+//
+// getTestContextConfig
+//
+// Used by tests which need specific context settings.
+//
+igl::vulkan::VulkanContextConfig getTestContextConfig() {
+  igl::vulkan::VulkanContextConfig config;
+  config.enhancedShaderDebugging = false; // This causes issues for MoltenVK
+  config.enableValidation = true;
+#if IGL_PLATFORM_MACOS
+  config.terminateOnValidationError = false;
+#else
+  config.terminateOnValidationError = true;
+#endif
+  config.swapChainColorSpace = igl::ColorSpace::SRGB_NONLINEAR;
+  return config;
+}
+
 //
 // createTestDevice
 //
 // Used by clients to get an IGL device.
 //
 std::shared_ptr<::igl::IDevice> createTestDevice() {
+  igl::vulkan::VulkanContextConfig config = getTestContextConfig();
+#if !IGL_PLATFORM_MACOS && !IGL_DEBUG
+  config.enableValidation = false;
+  config.terminateOnValidationError = false;
+#endif
+  return createTestDevice(config);
+}
+
+std::shared_ptr<::igl::IDevice> createTestDevice(const igl::vulkan::VulkanContextConfig& config) {
 #if IGL_PLATFORM_MACOS
   setupXCTestEnvironment();
 #endif
@@ -36,19 +63,6 @@ std::shared_ptr<::igl::IDevice> createTestDevice() {
   std::shared_ptr<igl::IDevice> iglDev = nullptr;
   Result ret;
 
-  igl::vulkan::VulkanContextConfig config;
-  config.enhancedShaderDebugging = false; // This causes issues for MoltenVK
-#if IGL_PLATFORM_MACOS
-  config.terminateOnValidationError = false;
-#elif IGL_DEBUG
-  config.enableValidation = true;
-  config.terminateOnValidationError = true;
-#else
-  config.enableValidation = false;
-  config.terminateOnValidationError = false;
-#endif
-  config.swapChainColorSpace = igl::ColorSpace::SRGB_NONLINEAR;
-
   auto ctx = igl::vulkan::HWDevice::createContext(config, nullptr);
 
   std::vector<HWDeviceDesc> devices = igl::vulkan::HWDevice::queryDevices(
@@ -11,6 +11,9 @@
 
 namespace igl {
 class IDevice;
+namespace vulkan {
+struct VulkanContextConfig;
+} // namespace vulkan
 namespace tests::util::device::vulkan {
 
 /**
@@ -18,5 +21,16 @@ namespace tests::util::device::vulkan {
  */
 std::shared_ptr<::igl::IDevice> createTestDevice();
 
+/**
+ Return the context configuration used for test devices, with validation enabled. Tests which need
+ specific context settings adjust it and pass it to createTestDevice(config).
+ */
+::igl::vulkan::VulkanContextConfig getTestContextConfig();
+
+/**
+ Create and return an igl::Device with a custom context configuration.
+ */
+std::shared_ptr<::igl::IDevice> createTestDevice(const ::igl::vulkan::VulkanContextConfig& config);
+
 } // namespace tests::util::device::vulkan
 } // namespace igl
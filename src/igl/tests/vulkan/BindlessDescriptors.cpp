@@ -0,0 +1,361 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <chrono>
+#include <gtest/gtest.h>
+#include <igl/IGL.h>
+#include <igl/vulkan/Device.h>
+#include <igl/vulkan/VulkanContext.h>
+#include <memory>
+#include <vector>
+
+#include "../data/ShaderData.h"
+#include "../util/Common.h"
+#include "../util/device/vulkan/TestDevice.h"
+
+#if IGL_PLATFORM_WIN || IGL_PLATFORM_ANDROID || IGL_PLATFORM_LINUX
+
+namespace igl::tests {
+
+namespace {
+constexpr uint32_t kNumTextures = 10000;
+constexpr uint32_t kNumTexturesPerFrame = 100;
+constexpr uint32_t kNumFrames = 60;
+// 4 sampled image bindings and 1 storage image binding
+constexpr uint64_t kDescriptorsPerTexture = 5;
+} // namespace
+
+//
+// BindlessDescriptorsVulkanTest
+//
+// Unit tests for incremental updates of the bindless descriptor sets of
+// igl::vulkan::VulkanContext.
+//
+class BindlessDescriptorsVulkanTest : public ::testing::Test {
+ public:
+  // Set up common resources. This will create a device which fits kNumTextures textures
+  void SetUp() override {
+    // Turn off debug break so unit tests can run
+    igl::setDebugBreakEnabled(false);
+
+    igl::vulkan::VulkanContextConfig config = util::device::vulkan::getTestContextConfig();
+    config.maxTextures = 2 * kNumTextures;
+
+    device_ = util::device::vulkan::createTestDevice(config);
+    ASSERT_TRUE(device_ != nullptr);
+
+    if (getVulkanContext()
+            .vkPhysicalDeviceDescriptorIndexingProperties_
+            .maxDescriptorSetUpdateAfterBindSampledImages < config.maxTextures) {
+      GTEST_SKIP() << "Too few update-after-bind sampled images";
+    }
+
+    Result ret;
+    cmdQueue_ = device_->createCommandQueue(CommandQueueDesc{CommandQueueType::Graphics}, &ret);
+    ASSERT_TRUE(ret.isOk());
+    ASSERT_TRUE(cmdQueue_ != nullptr);
+  }
+
+  const igl::vulkan::VulkanContext& getVulkanContext() const {
+    return static_cast<igl::vulkan::Device&>(*device_).getVulkanContext();
+  }
+
+  std::shared_ptr<ITexture> createTexture() const {
+    Result ret;
+    auto texture = device_->createTexture(
+        TextureDesc::new2D(
+            TextureFormat::RGBA_UNorm8, 1, 1, TextureDesc::TextureUsageBits::Sampled),
+        &ret);
+    EXPECT_TRUE(ret.isOk());
+    return texture;
+  }
+
+  // descriptor sets are updated by command encoders
+  std::shared_ptr<ICommandBuffer> encodeFrame() const {
+    Result ret;
+    auto cmdBuf = cmdQueue_->createCommandBuffer({}, &ret);
+    EXPECT_TRUE(ret.isOk());
+    auto encoder = cmdBuf->createComputeCommandEncoder();
+    EXPECT_TRUE(encoder != nullptr);
+    encoder->endEncoding();
+    cmdQueue_->submit(*cmdBuf, true);
+    return cmdBuf;
+  }
+
+ protected:
+  std::shared_ptr<IDevice> device_;
+  std::shared_ptr<ICommandQueue> cmdQueue_;
+};
+
+TEST_F(BindlessDescriptorsVulkanTest, OnlyNewDescriptorsAreWritten) {
+  const auto& ctx = getVulkanContext();
+
+  std::vector<std::shared_ptr<ITexture>> textures;
+  for (uint32_t i = 0; i != kNumTexturesPerFrame; i++) {
+    textures.push_back(createTexture());
+  }
+  encodeFrame();
+
+  uint64_t numWritten = ctx.numBindlessDescriptorsWritten_;
+
+  textures.push_back(createTexture());
+  encodeFrame();
+  EXPECT_EQ(ctx.numBindlessDescriptorsWritten_ - numWritten, kDescriptorsPerTexture);
+  numWritten = ctx.numBindlessDescriptorsWritten_;
+
+  // released descriptors are not rewritten while command buffers might access them
+  textures.pop_back();
+  encodeFrame();
+  EXPECT_EQ(ctx.numBindlessDescriptorsWritten_, numWritten);
+}
+
+TEST_F(BindlessDescriptorsVulkanTest, IndicesAreReusedOnceCompleted) {
+  auto texture = createTexture();
+  ASSERT_TRUE(texture != nullptr);
+  const uint64_t textureId = texture->getTextureId();
+  encodeFrame();
+
+  // the index is released by the next update and stays in use until the GPU is done with it
+  texture.reset();
+  auto keepAlive = createTexture();
+  EXPECT_NE(keepAlive->getTextureId(), textureId);
+  encodeFrame()->waitUntilCompleted();
+
+  texture = createTexture();
+  EXPECT_EQ(texture->getTextureId(), textureId);
+}
+
+TEST_F(BindlessDescriptorsVulkanTest, RecycledIndicesAreReset) {
+  const auto& ctx = getVulkanContext();
+
+  auto texture = createTexture();
+  ASSERT_TRUE(texture != nullptr);
+  encodeFrame();
+
+  // the index is released by the next update
+  texture.reset();
+  auto keepAlive = createTexture();
+  encodeFrame()->waitUntilCompleted();
+
+  // once the GPU is done with it, its descriptors no longer reference the destroyed image view
+  const uint64_t numWritten = ctx.numBindlessDescriptorsWritten_;
+  encodeFrame();
+  EXPECT_EQ(ctx.numBindlessDescriptorsWritten_ - numWritten, kDescriptorsPerTexture);
+}
+
+// Creates and destroys kNumTexturesPerFrame textures per frame while kNumTextures textures are
+// alive and reports the time spent updating descriptors. Run it with
+// --gtest_also_run_disabled_tests
+TEST_F(BindlessDescriptorsVulkanTest, DISABLED_StreamTexturesBenchmark) {
+  const auto& ctx = getVulkanContext();
+
+  std::vector<std::shared_ptr<ITexture>> textures;
+  textures.reserve(kNumTextures);
+  for (uint32_t i = 0; i != kNumTextures; i++) {
+    textures.push_back(createTexture());
+  }
+  encodeFrame();
+
+  const uint64_t numWritten = ctx.numBindlessDescriptorsWritten_;
+
+  std::chrono::duration<double, std::milli> encodingTime(0);
+
+  for (uint32_t frame = 0; frame != kNumFrames; frame++) {
+    for (uint32_t i = 0; i != kNumTexturesPerFrame; i++) {
+      textures[(frame * kNumTexturesPerFrame + i) % kNumTextures] = createTexture();
+    }
+    const auto start = std::chrono::steady_clock::now();
+    encodeFrame();
+    encodingTime += std::chrono::steady_clock::now() - start;
+  }
+
+  // only the descriptors of the new textures and of the recycled indices are written
+  EXPECT_LE(ctx.numBindlessDescriptorsWritten_ - numWritten,
+            2 * kDescriptorsPerTexture * kNumTexturesPerFrame * kNumFrames);
+
+  IGL_LOG_INFO("Streaming %u of %u textures per frame: %.3f ms per frame\n",
+               kNumTexturesPerFrame,
+               kNumTextures,
+               encodingTime.count() / kNumFrames);
+}
+
+//
+// BindlessDescriptorsGrowthVulkanTest
+//
+// Unit tests for growable bindless descriptor sets of igl::vulkan::VulkanContext.
+//
+class BindlessDescriptorsGrowthVulkanTest : public ::testing::Test {
+ public:
+  // Set up common resources. This will create a device with small growable descriptor sets
+  void SetUp() override {
+    // Turn off debug break so unit tests can run
+    igl::setDebugBreakEnabled(false);
+
+    igl::vulkan::VulkanContextConfig config = util::device::vulkan::getTestContextConfig();
+    config.maxTextures = kMaxTextures;
+    config.maxSamplers = kMaxSamplers;
+    config.growableBindlessTables = true;
+
+    device_ = util::device::vulkan::createTestDevice(config);
+    ASSERT_TRUE(device_ != nullptr);
+
+    Result ret;
+    cmdQueue_ = device_->createCommandQueue(CommandQueueDesc{CommandQueueType::Graphics}, &ret);
+    ASSERT_TRUE(ret.isOk());
+    ASSERT_TRUE(cmdQueue_ != nullptr);
+  }
+
+  const igl::vulkan::VulkanContext& getVulkanContext() const {
+    return static_cast<igl::vulkan::Device&>(*device_).getVulkanContext();
+  }
+
+  void createTextures(uint32_t numTextures) {
+    Result ret;
+    for (uint32_t i = 0; i != numTextures; i++) {
+      textures_.push_back(device_->createTexture(
+          TextureDesc::new2D(
+              TextureFormat::RGBA_UNorm8, 1, 1, TextureDesc::TextureUsageBits::Sampled),
+          &ret));
+      ASSERT_TRUE(ret.isOk());
+    }
+  }
+
+  // the descriptor sets are updated by command encoders; the returned command buffer is still being
+  // encoded until it is submitted
+  std::shared_ptr<ICommandBuffer> beginEncoding() const {
+    Result ret;
+    auto cmdBuf = cmdQueue_->createCommandBuffer({}, &ret);
+    EXPECT_TRUE(ret.isOk());
+    auto encoder = cmdBuf->createComputeCommandEncoder();
+    EXPECT_TRUE(encoder != nullptr);
+    encoder->endEncoding();
+    return cmdBuf;
+  }
+
+ protected:
+  static constexpr uint32_t kMaxTextures = 16;
+  static constexpr uint32_t kMaxSamplers = 16;
+
+  std::shared_ptr<IDevice> device_;
+  std::shared_ptr<ICommandQueue> cmdQueue_;
+  std::vector<std::shared_ptr<ITexture>> textures_;
+};
+
+TEST_F(BindlessDescriptorsGrowthVulkanTest, DescriptorSetsGrowOnDemand) {
+  const auto& ctx = getVulkanContext();
+  const uint32_t generation = ctx.bindlessGeneration_;
+
+  createTextures(3 * kMaxTextures);
+
+  // the descriptor sets grow when they are updated by the next command encoder
+  auto cmdBuf = beginEncoding();
+  cmdQueue_->submit(*cmdBuf);
+  cmdBuf->waitUntilCompleted();
+
+  // the dummy texture occupies the index 0
+  EXPECT_GE(ctx.bindlessTexturesCapacity_, 3 * kMaxTextures + 1);
+  EXPECT_EQ(ctx.bindlessTexturesHighWaterMark_, 3 * kMaxTextures + 1);
+  EXPECT_EQ(ctx.bindlessSamplersCapacity_, kMaxSamplers);
+  EXPECT_NE(ctx.bindlessGeneration_.load(), generation);
+}
+
+TEST_F(BindlessDescriptorsGrowthVulkanTest, DescriptorSetsGrowWhileOthersAreEncoded) {
+  const auto& ctx = getVulkanContext();
+  const uint32_t generation = ctx.bindlessGeneration_;
+
+  Result ret;
+  auto renderTarget =
+      device_->createTexture(TextureDesc::new2D(TextureFormat::RGBA_UNorm8,
+                                                1,
+                                                1,
+                                                TextureDesc::TextureUsageBits::Sampled |
+                                                    TextureDesc::TextureUsageBits::Attachment),
+                             &ret);
+  ASSERT_TRUE(ret.isOk());
+  FramebufferDesc framebufferDesc;
+  framebufferDesc.colorAttachments[0].texture = renderTarget;
+  auto framebuffer = device_->createFramebuffer(framebufferDesc, &ret);
+  ASSERT_TRUE(ret.isOk());
+
+  // one point in the center of the render target which samples the bound texture
+  const float position[] = {0.0f, 0.0f, 0.0f, 1.0f};
+  const float uv[] = {0.5f, 0.5f};
+  auto vb = device_->createBuffer(
+      BufferDesc(BufferDesc::BufferTypeBits::Vertex, position, sizeof(position)), &ret);
+  ASSERT_TRUE(ret.isOk());
+  auto uvb =
+      device_->createBuffer(BufferDesc(BufferDesc::BufferTypeBits::Vertex, uv, sizeof(uv)), &ret);
+  ASSERT_TRUE(ret.isOk());
+
+  VertexInputStateDesc inputDesc;
+  inputDesc.attributes[0].format = VertexAttributeFormat::Float4;
+  inputDesc.attributes[0].bufferIndex = data::shader::simplePosIndex;
+  inputDesc.attributes[0].name = data::shader::simplePos;
+  inputDesc.attributes[0].location = 0;
+  inputDesc.inputBindings[0].stride = sizeof(position);
+  inputDesc.attributes[1].format = VertexAttributeFormat::Float2;
+  inputDesc.attributes[1].bufferIndex = data::shader::simpleUvIndex;
+  inputDesc.attributes[1].name = data::shader::simpleUv;
+  inputDesc.attributes[1].location = 1;
+  inputDesc.inputBindings[1].stride = sizeof(uv);
+  inputDesc.numAttributes = inputDesc.numInputBindings = 2;
+
+  std::unique_ptr<IShaderStages> stages;
+  util::createSimpleShaderStages(device_, stages);
+  ASSERT_TRUE(stages != nullptr);
+
+  RenderPipelineDesc pipelineDesc;
+  pipelineDesc.vertexInputState = device_->createVertexInputState(inputDesc, &ret);
+  ASSERT_TRUE(ret.isOk());
+  pipelineDesc.shaderStages = std::move(stages);
+  pipelineDesc.targetDesc.colorAttachments.resize(1);
+  pipelineDesc.targetDesc.colorAttachments[0].textureFormat = renderTarget->getFormat();
+  pipelineDesc.cullMode = CullMode::Disabled;
+  auto pipelineState = device_->createRenderPipeline(pipelineDesc, &ret);
+  ASSERT_TRUE(ret.isOk());
+
+  // two other command buffers bind the current descriptor sets and pipeline layouts
+  auto other1 = beginEncoding();
+  auto other2 = beginEncoding();
+
+  // the last texture gets an index beyond the current capacity
+  createTextures(3 * kMaxTextures);
+  const uint32_t color = 0xff00ff00;
+  textures_.back()->upload(TextureRangeDesc::new2D(0, 0, 1, 1), &color);
+
+  // the descriptor sets grow when the next encoder is created, and one of the other command
+  // buffers draws with the new texture
+  RenderPassDesc renderPass;
+  renderPass.colorAttachments.resize(1);
+  renderPass.colorAttachments[0].loadAction = LoadAction::Clear;
+  renderPass.colorAttachments[0].storeAction = StoreAction::Store;
+  renderPass.colorAttachments[0].clearColor = {0.0f, 0.0f, 0.0f, 0.0f};
+  auto encoder = other1->createRenderCommandEncoder(renderPass, framebuffer);
+  ASSERT_TRUE(encoder != nullptr);
+
+  EXPECT_GE(ctx.bindlessTexturesCapacity_, 3 * kMaxTextures + 1);
+  EXPECT_NE(ctx.bindlessGeneration_.load(), generation);
+
+  encoder->bindRenderPipelineState(pipelineState);
+  encoder->bindTexture(0, BindTarget::kFragment, textures_.back());
+  encoder->bindBuffer(data::shader::simplePosIndex, BindTarget::kVertex, vb, 0);
+  encoder->bindBuffer(data::shader::simpleUvIndex, BindTarget::kVertex, uvb, 0);
+  encoder->draw(PrimitiveType::Point, 0, 1);
+  encoder->endEncoding();
+
+  cmdQueue_->submit(*other2);
+  cmdQueue_->submit(*other1);
+  other1->waitUntilCompleted();
+
+  uint32_t pixel = 0;
+  framebuffer->copyBytesColorAttachment(*cmdQueue_, 0, &pixel, TextureRangeDesc::new2D(0, 0, 1, 1));
+  EXPECT_EQ(pixel, color);
+}
+
+} // namespace igl::tests
+
+#endif // IGL_PLATFORM_WIN || IGL_PLATFORM_ANDROID || IGL_PLATFORM_LINUX
@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <array>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <igl/IGL.h>
+#include <igl/QueryPool.h>
+#include <igl/vulkan/Buffer.h>
+#include <igl/vulkan/Device.h>
+#include <igl/vulkan/VulkanContext.h>
+
+#include "../util/TestDevice.h"
+
+namespace igl::tests {
+
+//
+// BufferArenaVulkanTest
+//
+// Unit tests for buffers which are sub-allocated from shared VkBuffers
+// (BufferDesc::BufferAPIHintBits::Pooled).
+//
+class BufferArenaVulkanTest : public ::testing::Test {
+ public:
+  // Set up common resources. This will create a device
+  void SetUp() override {
+    // Turn off debug break so unit tests can run
+    igl::setDebugBreakEnabled(false);
+
+    iglDev_ = util::createTestDevice();
+    ASSERT_NE(iglDev_, nullptr);
+  }
+
+  const vulkan::VulkanContext& getVulkanContext() const {
+    return static_cast<vulkan::Device&>(*iglDev_).getVulkanContext();
+  }
+
+  std::unique_ptr<IBuffer> createBuffer(BufferDesc::BufferType type,
+                                        size_t length,
+                                        BufferDesc::BufferAPIHint hint,
+                                        const void* data = nullptr) const {
+    Result ret;
+    auto buffer = iglDev_->createBuffer(
+        BufferDesc(type, data, length, ResourceStorage::Shared, hint, "BufferArenaVulkanTest"),
+        &ret);
+    EXPECT_EQ(ret.code, Result::Code::Ok);
+    EXPECT_NE(buffer, nullptr);
+    return buffer;
+  }
+
+ public:
+  std::shared_ptr<IDevice> iglDev_;
+};
+
+TEST_F(BufferArenaVulkanTest, SmallBuffersShareVkBuffer) {
+  constexpr std::array<uint32_t, 4> kData = {1, 2, 3, 4};
+
+  auto vertexBuffer = createBuffer(BufferDesc::BufferTypeBits::Vertex,
+                                   sizeof(kData),
+                                   BufferDesc::BufferAPIHintBits::Pooled,
+                                   kData.data());
+  auto uniformBuffer = createBuffer(BufferDesc::BufferTypeBits::Uniform,
+                                    sizeof(kData),
+                                    BufferDesc::BufferAPIHintBits::Pooled,
+                                    kData.data());
+  ASSERT_NE(vertexBuffer, nullptr);
+  ASSERT_NE(uniformBuffer, nullptr);
+
+  const auto& vkVertexBuffer = static_cast<const vulkan::Buffer&>(*vertexBuffer);
+  const auto& vkUniformBuffer = static_cast<const vulkan::Buffer&>(*uniformBuffer);
+
+  EXPECT_TRUE(vertexBuffer->acceptedApiHints() & BufferDesc::BufferAPIHintBits::Pooled);
+  EXPECT_TRUE(uniformBuffer->acceptedApiHints() & BufferDesc::BufferAPIHintBits::Pooled);
+  EXPECT_EQ(vertexBuffer->getSizeInBytes(), sizeof(kData));
+  EXPECT_EQ(vkVertexBuffer.getVkBuffer(), vkUniformBuffer.getVkBuffer());
+  EXPECT_NE(vkVertexBuffer.getVkBufferOffset(), vkUniformBuffer.getVkBufferOffset());
+  EXPECT_EQ(vkUniformBuffer.getVkBufferOffset() %
+                getVulkanContext()
+                    .getVkPhysicalDeviceProperties()
+                    .limits.minUniformBufferOffsetAlignment,
+            0u);
+  EXPECT_EQ(getVulkanContext().bufferArena_->getNumPages(), 1u);
+
+  // buffer device addresses point into the shared buffer
+  EXPECT_EQ(vertexBuffer->gpuAddress() - vkVertexBuffer.getVkBufferOffset(),
+            uniformBuffer->gpuAddress() - vkUniformBuffer.getVkBufferOffset());
+
+  Result ret;
+  const auto* data = uniformBuffer->map(BufferRange(sizeof(kData), 0), &ret);
+  ASSERT_EQ(ret.code, Result::Code::Ok);
+  ASSERT_NE(data, nullptr);
+  EXPECT_EQ(std::memcmp(data, kData.data(), sizeof(kData)), 0);
+  uniformBuffer->unmap();
+}
+
+TEST_F(BufferArenaVulkanTest, OnlySmallBuffersArePooled) {
+  const auto& ctx = getVulkanContext();
+
+  auto unpooledBuffer = createBuffer(BufferDesc::BufferTypeBits::Vertex, 256, 0);
+  auto largeBuffer = createBuffer(BufferDesc::BufferTypeBits::Vertex,
+                                  ctx.config_.maxBufferArenaAllocationSize + 1,
+                                  BufferDesc::BufferAPIHintBits::Pooled);
+  auto storageBuffer = createBuffer(
+      BufferDesc::BufferTypeBits::Storage, 256, BufferDesc::BufferAPIHintBits::Pooled);
+
+  for (const auto* buffer : {unpooledBuffer.get(), largeBuffer.get(), storageBuffer.get()}) {
+    ASSERT_NE(buffer, nullptr);
+    EXPECT_FALSE(buffer->acceptedApiHints() & BufferDesc::BufferAPIHintBits::Pooled);
+    EXPECT_EQ(static_cast<const vulkan::Buffer*>(buffer)->getVkBufferOffset(), 0u);
+  }
+
+  EXPECT_EQ(ctx.bufferArena_->getNumPages(), 0u);
+}
+
+TEST_F(BufferArenaVulkanTest, QueryResultsAreCopiedIntoPooledBuffers) {
+  if (!iglDev_->hasFeature(DeviceFeatures::OcclusionQueries)) {
+    GTEST_SKIP() << "Occlusion queries are not supported";
+  }
+
+  constexpr std::array<uint64_t, 2> kData = {~0ull, ~0ull};
+
+  // the second buffer starts at a non-zero offset within the shared VkBuffer
+  auto firstBuffer = createBuffer(BufferDesc::BufferTypeBits::Uniform,
+                                  sizeof(kData),
+                                  BufferDesc::BufferAPIHintBits::Pooled,
+                                  kData.data());
+  auto secondBuffer = createBuffer(BufferDesc::BufferTypeBits::Uniform,
+                                   sizeof(kData),
+                                   BufferDesc::BufferAPIHintBits::Pooled,
+                                   kData.data());
+  ASSERT_NE(firstBuffer, nullptr);
+  ASSERT_NE(secondBuffer, nullptr);
+  ASSERT_NE(static_cast<const vulkan::Buffer&>(*secondBuffer).getVkBufferOffset(), 0u);
+
+  Result ret;
+  auto pool = iglDev_->createQueryPool({QueryType::BinaryOcclusion, 1}, &ret);
+  ASSERT_EQ(ret.code, Result::Code::Ok);
+
+  auto texture = iglDev_->createTexture(
+      TextureDesc::new2D(
+          TextureFormat::RGBA_UNorm8, 1, 1, TextureDesc::TextureUsageBits::Attachment),
+      &ret);
+  ASSERT_EQ(ret.code, Result::Code::Ok);
+  FramebufferDesc framebufferDesc;
+  framebufferDesc.colorAttachments[0].texture = texture;
+  auto framebuffer = iglDev_->createFramebuffer(framebufferDesc, &ret);
+  ASSERT_EQ(ret.code, Result::Code::Ok);
+
+  RenderPassDesc renderPass;
+  renderPass.colorAttachments.resize(1);
+  renderPass.colorAttachments[0].loadAction = LoadAction::Clear;
+  renderPass.colorAttachments[0].storeAction = StoreAction::Store;
+
+  auto cmdQueue = iglDev_->createCommandQueue(CommandQueueDesc{CommandQueueType::Graphics}, &ret);
+  ASSERT_EQ(ret.code, Result::Code::Ok);
+  auto cmdBuf = cmdQueue->createCommandBuffer({}, &ret);
+  ASSERT_EQ(ret.code, Result::Code::Ok);
+
+  cmdBuf->resetQueries(*pool, 0, 1);
+  auto encoder = cmdBuf->createRenderCommandEncoder(renderPass, framebuffer, &ret);
+  ASSERT_EQ(ret.code, Result::Code::Ok);
+  encoder->beginQuery(*pool, 0);
+  encoder->endQuery(*pool, 0);
+  encoder->endEncoding();
+
+  // an empty render pass is occluded, so the result is 0
+  cmdBuf->copyQueryResults(*pool, 0, 1, *secondBuffer, sizeof(uint64_t));
+  cmdQueue->submit(*cmdBuf);
+  cmdBuf->waitUntilCompleted();
+
+  for (auto* buffer : {firstBuffer.get(), secondBuffer.get()}) {
+    const auto* data =
+        static_cast<const uint64_t*>(buffer->map(BufferRange(sizeof(kData), 0), &ret));
+    ASSERT_EQ(ret.code, Result::Code::Ok);
+    ASSERT_NE(data, nullptr);
+    EXPECT_EQ(data[0], kData[0]);
+    EXPECT_EQ(data[1], buffer == secondBuffer.get() ? 0u : kData[1]);
+    buffer->unmap();
+  }
+}
+
+} // namespace igl::tests
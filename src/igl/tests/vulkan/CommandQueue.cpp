@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <igl/IGL.h>
+#include <igl/vulkan/CommandQueue.h>
+#include <igl/vulkan/Device.h>
+#include <igl/vulkan/SyncManager.h>
+#include <igl/vulkan/VulkanContext.h>
+#include <memory>
+#include <vector>
+
+#include "../util/device/vulkan/TestDevice.h"
+
+#if IGL_PLATFORM_WIN || IGL_PLATFORM_ANDROID || IGL_PLATFORM_LINUX
+
+namespace igl::tests {
+
+namespace {
+constexpr uint32_t kFramesInFlight = 3;
+} // namespace
+
+//
+// CommandQueueVulkanTest
+//
+// Unit tests for multiple open command buffers and explicit frame pacing in
+// igl::vulkan::CommandQueue.
+//
+class CommandQueueVulkanTest : public ::testing::Test {
+ public:
+  // Set up common resources. This will create a device with explicit frame pacing
+  void SetUp() override {
+    // Turn off debug break so unit tests can run
+    igl::setDebugBreakEnabled(false);
+
+    igl::vulkan::VulkanContextConfig config = util::device::vulkan::getTestContextConfig();
+    config.enableGPUAssistedValidation = false;
+    config.maxResourceCount = kFramesInFlight;
+    config.explicitFramePacing = true;
+
+    device_ = util::device::vulkan::createTestDevice(config);
+    ASSERT_TRUE(device_ != nullptr);
+
+    Result ret;
+    cmdQueue_ = device_->createCommandQueue(CommandQueueDesc{CommandQueueType::Graphics}, &ret);
+    ASSERT_TRUE(ret.isOk());
+    ASSERT_TRUE(cmdQueue_ != nullptr);
+  }
+
+  igl::vulkan::VulkanContext& getVulkanContext() const {
+    return static_cast<igl::vulkan::Device&>(*device_).getVulkanContext();
+  }
+
+ protected:
+  std::shared_ptr<IDevice> device_;
+  std::shared_ptr<ICommandQueue> cmdQueue_;
+};
+
+TEST_F(CommandQueueVulkanTest, SubmitOpenCommandBuffersInAnyOrder) {
+  Result ret;
+  auto cmdBuf1 = cmdQueue_->createCommandBuffer({}, &ret);
+  ASSERT_TRUE(ret.isOk());
+  auto cmdBuf2 = cmdQueue_->createCommandBuffer({}, &ret);
+  ASSERT_TRUE(ret.isOk());
+  ASSERT_TRUE(cmdBuf1 != nullptr);
+  ASSERT_TRUE(cmdBuf2 != nullptr);
+
+  EXPECT_NE(cmdQueue_->submit(*cmdBuf2), 0u);
+  EXPECT_NE(cmdQueue_->submit(*cmdBuf1), 0u);
+
+  cmdBuf1->waitUntilCompleted();
+  cmdBuf2->waitUntilCompleted();
+}
+
+TEST_F(CommandQueueVulkanTest, TooManyOpenCommandBuffers) {
+  Result ret;
+  std::vector<std::shared_ptr<ICommandBuffer>> cmdBuffers;
+  for (uint32_t i = 0; i != igl::vulkan::CommandQueue::kMaxOpenCommandBuffers; i++) {
+    cmdBuffers.push_back(cmdQueue_->createCommandBuffer({}, &ret));
+    ASSERT_TRUE(ret.isOk());
+  }
+
+  auto cmdBuf = cmdQueue_->createCommandBuffer({}, &ret);
+  EXPECT_EQ(ret.code, Result::Code::InvalidOperation);
+  EXPECT_TRUE(cmdBuf == nullptr);
+
+  for (const auto& cmdBuffer : cmdBuffers) {
+    cmdQueue_->submit(*cmdBuffer);
+  }
+
+  cmdBuf = cmdQueue_->createCommandBuffer({}, &ret);
+  EXPECT_TRUE(ret.isOk());
+  ASSERT_TRUE(cmdBuf != nullptr);
+  cmdQueue_->submit(*cmdBuf);
+}
+
+TEST_F(CommandQueueVulkanTest, TooManyOpenCommandBuffersOnAllQueues) {
+  Result ret;
+  auto otherQueue =
+      device_->createCommandQueue(CommandQueueDesc{CommandQueueType::Graphics}, &ret);
+  ASSERT_TRUE(ret.isOk());
+
+  // the queues share one pool of command buffers
+  std::vector<std::shared_ptr<ICommandBuffer>> cmdBuffers;
+  for (uint32_t i = 0; i != igl::vulkan::CommandQueue::kMaxOpenCommandBuffers; i++) {
+    auto& queue = i % 2 ? otherQueue : cmdQueue_;
+    cmdBuffers.push_back(queue->createCommandBuffer({}, &ret));
+    ASSERT_TRUE(ret.isOk());
+  }
+
+  for (const auto& queue : {cmdQueue_, otherQueue}) {
+    auto cmdBuf = queue->createCommandBuffer({}, &ret);
+    EXPECT_EQ(ret.code, Result::Code::InvalidOperation);
+    EXPECT_TRUE(cmdBuf == nullptr);
+  }
+
+  for (size_t i = 0; i != cmdBuffers.size(); i++) {
+    (i % 2 ? otherQueue : cmdQueue_)->submit(*cmdBuffers[i]);
+  }
+}
+
+TEST_F(CommandQueueVulkanTest, DependenciesDeferSubmission) {
+  const auto& ctx = getVulkanContext();
+
+  Result ret;
+  auto shadowPass = cmdQueue_->createCommandBuffer({}, &ret);
+  ASSERT_TRUE(ret.isOk());
+
+  CommandBufferDesc desc;
+  desc.dependencies.push_back(shadowPass);
+  auto mainPass = cmdQueue_->createCommandBuffer(desc, &ret);
+  ASSERT_TRUE(ret.isOk());
+
+  // the main pass cannot be submitted before the shadow pass
+  EXPECT_EQ(cmdQueue_->submit(*mainPass), 0u);
+
+  const SubmitHandle shadowHandle = cmdQueue_->submit(*shadowPass);
+  EXPECT_NE(shadowHandle, 0u);
+
+  // the main pass was submitted right after the shadow pass
+  const SubmitHandle mainHandle = ctx.immediate_->getLastSubmitHandle().handle();
+  EXPECT_NE(mainHandle, shadowHandle);
+
+  mainPass->waitUntilCompleted();
+  EXPECT_TRUE(ctx.immediate_->isReady(
+      igl::vulkan::VulkanImmediateCommands::SubmitHandle(shadowHandle)));
+}
+
+TEST_F(CommandQueueVulkanTest, InvalidDependencies) {
+  Result ret;
+  CommandBufferDesc desc;
+  desc.dependencies.push_back(nullptr);
+  auto cmdBuf = cmdQueue_->createCommandBuffer(desc, &ret);
+  EXPECT_EQ(ret.code, Result::Code::ArgumentNull);
+  EXPECT_TRUE(cmdBuf == nullptr);
+
+  auto otherQueue =
+      device_->createCommandQueue(CommandQueueDesc{CommandQueueType::Graphics}, &ret);
+  ASSERT_TRUE(ret.isOk());
+  auto otherCmdBuf = otherQueue->createCommandBuffer({}, &ret);
+  ASSERT_TRUE(ret.isOk());
+
+  desc.dependencies = {otherCmdBuf};
+  cmdBuf = cmdQueue_->createCommandBuffer(desc, &ret);
+  EXPECT_EQ(ret.code, Result::Code::ArgumentInvalid);
+  EXPECT_TRUE(cmdBuf == nullptr);
+
+  otherQueue->submit(*otherCmdBuf);
+}
+
+TEST_F(CommandQueueVulkanTest, DestroyedCommandBuffersReleaseTheirSlots) {
+  Result ret;
+  for (uint32_t i = 0; i != igl::vulkan::CommandQueue::kMaxOpenCommandBuffers + 1; i++) {
+    auto cmdBuf = cmdQueue_->createCommandBuffer({}, &ret);
+    ASSERT_TRUE(ret.isOk());
+    ASSERT_TRUE(cmdBuf != nullptr);
+  }
+}
+
+TEST_F(CommandQueueVulkanTest, ExplicitFramePacing) {
+  const auto& ctx = getVulkanContext();
+
+  ASSERT_EQ(ctx.syncManager_->maxResourceCount(), kFramesInFlight);
+
+  for (uint32_t frame = 0; frame != 2 * kFramesInFlight; frame++) {
+    const uint32_t index = ctx.syncManager_->currentIndex();
+
+    // a frame can consist of several command buffers
+    Result ret;
+    auto shadowPass = cmdQueue_->createCommandBuffer({}, &ret);
+    ASSERT_TRUE(ret.isOk());
+    auto mainPass = cmdQueue_->createCommandBuffer({}, &ret);
+    ASSERT_TRUE(ret.isOk());
+
+    cmdQueue_->submit(*shadowPass);
+    EXPECT_EQ(ctx.syncManager_->currentIndex(), index);
+
+    cmdQueue_->submit(*mainPass, true);
+    EXPECT_EQ(ctx.syncManager_->currentIndex(), (index + 1) % kFramesInFlight);
+  }
+}
+
+} // namespace igl::tests
+
+#endif // IGL_PLATFORM_WIN || IGL_PLATFORM_ANDROID || IGL_PLATFORM_LINUX
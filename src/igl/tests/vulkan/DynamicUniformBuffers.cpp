@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <igl/IGL.h>
+#include <igl/ShaderCreator.h>
+#include <igl/vulkan/Device.h>
+#include <igl/vulkan/VulkanContext.h>
+#include <memory>
+#include <vector>
+
+#include "../util/device/vulkan/TestDevice.h"
+
+#if IGL_PLATFORM_WIN || IGL_PLATFORM_ANDROID || IGL_PLATFORM_LINUX
+
+namespace igl::tests {
+
+namespace {
+// a DUB is at most 256 KB and holds 256-byte bindings
+constexpr size_t kMaxBindingsPerDUB = 1024;
+
+const char kComputeShader[] = R"(
+layout (local_size_x = 1) in;
+void main() {}
+)";
+} // namespace
+
+//
+// DynamicUniformBuffersVulkanTest
+//
+// Unit tests for the ring of dynamic uniform buffers (DUBs) of igl::vulkan::VulkanContext, which
+// receives the bindings of the command encoders.
+//
+class DynamicUniformBuffersVulkanTest : public ::testing::Test {
+ public:
+  // Set up common resources. This will create a device with the smallest ring of DUBs
+  void SetUp() override {
+    // Turn off debug break so unit tests can run
+    igl::setDebugBreakEnabled(false);
+
+    igl::vulkan::VulkanContextConfig config = util::device::vulkan::getTestContextConfig();
+    config.maxResourceCount = 1;
+
+    device_ = util::device::vulkan::createTestDevice(config);
+    ASSERT_TRUE(device_ != nullptr);
+
+    Result ret;
+    cmdQueue_ = device_->createCommandQueue(CommandQueueDesc{CommandQueueType::Graphics}, &ret);
+    ASSERT_TRUE(ret.isOk());
+    ASSERT_TRUE(cmdQueue_ != nullptr);
+
+    ComputePipelineDesc desc;
+    desc.shaderStages =
+        ShaderStagesCreator::fromModuleStringInput(*device_, kComputeShader, "main", "", &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message;
+    computePipeline_ = device_->createComputePipeline(desc, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message;
+    ASSERT_TRUE(computePipeline_ != nullptr);
+  }
+
+  const igl::vulkan::VulkanContext& getVulkanContext() const {
+    return static_cast<igl::vulkan::Device&>(*device_).getVulkanContext();
+  }
+
+  // encodes `numDispatches` dispatches within a single command buffer. Every dispatch binds a
+  // storage buffer, either with a different offset each time or always with the same one
+  std::shared_ptr<ICommandBuffer> encodeDispatches(size_t numDispatches,
+                                                   bool differentBindings,
+                                                   size_t* numGrownDUBs) {
+    constexpr size_t kOffsetStep = 16;
+
+    Result ret;
+    buffer_ = device_->createBuffer(BufferDesc(BufferDesc::BufferTypeBits::Storage,
+                                               nullptr,
+                                               numDispatches * kOffsetStep,
+                                               ResourceStorage::Private),
+                                    &ret);
+    EXPECT_TRUE(ret.isOk()) << ret.message;
+
+    auto cmdBuf = cmdQueue_->createCommandBuffer({}, &ret);
+    EXPECT_TRUE(ret.isOk());
+    auto encoder = cmdBuf->createComputeCommandEncoder();
+    EXPECT_TRUE(encoder != nullptr);
+    encoder->bindComputePipelineState(computePipeline_);
+
+    const auto& ctx = getVulkanContext();
+    const size_t numDUBs = ctx.DUBs_->getNumDUBs();
+    for (size_t i = 0; i != numDispatches; i++) {
+      encoder->bindBuffer(0, buffer_, differentBindings ? i * kOffsetStep : 0);
+      encoder->dispatchThreadGroups(Dimensions(1, 1, 1), Dimensions(1, 1, 1));
+      if (numGrownDUBs && ctx.DUBs_->getNumDUBs() != numDUBs) {
+        *numGrownDUBs = i + 1;
+        break;
+      }
+    }
+
+    encoder->endEncoding();
+    cmdQueue_->submit(*cmdBuf);
+    return cmdBuf;
+  }
+
+ protected:
+  std::shared_ptr<IDevice> device_;
+  std::shared_ptr<ICommandQueue> cmdQueue_;
+  std::shared_ptr<IComputePipelineState> computePipeline_;
+  std::shared_ptr<IBuffer> buffer_;
+};
+
+TEST_F(DynamicUniformBuffersVulkanTest, RingGrowsWithinSubmit) {
+  const auto& ctx = getVulkanContext();
+  const size_t numDUBs = ctx.DUBs_->getNumDUBs();
+  ASSERT_GT(numDUBs, 0u);
+
+  // a single command buffer which needs more DUBs than the ring holds
+  size_t numDispatches = 0;
+  encodeDispatches(numDUBs * kMaxBindingsPerDUB + 1, true, &numDispatches)->waitUntilCompleted();
+  ASSERT_GT(numDispatches, 0u);
+  EXPECT_EQ(ctx.DUBs_->getNumDUBs(), numDUBs + 1);
+
+  // once the GPU is done with it, the grown ring is reused
+  encodeDispatches(numDispatches, true, nullptr)->waitUntilCompleted();
+  EXPECT_EQ(ctx.DUBs_->getNumDUBs(), numDUBs + 1);
+}
+
+TEST_F(DynamicUniformBuffersVulkanTest, SameBindingsAreUploadedOnce) {
+  const auto& ctx = getVulkanContext();
+  const size_t numDUBs = ctx.DUBs_->getNumDUBs();
+  ASSERT_GT(numDUBs, 0u);
+
+  // binding the same buffer again does not take any more space in the DUBs
+  encodeDispatches(numDUBs * kMaxBindingsPerDUB + 1, false, nullptr)->waitUntilCompleted();
+  EXPECT_EQ(ctx.DUBs_->getNumDUBs(), numDUBs);
+}
+
+} // namespace igl::tests
+
+#endif // IGL_PLATFORM_WIN || IGL_PLATFORM_ANDROID || IGL_PLATFORM_LINUX
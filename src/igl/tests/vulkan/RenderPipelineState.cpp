@@ -0,0 +1,340 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <igl/IGL.h>
+#include <igl/vulkan/Common.h>
+#include <igl/vulkan/Device.h>
+#include <igl/vulkan/RenderCommandEncoder.h>
+#include <igl/vulkan/RenderPipelineState.h>
+#include <igl/vulkan/VulkanPipelineBuilder.h>
+
+#include "../data/ShaderData.h"
+#include "../util/Common.h"
+
+namespace igl {
+namespace tests {
+
+//
+// RenderPipelineStateVulkanTest
+//
+// Unit tests for prewarming of Vulkan pipelines in igl::vulkan::RenderPipelineState.
+//
+class RenderPipelineStateVulkanTest : public ::testing::Test {
+ public:
+  // Set up common resources. This will create a device, a command queue, a render pipeline state
+  // and the dynamic state of a render pass which renders into an offscreen texture
+  void SetUp() override {
+    setDebugBreakEnabled(false);
+
+    util::createDeviceAndQueue(iglDev_, cmdQueue_);
+    ASSERT_TRUE(iglDev_ != nullptr);
+    ASSERT_TRUE(cmdQueue_ != nullptr);
+
+    Result ret;
+
+    const TextureDesc texDesc = TextureDesc::new2D(TextureFormat::RGBA_UNorm8,
+                                                   2,
+                                                   2,
+                                                   TextureDesc::TextureUsageBits::Sampled |
+                                                       TextureDesc::TextureUsageBits::Attachment);
+    auto texture = iglDev_->createTexture(texDesc, &ret);
+    ASSERT_TRUE(ret.isOk());
+
+    FramebufferDesc framebufferDesc;
+    framebufferDesc.colorAttachments[0].texture = texture;
+    auto framebuffer = iglDev_->createFramebuffer(framebufferDesc, &ret);
+    ASSERT_TRUE(ret.isOk());
+
+    std::unique_ptr<IShaderStages> stages;
+    util::createSimpleShaderStages(iglDev_, stages);
+    ASSERT_TRUE(stages != nullptr);
+
+    RenderPipelineDesc pipelineDesc;
+    pipelineDesc.shaderStages = std::move(stages);
+    pipelineDesc.targetDesc.colorAttachments.resize(1);
+    pipelineDesc.targetDesc.colorAttachments[0].textureFormat = texture->getFormat();
+    pipelineState_ = iglDev_->createRenderPipeline(pipelineDesc, &ret);
+    ASSERT_TRUE(ret.isOk());
+    ASSERT_TRUE(pipelineState_ != nullptr);
+
+    // the render pass index is assigned by a render command encoder
+    RenderPassDesc renderPass;
+    renderPass.colorAttachments.resize(1);
+    renderPass.colorAttachments[0].loadAction = LoadAction::Clear;
+    renderPass.colorAttachments[0].storeAction = StoreAction::Store;
+
+    auto cmdBuf = cmdQueue_->createCommandBuffer({}, &ret);
+    ASSERT_TRUE(ret.isOk());
+    auto encoder = cmdBuf->createRenderCommandEncoder(renderPass, framebuffer);
+    ASSERT_TRUE(encoder != nullptr);
+    dynamicState_ = static_cast<vulkan::RenderCommandEncoder&>(*encoder).getDynamicState();
+    encoder->endEncoding();
+    cmdQueue_->submit(*cmdBuf);
+  }
+
+  const vulkan::RenderPipelineState& getPipelineState() const {
+    return static_cast<const vulkan::RenderPipelineState&>(*pipelineState_);
+  }
+
+ protected:
+  std::shared_ptr<IDevice> iglDev_;
+  std::shared_ptr<ICommandQueue> cmdQueue_;
+  std::shared_ptr<IRenderPipelineState> pipelineState_;
+  vulkan::RenderPipelineDynamicState dynamicState_;
+};
+
+TEST_F(RenderPipelineStateVulkanTest, Prewarm) {
+  std::vector<vulkan::RenderPipelineDynamicState> dynamicStates;
+  // topologies of different classes need different pipelines even with extended dynamic state
+  for (const auto topology : {VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST,
+                              VK_PRIMITIVE_TOPOLOGY_POINT_LIST,
+                              VK_PRIMITIVE_TOPOLOGY_LINE_LIST}) {
+    dynamicStates.push_back(dynamicState_);
+    dynamicStates.back().setTopology(topology);
+  }
+
+  const uint32_t numPipelines = vulkan::VulkanPipelineBuilder::getNumPipelinesCreated();
+
+  getPipelineState().prewarm(dynamicStates);
+  // already built or pending pipelines are not built twice
+  getPipelineState().prewarm(dynamicStates);
+
+  for (const auto& dynamicState : dynamicStates) {
+    EXPECT_NE(getPipelineState().getVkPipeline(dynamicState), VK_NULL_HANDLE);
+  }
+
+  EXPECT_EQ(vulkan::VulkanPipelineBuilder::getNumPipelinesCreated(),
+            numPipelines + dynamicStates.size());
+
+  // prewarmed pipelines are returned without waiting
+  for (const auto& dynamicState : dynamicStates) {
+    EXPECT_NE(getPipelineState().getVkPipeline(dynamicState, false), VK_NULL_HANDLE);
+  }
+}
+
+TEST_F(RenderPipelineStateVulkanTest, DoNotWait) {
+  dynamicState_.setTopology(VK_PRIMITIVE_TOPOLOGY_LINE_STRIP);
+
+  // the pipeline is scheduled for building on a worker thread
+  EXPECT_EQ(getPipelineState().getVkPipeline(dynamicState_, false), VK_NULL_HANDLE);
+
+  EXPECT_NE(getPipelineState().getVkPipeline(dynamicState_), VK_NULL_HANDLE);
+
+  // the pipeline can be replaced by an optimized one, but it is never built again
+  const uint32_t numPipelines = vulkan::VulkanPipelineBuilder::getNumPipelinesCreated();
+  EXPECT_NE(getPipelineState().getVkPipeline(dynamicState_, false), VK_NULL_HANDLE);
+  EXPECT_EQ(vulkan::VulkanPipelineBuilder::getNumPipelinesCreated(), numPipelines);
+}
+
+TEST_F(RenderPipelineStateVulkanTest, SpecializationConstants) {
+  const std::vector<SpecializationConstant> constants = {
+      SpecializationConstant::fromBool(0, "kEnabled", true),
+      SpecializationConstant::fromInt(1, "kCount", -3),
+      SpecializationConstant::fromFloat(2, "kScale", 0.5f),
+  };
+
+  std::vector<VkSpecializationMapEntry> entries;
+  std::vector<uint32_t> data;
+  VkSpecializationInfo info = {};
+  EXPECT_EQ(vulkan::getVkSpecializationInfo({}, entries, data, info), nullptr);
+
+  const VkSpecializationInfo* specialization =
+      vulkan::getVkSpecializationInfo(constants, entries, data, info);
+  ASSERT_EQ(specialization, &info);
+  ASSERT_EQ(info.mapEntryCount, 3u);
+  EXPECT_EQ(info.dataSize, 3 * sizeof(uint32_t));
+  EXPECT_EQ(info.pMapEntries[2].constantID, 2u);
+  EXPECT_EQ(info.pMapEntries[2].offset, 2 * sizeof(uint32_t));
+  EXPECT_EQ(static_cast<const uint32_t*>(info.pData)[0], 1u);
+  EXPECT_EQ(static_cast<const int32_t*>(info.pData)[1], -3);
+  EXPECT_EQ(static_cast<const float*>(info.pData)[2], 0.5f);
+
+  // constants which are not used by the shaders are ignored
+  RenderPipelineDesc desc = getPipelineState().getRenderPipelineDesc();
+  desc.specializationConstants = constants;
+
+  Result ret;
+  auto pipelineState = iglDev_->createRenderPipeline(desc, &ret);
+  ASSERT_TRUE(ret.isOk());
+  ASSERT_TRUE(pipelineState != nullptr);
+  EXPECT_NE(static_cast<const vulkan::RenderPipelineState&>(*pipelineState)
+                .getVkPipeline(dynamicState_),
+            VK_NULL_HANDLE);
+}
+
+TEST_F(RenderPipelineStateVulkanTest, ExtendedDynamicState) {
+  const auto& ctx = static_cast<const vulkan::Device&>(*iglDev_).getVulkanContext();
+  if (!ctx.hasExtendedDynamicState_) {
+    GTEST_SKIP() << "VK_EXT_extended_dynamic_state is not supported";
+  }
+
+  dynamicState_.setTopology(VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST);
+  const VkPipeline pipeline = getPipelineState().getVkPipeline(dynamicState_);
+  ASSERT_NE(pipeline, VK_NULL_HANDLE);
+
+  const uint32_t numPipelines = vulkan::VulkanPipelineBuilder::getNumPipelinesCreated();
+
+  // depth and stencil states and topologies of the same class are set with vkCmdSet*()
+  vulkan::RenderPipelineDynamicState dynamicState = dynamicState_;
+  dynamicState.setTopology(VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP);
+  dynamicState.setDepthCompareOp(VK_COMPARE_OP_LESS);
+  dynamicState.depthWriteEnable_ = true;
+  dynamicState.setStencilStateOps(true,
+                                  VK_STENCIL_OP_REPLACE,
+                                  VK_STENCIL_OP_REPLACE,
+                                  VK_STENCIL_OP_KEEP,
+                                  VK_COMPARE_OP_EQUAL);
+  EXPECT_NE(getPipelineState().getVkPipeline(dynamicState), VK_NULL_HANDLE);
+  EXPECT_EQ(vulkan::VulkanPipelineBuilder::getNumPipelinesCreated(), numPipelines);
+
+  // a different topology class needs another pipeline
+  dynamicState.setTopology(VK_PRIMITIVE_TOPOLOGY_LINE_LIST);
+  EXPECT_NE(getPipelineState().getVkPipeline(dynamicState), pipeline);
+  EXPECT_EQ(vulkan::VulkanPipelineBuilder::getNumPipelinesCreated(), numPipelines + 1);
+}
+
+TEST_F(RenderPipelineStateVulkanTest, DynamicRendering) {
+  const auto& ctx = static_cast<const vulkan::Device&>(*iglDev_).getVulkanContext();
+  if (!ctx.useDynamicRendering_) {
+    GTEST_SKIP() << "VK_KHR_dynamic_rendering is not supported";
+  }
+
+  // render command encoders do not create render passes
+  EXPECT_TRUE(ctx.renderPasses_.empty());
+  EXPECT_EQ(dynamicState_.renderPassIndex_, 0u);
+  EXPECT_FALSE(dynamicState_.isStereo_);
+
+  // the pipeline is created against the attachment formats of its descriptor
+  EXPECT_NE(getPipelineState().getVkPipeline(dynamicState_), VK_NULL_HANDLE);
+}
+
+TEST_F(RenderPipelineStateVulkanTest, DynamicRenderingKeepsOtherMipLevels) {
+  const auto& ctx = static_cast<const vulkan::Device&>(*iglDev_).getVulkanContext();
+  if (!ctx.useDynamicRendering_) {
+    GTEST_SKIP() << "VK_KHR_dynamic_rendering is not supported";
+  }
+
+  Result ret;
+  TextureDesc texDesc = TextureDesc::new2D(TextureFormat::RGBA_UNorm8,
+                                           4,
+                                           4,
+                                           TextureDesc::TextureUsageBits::Sampled |
+                                               TextureDesc::TextureUsageBits::Attachment);
+  texDesc.numMipLevels = 2;
+  auto texture = iglDev_->createTexture(texDesc, &ret);
+  ASSERT_TRUE(ret.isOk());
+
+  FramebufferDesc framebufferDesc;
+  framebufferDesc.colorAttachments[0].texture = texture;
+  auto framebuffer = iglDev_->createFramebuffer(framebufferDesc, &ret);
+  ASSERT_TRUE(ret.isOk());
+
+  // clear each mip level without loading its previous contents
+  const auto clearMipLevel = [&](uint8_t mipLevel, const Color& color) {
+    RenderPassDesc renderPass;
+    renderPass.colorAttachments.resize(1);
+    renderPass.colorAttachments[0].loadAction = LoadAction::Clear;
+    renderPass.colorAttachments[0].storeAction = StoreAction::Store;
+    renderPass.colorAttachments[0].clearColor = color;
+    renderPass.colorAttachments[0].mipmapLevel = mipLevel;
+
+    auto cmdBuf = cmdQueue_->createCommandBuffer({}, &ret);
+    ASSERT_TRUE(ret.isOk());
+    auto encoder = cmdBuf->createRenderCommandEncoder(renderPass, framebuffer);
+    ASSERT_TRUE(encoder != nullptr);
+    encoder->endEncoding();
+    cmdQueue_->submit(*cmdBuf);
+    cmdBuf->waitUntilCompleted();
+  };
+
+  clearMipLevel(0, Color(1.0f, 0.0f, 0.0f, 1.0f));
+  clearMipLevel(1, Color(0.0f, 1.0f, 0.0f, 1.0f));
+
+  // rendering into mip level 1 does not discard mip level 0
+  std::vector<uint32_t> pixels(4 * 4);
+  framebuffer->copyBytesColorAttachment(
+      *cmdQueue_, 0, pixels.data(), TextureRangeDesc::new2D(0, 0, 4, 4, 0));
+  for (const auto& pixel : pixels) {
+    ASSERT_EQ(pixel, 0xff0000ffu);
+  }
+
+  pixels.resize(2 * 2);
+  framebuffer->copyBytesColorAttachment(
+      *cmdQueue_, 0, pixels.data(), TextureRangeDesc::new2D(0, 0, 2, 2, 1));
+  for (const auto& pixel : pixels) {
+    ASSERT_EQ(pixel, 0xff00ff00u);
+  }
+}
+
+TEST_F(RenderPipelineStateVulkanTest, PipelineLibraries) {
+  const auto& ctx = static_cast<const vulkan::Device&>(*iglDev_).getVulkanContext();
+  if (!ctx.pipelineLibraries_) {
+    GTEST_SKIP() << "VK_EXT_graphics_pipeline_library is not supported";
+  }
+
+  ASSERT_NE(getPipelineState().getVkPipeline(dynamicState_), VK_NULL_HANDLE);
+
+  const size_t numLibraries = ctx.pipelineLibraries_->getNumLibraries();
+
+  // only the pre-rasterization shaders library depends on the cull mode
+  RenderPipelineDesc desc = getPipelineState().getRenderPipelineDesc();
+  desc.cullMode = desc.cullMode == CullMode::Back ? CullMode::Front : CullMode::Back;
+
+  Result ret;
+  auto pipelineState = iglDev_->createRenderPipeline(desc, &ret);
+  ASSERT_TRUE(ret.isOk());
+  ASSERT_TRUE(pipelineState != nullptr);
+  EXPECT_NE(static_cast<const vulkan::RenderPipelineState&>(*pipelineState)
+                .getVkPipeline(dynamicState_),
+            VK_NULL_HANDLE);
+  EXPECT_EQ(ctx.pipelineLibraries_->getNumLibraries(), numLibraries + 1);
+}
+
+TEST_F(RenderPipelineStateVulkanTest, PipelineLibrariesOfDestroyedShaderModules) {
+  const auto& ctx = static_cast<const vulkan::Device&>(*iglDev_).getVulkanContext();
+  if (!ctx.pipelineLibraries_) {
+    GTEST_SKIP() << "VK_EXT_graphics_pipeline_library is not supported";
+  }
+
+  ASSERT_NE(getPipelineState().getVkPipeline(dynamicState_), VK_NULL_HANDLE);
+
+  const size_t numLibraries = ctx.pipelineLibraries_->getNumLibraries();
+
+  Result ret;
+  {
+    std::unique_ptr<IShaderStages> stages;
+    util::createSimpleShaderStages(iglDev_, stages);
+    ASSERT_TRUE(stages != nullptr);
+
+    RenderPipelineDesc desc = getPipelineState().getRenderPipelineDesc();
+    desc.shaderStages = std::move(stages);
+    auto pipelineState = iglDev_->createRenderPipeline(desc, &ret);
+    ASSERT_TRUE(ret.isOk());
+    ASSERT_TRUE(pipelineState != nullptr);
+    EXPECT_NE(static_cast<const vulkan::RenderPipelineState&>(*pipelineState)
+                  .getVkPipeline(dynamicState_),
+              VK_NULL_HANDLE);
+
+    // other shader modules need their own pre-rasterization and fragment shader libraries
+    EXPECT_EQ(ctx.pipelineLibraries_->getNumLibraries(), numLibraries + 2);
+  }
+
+  // the libraries of the destroyed shader modules are evicted once another library is added
+  RenderPipelineDesc desc = getPipelineState().getRenderPipelineDesc();
+  desc.cullMode = desc.cullMode == CullMode::Back ? CullMode::Front : CullMode::Back;
+  auto pipelineState = iglDev_->createRenderPipeline(desc, &ret);
+  ASSERT_TRUE(ret.isOk());
+  ASSERT_TRUE(pipelineState != nullptr);
+  EXPECT_NE(static_cast<const vulkan::RenderPipelineState&>(*pipelineState)
+                .getVkPipeline(dynamicState_),
+            VK_NULL_HANDLE);
+  EXPECT_EQ(ctx.pipelineLibraries_->getNumLibraries(), numLibraries + 1);
+}
+
+} // namespace tests
+} // namespace igl
@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include <igl/IGL.h>
+#include <igl/vulkan/Buffer.h>
+#include <igl/vulkan/Device.h>
+#include <igl/vulkan/TransientAllocator.h>
+#include <igl/vulkan/VulkanContext.h>
+#include <memory>
+#include <vector>
+
+#include "../util/device/vulkan/TestDevice.h"
+
+#if IGL_PLATFORM_WIN || IGL_PLATFORM_ANDROID || IGL_PLATFORM_LINUX
+
+namespace igl::tests {
+
+namespace {
+constexpr uint32_t kFramesInFlight = 3;
+constexpr uint32_t kTransientBufferSize = 64 * 1024;
+} // namespace
+
+//
+// TransientAllocatorVulkanTest
+//
+// Unit tests for IDevice::allocateTransient() on Vulkan.
+//
+class TransientAllocatorVulkanTest : public ::testing::Test {
+ public:
+  // Set up common resources. This will create a device with small transient buffers
+  void SetUp() override {
+    // Turn off debug break so unit tests can run
+    igl::setDebugBreakEnabled(false);
+
+    igl::vulkan::VulkanContextConfig config = util::device::vulkan::getTestContextConfig();
+    config.maxResourceCount = kFramesInFlight;
+    config.transientBufferSize = kTransientBufferSize;
+
+    device_ = util::device::vulkan::createTestDevice(config);
+    ASSERT_TRUE(device_ != nullptr);
+
+    Result ret;
+    cmdQueue_ = device_->createCommandQueue(CommandQueueDesc{CommandQueueType::Graphics}, &ret);
+    ASSERT_TRUE(ret.isOk());
+    ASSERT_TRUE(cmdQueue_ != nullptr);
+  }
+
+  TransientAllocation allocate(size_t size) const {
+    Result ret;
+    const TransientAllocation allocation =
+        device_->allocateTransient(BufferDesc::BufferTypeBits::Uniform, size, &ret);
+    EXPECT_TRUE(ret.isOk()) << ret.message;
+    EXPECT_NE(allocation.data, nullptr);
+    EXPECT_NE(allocation.buffer, nullptr);
+    EXPECT_EQ(allocation.size, size);
+    return allocation;
+  }
+
+  size_t getNumPages() const {
+    return static_cast<igl::vulkan::Device&>(*device_).getTransientAllocator().getNumPages();
+  }
+
+  // every submit ends a frame
+  void endFrame() const {
+    Result ret;
+    auto cmdBuf = cmdQueue_->createCommandBuffer({}, &ret);
+    ASSERT_TRUE(ret.isOk());
+    cmdQueue_->submit(*cmdBuf);
+  }
+
+ protected:
+  std::shared_ptr<IDevice> device_;
+  std::shared_ptr<ICommandQueue> cmdQueue_;
+};
+
+TEST_F(TransientAllocatorVulkanTest, AllocationsArePersistentlyMapped) {
+  const size_t alignment = static_cast<igl::vulkan::Device&>(*device_)
+                               .getVulkanContext()
+                               .getVkPhysicalDeviceProperties()
+                               .limits.minUniformBufferOffsetAlignment;
+
+  const TransientAllocation first = allocate(100);
+  const TransientAllocation second = allocate(100);
+
+  EXPECT_EQ(first.buffer, second.buffer);
+  EXPECT_GE(second.offset, first.offset + first.size);
+  EXPECT_EQ(second.offset % alignment, 0u);
+
+  // the data is written directly into the buffer
+  const auto& buffer = static_cast<const igl::vulkan::Buffer&>(*second.buffer);
+  EXPECT_EQ(buffer.getMappedPtr() + second.offset, second.data);
+  std::memset(second.data, 0xAB, second.size);
+  EXPECT_EQ(buffer.getMappedPtr()[second.offset], 0xAB);
+}
+
+TEST_F(TransientAllocatorVulkanTest, FramesReuseTheirBuffers) {
+  const TransientAllocation first = allocate(16);
+
+  // a full buffer continues in another one
+  const TransientAllocation large = allocate(kTransientBufferSize);
+  EXPECT_NE(large.buffer, first.buffer);
+  EXPECT_EQ(large.offset, 0u);
+
+  // the other frames in flight have their own buffers
+  std::vector<std::shared_ptr<IBuffer>> buffers = {first.buffer};
+  for (uint32_t i = 1; i != kFramesInFlight; i++) {
+    endFrame();
+    const TransientAllocation allocation = allocate(16);
+    for (const auto& buffer : buffers) {
+      EXPECT_NE(allocation.buffer, buffer);
+    }
+    buffers.push_back(allocation.buffer);
+  }
+
+  // the first frame has been retired, so its memory is reused
+  endFrame();
+  const TransientAllocation reused = allocate(16);
+  EXPECT_EQ(reused.buffer, first.buffer);
+  EXPECT_EQ(reused.offset, first.offset);
+}
+
+TEST_F(TransientAllocatorVulkanTest, SlotsAreNotReusedWhileCommandBuffersAreEncoded) {
+  // a command buffer which is still being encoded when its frame ends
+  Result ret;
+  auto cmdBuf = cmdQueue_->createCommandBuffer({}, &ret);
+  ASSERT_TRUE(ret.isOk());
+
+  const TransientAllocation first = allocate(16);
+
+  for (uint32_t i = 0; i != kFramesInFlight; i++) {
+    endFrame();
+  }
+
+  // the first frame slot is reused, but its buffer might still be accessed
+  const TransientAllocation second = allocate(16);
+  EXPECT_NE(second.buffer, first.buffer);
+
+  cmdQueue_->submit(*cmdBuf);
+  cmdBuf->waitUntilCompleted();
+
+  for (uint32_t i = 1; i != kFramesInFlight; i++) {
+    allocate(16);
+    endFrame();
+  }
+
+  // nothing is pending anymore, so the slot keeps its buffer
+  const TransientAllocation third = allocate(16);
+  EXPECT_EQ(third.buffer, second.buffer);
+}
+
+TEST_F(TransientAllocatorVulkanTest, PagesShrinkAfterASpike) {
+  allocate(16);
+  EXPECT_EQ(getNumPages(), 1u);
+
+  // a spike which needs several buffers
+  constexpr size_t kNumSpikePages = 4;
+  for (size_t i = 0; i != kNumSpikePages; i++) {
+    allocate(kTransientBufferSize);
+  }
+  EXPECT_EQ(getNumPages(), kNumSpikePages + 1);
+
+  // the spike is followed by a small frame and then by another small frame
+  for (uint32_t frame = 0; frame != 2; frame++) {
+    for (uint32_t i = 0; i != kFramesInFlight; i++) {
+      endFrame();
+      allocate(16);
+    }
+  }
+
+  // a frame slot keeps only as many buffers as its previous frame needed
+  EXPECT_EQ(getNumPages(), kFramesInFlight);
+}
+
+TEST_F(TransientAllocatorVulkanTest, InvalidArguments) {
+  Result ret;
+  TransientAllocation allocation =
+      device_->allocateTransient(BufferDesc::BufferTypeBits::Vertex, 0, &ret);
+  EXPECT_EQ(ret.code, Result::Code::ArgumentInvalid);
+  EXPECT_EQ(allocation.buffer, nullptr);
+
+  allocation = device_->allocateTransient(0, 16, &ret);
+  EXPECT_EQ(ret.code, Result::Code::ArgumentInvalid);
+  EXPECT_EQ(allocation.data, nullptr);
+}
+
+} // namespace igl::tests
+
+#endif // IGL_PLATFORM_WIN || IGL_PLATFORM_ANDROID || IGL_PLATFORM_LINUX
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <array>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <igl/IGL.h>
+#include <igl/vulkan/PlatformDevice.h>
+
+#include "../util/TestDevice.h"
+
+namespace igl::tests {
+
+//
+// UploadAsyncVulkanTest
+//
+// Unit tests for the non-blocking uploads of Vulkan buffers and textures.
+//
+class UploadAsyncVulkanTest : public ::testing::Test {
+ public:
+  // Set up common resources. This will create a device
+  void SetUp() override {
+    // Turn off debug break so unit tests can run
+    igl::setDebugBreakEnabled(false);
+
+    iglDev_ = util::createTestDevice();
+    ASSERT_NE(iglDev_, nullptr);
+
+    platformDevice_ = iglDev_->getPlatformDevice<vulkan::PlatformDevice>();
+    ASSERT_NE(platformDevice_, nullptr);
+  }
+
+ public:
+  std::shared_ptr<IDevice> iglDev_;
+  const vulkan::PlatformDevice* platformDevice_ = nullptr;
+};
+
+TEST_F(UploadAsyncVulkanTest, BufferUploadAsync) {
+  Result ret;
+  constexpr std::array<uint32_t, 8> kData = {1, 2, 3, 4, 5, 6, 7, 8};
+
+  const BufferDesc desc(
+      BufferDesc::BufferTypeBits::Storage, nullptr, sizeof(kData), ResourceStorage::Private);
+  auto buffer = iglDev_->createBuffer(desc, &ret);
+  ASSERT_EQ(ret.code, Result::Code::Ok);
+  ASSERT_NE(buffer, nullptr);
+
+  const UploadHandle handle =
+      buffer->uploadAsync(kData.data(), BufferRange(sizeof(kData), 0), &ret);
+  ASSERT_EQ(ret.code, Result::Code::Ok);
+
+  platformDevice_->waitOnUpload(handle);
+  EXPECT_TRUE(platformDevice_->isUploadComplete(handle));
+
+  const auto* data = buffer->map(BufferRange(sizeof(kData), 0), &ret);
+  ASSERT_EQ(ret.code, Result::Code::Ok);
+  ASSERT_NE(data, nullptr);
+  EXPECT_EQ(std::memcmp(data, kData.data(), sizeof(kData)), 0);
+  buffer->unmap();
+}
+
+TEST_F(UploadAsyncVulkanTest, TextureUploadAsync) {
+  Result ret;
+  constexpr size_t kSize = 4;
+  std::array<uint32_t, kSize * kSize> pixels{};
+  pixels.fill(0x11223344);
+
+  const TextureDesc desc = TextureDesc::new2D(TextureFormat::RGBA_UNorm8,
+                                              kSize,
+                                              kSize,
+                                              TextureDesc::TextureUsageBits::Sampled |
+                                                  TextureDesc::TextureUsageBits::Attachment,
+                                              "UploadAsyncVulkanTest");
+  auto texture = iglDev_->createTexture(desc, &ret);
+  ASSERT_EQ(ret.code, Result::Code::Ok);
+  ASSERT_NE(texture, nullptr);
+
+  const auto range = TextureRangeDesc::new2D(0, 0, kSize, kSize);
+  const UploadHandle handle = texture->uploadAsync(range, pixels.data(), 0, &ret);
+  ASSERT_EQ(ret.code, Result::Code::Ok);
+
+  platformDevice_->waitOnUpload(handle);
+  EXPECT_TRUE(platformDevice_->isUploadComplete(handle));
+
+  auto cmdQueue = iglDev_->createCommandQueue(CommandQueueDesc{CommandQueueType::Graphics}, &ret);
+  ASSERT_EQ(ret.code, Result::Code::Ok);
+  ASSERT_NE(cmdQueue, nullptr);
+
+  FramebufferDesc framebufferDesc;
+  framebufferDesc.colorAttachments[0].texture = texture;
+  auto framebuffer = iglDev_->createFramebuffer(framebufferDesc, &ret);
+  ASSERT_EQ(ret.code, Result::Code::Ok);
+  ASSERT_NE(framebuffer, nullptr);
+
+  std::array<uint32_t, kSize * kSize> readback{};
+  framebuffer->copyBytesColorAttachment(*cmdQueue, 0, readback.data(), range);
+  EXPECT_EQ(readback, pixels);
+}
+
+} // namespace igl::tests
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <igl/IGL.h>
+#include <igl/ShaderCreator.h>
+#include <igl/vulkan/ComputePipelineState.h>
+#include <igl/vulkan/Device.h>
+#include <igl/vulkan/VulkanContext.h>
+#include <igl/vulkan/VulkanPipelineCache.h>
+
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+#include "../util/device/vulkan/TestDevice.h"
+
+#if IGL_PLATFORM_WIN || IGL_PLATFORM_ANDROID || IGL_PLATFORM_LINUX
+
+namespace igl::tests {
+
+namespace {
+const char kComputeShader[] = R"(
+layout (local_size_x = 1) in;
+void main() {}
+)";
+
+igl::vulkan::VulkanContext& getVulkanContext(IDevice& device) {
+  return static_cast<igl::vulkan::Device&>(device).getVulkanContext();
+}
+
+void createComputePipeline(IDevice& device) {
+  Result ret;
+  ComputePipelineDesc desc;
+  desc.shaderStages =
+      ShaderStagesCreator::fromModuleStringInput(device, kComputeShader, "main", "", &ret);
+  ASSERT_TRUE(ret.isOk());
+  auto pipelineState = device.createComputePipeline(desc, &ret);
+  ASSERT_TRUE(ret.isOk());
+  ASSERT_TRUE(pipelineState != nullptr);
+  EXPECT_NE(static_cast<igl::vulkan::ComputePipelineState&>(*pipelineState).getVkPipeline(),
+            VK_NULL_HANDLE);
+}
+} // namespace
+
+//
+// VulkanPipelineCacheTest
+//
+// Unit tests for igl::vulkan::VulkanPipelineCache.
+//
+class VulkanPipelineCacheTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    // Turn off debug break so unit tests can run
+    igl::setDebugBreakEnabled(false);
+
+    config_ = util::device::vulkan::getTestContextConfig();
+    config_.enableGPUAssistedValidation = false;
+
+    fileName_ = std::filesystem::temp_directory_path() / "igl_vulkan_pipeline_cache_test.bin";
+    std::filesystem::remove(fileName_);
+  }
+
+  void TearDown() override {
+    std::filesystem::remove(fileName_);
+  }
+
+ protected:
+  igl::vulkan::VulkanContextConfig config_;
+  std::filesystem::path fileName_;
+};
+
+TEST_F(VulkanPipelineCacheTest, HeaderValidation) {
+  auto device = util::device::vulkan::createTestDevice(config_);
+  ASSERT_TRUE(device != nullptr);
+
+  auto& ctx = getVulkanContext(*device);
+  const auto& properties = ctx.getVkPhysicalDeviceProperties();
+
+  createComputePipeline(*device);
+
+  std::vector<uint8_t> data = ctx.getPipelineCacheData();
+  ASSERT_FALSE(data.empty());
+
+  using igl::vulkan::VulkanPipelineCache;
+  EXPECT_TRUE(VulkanPipelineCache::isCompatible(data.data(), data.size(), properties));
+  EXPECT_FALSE(VulkanPipelineCache::isCompatible(data.data(), 8, properties));
+  EXPECT_FALSE(VulkanPipelineCache::isCompatible(nullptr, data.size(), properties));
+
+  // a cache created by a different driver
+  data[4 * sizeof(uint32_t)] ^= 0xFF;
+  EXPECT_FALSE(VulkanPipelineCache::isCompatible(data.data(), data.size(), properties));
+
+  // incompatible data is ignored
+  config_.pipelineCacheData = data.data();
+  config_.pipelineCacheDataSize = data.size();
+  auto newDevice = util::device::vulkan::createTestDevice(config_);
+  ASSERT_TRUE(newDevice != nullptr);
+  EXPECT_FALSE(getVulkanContext(*newDevice).pipelineCache_->hasInitialData());
+}
+
+TEST_F(VulkanPipelineCacheTest, SaveAndLoad) {
+  config_.pipelineCacheFile = fileName_.string();
+
+  {
+    auto device = util::device::vulkan::createTestDevice(config_);
+    ASSERT_TRUE(device != nullptr);
+    EXPECT_FALSE(getVulkanContext(*device).pipelineCache_->hasInitialData());
+
+    createComputePipeline(*device);
+  }
+
+  // the cache is saved when the context is destroyed
+  ASSERT_TRUE(std::filesystem::exists(fileName_));
+
+  auto device = util::device::vulkan::createTestDevice(config_);
+  ASSERT_TRUE(device != nullptr);
+  EXPECT_TRUE(getVulkanContext(*device).pipelineCache_->hasInitialData());
+}
+
+TEST_F(VulkanPipelineCacheTest, Autosave) {
+  config_.pipelineCacheFile = fileName_.string();
+  config_.pipelineCacheSaveInterval = 2;
+
+  auto device = util::device::vulkan::createTestDevice(config_);
+  ASSERT_TRUE(device != nullptr);
+
+  auto& pipelineCache = *getVulkanContext(*device).pipelineCache_;
+
+  createComputePipeline(*device);
+
+  pipelineCache.autosave();
+  EXPECT_FALSE(std::filesystem::exists(fileName_));
+
+  pipelineCache.autosave();
+  // the file is written in the background
+  EXPECT_TRUE(pipelineCache.save());
+  EXPECT_TRUE(std::filesystem::exists(fileName_));
+}
+
+TEST_F(VulkanPipelineCacheTest, CacheHitsAreNotSaved) {
+  config_.pipelineCacheFile = fileName_.string();
+  config_.pipelineCacheSaveInterval = 1;
+
+  {
+    auto device = util::device::vulkan::createTestDevice(config_);
+    ASSERT_TRUE(device != nullptr);
+    createComputePipeline(*device);
+  }
+
+  ASSERT_TRUE(std::filesystem::exists(fileName_));
+
+  auto device = util::device::vulkan::createTestDevice(config_);
+  ASSERT_TRUE(device != nullptr);
+  ASSERT_TRUE(getVulkanContext(*device).pipelineCache_->hasInitialData());
+  std::filesystem::remove(fileName_);
+
+  // the same pipeline is found in the loaded cache, so there is nothing new to save
+  createComputePipeline(*device);
+  getVulkanContext(*device).pipelineCache_->autosave();
+  EXPECT_FALSE(std::filesystem::exists(fileName_));
+}
+
+} // namespace igl::tests
+
+#endif // IGL_PLATFORM_WIN || IGL_PLATFORM_ANDROID || IGL_PLATFORM_LINUX
@@ -248,4 +248,44 @@ TEST(VulkanQueuePoolTest, ReturnMultipleQueueCreationInfosForDifferentQueueFamil
   EXPECT_EQ(qcis[1].queueCount, 1);
 }
 
+TEST(VulkanQueuePoolTest, FindDedicatedQueueSkipsQueuesWithAvoidedFlags) {
+  // Given an all in one queue, a compute queue and a transfer-only queue
+  VulkanQueueDescriptor allInOneQueueDescriptor{
+      .queueFlags = VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT | VK_QUEUE_TRANSFER_BIT,
+      .queueIndex = 0,
+      .familyIndex = 0};
+  VulkanQueueDescriptor computeQueueDescriptor{
+      .queueFlags = VK_QUEUE_COMPUTE_BIT | VK_QUEUE_TRANSFER_BIT,
+      .queueIndex = 0,
+      .familyIndex = 1};
+  VulkanQueueDescriptor transferQueueDescriptor{
+      .queueFlags = VK_QUEUE_TRANSFER_BIT, .queueIndex = 0, .familyIndex = 2};
+  VulkanQueuePool queuePool(
+      {allInOneQueueDescriptor, computeQueueDescriptor, transferQueueDescriptor});
+
+  // When a transfer queue without graphics and compute capabilities is requested
+  auto queueDescriptor = queuePool.findDedicatedQueueDescriptor(
+      VK_QUEUE_TRANSFER_BIT, VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT);
+
+  // Then return the transfer-only queue
+  ASSERT_TRUE(queueDescriptor.isValid());
+  EXPECT_EQ(queueDescriptor, transferQueueDescriptor);
+}
+
+TEST(VulkanQueuePoolTest, FindDedicatedQueueDoesNotFallback) {
+  // Given an all in one queue
+  VulkanQueueDescriptor allInOneQueueDescriptor{
+      .queueFlags = VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT | VK_QUEUE_TRANSFER_BIT,
+      .queueIndex = 0,
+      .familyIndex = 0};
+  VulkanQueuePool queuePool({allInOneQueueDescriptor});
+
+  // When a transfer queue without graphics capabilities is requested
+  auto queueDescriptor =
+      queuePool.findDedicatedQueueDescriptor(VK_QUEUE_TRANSFER_BIT, VK_QUEUE_GRAPHICS_BIT);
+
+  // Then return an invalid queue
+  EXPECT_FALSE(queueDescriptor.isValid());
+}
+
 } // namespace igl::tests
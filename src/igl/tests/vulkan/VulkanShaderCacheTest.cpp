@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <igl/IGL.h>
+#include <igl/ShaderCreator.h>
+#include <igl/vulkan/Device.h>
+#include <igl/vulkan/VulkanContext.h>
+#include <igl/vulkan/VulkanShaderCache.h>
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+#include "../data/ShaderData.h"
+#include "../util/device/vulkan/TestDevice.h"
+
+#if IGL_PLATFORM_WIN || IGL_PLATFORM_ANDROID || IGL_PLATFORM_LINUX
+
+namespace igl::tests {
+
+namespace {
+std::shared_ptr<IShaderModule> createShaderModule(const IDevice& device,
+                                                  const char* source,
+                                                  ShaderStage stage) {
+  Result ret;
+  auto module = ShaderModuleCreator::fromStringInput(device, source, {stage, "main"}, "", &ret);
+  EXPECT_TRUE(ret.isOk()) << ret.message;
+  return module;
+}
+} // namespace
+
+//
+// VulkanShaderCacheTest
+//
+// Unit tests for igl::vulkan::VulkanShaderCache.
+//
+class VulkanShaderCacheTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    // Turn off debug break so unit tests can run
+    igl::setDebugBreakEnabled(false);
+
+    config_ = util::device::vulkan::getTestContextConfig();
+    config_.enableGPUAssistedValidation = false;
+    config_.enableShaderCache = true;
+
+    directory_ = std::filesystem::temp_directory_path() / "igl_vulkan_shader_cache_test";
+    std::filesystem::remove_all(directory_);
+    std::filesystem::create_directories(directory_);
+  }
+
+  void TearDown() override {
+    std::filesystem::remove_all(directory_);
+  }
+
+  static const igl::vulkan::VulkanShaderCache& getShaderCache(const IDevice& device) {
+    const auto& ctx = static_cast<const igl::vulkan::Device&>(device).getVulkanContext();
+    IGL_ASSERT(ctx.shaderCache_);
+    return *ctx.shaderCache_;
+  }
+
+ protected:
+  igl::vulkan::VulkanContextConfig config_;
+  std::filesystem::path directory_;
+};
+
+TEST_F(VulkanShaderCacheTest, KeyDependsOnStageAndLimits) {
+  glslang_resource_t resource;
+  ivkGlslangResource(&resource, nullptr);
+
+  const char* source = data::shader::VULKAN_SIMPLE_VERT_SHADER;
+
+  using igl::vulkan::VulkanShaderCache;
+  const uint64_t key =
+      VulkanShaderCache::computeKey(VK_SHADER_STAGE_VERTEX_BIT, source, resource);
+
+  EXPECT_EQ(key, VulkanShaderCache::computeKey(VK_SHADER_STAGE_VERTEX_BIT, source, resource));
+  EXPECT_NE(key, VulkanShaderCache::computeKey(VK_SHADER_STAGE_COMPUTE_BIT, source, resource));
+  EXPECT_NE(key,
+            VulkanShaderCache::computeKey(
+                VK_SHADER_STAGE_VERTEX_BIT, data::shader::VULKAN_SIMPLE_FRAG_SHADER, resource));
+
+  resource.max_vertex_attribs++;
+  EXPECT_NE(key, VulkanShaderCache::computeKey(VK_SHADER_STAGE_VERTEX_BIT, source, resource));
+}
+
+TEST_F(VulkanShaderCacheTest, MemoryCache) {
+  auto device = util::device::vulkan::createTestDevice(config_);
+  ASSERT_TRUE(device != nullptr);
+
+  const auto& cache = getShaderCache(*device);
+
+  createShaderModule(*device, data::shader::VULKAN_SIMPLE_VERT_SHADER, ShaderStage::Vertex);
+  EXPECT_EQ(cache.getNumHits(), 0u);
+  EXPECT_EQ(cache.getNumMisses(), 1u);
+
+  auto module =
+      createShaderModule(*device, data::shader::VULKAN_SIMPLE_VERT_SHADER, ShaderStage::Vertex);
+  EXPECT_TRUE(module != nullptr);
+  EXPECT_EQ(cache.getNumHits(), 1u);
+  EXPECT_EQ(cache.getNumMisses(), 1u);
+
+  createShaderModule(*device, data::shader::VULKAN_SIMPLE_FRAG_SHADER, ShaderStage::Fragment);
+  EXPECT_EQ(cache.getNumHits(), 1u);
+  EXPECT_EQ(cache.getNumMisses(), 2u);
+
+  // nothing is written to disk without a cache directory
+  EXPECT_TRUE(std::filesystem::is_empty(directory_));
+}
+
+TEST_F(VulkanShaderCacheTest, DiskCache) {
+  config_.shaderCacheDirectory = directory_.string();
+
+  {
+    auto device = util::device::vulkan::createTestDevice(config_);
+    ASSERT_TRUE(device != nullptr);
+
+    createShaderModule(*device, data::shader::VULKAN_SIMPLE_VERT_SHADER, ShaderStage::Vertex);
+    EXPECT_EQ(getShaderCache(*device).getNumMisses(), 1u);
+  }
+
+  EXPECT_FALSE(std::filesystem::is_empty(directory_));
+
+  // a new device starts with an empty in-memory cache and loads the binary from disk
+  auto device = util::device::vulkan::createTestDevice(config_);
+  ASSERT_TRUE(device != nullptr);
+
+  auto module =
+      createShaderModule(*device, data::shader::VULKAN_SIMPLE_VERT_SHADER, ShaderStage::Vertex);
+  EXPECT_TRUE(module != nullptr);
+  EXPECT_EQ(getShaderCache(*device).getNumHits(), 1u);
+  EXPECT_EQ(getShaderCache(*device).getNumMisses(), 0u);
+}
+
+TEST_F(VulkanShaderCacheTest, CorruptedFilesAreIgnored) {
+  igl::vulkan::VulkanShaderCache cache(directory_.string());
+
+  const char* source = data::shader::VULKAN_SIMPLE_VERT_SHADER;
+  const std::vector<uint32_t> spirv = {0x07230203, 1, 2, 3};
+  cache.insert(42, source, spirv);
+
+  // truncate every cache file
+  for (const auto& entry : std::filesystem::directory_iterator(directory_)) {
+    std::ofstream file(entry.path(), std::ios::binary | std::ios::trunc);
+    file << "IGLS";
+  }
+
+  igl::vulkan::VulkanShaderCache newCache(directory_.string());
+
+  std::vector<uint32_t> result;
+  EXPECT_FALSE(newCache.find(42, source, result));
+  EXPECT_EQ(newCache.getNumMisses(), 1u);
+
+  // the in-memory layer still has the valid entry
+  EXPECT_TRUE(cache.find(42, source, result));
+  EXPECT_EQ(result, spirv);
+}
+
+TEST_F(VulkanShaderCacheTest, SourceIsVerified) {
+  igl::vulkan::VulkanShaderCache cache(directory_.string());
+
+  const std::vector<uint32_t> spirv = {0x07230203, 1, 2, 3};
+  cache.insert(42, data::shader::VULKAN_SIMPLE_VERT_SHADER, spirv);
+
+  // the same key with another source is a miss, both in memory and on disk
+  std::vector<uint32_t> result;
+  EXPECT_FALSE(cache.find(42, data::shader::VULKAN_SIMPLE_FRAG_SHADER, result));
+
+  igl::vulkan::VulkanShaderCache newCache(directory_.string());
+  EXPECT_FALSE(newCache.find(42, data::shader::VULKAN_SIMPLE_FRAG_SHADER, result));
+  EXPECT_TRUE(newCache.find(42, data::shader::VULKAN_SIMPLE_VERT_SHADER, result));
+  EXPECT_EQ(result, spirv);
+}
+
+TEST_F(VulkanShaderCacheTest, LeastRecentlyUsedEntriesAreEvicted) {
+  igl::vulkan::VulkanShaderCache cache("", 2);
+
+  const char* source = data::shader::VULKAN_SIMPLE_VERT_SHADER;
+  const std::vector<uint32_t> spirv = {0x07230203, 1, 2, 3};
+  cache.insert(1, source, spirv);
+  cache.insert(2, source, spirv);
+
+  // make the first entry the most recently used one
+  std::vector<uint32_t> result;
+  EXPECT_TRUE(cache.find(1, source, result));
+
+  cache.insert(3, source, spirv);
+  EXPECT_EQ(cache.getNumEntries(), 2u);
+  EXPECT_TRUE(cache.find(1, source, result));
+  EXPECT_FALSE(cache.find(2, source, result));
+  EXPECT_TRUE(cache.find(3, source, result));
+}
+
+TEST_F(VulkanShaderCacheTest, CacheIsOptIn) {
+  config_ = util::device::vulkan::getTestContextConfig();
+  config_.enableGPUAssistedValidation = false;
+
+  auto device = util::device::vulkan::createTestDevice(config_);
+  ASSERT_TRUE(device != nullptr);
+
+  EXPECT_TRUE(static_cast<igl::vulkan::Device&>(*device).getVulkanContext().shaderCache_ ==
+              nullptr);
+
+  auto module =
+      createShaderModule(*device, data::shader::VULKAN_SIMPLE_VERT_SHADER, ShaderStage::Vertex);
+  EXPECT_TRUE(module != nullptr);
+}
+
+} // namespace igl::tests
+
+#endif // IGL_PLATFORM_WIN || IGL_PLATFORM_ANDROID || IGL_PLATFORM_LINUX
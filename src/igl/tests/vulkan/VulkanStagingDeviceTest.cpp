@@ -0,0 +1,265 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <array>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <igl/IGL.h>
+#include <igl/vulkan/Device.h>
+#include <igl/vulkan/VulkanContext.h>
+#include <igl/vulkan/VulkanStagingDevice.h>
+#include <memory>
+#include <vector>
+
+#include "../util/device/vulkan/TestDevice.h"
+
+#if IGL_PLATFORM_WIN || IGL_PLATFORM_ANDROID || IGL_PLATFORM_LINUX
+
+namespace igl::tests {
+
+namespace {
+// the staging ring is smaller than the textures uploaded below, so uploads are split into chunks
+constexpr uint32_t kStagingBufferSize = 16u * 1024u;
+constexpr uint32_t kReadbackBufferSize = 4u * 1024u;
+constexpr size_t kWidth = 64;
+constexpr size_t kHeight = 128;
+
+igl::vulkan::VulkanContextConfig getTestConfig() {
+  igl::vulkan::VulkanContextConfig config = util::device::vulkan::getTestContextConfig();
+  config.enableGPUAssistedValidation = false;
+  return config;
+}
+} // namespace
+
+//
+// VulkanStagingDeviceTest
+//
+// Unit tests for the chunked uploads of igl::vulkan::VulkanStagingDevice.
+//
+class VulkanStagingDeviceTest : public ::testing::Test {
+ public:
+  // Set up common resources. This will create a device with a tiny staging ring
+  void SetUp() override {
+    // Turn off debug break so unit tests can run
+    igl::setDebugBreakEnabled(false);
+
+    igl::vulkan::VulkanContextConfig config = getTestConfig();
+    config.stagingBufferSize = kStagingBufferSize;
+    config.readbackBufferSize = kReadbackBufferSize;
+    // route every upload through the dedicated transfer queue, if there is one
+    config.enableDedicatedTransferQueue = true;
+    config.minDedicatedTransferQueueUploadSize = 0;
+
+    device_ = util::device::vulkan::createTestDevice(config);
+    ASSERT_TRUE(device_ != nullptr);
+
+    Result ret;
+    cmdQueue_ = device_->createCommandQueue(CommandQueueDesc{CommandQueueType::Graphics}, &ret);
+    ASSERT_TRUE(ret.isOk());
+    ASSERT_TRUE(cmdQueue_ != nullptr);
+  }
+
+ protected:
+  std::shared_ptr<IDevice> device_;
+  std::shared_ptr<ICommandQueue> cmdQueue_;
+};
+
+TEST_F(VulkanStagingDeviceTest, UploadTexture2DLargerThanStagingBuffer) {
+  Result ret;
+
+  const TextureDesc desc = TextureDesc::new2D(TextureFormat::RGBA_UNorm8,
+                                              kWidth,
+                                              kHeight,
+                                              TextureDesc::TextureUsageBits::Sampled |
+                                                  TextureDesc::TextureUsageBits::Attachment,
+                                              "VulkanStagingDeviceTest");
+  std::shared_ptr<ITexture> texture = device_->createTexture(desc, &ret);
+  ASSERT_TRUE(ret.isOk());
+  ASSERT_TRUE(texture != nullptr);
+
+  // every row has a unique color, so misplaced bands of rows are detected
+  std::vector<uint32_t> pixels(kWidth * kHeight);
+  for (size_t y = 0; y != kHeight; y++) {
+    for (size_t x = 0; x != kWidth; x++) {
+      pixels[y * kWidth + x] = 0xFF000000u | static_cast<uint32_t>(y);
+    }
+  }
+
+  ret = texture->upload(TextureRangeDesc::new2D(0, 0, kWidth, kHeight), pixels.data());
+  ASSERT_TRUE(ret.isOk());
+
+  FramebufferDesc framebufferDesc;
+  framebufferDesc.colorAttachments[0].texture = texture;
+  std::shared_ptr<IFramebuffer> framebuffer = device_->createFramebuffer(framebufferDesc, &ret);
+  ASSERT_TRUE(ret.isOk());
+  ASSERT_TRUE(framebuffer != nullptr);
+
+  // the readback is streamed through the staging ring as well
+  std::vector<uint32_t> readback(kWidth * kHeight);
+  framebuffer->copyBytesColorAttachment(
+      *cmdQueue_, 0, readback.data(), TextureRangeDesc::new2D(0, 0, kWidth, kHeight));
+
+  // the readback is flipped vertically
+  for (size_t y = 0; y != kHeight; y++) {
+    const size_t row = kHeight - 1 - y;
+    ASSERT_EQ(readback[y * kWidth], 0xFF000000u | static_cast<uint32_t>(row));
+    ASSERT_EQ(readback[y * kWidth + kWidth - 1], 0xFF000000u | static_cast<uint32_t>(row));
+  }
+}
+
+TEST_F(VulkanStagingDeviceTest, UploadTexture3DLargerThanStagingBuffer) {
+  Result ret;
+
+  // the first texture streams bands of rows of its only slice, the second one streams whole slices
+  for (const size_t depth : {size_t(1), size_t(8)}) {
+    const size_t width = depth == 1 ? kWidth : kWidth / 4;
+    const TextureDesc desc = TextureDesc::new3D(TextureFormat::RGBA_UNorm8,
+                                                width,
+                                                kHeight,
+                                                depth,
+                                                TextureDesc::TextureUsageBits::Sampled,
+                                                "VulkanStagingDeviceTest");
+    std::shared_ptr<ITexture> texture = device_->createTexture(desc, &ret);
+    ASSERT_TRUE(ret.isOk());
+    ASSERT_TRUE(texture != nullptr);
+
+    const std::vector<uint32_t> pixels(width * kHeight * depth, 0xFF00FF00u);
+
+    ret = texture->upload(TextureRangeDesc::new3D(0, 0, 0, width, kHeight, depth), pixels.data());
+    ASSERT_TRUE(ret.isOk());
+  }
+}
+
+TEST_F(VulkanStagingDeviceTest, FullBufferUploadsAreOrdered) {
+  Result ret;
+
+  // full-buffer uploads can go through a dedicated transfer queue; the initial upload of a new
+  // buffer does not wait for the graphics queue
+  constexpr size_t kNumValues = 1024;
+  const std::vector<uint32_t> initialData(kNumValues, 0);
+  const BufferDesc desc(BufferDesc::BufferTypeBits::Storage,
+                        initialData.data(),
+                        kNumValues * sizeof(uint32_t),
+                        ResourceStorage::Private);
+  std::shared_ptr<IBuffer> buffer = device_->createBuffer(desc, &ret);
+  ASSERT_TRUE(ret.isOk());
+  ASSERT_TRUE(buffer != nullptr);
+
+  // back-to-back uploads without waiting in between: the last one wins
+  for (uint32_t value = 1; value != 4; value++) {
+    const std::vector<uint32_t> data(kNumValues, value);
+    ret = buffer->upload(data.data(), BufferRange(desc.length, 0));
+    ASSERT_TRUE(ret.isOk());
+  }
+
+  const auto* readback =
+      static_cast<const uint32_t*>(buffer->map(BufferRange(desc.length, 0), &ret));
+  ASSERT_TRUE(ret.isOk());
+  ASSERT_TRUE(readback != nullptr);
+  EXPECT_EQ(readback[0], 3u);
+  EXPECT_EQ(readback[kNumValues - 1], 3u);
+  buffer->unmap();
+}
+
+TEST_F(VulkanStagingDeviceTest, ReadbackRegionsAreReleasedOutOfOrder) {
+  vulkan::VulkanStagingDevice& stagingDevice =
+      *static_cast<vulkan::Device&>(*device_).getVulkanContext().stagingDevice_;
+
+  // fill up the readback ring
+  const auto region0 = stagingDevice.acquireReadbackRegion(kReadbackBufferSize / 4);
+  const auto region1 = stagingDevice.acquireReadbackRegion(kReadbackBufferSize / 4);
+  const auto region2 = stagingDevice.acquireReadbackRegion(kReadbackBufferSize / 2);
+  ASSERT_FALSE(region0.isDedicated_ || region1.isDedicated_ || region2.isDedicated_);
+  EXPECT_EQ(region0.buffer_, region2.buffer_);
+  EXPECT_EQ(region1.offset_, kReadbackBufferSize / 4);
+  EXPECT_EQ(region2.offset_, kReadbackBufferSize / 2);
+
+  // a full ring falls back to dedicated buffers
+  const auto dedicated = stagingDevice.acquireReadbackRegion(16);
+  EXPECT_TRUE(dedicated.isDedicated_);
+  EXPECT_NE(dedicated.buffer_, region0.buffer_);
+  stagingDevice.releaseReadbackRegion(dedicated);
+
+  // the space of the second region is reclaimed only after the first one is released
+  stagingDevice.releaseReadbackRegion(region1);
+  EXPECT_TRUE(stagingDevice.acquireReadbackRegion(kReadbackBufferSize / 4).isDedicated_);
+  stagingDevice.releaseReadbackRegion(region0);
+
+  const auto region3 = stagingDevice.acquireReadbackRegion(kReadbackBufferSize / 2);
+  EXPECT_FALSE(region3.isDedicated_);
+  EXPECT_EQ(region3.offset_, 0u);
+
+  stagingDevice.releaseReadbackRegion(region2);
+  stagingDevice.releaseReadbackRegion(region3);
+}
+
+// Micro-benchmark: many small uploads into a device-local buffer every frame, with and without
+// batching of the staging copies. Reports the number of submits and the CPU time per frame
+TEST(VulkanStagingDeviceBenchmark, BatchedBufferUploads) {
+  igl::setDebugBreakEnabled(false);
+
+  constexpr size_t kNumUploadsPerFrame = 1000;
+  constexpr size_t kUploadSize = 256;
+  constexpr uint32_t kNumFrames = 16;
+
+  std::array<uint32_t, 2> numSubmits = {};
+
+  for (const bool batch : {false, true}) {
+    igl::vulkan::VulkanContextConfig config = getTestConfig();
+    config.batchStagingBufferCopies = batch;
+
+    std::shared_ptr<IDevice> device = util::device::vulkan::createTestDevice(config);
+    ASSERT_TRUE(device != nullptr);
+
+    const vulkan::VulkanContext& ctx = static_cast<vulkan::Device&>(*device).getVulkanContext();
+
+    Result ret;
+    const BufferDesc desc(BufferDesc::BufferTypeBits::Storage,
+                          nullptr,
+                          kNumUploadsPerFrame * kUploadSize,
+                          ResourceStorage::Private);
+    std::shared_ptr<IBuffer> buffer = device->createBuffer(desc, &ret);
+    ASSERT_TRUE(ret.isOk());
+    ASSERT_TRUE(buffer != nullptr);
+
+    const std::vector<uint8_t> data(kUploadSize, 0x42);
+
+    const uint32_t firstSubmitId = ctx.stagingDevice_->getLastSubmitHandle().submitId_;
+    const auto start = std::chrono::steady_clock::now();
+
+    for (uint32_t frame = 0; frame != kNumFrames; frame++) {
+      for (size_t i = 0; i != kNumUploadsPerFrame; i++) {
+        ret = buffer->upload(data.data(), BufferRange(kUploadSize, i * kUploadSize));
+        ASSERT_TRUE(ret.isOk());
+      }
+      // end of the frame
+      ctx.stagingDevice_->flushPendingCopies();
+    }
+
+    const auto end = std::chrono::steady_clock::now();
+    ctx.stagingDevice_->wait(ctx.stagingDevice_->getLastSubmitHandle());
+
+    numSubmits[batch] = ctx.stagingDevice_->getLastSubmitHandle().submitId_ - firstSubmitId;
+
+    const auto cpuTime = std::chrono::duration<double, std::micro>(end - start).count();
+    IGL_LOG_INFO("%s: %u submits/frame, %.1f us/frame\n",
+                 batch ? "batched" : "unbatched",
+                 numSubmits[batch] / kNumFrames,
+                 cpuTime / kNumFrames);
+  }
+
+  if (numSubmits[0] == 0) {
+    GTEST_SKIP() << "Uploads into host-visible device-local memory do not use the staging device";
+  }
+
+  EXPECT_GE(numSubmits[0], kNumFrames * kNumUploadsPerFrame);
+  EXPECT_LE(numSubmits[1], kNumFrames);
+}
+
+} // namespace igl::tests
+
+#endif // IGL_PLATFORM_WIN || IGL_PLATFORM_ANDROID || IGL_PLATFORM_LINUX
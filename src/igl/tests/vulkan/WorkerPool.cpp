@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <atomic>
+#include <future>
+#include <gtest/gtest.h>
+#include <igl/vulkan/WorkerPool.h>
+#include <vector>
+
+namespace igl::tests {
+
+using namespace vulkan;
+
+TEST(WorkerPoolTest, NumberOfThreadsIsBounded) {
+  EXPECT_EQ(WorkerPool(2).getNumThreads(), 2u);
+  EXPECT_GE(WorkerPool().getNumThreads(), 1u);
+}
+
+TEST(WorkerPoolTest, TasksRunInScheduleOrder) {
+  WorkerPool pool(1);
+
+  std::vector<int> order;
+  std::vector<std::future<void>> futures;
+  for (int i = 0; i != 8; i++) {
+    futures.push_back(
+        pool.schedule(std::packaged_task<void()>([&order, i]() { order.push_back(i); })));
+  }
+
+  for (auto& future : futures) {
+    future.wait();
+  }
+
+  EXPECT_EQ(order, std::vector<int>({0, 1, 2, 3, 4, 5, 6, 7}));
+}
+
+TEST(WorkerPoolTest, DestructorRunsScheduledTasks) {
+  std::atomic<int> numTasks{0};
+
+  {
+    WorkerPool pool(2);
+    for (int i = 0; i != 16; i++) {
+      pool.schedule(std::packaged_task<void()>([&numTasks]() { numTasks++; }));
+    }
+  }
+
+  EXPECT_EQ(numTasks, 16);
+}
+
+} // namespace igl::tests
@@ -25,6 +25,38 @@ namespace vulkan {
 
 Buffer::Buffer(const igl::vulkan::Device& device) : device_(device) {}
 
+Buffer::~Buffer() {
+  if (arenaAllocation_.buffer) {
+    device_.getVulkanContext().bufferArena_->release(std::move(arenaAllocation_));
+  }
+}
+
+bool Buffer::canBePooled() const {
+  const VulkanContext& ctx = device_.getVulkanContext();
+
+  if (!(desc_.hint & BufferDesc::BufferAPIHintBits::Pooled) || isRingBuffer_ || !ctx.bufferArena_) {
+    return false;
+  }
+
+  // storage and indirect buffers are written by the GPU and synchronized with whole-buffer barriers
+  const BufferDesc::BufferType pooledTypes = BufferDesc::BufferTypeBits::Index |
+                                             BufferDesc::BufferTypeBits::Vertex |
+                                             BufferDesc::BufferTypeBits::Uniform;
+  if (desc_.type & ~pooledTypes) {
+    return false;
+  }
+
+  const VkPhysicalDeviceLimits& limits = ctx.getVkPhysicalDeviceProperties().limits;
+
+  if ((desc_.type & BufferDesc::BufferTypeBits::Uniform) &&
+      desc_.length > limits.maxUniformBufferRange) {
+    return false;
+  }
+
+  return desc_.length <= ctx.config_.maxBufferArenaAllocationSize &&
+         desc_.length <= ctx.bufferArena_->getPageSize();
+}
+
 Result Buffer::create(const BufferDesc& desc) {
   desc_ = desc;
 
@@ -62,8 +94,9 @@ Result Buffer::create(const BufferDesc& desc) {
   }
 
   if (desc_.type & BufferDesc::BufferTypeBits::Indirect) {
-    usageFlags |=
-        VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT_KHR;
+    // query results can be copied into indirect buffers, see ICommandBuffer::copyQueryResults()
+    usageFlags |= VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+                  VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT_KHR;
   }
 
   const VkMemoryPropertyFlags memFlags = resourceStorageToVkMemoryPropertyFlags(desc_.storage);
@@ -71,6 +104,16 @@ Result Buffer::create(const BufferDesc& desc) {
   // Store the flag that determines if this buffer contains sub-allocations (i.e. is a ring-buffer)
   isRingBuffer_ = ((desc_.hint & BufferDesc::BufferAPIHintBits::Ring) != 0);
 
+  if (canBePooled()) {
+    Result result;
+    arenaAllocation_ = ctx.bufferArena_->allocate(desc_.length, memFlags, &result);
+    if (result.isOk()) {
+      buffers_.push_back(arenaAllocation_.buffer);
+      bufferPatches_.resize(1, BufferRange());
+      return result;
+    }
+  }
+
   const auto numBuffers =
       isRingBuffer_ ? device_.getVulkanContext().syncManager_->maxResourceCount() : 1u;
 
@@ -133,6 +176,21 @@ void Buffer::resetUpdateRange(uint32_t ringBufferIndex, const BufferRange& range
 }
 
 igl::Result Buffer::upload(const void* data, const BufferRange& range) {
+  return uploadInternal(data, range, false, nullptr);
+}
+
+UploadHandle Buffer::uploadAsync(const void* data, const BufferRange& range, Result* outResult) {
+  UploadHandle handle;
+  const Result result = uploadInternal(data, range, true, &handle);
+  Result::setResult(outResult, result);
+  return handle;
+}
+
+igl::Result Buffer::uploadInternal(const void* data,
+                                   const BufferRange& range,
+                                   bool nonBlocking,
+                                   UploadHandle* outHandle,
+                                   bool isUnusedByGpu) {
   IGL_PROFILER_FUNCTION();
 
   if (!IGL_VERIFY(data)) {
@@ -146,6 +204,7 @@ igl::Result Buffer::upload(const void* data, const BufferRange& range) {
   // To handle an upload to a ring-buffer, we update the local copy first and upload the entire
   // local data to the device below
   const VulkanContext& ctx = device_.getVulkanContext();
+  VulkanStagingDevice::SubmitHandle handle;
   if (isRingBuffer_) {
     // update local data copy
     checked_memcpy(localData_.get() + range.offset, range.size, (void*)data, range.size);
@@ -164,13 +223,23 @@ igl::Result Buffer::upload(const void* data, const BufferRange& range) {
       extendUpdateRange(currentBufferIndex, range);
     }
     // use staging to upload data to device-local buffers
-    ctx.stagingDevice_->bufferSubData(*currentVulkanBuffer(),
-                                      currentUpdateRange.offset,
-                                      currentUpdateRange.size,
-                                      localData_.get() + currentUpdateRange.offset);
+    handle = ctx.stagingDevice_->bufferSubData(*currentVulkanBuffer(),
+                                               currentUpdateRange.offset,
+                                               currentUpdateRange.size,
+                                               localData_.get() + currentUpdateRange.offset,
+                                               nonBlocking,
+                                               isUnusedByGpu);
   } else {
     // use staging to upload data to device-local buffers
-    ctx.stagingDevice_->bufferSubData(*currentVulkanBuffer(), range.offset, range.size, data);
+    handle = ctx.stagingDevice_->bufferSubData(*currentVulkanBuffer(),
+                                               getVkBufferOffset() + range.offset,
+                                               range.size,
+                                               data,
+                                               nonBlocking,
+                                               isUnusedByGpu);
+  }
+  if (outHandle) {
+    *outHandle = UploadHandle{handle.handle()};
   }
   return igl::Result();
 }
@@ -183,13 +252,18 @@ uint64_t Buffer::gpuAddress(size_t offset) const {
   IGL_ASSERT_MSG((offset & 7) == 0,
                  "Buffer offset must be 8 bytes aligned as per GLSL_EXT_buffer_reference spec.");
 
-  return (uint64_t)currentVulkanBuffer()->getVkDeviceAddress() + offset;
+  return (uint64_t)currentVulkanBuffer()->getVkDeviceAddress() + getVkBufferOffset() + offset;
 }
 
 VkBuffer Buffer::getVkBuffer() const {
   return currentVulkanBuffer()->getVkBuffer();
 }
 
+uint8_t* Buffer::getMappedPtr() const {
+  const auto& buffer = currentVulkanBuffer();
+  return buffer->isMapped() ? buffer->getMappedPtr() + getVkBufferOffset() : nullptr;
+}
+
 void* Buffer::map(const BufferRange& range, igl::Result* outResult) {
   IGL_ASSERT_MSG(!isRingBuffer_, "Buffer::map() operation not supported for ring buffer");
 
@@ -217,14 +291,15 @@ void* Buffer::map(const BufferRange& range, igl::Result* outResult) {
     // handle DEVICE_LOCAL buffers
     tmpBuffer_.resize(range.size);
     const VulkanContext& ctx = device_.getVulkanContext();
-    ctx.stagingDevice_->getBufferSubData(*buffer, range.offset, range.size, tmpBuffer_.data());
+    ctx.stagingDevice_->getBufferSubData(
+        *buffer, getVkBufferOffset() + range.offset, range.size, tmpBuffer_.data());
     return tmpBuffer_.data();
   }
 
   IGL_ASSERT(buffer->getMemoryPropertyFlags() & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
 
   // Vulkan mapped buffers are always coherent in our implementation
-  return buffer->getMappedPtr() + range.offset;
+  return buffer->getMappedPtr() + getVkBufferOffset() + range.offset;
 }
 
 void Buffer::unmap() {
@@ -243,11 +318,16 @@ BufferDesc::BufferAPIHint Buffer::requestedApiHints() const noexcept {
 }
 
 BufferDesc::BufferAPIHint Buffer::acceptedApiHints() const noexcept {
+  BufferDesc::BufferAPIHint hints = 0;
+
   if (desc_.type & BufferDesc::BufferTypeBits::Uniform) {
-    return BufferDesc::BufferAPIHintBits::UniformBlock;
+    hints |= BufferDesc::BufferAPIHintBits::UniformBlock;
+  }
+  if (arenaAllocation_.buffer) {
+    hints |= BufferDesc::BufferAPIHintBits::Pooled;
   }
 
-  return 0;
+  return hints;
 }
 
 ResourceStorage Buffer::storage() const noexcept {
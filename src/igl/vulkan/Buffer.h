@@ -8,7 +8,9 @@
 #pragma once
 
 #include <igl/Buffer.h>
+#include <igl/CommandQueue.h>
 #include <igl/vulkan/Common.h>
+#include <igl/vulkan/VulkanBufferArena.h>
 
 namespace igl {
 namespace vulkan {
@@ -21,10 +23,17 @@ class Buffer final : public igl::IBuffer {
 
  public:
   explicit Buffer(const igl::vulkan::Device& device);
-  ~Buffer() override = default;
+  ~Buffer() override;
 
   Result upload(const void* data, const BufferRange& range) override;
 
+  /// Never waits for the GPU to free up the staging memory. The returned handle belongs to the
+  /// staging device and can be queried with PlatformDevice::isUploadComplete() or waited on with
+  /// PlatformDevice::waitOnUpload()
+  UploadHandle uploadAsync(const void* data,
+                           const BufferRange& range,
+                           Result* outResult = nullptr) override;
+
   void* map(const BufferRange& range, Result* outResult) override;
 
   void unmap() override;
@@ -37,13 +46,28 @@ class Buffer final : public igl::IBuffer {
   uint64_t gpuAddress(size_t offset) const override;
 
   VkBuffer getVkBuffer() const;
+  /// The offset of this buffer's data in getVkBuffer(). Non-zero only for buffers which are
+  /// sub-allocated from a shared buffer, see BufferDesc::BufferAPIHintBits::Pooled
+  VkDeviceSize getVkBufferOffset() const {
+    return arenaAllocation_.offset;
+  }
+  /// Persistently mapped memory of host-visible buffers (including getVkBufferOffset()), nullptr
+  /// for device-local buffers
+  [[nodiscard]] uint8_t* getMappedPtr() const;
   BufferDesc::BufferType getBufferType() const {
     return desc_.type;
   }
 
  private:
   Result create(const BufferDesc& desc);
+  // `isUnusedByGpu` is set for the initial upload of the data provided at creation
+  Result uploadInternal(const void* data,
+                        const BufferRange& range,
+                        bool nonBlocking,
+                        UploadHandle* outHandle,
+                        bool isUnusedByGpu = false);
   [[nodiscard]] const std::shared_ptr<VulkanBuffer>& currentVulkanBuffer() const;
+  [[nodiscard]] bool canBePooled() const;
 
  private:
   const igl::vulkan::Device& device_;
@@ -51,6 +75,8 @@ class Buffer final : public igl::IBuffer {
   bool isRingBuffer_ = false;
   uint32_t previousBufferIndex_ = UINT32_MAX;
   std::vector<std::shared_ptr<VulkanBuffer>> buffers_;
+  // the sub-range of a shared buffer which backs a pooled buffer
+  VulkanBufferArena::Allocation arenaAllocation_;
   std::unique_ptr<uint8_t[]> localData_;
   std::vector<BufferRange> bufferPatches_;
 
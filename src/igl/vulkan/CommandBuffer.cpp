@@ -11,10 +11,14 @@
 #include <igl/vulkan/ComputeCommandEncoder.h>
 #include <igl/vulkan/EnhancedShaderDebuggingStore.h>
 #include <igl/vulkan/Framebuffer.h>
+#include <igl/vulkan/ParallelRenderCommandEncoder.h>
+#include <igl/vulkan/QueryPool.h>
 #include <igl/vulkan/RenderCommandEncoder.h>
 #include <igl/vulkan/Texture.h>
+#include <igl/vulkan/TimestampQueryPool.h>
 #include <igl/vulkan/VulkanContext.h>
 #include <igl/vulkan/VulkanImage.h>
+#include <igl/vulkan/VulkanSecondaryCommandBuffers.h>
 #include <igl/vulkan/VulkanTexture.h>
 
 namespace igl {
@@ -23,6 +27,30 @@ namespace vulkan {
 CommandBuffer::CommandBuffer(VulkanContext& ctx, CommandBufferDesc desc) :
   ctx_(ctx), wrapper_(ctx_.immediate_->acquire()), desc_(std::move(desc)) {
   IGL_ASSERT(wrapper_.cmdBuf_ != VK_NULL_HANDLE);
+
+  // a command buffer which is never submitted must not keep the command buffers depending on it
+  // waiting forever, so only weak references to the dependencies are kept
+  dependencies_.reserve(desc_.dependencies.size());
+  for (const auto& dependency : desc_.dependencies) {
+    IGL_ASSERT(dependency);
+    const auto cmdBuffer = std::static_pointer_cast<const CommandBuffer>(dependency);
+    dependencies_.push_back(Dependency{cmdBuffer, cmdBuffer->isSubmitted_});
+  }
+  desc_.dependencies.clear();
+
+  if (desc_.timestampQueryPool) {
+    resetTimestampQueries(*desc_.timestampQueryPool);
+  }
+}
+
+CommandBuffer::~CommandBuffer() {
+  if (!*isSubmitted_) {
+    // a command buffer destroyed without being submitted gives its Vulkan command buffer back
+    ctx_.immediate_->discard(wrapper_);
+    for (const uint32_t index : secondaryCommandBuffers_) {
+      ctx_.secondaryCommandBuffers_->release(index);
+    }
+  }
 }
 
 std::unique_ptr<IComputeCommandEncoder> CommandBuffer::createComputeCommandEncoder() {
@@ -56,14 +84,8 @@ void transitionColorAttachment(VkCommandBuffer buffer, const std::shared_ptr<ITe
 
 } // namespace
 
-std::unique_ptr<IRenderCommandEncoder> CommandBuffer::createRenderCommandEncoder(
-    const RenderPassDesc& renderPass,
-    std::shared_ptr<IFramebuffer> framebuffer,
-    Result* outResult) {
+void CommandBuffer::prepareAttachments(const std::shared_ptr<IFramebuffer>& framebuffer) {
   IGL_PROFILER_FUNCTION();
-  IGL_ASSERT(framebuffer);
-
-  framebuffer_ = framebuffer;
 
   // prepare all the color attachments
   const auto& indices = framebuffer->getColorAttachmentIndices();
@@ -92,9 +114,21 @@ std::unique_ptr<IRenderCommandEncoder> CommandBuffer::createRenderCommandEncoder
         VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, // wait for subsequent fragment shaders
         VkImageSubresourceRange{flags, 0, VK_REMAINING_MIP_LEVELS, 0, VK_REMAINING_ARRAY_LAYERS});
   }
+}
 
-  auto encoder =
-      RenderCommandEncoder::create(shared_from_this(), ctx_, renderPass, framebuffer, outResult);
+std::unique_ptr<IRenderCommandEncoder> CommandBuffer::createRenderCommandEncoder(
+    const RenderPassDesc& renderPass,
+    std::shared_ptr<IFramebuffer> framebuffer,
+    Result* outResult) {
+  IGL_PROFILER_FUNCTION();
+  IGL_ASSERT(framebuffer);
+
+  framebuffer_ = framebuffer;
+
+  prepareAttachments(framebuffer);
+
+  auto encoder = RenderCommandEncoder::create(
+      shared_from_this(), ctx_, renderPass, framebuffer, VK_SUBPASS_CONTENTS_INLINE, outResult);
 
   if (ctx_.enhancedShaderDebuggingStore_) {
     encoder->binder().bindBuffer(
@@ -106,6 +140,32 @@ std::unique_ptr<IRenderCommandEncoder> CommandBuffer::createRenderCommandEncoder
   return encoder;
 }
 
+std::unique_ptr<IParallelRenderCommandEncoder> CommandBuffer::createParallelRenderCommandEncoder(
+    const RenderPassDesc& renderPass,
+    std::shared_ptr<IFramebuffer> framebuffer,
+    Result* outResult) {
+  IGL_PROFILER_FUNCTION();
+  IGL_ASSERT(framebuffer);
+
+  framebuffer_ = framebuffer;
+
+  prepareAttachments(framebuffer);
+
+  // the render pass is begun in the primary command buffer and recorded in secondary ones
+  auto primary = RenderCommandEncoder::create(shared_from_this(),
+                                              ctx_,
+                                              renderPass,
+                                              framebuffer,
+                                              VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS,
+                                              outResult);
+  if (!primary) {
+    return nullptr;
+  }
+
+  return std::make_unique<ParallelRenderCommandEncoder>(
+      shared_from_this(), ctx_, std::move(primary));
+}
+
 void CommandBuffer::present(std::shared_ptr<ITexture> surface) const {
   IGL_PROFILER_FUNCTION();
 
@@ -156,13 +216,102 @@ void CommandBuffer::present(std::shared_ptr<ITexture> surface) const {
 
 void CommandBuffer::pushDebugGroupLabel(const std::string& label, const igl::Color& color) const {
   ivkCmdBeginDebugUtilsLabel(wrapper_.cmdBuf_, label.c_str(), color.toFloatPtr());
+  beginTimestampScope(label);
 }
 
 void CommandBuffer::popDebugGroupLabel() const {
+  endTimestampScope();
   ivkCmdEndDebugUtilsLabel(wrapper_.cmdBuf_);
 }
 
+void CommandBuffer::resetTimestampQueries(ITimestampQueryPool& pool) {
+  static_cast<TimestampQueryPool&>(pool).reset(wrapper_.cmdBuf_);
+}
+
+void CommandBuffer::writeTimestamp(ITimestampQueryPool& pool, uint32_t query) {
+  static_cast<const TimestampQueryPool&>(pool).writeTimestamp(
+      wrapper_.cmdBuf_, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, query);
+}
+
+void CommandBuffer::resetQueries(IQueryPool& pool, uint32_t firstQuery, uint32_t queryCount) {
+  const auto& vkPool = static_cast<const QueryPool&>(pool);
+  if (!IGL_VERIFY(firstQuery + queryCount <= vkPool.getQueryCount())) {
+    return;
+  }
+  vkCmdResetQueryPool(wrapper_.cmdBuf_, vkPool.getVkQueryPool(), firstQuery, queryCount);
+}
+
+void CommandBuffer::copyQueryResults(IQueryPool& pool,
+                                     uint32_t firstQuery,
+                                     uint32_t queryCount,
+                                     IBuffer& buffer,
+                                     size_t bufferOffset) {
+  IGL_PROFILER_FUNCTION();
+
+  const auto& vkPool = static_cast<const QueryPool&>(pool);
+  if (!IGL_VERIFY(firstQuery + queryCount <= vkPool.getQueryCount())) {
+    return;
+  }
+
+  const VkDeviceSize stride = vkPool.getValuesPerQuery() * sizeof(uint64_t);
+  const VkDeviceSize size = queryCount * stride;
+  const auto& vkBuffer = static_cast<Buffer&>(buffer);
+
+  if (!IGL_VERIFY(bufferOffset + size <= vkBuffer.getSizeInBytes())) {
+    return;
+  }
+
+  // pooled buffers are sub-allocated from a larger VkBuffer
+  const VkDeviceSize dstOffset = vkBuffer.getVkBufferOffset() + bufferOffset;
+
+  // VK_QUERY_RESULT_WAIT_BIT makes the GPU, not the CPU, wait for the results
+  vkCmdCopyQueryPoolResults(wrapper_.cmdBuf_,
+                            vkPool.getVkQueryPool(),
+                            firstQuery,
+                            queryCount,
+                            vkBuffer.getVkBuffer(),
+                            dstOffset,
+                            stride,
+                            VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
+
+  // make the results visible to indirect draws and shaders
+  ivkBufferMemoryBarrier(wrapper_.cmdBuf_,
+                         vkBuffer.getVkBuffer(),
+                         VK_ACCESS_TRANSFER_WRITE_BIT,
+                         VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_SHADER_READ_BIT,
+                         dstOffset,
+                         size,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT |
+                             VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT |
+                             VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+}
+
+void CommandBuffer::beginTimestampScope(const std::string& label) const {
+  if (desc_.timestampQueryPool) {
+    auto& pool = static_cast<TimestampQueryPool&>(*desc_.timestampQueryPool);
+    const uint32_t query = pool.beginScope(label);
+    if (query != ITimestampQueryPool::kInvalidQuery) {
+      pool.writeTimestamp(wrapper_.cmdBuf_, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, query);
+    }
+  }
+}
+
+void CommandBuffer::endTimestampScope() const {
+  if (desc_.timestampQueryPool) {
+    auto& pool = static_cast<TimestampQueryPool&>(*desc_.timestampQueryPool);
+    const uint32_t query = pool.endScope();
+    if (query != ITimestampQueryPool::kInvalidQuery) {
+      pool.writeTimestamp(wrapper_.cmdBuf_, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, query);
+    }
+  }
+}
+
 void CommandBuffer::waitUntilCompleted() {
+  IGL_ASSERT_MSG(!isPending_,
+                 "The command buffer has not been submitted to the GPU yet because its "
+                 "dependencies have not been submitted");
+
   ctx_.immediate_->wait(lastSubmitHandle_);
 
   lastSubmitHandle_ = VulkanImmediateCommands::SubmitHandle();
@@ -178,5 +327,23 @@ std::shared_ptr<ITexture> CommandBuffer::getPresentedSurface() const {
   return presentedSurface_;
 }
 
+bool CommandBuffer::areDependenciesSubmitted() const {
+  for (const auto& dependency : dependencies_) {
+    if (!*dependency.isSubmitted) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CommandBuffer::hasAbandonedDependencies() const {
+  for (const auto& dependency : dependencies_) {
+    if (!*dependency.isSubmitted && dependency.cmdBuffer.expired()) {
+      return true;
+    }
+  }
+  return false;
+}
+
 } // namespace vulkan
 } // namespace igl
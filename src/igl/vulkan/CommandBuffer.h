@@ -15,12 +15,14 @@ namespace igl {
 namespace vulkan {
 
 class Buffer;
+class CommandQueue;
 class VulkanContext;
 
 class CommandBuffer final : public ICommandBuffer,
                             public std::enable_shared_from_this<CommandBuffer> {
  public:
   CommandBuffer(VulkanContext& ctx, CommandBufferDesc desc);
+  ~CommandBuffer() override;
 
   std::unique_ptr<IComputeCommandEncoder> createComputeCommandEncoder() override;
 
@@ -29,6 +31,11 @@ class CommandBuffer final : public ICommandBuffer,
       std::shared_ptr<IFramebuffer> framebuffer,
       Result* outResult) override;
 
+  std::unique_ptr<IParallelRenderCommandEncoder> createParallelRenderCommandEncoder(
+      const RenderPassDesc& renderPass,
+      std::shared_ptr<IFramebuffer> framebuffer,
+      Result* outResult) override;
+
   void present(std::shared_ptr<ITexture> surface) const override;
 
   void pushDebugGroupLabel(const std::string& label, const igl::Color& color) const override;
@@ -39,6 +46,18 @@ class CommandBuffer final : public ICommandBuffer,
 
   void waitUntilScheduled() override;
 
+  void resetTimestampQueries(ITimestampQueryPool& pool) override;
+
+  void writeTimestamp(ITimestampQueryPool& pool, uint32_t query) override;
+
+  void resetQueries(IQueryPool& pool, uint32_t firstQuery, uint32_t queryCount) override;
+
+  void copyQueryResults(IQueryPool& pool,
+                        uint32_t firstQuery,
+                        uint32_t queryCount,
+                        IBuffer& buffer,
+                        size_t bufferOffset) override;
+
   VkCommandBuffer getVkCommandBuffer() const {
     return wrapper_.cmdBuf_;
   }
@@ -51,8 +70,22 @@ class CommandBuffer final : public ICommandBuffer,
 
   std::shared_ptr<ITexture> getPresentedSurface() const;
 
+  // true when all the command buffers in CommandBufferDesc::dependencies have been submitted
+  bool areDependenciesSubmitted() const;
+  // true when one of the dependencies was destroyed without being submitted, so it never will be
+  bool hasAbandonedDependencies() const;
+
+  // Used by the encoders to time themselves and their debug groups. No-ops unless a timestamp query
+  // pool was set in CommandBufferDesc
+  void beginTimestampScope(const std::string& label) const;
+  void endTimestampScope() const;
+
+ private:
+  void prepareAttachments(const std::shared_ptr<IFramebuffer>& framebuffer);
+
  private:
   friend class CommandQueue;
+  friend class ParallelRenderCommandEncoder;
 
   VulkanContext& ctx_;
   const VulkanImmediateCommands::CommandBufferWrapper& wrapper_;
@@ -64,6 +97,24 @@ class CommandBuffer final : public ICommandBuffer,
   mutable std::shared_ptr<ITexture> presentedSurface_;
 
   VulkanImmediateCommands::SubmitHandle lastSubmitHandle_ = {};
+  // shared with the command buffers which depend on this one, so they can tell whether it was
+  // submitted after it has been destroyed
+  std::shared_ptr<bool> isSubmitted_ = std::make_shared<bool>(false);
+  // submitted before its dependencies; the submission is deferred until they are submitted
+  bool isPending_ = false;
+  // the command queue which created this command buffer
+  const CommandQueue* queue_ = nullptr;
+
+  // CommandBufferDesc::dependencies; the dependencies are not kept alive by this command buffer
+  struct Dependency {
+    std::weak_ptr<const CommandBuffer> cmdBuffer;
+    std::shared_ptr<const bool> isSubmitted;
+  };
+  std::vector<Dependency> dependencies_;
+
+  // indices of the secondary command buffers (see VulkanSecondaryCommandBuffers) executed by this
+  // command buffer; they are recycled once the GPU has finished executing it
+  std::vector<uint32_t> secondaryCommandBuffers_;
 };
 
 } // namespace vulkan
@@ -5,6 +5,8 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <algorithm>
+
 #include <igl/vulkan/Buffer.h>
 #include <igl/vulkan/CommandBuffer.h>
 #include <igl/vulkan/CommandQueue.h>
@@ -14,6 +16,7 @@
 #include <igl/vulkan/VulkanContext.h>
 #include <igl/vulkan/VulkanDevice.h>
 #include <igl/vulkan/VulkanHelpers.h>
+#include <igl/vulkan/VulkanStagingDevice.h>
 #include <igl/vulkan/VulkanSwapchain.h>
 
 namespace igl {
@@ -28,33 +31,151 @@ std::shared_ptr<ICommandBuffer> CommandQueue::createCommandBuffer(const CommandB
                                                                   Result* outResult) {
   IGL_PROFILER_FUNCTION();
 
-  // for now, we want only 1 command buffer
-  IGL_ASSERT(!isInsideFrame_);
+  // dependencies are fixed at creation and can only refer to existing command buffers, so they
+  // cannot form cycles
+  for (const auto& dependency : desc.dependencies) {
+    if (!dependency) {
+      Result::setResult(
+          outResult, Result::Code::ArgumentNull, "Command buffer dependencies cannot be null");
+      return nullptr;
+    }
+    const auto& vkDependency = static_cast<const CommandBuffer&>(*dependency);
+    if (vkDependency.queue_ != this) {
+      Result::setResult(outResult,
+                        Result::Code::ArgumentInvalid,
+                        "Command buffer dependencies have to be created by the same queue");
+      return nullptr;
+    }
+  }
+
+  // the command buffers destroyed without being submitted release their slots here
+  submitPendingCommandBuffers(device_.getVulkanContext());
+
+  // all the queues of a device share the command buffers of VulkanContext::immediate_, which waits
+  // forever for one of them when all of them are open
+  if (device_.getVulkanContext().immediate_->getNumEncodingCommandBuffers() >=
+      kMaxOpenCommandBuffers) {
+    Result::setResult(outResult,
+                      Result::Code::InvalidOperation,
+                      "Too many command buffers are open at the same time");
+    return nullptr;
+  }
+
+  Result::setOk(outResult);
 
-  isInsideFrame_ = true;
+  auto cmdBuffer = std::make_shared<CommandBuffer>(device_.getVulkanContext(), desc);
+  cmdBuffer->queue_ = this;
+  openCommandBuffers_.push_back(cmdBuffer);
 
-  return std::make_shared<CommandBuffer>(device_.getVulkanContext(), desc);
+  return cmdBuffer;
 }
 
-SubmitHandle CommandQueue::submit(const ICommandBuffer& cmdBuffer, bool /* endOfFrame */) {
+uint32_t CommandQueue::getNumOpenCommandBuffers() {
+  openCommandBuffers_.erase(
+      std::remove_if(openCommandBuffers_.begin(),
+                     openCommandBuffers_.end(),
+                     [](const std::weak_ptr<CommandBuffer>& weak) {
+                       const auto cmdBuffer = weak.lock();
+                       return !cmdBuffer || *cmdBuffer->isSubmitted_;
+                     }),
+      openCommandBuffers_.end());
+  return static_cast<uint32_t>(openCommandBuffers_.size());
+}
+
+SubmitHandle CommandQueue::submit(const ICommandBuffer& cmdBuffer, bool endOfFrame) {
   IGL_PROFILER_FUNCTION();
   VulkanContext& ctx = device_.getVulkanContext();
 
-  if (ctx.enhancedShaderDebuggingStore_) {
-    ctx.enhancedShaderDebuggingStore_->installBufferBarrier(cmdBuffer);
-  }
+  auto* vkCmdBuffer =
+      const_cast<vulkan::CommandBuffer*>(static_cast<const vulkan::CommandBuffer*>(&cmdBuffer));
+
+  IGL_ASSERT(vkCmdBuffer->queue_ == this);
+  IGL_ASSERT_MSG(!*vkCmdBuffer->isSubmitted_ && !vkCmdBuffer->isPending_,
+                 "The command buffer has already been submitted");
 
   incrementDrawCount(cmdBuffer.getCurrentDrawCount());
 
-  IGL_ASSERT(isInsideFrame_);
+  if (!vkCmdBuffer->areDependenciesSubmitted() && !vkCmdBuffer->hasAbandonedDependencies()) {
+    // keep the command buffer alive until the last of its dependencies is submitted
+    vkCmdBuffer->isPending_ = true;
+    pendingSubmits_.push_back(PendingSubmit{vkCmdBuffer->shared_from_this(), endOfFrame});
+    submitPendingCommandBuffers(ctx);
+    return vkCmdBuffer->isPending_ ? 0 : vkCmdBuffer->lastSubmitHandle_.handle();
+  }
 
-  auto* vkCmdBuffer =
-      const_cast<vulkan::CommandBuffer*>(static_cast<const vulkan::CommandBuffer*>(&cmdBuffer));
-  const bool presentIfNotDebugging = ctx.enhancedShaderDebuggingStore_ == nullptr;
-  auto submitHandle = endCommandBuffer(ctx, vkCmdBuffer, presentIfNotDebugging);
+  const SubmitHandle submitHandle = submitCommandBuffer(ctx, vkCmdBuffer, endOfFrame);
+
+  // the command buffers waiting for this one can be submitted now
+  submitPendingCommandBuffers(ctx);
+
+  return submitHandle;
+}
+
+void CommandQueue::submitPendingCommandBuffers(igl::vulkan::VulkanContext& ctx) {
+  IGL_PROFILER_FUNCTION();
+
+  // submit the ready command buffers in the order of submit() calls
+  for (auto it = pendingSubmits_.begin(); it != pendingSubmits_.end();) {
+    const bool isAbandoned = it->cmdBuffer->hasAbandonedDependencies();
+    if (!isAbandoned && !it->cmdBuffer->areDependenciesSubmitted()) {
+      ++it;
+      continue;
+    }
+    if (isAbandoned) {
+      IGL_LOG_ERROR(
+          "A dependency of the command buffer '%s' was destroyed without being submitted\n",
+          it->cmdBuffer->desc_.debugName.c_str());
+      IGL_ASSERT_NOT_REACHED();
+    }
+    const PendingSubmit pending = *it;
+    pendingSubmits_.erase(it);
+    pending.cmdBuffer->isPending_ = false;
+    submitCommandBuffer(ctx, pending.cmdBuffer.get(), pending.endOfFrame);
+    // submitting it might have unblocked the ones before it
+    it = pendingSubmits_.begin();
+  }
+
+  if (!pendingSubmits_.empty() && pendingSubmits_.size() == getNumOpenCommandBuffers()) {
+    // every open command buffer waits for another one: nothing can submit their dependencies
+    IGL_LOG_ERROR("All the open command buffers are waiting for their dependencies\n");
+    IGL_ASSERT_NOT_REACHED();
+    std::vector<PendingSubmit> pendingSubmits;
+    pendingSubmits.swap(pendingSubmits_);
+    for (const auto& pending : pendingSubmits) {
+      pending.cmdBuffer->isPending_ = false;
+      submitCommandBuffer(ctx, pending.cmdBuffer.get(), pending.endOfFrame);
+    }
+  }
+}
+
+SubmitHandle CommandQueue::submitCommandBuffer(igl::vulkan::VulkanContext& ctx,
+                                               igl::vulkan::CommandBuffer* cmdBuffer,
+                                               bool endOfFrame) {
+  IGL_PROFILER_FUNCTION();
 
   if (ctx.enhancedShaderDebuggingStore_) {
-    enhancedShaderDebuggingPass(ctx, vkCmdBuffer);
+    ctx.enhancedShaderDebuggingStore_->installBufferBarrier(*cmdBuffer);
+  }
+
+  // the batched staging copies have to be executed before the commands which use their results
+  ctx.stagingDevice_->flushPendingCopies();
+
+  const bool isEndOfFrame =
+      !ctx.config_.explicitFramePacing || endOfFrame || cmdBuffer->isFromSwapchain();
+  const bool hasDebuggingPass = ctx.enhancedShaderDebuggingStore_ != nullptr;
+
+  // when debugging, the frame is presented and ended by the debugging pass
+  auto submitHandle = endCommandBuffer(
+      ctx, cmdBuffer, !hasDebuggingPass, isEndOfFrame && !hasDebuggingPass);
+
+  cmdBuffer->dependencies_.clear();
+
+  if (hasDebuggingPass) {
+    enhancedShaderDebuggingPass(ctx, cmdBuffer, isEndOfFrame);
+  }
+
+  if (isEndOfFrame) {
+    ctx.pipelineCache_->autosave();
   }
 
   return submitHandle;
@@ -62,7 +183,8 @@ SubmitHandle CommandQueue::submit(const ICommandBuffer& cmdBuffer, bool /* endOf
 
 SubmitHandle CommandQueue::endCommandBuffer(const igl::vulkan::VulkanContext& ctx,
                                             igl::vulkan::CommandBuffer* cmdBuffer,
-                                            bool present) {
+                                            bool present,
+                                            bool endOfFrame) {
   IGL_PROFILER_FUNCTION();
 
   const bool isGraphicsQueue = desc_.type == CommandQueueType::Graphics;
@@ -75,21 +197,35 @@ SubmitHandle CommandQueue::endCommandBuffer(const igl::vulkan::VulkanContext& ct
   }
 
   cmdBuffer->lastSubmitHandle_ = ctx.immediate_->submit(cmdBuffer->wrapper_);
+  *cmdBuffer->isSubmitted_ = true;
 
   if (shouldPresent) {
     ctx.present();
   }
   ctx.DUBs_->markSubmit(cmdBuffer->lastSubmitHandle_);
-  ctx.syncManager_->markSubmit(cmdBuffer->lastSubmitHandle_);
-  ctx.processDeferredTasks();
+  ctx.syncManager_->markSubmit(cmdBuffer->lastSubmitHandle_, endOfFrame);
+
+  if (!cmdBuffer->secondaryCommandBuffers_.empty()) {
+    // recycle the secondary command buffers once the GPU has finished executing them
+    std::vector<uint32_t> indices;
+    indices.swap(cmdBuffer->secondaryCommandBuffers_);
+    ctx.deferredTask(std::packaged_task<void()>(
+                         [secondaryCommandBuffers = ctx.secondaryCommandBuffers_.get(), indices]() {
+                           for (const uint32_t index : indices) {
+                             secondaryCommandBuffers->release(index);
+                           }
+                         }),
+                     cmdBuffer->lastSubmitHandle_);
+  }
 
-  isInsideFrame_ = false;
+  ctx.processDeferredTasks();
 
   return cmdBuffer->lastSubmitHandle_.handle();
 }
 
 void CommandQueue::enhancedShaderDebuggingPass(const igl::vulkan::VulkanContext& ctx,
-                                               const igl::vulkan::CommandBuffer* cmdBuffer) {
+                                               const igl::vulkan::CommandBuffer* cmdBuffer,
+                                               bool endOfFrame) {
   IGL_PROFILER_FUNCTION();
 
   auto& debugger = ctx.enhancedShaderDebuggingStore_;
@@ -97,6 +233,9 @@ void CommandQueue::enhancedShaderDebuggingPass(const igl::vulkan::VulkanContext&
   // If there are no color attachments, return, as we won't have a framebuffer to render into
   if (!cmdBuffer->getFramebuffer() ||
       cmdBuffer->getFramebuffer()->getColorAttachmentIndices().empty()) {
+    if (endOfFrame) {
+      ctx.syncManager_->acquireNext();
+    }
     return;
   }
 
@@ -114,6 +253,9 @@ void CommandQueue::enhancedShaderDebuggingPass(const igl::vulkan::VulkanContext&
 
   if (!IGL_VERIFY(result.isOk())) {
     IGL_LOG_INFO("Error obtaining a new command buffer for drawing debug lines");
+    if (endOfFrame) {
+      ctx.syncManager_->acquireNext();
+    }
     return;
   }
 
@@ -162,20 +304,21 @@ void CommandQueue::enhancedShaderDebuggingPass(const igl::vulkan::VulkanContext&
                          lineBuffer->getVkBuffer(),
                          0, /* src access flag */
                          0, /* dst access flag */
-                         0,
-                         VK_WHOLE_SIZE,
+                         lineBuffer->getVkBufferOffset(),
+                         lineBuffer->getSizeInBytes(),
                          VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
                          VK_PIPELINE_STAGE_TRANSFER_BIT);
 
   // Reset instanceCount of the buffer
   vkCmdFillBuffer(vkResetCmdBuffer,
                   lineBuffer->getVkBuffer(),
-                  offsetof(EnhancedShaderDebuggingStore::Header, command_) +
+                  lineBuffer->getVkBufferOffset() +
+                      offsetof(EnhancedShaderDebuggingStore::Header, command_) +
                       offsetof(VkDrawIndirectCommand, instanceCount),
                   sizeof(uint32_t), // reset only the instance count
                   0);
 
-  endCommandBuffer(ctx, resetCmdBuffer, true);
+  endCommandBuffer(ctx, resetCmdBuffer, true, endOfFrame);
 }
 
 } // namespace vulkan
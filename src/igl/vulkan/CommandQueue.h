@@ -7,17 +7,30 @@
 
 #pragma once
 
+#include <memory>
+#include <vector>
+
 #include <igl/CommandQueue.h>
 #include <igl/vulkan/Common.h>
 #include <igl/vulkan/Device.h>
+#include <igl/vulkan/VulkanImmediateCommands.h>
 
 namespace igl {
 namespace vulkan {
 
 class CommandBuffer;
 
+/// @brief Several command buffers can be open at the same time. They are executed by the GPU in the
+/// order of submit() calls, except that a command buffer is never submitted before its
+/// dependencies (see CommandBufferDesc::dependencies).
 class CommandQueue final : public ICommandQueue {
  public:
+  // the number of command buffers which can be open at the same time on all the queues of a device;
+  // the remaining command buffers of VulkanImmediateCommands are left for internal submits and
+  // frames in flight
+  static constexpr uint32_t kMaxOpenCommandBuffers =
+      VulkanImmediateCommands::kMaxCommandBuffers / 2;
+
   CommandQueue(Device& device, const CommandQueueDesc& desc);
 
   ~CommandQueue() override = default;
@@ -31,17 +44,35 @@ class CommandQueue final : public ICommandQueue {
   }
 
  private:
+  SubmitHandle submitCommandBuffer(igl::vulkan::VulkanContext& ctx,
+                                   igl::vulkan::CommandBuffer* cmdBuffer,
+                                   bool endOfFrame);
   SubmitHandle endCommandBuffer(const igl::vulkan::VulkanContext& ctx,
                                 igl::vulkan::CommandBuffer* cmdBuffer,
-                                bool present);
+                                bool present,
+                                bool endOfFrame);
 
   void enhancedShaderDebuggingPass(const igl::vulkan::VulkanContext& ctx,
-                                   const igl::vulkan::CommandBuffer* cmdBuffer);
+                                   const igl::vulkan::CommandBuffer* cmdBuffer,
+                                   bool endOfFrame);
+
+  // submits the deferred command buffers whose dependencies have been submitted
+  void submitPendingCommandBuffers(igl::vulkan::VulkanContext& ctx);
+  // the command buffers created by this queue which are alive and not submitted yet
+  uint32_t getNumOpenCommandBuffers();
 
  private:
+  struct PendingSubmit {
+    std::shared_ptr<CommandBuffer> cmdBuffer;
+    bool endOfFrame = false;
+  };
+
   igl::vulkan::Device& device_;
   CommandQueueDesc desc_;
-  bool isInsideFrame_ = false;
+  // command buffers destroyed without being submitted do not keep their slots
+  std::vector<std::weak_ptr<CommandBuffer>> openCommandBuffers_;
+  // command buffers which were submitted before their dependencies, in the order of submit() calls
+  std::vector<PendingSubmit> pendingSubmits_;
 };
 
 } // namespace vulkan
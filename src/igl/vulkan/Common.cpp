@@ -442,6 +442,40 @@ VkCompareOp compareFunctionToVkCompareOp(igl::CompareFunction func) {
   return VK_COMPARE_OP_ALWAYS;
 }
 
+const VkSpecializationInfo* getVkSpecializationInfo(
+    const std::vector<SpecializationConstant>& constants,
+    std::vector<VkSpecializationMapEntry>& outEntries,
+    std::vector<uint32_t>& outData,
+    VkSpecializationInfo& outInfo) {
+  if (constants.empty()) {
+    return nullptr;
+  }
+
+  outEntries.clear();
+  outData.clear();
+  outEntries.reserve(constants.size());
+  outData.reserve(constants.size());
+
+  // every constant is 32 bits wide: VkBool32, int32_t, uint32_t or float
+  for (const auto& constant : constants) {
+    outEntries.push_back({
+        constant.id,
+        static_cast<uint32_t>(outData.size() * sizeof(uint32_t)),
+        sizeof(uint32_t),
+    });
+    outData.push_back(constant.value);
+  }
+
+  outInfo = {
+      static_cast<uint32_t>(outEntries.size()),
+      outEntries.data(),
+      outData.size() * sizeof(uint32_t),
+      outData.data(),
+  };
+
+  return &outInfo;
+}
+
 VkSampleCountFlagBits getVulkanSampleCountFlags(size_t numSamples) {
   if (numSamples <= 1) {
     return VK_SAMPLE_COUNT_1_BIT;
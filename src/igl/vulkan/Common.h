@@ -24,6 +24,7 @@
 
 #include <igl/Common.h>
 #include <igl/DepthStencilState.h>
+#include <igl/Shader.h>
 #include <igl/Texture.h>
 #include <igl/vulkan/VulkanHelpers.h>
 
@@ -77,4 +78,12 @@ VkCompareOp compareFunctionToVkCompareOp(igl::CompareFunction func);
 VkSampleCountFlagBits getVulkanSampleCountFlags(size_t numSamples);
 VkSurfaceFormatKHR colorSpaceToVkSurfaceFormat(igl::ColorSpace colorSpace, bool isBGR = false);
 
+/// Returns nullptr if there are no constants. Otherwise, 'outEntries' and 'outData' are filled and
+/// have to outlive the returned structure.
+const VkSpecializationInfo* getVkSpecializationInfo(
+    const std::vector<SpecializationConstant>& constants,
+    std::vector<VkSpecializationMapEntry>& outEntries,
+    std::vector<uint32_t>& outData,
+    VkSpecializationInfo& outInfo);
+
 } // namespace igl::vulkan
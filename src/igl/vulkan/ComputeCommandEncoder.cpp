@@ -21,15 +21,20 @@ namespace vulkan {
 ComputeCommandEncoder::ComputeCommandEncoder(const std::shared_ptr<CommandBuffer>& commandBuffer,
                                              const VulkanContext& ctx) :
   ctx_(ctx),
+  commandBuffer_(commandBuffer.get()),
   cmdBuffer_(commandBuffer ? commandBuffer->getVkCommandBuffer() : VK_NULL_HANDLE),
-  binder_(commandBuffer, ctx_, VK_PIPELINE_BIND_POINT_COMPUTE) {
+  binder_(cmdBuffer_, ctx_, VK_PIPELINE_BIND_POINT_COMPUTE) {
   IGL_PROFILER_FUNCTION();
 
-  IGL_ASSERT(commandBuffer);
+  if (!IGL_VERIFY(commandBuffer)) {
+    return;
+  }
 
   ctx_.checkAndUpdateDescriptorSets();
   ctx_.DUBs_->update(cmdBuffer_, VK_PIPELINE_BIND_POINT_COMPUTE, nullptr);
 
+  commandBuffer_->beginTimestampScope("ComputeCommandEncoder");
+
   isEncoding_ = true;
 }
 
@@ -41,6 +46,8 @@ void ComputeCommandEncoder::endEncoding() {
   }
 
   isEncoding_ = false;
+
+  commandBuffer_->endTimestampScope();
 }
 
 void ComputeCommandEncoder::bindComputePipelineState(
@@ -51,18 +58,20 @@ void ComputeCommandEncoder::bindComputePipelineState(
     return;
   }
 
-  const igl::vulkan::ComputePipelineState* cps =
-      static_cast<igl::vulkan::ComputePipelineState*>(pipelineState.get());
-
-  IGL_ASSERT(cps);
+  currentPipeline_ = pipelineState;
 
-  binder_.bindPipeline(cps->getVkPipeline());
+  binder_.bindPipeline(
+      static_cast<igl::vulkan::ComputePipelineState&>(*currentPipeline_).getVkPipeline());
 }
 
 void ComputeCommandEncoder::dispatchThreadGroups(const Dimensions& threadgroupCount,
                                                  const Dimensions& /*threadgroupSize*/) {
   IGL_PROFILER_FUNCTION();
 
+  if (currentPipeline_) {
+    binder_.bindPipeline(
+        static_cast<igl::vulkan::ComputePipelineState&>(*currentPipeline_).getVkPipeline());
+  }
   binder_.updateBindings();
   // threadgroupSize is controlled inside compute shaders
   vkCmdDispatch(
@@ -74,6 +83,7 @@ void ComputeCommandEncoder::pushDebugGroupLabel(const std::string& label,
   IGL_ASSERT(!label.empty());
 
   ivkCmdBeginDebugUtilsLabel(cmdBuffer_, label.c_str(), color.toFloatPtr());
+  commandBuffer_->beginTimestampScope(label);
 }
 
 void ComputeCommandEncoder::insertDebugEventLabel(const std::string& label,
@@ -84,6 +94,7 @@ void ComputeCommandEncoder::insertDebugEventLabel(const std::string& label,
 }
 
 void ComputeCommandEncoder::popDebugGroupLabel() const {
+  commandBuffer_->endTimestampScope();
   ivkCmdEndDebugUtilsLabel(cmdBuffer_);
 }
 
@@ -51,8 +51,11 @@ class ComputeCommandEncoder : public IComputeCommandEncoder {
 
  private:
   const VulkanContext& ctx_;
+  const CommandBuffer* commandBuffer_ = nullptr;
   VkCommandBuffer cmdBuffer_ = VK_NULL_HANDLE;
   bool isEncoding_ = false;
+  // the pipeline is rebuilt when the bindless descriptor sets grow while this encoder is open
+  std::shared_ptr<IComputePipelineState> currentPipeline_;
 
   igl::vulkan::ResourcesBinder binder_;
 };
@@ -13,6 +13,7 @@
 #include <igl/vulkan/VulkanPipelineBuilder.h>
 #include <igl/vulkan/VulkanPipelineLayout.h>
 #include <utility>
+#include <vector>
 
 namespace igl {
 namespace vulkan {
@@ -36,27 +37,46 @@ ComputePipelineState ::~ComputePipelineState() {
 }
 
 VkPipeline ComputePipelineState::getVkPipeline() const {
+  const VulkanContext& ctx = device_.getVulkanContext();
+
   if (pipeline_ != VK_NULL_HANDLE) {
-    return pipeline_;
+    if (pipelineGeneration_ == ctx.bindlessGeneration_) {
+      return pipeline_;
+    }
+    // the bindless descriptor sets have grown, so the pipeline layout has changed
+    ctx.deferredTask(std::packaged_task<void()>(
+        [device = ctx.device_->getVkDevice(), pipeline = pipeline_]() {
+          vkDestroyPipeline(device, pipeline, nullptr);
+        }));
+    pipeline_ = VK_NULL_HANDLE;
   }
 
-  const VulkanContext& ctx = device_.getVulkanContext();
+  pipelineGeneration_ = ctx.bindlessGeneration_;
 
   const auto& shaderModule = desc_.shaderStages->getComputeModule();
 
-  igl::vulkan::VulkanComputePipelineBuilder()
-      .shaderStage(ivkGetPipelineShaderStageCreateInfo(
-          VK_SHADER_STAGE_COMPUTE_BIT,
-          igl::vulkan::ShaderModule::getVkShaderModule(shaderModule),
-          shaderModule->info().entryPoint.c_str()))
-      .build(ctx.device_->getVkDevice(),
-             // TODO: use ctx.pipelineCache_
-             // @fb-only
-             // @fb-only
-             VK_NULL_HANDLE,
-             ctx.pipelineLayoutCompute_->getVkPipelineLayout(),
-             &pipeline_,
-             desc_.debugName.c_str());
+  std::vector<VkSpecializationMapEntry> specializationEntries;
+  std::vector<uint32_t> specializationData;
+  VkSpecializationInfo specializationInfo = {};
+  const VkSpecializationInfo* specialization = getVkSpecializationInfo(
+      desc_.specializationConstants, specializationEntries, specializationData, specializationInfo);
+
+  const VkPipelineCache pipelineCache = ctx.pipelineCache_->acquire();
+
+  const VkResult result =
+      igl::vulkan::VulkanComputePipelineBuilder()
+          .shaderStage(ivkGetPipelineShaderStageCreateInfo(
+              VK_SHADER_STAGE_COMPUTE_BIT,
+              igl::vulkan::ShaderModule::getVkShaderModule(shaderModule),
+              shaderModule->info().entryPoint.c_str(),
+              specialization))
+          .build(ctx.device_->getVkDevice(),
+                 pipelineCache,
+                 ctx.pipelineLayoutCompute_->getVkPipelineLayout(),
+                 &pipeline_,
+                 desc_.debugName.c_str());
+
+  ctx.pipelineCache_->release(pipelineCache, result == VK_SUCCESS);
 
   return pipeline_;
 }
@@ -35,6 +35,8 @@ class ComputePipelineState final : public IComputePipelineState {
   ComputePipelineDesc desc_;
 
   mutable VkPipeline pipeline_ = VK_NULL_HANDLE;
+  // VulkanContext::bindlessGeneration_ of pipeline_
+  mutable uint32_t pipelineGeneration_ = 0;
 };
 
 } // namespace vulkan
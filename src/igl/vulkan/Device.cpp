@@ -16,15 +16,25 @@
 #include <igl/vulkan/EnhancedShaderDebuggingStore.h>
 #include <igl/vulkan/Framebuffer.h>
 #include <igl/vulkan/PlatformDevice.h>
+#include <igl/vulkan/QueryPool.h>
 #include <igl/vulkan/RenderPipelineState.h>
 #include <igl/vulkan/SamplerState.h>
 #include <igl/vulkan/ShaderModule.h>
 #include <igl/vulkan/Texture.h>
+#include <igl/vulkan/TimestampQueryPool.h>
+#include <igl/vulkan/TransientAllocator.h>
 #include <igl/vulkan/VertexInputState.h>
 #include <igl/vulkan/VulkanContext.h>
 #include <igl/vulkan/VulkanDevice.h>
 #include <igl/vulkan/VulkanHelpers.h>
 #include <igl/vulkan/VulkanShaderModule.h>
+#include <igl/vulkan/WorkerPool.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <future>
+#include <mutex>
 
 #if IGL_SHADER_DUMP && IGL_DEBUG
 #include <filesystem>
@@ -61,8 +71,12 @@ Device::Device(std::unique_ptr<VulkanContext> ctx) : ctx_(std::move(ctx)), platf
   if (ctx_->enhancedShaderDebuggingStore_) {
     ctx_->enhancedShaderDebuggingStore_->initialize(this);
   }
+  transientAllocator_ =
+      std::make_unique<TransientAllocator>(*this, ctx_->config_.transientBufferSize);
 }
 
+Device::~Device() = default;
+
 std::shared_ptr<ICommandQueue> Device::createCommandQueue(const CommandQueueDesc& desc,
                                                           Result* outResult) {
   Result::setOk(outResult);
@@ -84,7 +98,9 @@ std::unique_ptr<IBuffer> Device::createBuffer(const BufferDesc& desc,
     return buffer;
   }
 
-  const auto uploadResult = buffer->upload(desc.data, BufferRange(desc.length, 0u));
+  // the new buffer has never been used by the GPU
+  const auto uploadResult =
+      buffer->uploadInternal(desc.data, BufferRange(desc.length, 0u), false, nullptr, true);
   IGL_VERIFY(uploadResult.isOk());
   Result::setResult(outResult, uploadResult);
 
@@ -217,6 +233,108 @@ std::shared_ptr<IShaderModule> Device::createShaderModule(const ShaderModuleDesc
   return std::make_shared<ShaderModule>(desc.info, std::move(vulkanShaderModule));
 }
 
+std::vector<std::unique_ptr<IShaderStages>> Device::createShaderStagesBatch(
+    const std::vector<ShaderStagesModulesDesc>& descs,
+    std::vector<Result>* outResults) const {
+  IGL_PROFILER_FUNCTION();
+
+  // The modules are compiled as a flat list by the calling thread and the context's workers. The
+  // state is shared with the workers, so the batch does not wait for workers which are busy with
+  // other tasks: those find no modules left once they get to this batch
+  struct CompilationState {
+    std::vector<const ShaderModuleDesc*> moduleDescs;
+    std::vector<std::shared_ptr<IShaderModule>> modules;
+    std::vector<Result> moduleResults;
+    std::atomic<size_t> nextModule{0};
+    size_t numCompiledModules = 0; // guarded by `mutex`
+    std::mutex mutex;
+    std::condition_variable condition;
+  };
+  const auto state = std::make_shared<CompilationState>();
+
+  // all the modules are independent from each other
+  state->moduleDescs.reserve(2 * descs.size());
+  for (const auto& desc : descs) {
+    if (desc.type == ShaderStagesType::Render) {
+      state->moduleDescs.push_back(&desc.vertexModule);
+      state->moduleDescs.push_back(&desc.fragmentModule);
+    } else {
+      state->moduleDescs.push_back(&desc.computeModule);
+    }
+  }
+
+  const size_t numModules = state->moduleDescs.size();
+  state->modules.resize(numModules);
+  state->moduleResults.resize(numModules);
+
+  // glslang and vkCreateShaderModule() can be used from any thread
+  auto compileModules = [this, state, numModules]() {
+    size_t numCompiled = 0;
+    for (size_t i = state->nextModule++; i < numModules; i = state->nextModule++) {
+      state->modules[i] = createShaderModule(*state->moduleDescs[i], &state->moduleResults[i]);
+      numCompiled++;
+    }
+    if (numCompiled) {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      state->numCompiledModules += numCompiled;
+      state->condition.notify_all();
+    }
+  };
+
+  WorkerPool& workerPool = *getVulkanContext().workerPool_;
+  const size_t numWorkers = std::min<size_t>(numModules, workerPool.getNumThreads());
+  for (size_t i = 0; i != numWorkers; i++) {
+    // the futures are not needed: the calling thread waits for the modules instead
+    workerPool.schedule(std::packaged_task<void()>(compileModules));
+  }
+  // the calling thread is one of the workers
+  compileModules();
+  {
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->condition.wait(lock, [&state, numModules]() {
+      return state->numCompiledModules == numModules;
+    });
+  }
+
+  std::vector<std::shared_ptr<IShaderModule>>& modules = state->modules;
+  std::vector<Result>& moduleResults = state->moduleResults;
+
+  std::vector<std::unique_ptr<IShaderStages>> stages(descs.size());
+
+  if (outResults) {
+    outResults->assign(descs.size(), Result());
+  }
+
+  for (size_t i = 0, m = 0; i != descs.size(); i++) {
+    Result* outResult = outResults ? &(*outResults)[i] : nullptr;
+
+    ShaderStagesDesc stagesDesc;
+    stagesDesc.type = descs[i].type;
+
+    const size_t numModules = stagesDesc.type == ShaderStagesType::Render ? 2 : 1;
+    const auto failed = std::find_if(moduleResults.begin() + m,
+                                     moduleResults.begin() + m + numModules,
+                                     [](const Result& result) { return !result.isOk(); });
+
+    if (stagesDesc.type == ShaderStagesType::Render) {
+      stagesDesc.vertexModule = std::move(modules[m]);
+      stagesDesc.fragmentModule = std::move(modules[m + 1]);
+    } else {
+      stagesDesc.computeModule = std::move(modules[m]);
+    }
+    m += numModules;
+
+    if (failed != moduleResults.begin() + m) {
+      Result::setResult(outResult, std::move(*failed));
+      continue;
+    }
+
+    stages[i] = createShaderStages(stagesDesc, outResult);
+  }
+
+  return stages;
+}
+
 std::shared_ptr<VulkanShaderModule> Device::createShaderModule(const void* data,
                                                                size_t length,
                                                                const std::string& debugName,
@@ -392,13 +510,41 @@ std::shared_ptr<VulkanShaderModule> Device::createShaderModule(ShaderStage stage
   ivkGlslangResource(&glslangResource, &ctx_->getVkPhysicalDeviceProperties());
 
   VkShaderModule vkShaderModule = VK_NULL_HANDLE;
-  const Result result =
-      igl::vulkan::compileShader(device, vkStage, source, &vkShaderModule, &glslangResource);
 
-  Result::setResult(outResult, result);
+  if (ctx_->shaderCache_) {
+    const uint64_t key = VulkanShaderCache::computeKey(vkStage, source, glslangResource);
 
-  if (!result.isOk()) {
-    return nullptr;
+    std::vector<uint32_t> spirv;
+
+    if (!ctx_->shaderCache_->find(key, source, spirv)) {
+      const Result result = igl::vulkan::compileShader(vkStage, source, spirv, &glslangResource);
+
+      Result::setResult(outResult, result);
+
+      if (!result.isOk()) {
+        return nullptr;
+      }
+
+      ctx_->shaderCache_->insert(key, source, spirv);
+    }
+
+    const VkResult result = ivkCreateShaderModuleFromSPIRV(
+        device, spirv.data(), spirv.size() * sizeof(uint32_t), &vkShaderModule);
+
+    setResultFrom(outResult, result);
+
+    if (result != VK_SUCCESS) {
+      return nullptr;
+    }
+  } else {
+    const Result result =
+        igl::vulkan::compileShader(device, vkStage, source, &vkShaderModule, &glslangResource);
+
+    Result::setResult(outResult, result);
+
+    if (!result.isOk()) {
+      return nullptr;
+    }
   }
 
   if (!debugName.empty()) {
@@ -419,6 +565,76 @@ std::shared_ptr<IFramebuffer> Device::createFramebuffer(const FramebufferDesc& d
   return resource;
 }
 
+std::shared_ptr<ITimestampQueryPool> Device::createTimestampQueryPool(
+    const TimestampQueryPoolDesc& desc,
+    Result* outResult) const {
+  if (!hasFeature(DeviceFeatures::Timestamps)) {
+    Result::setResult(outResult, Result::Code::Unsupported, "Timestamp queries are not supported");
+    return nullptr;
+  }
+  if (desc.queryCount == 0) {
+    Result::setResult(outResult, Result::Code::ArgumentInvalid, "queryCount must be non-zero");
+    return nullptr;
+  }
+
+  // timestamps are written into graphics command buffers only
+  uint32_t numQueueFamilies = 0;
+  vkGetPhysicalDeviceQueueFamilyProperties(
+      ctx_->getVkPhysicalDevice(), &numQueueFamilies, nullptr);
+  std::vector<VkQueueFamilyProperties> queueFamilies(numQueueFamilies);
+  vkGetPhysicalDeviceQueueFamilyProperties(
+      ctx_->getVkPhysicalDevice(), &numQueueFamilies, queueFamilies.data());
+
+  const uint32_t queueFamilyIndex = ctx_->deviceQueues_.graphicsQueueFamilyIndex;
+  if (!IGL_VERIFY(queueFamilyIndex < numQueueFamilies)) {
+    Result::setResult(outResult, Result::Code::RuntimeError, "Invalid graphics queue family");
+    return nullptr;
+  }
+
+  const uint32_t timestampValidBits = queueFamilies[queueFamilyIndex].timestampValidBits;
+  if (timestampValidBits == 0) {
+    Result::setResult(outResult,
+                      Result::Code::Unsupported,
+                      "The graphics queue does not support timestamp queries");
+    return nullptr;
+  }
+
+  Result::setOk(outResult);
+  return std::make_shared<TimestampQueryPool>(
+      *ctx_, desc.queryCount, timestampValidBits, desc.debugName.c_str());
+}
+
+std::shared_ptr<IQueryPool> Device::createQueryPool(const QueryPoolDesc& desc,
+                                                    Result* outResult) const {
+  const DeviceFeatures feature = desc.type == QueryType::Occlusion
+                                     ? DeviceFeatures::PreciseOcclusionQueries
+                                 : desc.type == QueryType::BinaryOcclusion
+                                     ? DeviceFeatures::OcclusionQueries
+                                     : DeviceFeatures::PipelineStatisticsQueries;
+  if (!hasFeature(feature)) {
+    Result::setResult(outResult, Result::Code::Unsupported, "The query type is not supported");
+    return nullptr;
+  }
+  if (desc.queryCount == 0) {
+    Result::setResult(outResult, Result::Code::ArgumentInvalid, "queryCount must be non-zero");
+    return nullptr;
+  }
+  if (desc.type == QueryType::PipelineStatistics && desc.pipelineStatistics == 0) {
+    Result::setResult(
+        outResult, Result::Code::ArgumentInvalid, "pipelineStatistics must be non-zero");
+    return nullptr;
+  }
+
+  Result::setOk(outResult);
+  return std::make_shared<QueryPool>(*ctx_, desc);
+}
+
+TransientAllocation Device::allocateTransient(BufferDesc::BufferType type,
+                                              size_t size,
+                                              Result* outResult) {
+  return transientAllocator_->allocate(type, size, outResult);
+}
+
 const PlatformDevice& Device::getPlatformDevice() const noexcept {
   return platformDevice_;
 }
@@ -531,6 +747,21 @@ bool Device::hasFeature(DeviceFeatures feature) const {
     return false;
   case DeviceFeatures::TexturePartialMipChain:
     return true;
+  case DeviceFeatures::Timestamps:
+    return deviceProperties.limits.timestampComputeAndGraphics == VK_TRUE;
+  case DeviceFeatures::OcclusionQueries:
+    return true;
+  case DeviceFeatures::PreciseOcclusionQueries:
+    return ctx_->getVkPhysicalDeviceFeatures2().features.occlusionQueryPrecise == VK_TRUE;
+  case DeviceFeatures::PipelineStatisticsQueries:
+    return ctx_->getVkPhysicalDeviceFeatures2().features.pipelineStatisticsQuery == VK_TRUE;
+  case DeviceFeatures::DrawInstanced:
+  case DeviceFeatures::DrawBaseInstance:
+    return true;
+  case DeviceFeatures::VertexInstanceStepRate:
+    return ctx_->hasVertexAttributeDivisor_;
+  case DeviceFeatures::ParallelRenderEncoding:
+    return true;
   case DeviceFeatures::BufferRing:
     return false;
   case DeviceFeatures::BufferNoCopy:
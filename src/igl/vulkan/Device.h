@@ -17,6 +17,7 @@
 namespace igl {
 namespace vulkan {
 
+class TransientAllocator;
 class VulkanContext;
 class VulkanShaderModule;
 struct DeviceQueues;
@@ -24,6 +25,7 @@ struct DeviceQueues;
 class Device final : public IDevice {
  public:
   explicit Device(std::unique_ptr<VulkanContext> ctx);
+  ~Device() override;
 
   // Command Queue
   std::shared_ptr<ICommandQueue> createCommandQueue(const CommandQueueDesc& desc,
@@ -59,9 +61,26 @@ class Device final : public IDevice {
   std::shared_ptr<IShaderModule> createShaderModule(const ShaderModuleDesc& desc,
                                                     Result* outResult) const override;
 
+  // Compiles GLSL shader modules of all the stages concurrently on the context's worker threads
+  std::vector<std::unique_ptr<IShaderStages>> createShaderStagesBatch(
+      const std::vector<ShaderStagesModulesDesc>& descs,
+      std::vector<Result>* outResults) const override;
+
   std::shared_ptr<IFramebuffer> createFramebuffer(const FramebufferDesc& desc,
                                                   Result* outResult) override;
 
+  std::shared_ptr<ITimestampQueryPool> createTimestampQueryPool(
+      const TimestampQueryPoolDesc& desc,
+      Result* outResult) const override;
+
+  std::shared_ptr<IQueryPool> createQueryPool(const QueryPoolDesc& desc,
+                                              Result* outResult) const override;
+
+  // Bump-allocates from persistently mapped buffers owned by the current frame in flight
+  TransientAllocation allocateTransient(BufferDesc::BufferType type,
+                                        size_t size,
+                                        Result* outResult) override;
+
   // Platform-specific extensions
   const PlatformDevice& getPlatformDevice() const noexcept override;
 
@@ -84,6 +103,10 @@ class Device final : public IDevice {
     return *ctx_.get();
   }
 
+  const TransientAllocator& getTransientAllocator() const {
+    return *transientAllocator_.get();
+  }
+
  private:
   std::shared_ptr<VulkanShaderModule> createShaderModule(const void* data,
                                                          size_t length,
@@ -97,6 +120,9 @@ class Device final : public IDevice {
   std::unique_ptr<VulkanContext> ctx_;
 
   PlatformDevice platformDevice_;
+
+  // owns buffers, so it has to be destroyed before the context
+  std::unique_ptr<TransientAllocator> transientAllocator_;
 };
 
 } // namespace vulkan
@@ -315,8 +315,8 @@ void EnhancedShaderDebuggingStore::installBufferBarrier(
                            buffer->getVkBuffer(),
                            VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT, /* src access flag */
                            VK_ACCESS_INDIRECT_COMMAND_READ_BIT, /* dst access flag */
-                           0,
-                           VK_WHOLE_SIZE,
+                           buffer->getVkBufferOffset(),
+                           buffer->getSizeInBytes(),
                            VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
                            VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT);
   }
@@ -21,6 +21,7 @@
 #include <igl/vulkan/ShaderModule.h>
 #include <igl/vulkan/Texture.h>
 #include <igl/vulkan/VertexInputState.h>
+#include <igl/vulkan/VulkanBuffer.h>
 #include <igl/vulkan/VulkanContext.h>
 #include <igl/vulkan/VulkanDevice.h>
 #include <igl/vulkan/VulkanFramebuffer.h>
@@ -31,6 +32,72 @@
 namespace igl {
 namespace vulkan {
 
+namespace {
+
+// returns the region to the readback ring once the GPU is done copying into it
+void releaseReadbackRegionDeferred(const VulkanContext& ctx,
+                                   VulkanStagingDevice::ReadbackRegion region,
+                                   VulkanStagingDevice::SubmitHandle handle) {
+  ctx.deferredTask(std::packaged_task<void()>([&ctx, region = std::move(region), handle]() {
+    if (!ctx.stagingDevice_) {
+      // the context is being destroyed along with the readback ring
+      return;
+    }
+    if (!ctx.stagingDevice_->isReady(handle)) {
+      // the handle belongs to the staging device, not to the context
+      releaseReadbackRegionDeferred(ctx, region, handle);
+      return;
+    }
+    ctx.stagingDevice_->releaseReadbackRegion(region);
+  }));
+}
+
+/// An asynchronous readback into a region of the staging device's readback ring
+class ReadbackRequest final : public IReadbackRequest {
+ public:
+  ReadbackRequest(const VulkanContext& ctx,
+                  VulkanStagingDevice::ReadbackRegion region,
+                  VulkanStagingDevice::SubmitHandle handle,
+                  size_t bytesPerRow,
+                  size_t numRows) :
+    ctx_(ctx),
+    region_(std::move(region)),
+    handle_(handle),
+    bytesPerRow_(bytesPerRow),
+    numRows_(numRows) {}
+
+  ~ReadbackRequest() override {
+    releaseReadbackRegionDeferred(ctx_, std::move(region_), handle_);
+  }
+
+  [[nodiscard]] bool isReady() const override {
+    return ctx_.stagingDevice_->isReady(handle_);
+  }
+
+  void getBytes(void* pixelBytes, size_t bytesPerRow) override {
+    IGL_PROFILER_FUNCTION();
+
+    ctx_.stagingDevice_->wait(handle_);
+
+    // Vulkan textures are up-side down compared to OGL textures. IGL follows the OGL convention
+    copyRows(pixelBytes,
+             bytesPerRow,
+             region_.buffer_->getMappedPtr() + region_.offset_,
+             bytesPerRow_,
+             numRows_,
+             true);
+  }
+
+ private:
+  const VulkanContext& ctx_;
+  VulkanStagingDevice::ReadbackRegion region_;
+  VulkanStagingDevice::SubmitHandle handle_;
+  size_t bytesPerRow_ = 0;
+  size_t numRows_ = 0;
+};
+
+} // namespace
+
 std::vector<size_t> Framebuffer::getColorAttachmentIndices() const {
   std::vector<size_t> indices;
 
@@ -105,6 +172,48 @@ void Framebuffer::copyBytesColorAttachment(ICommandQueue& /* Not Used */,
                                      true); // Flip the image vertically
 }
 
+std::shared_ptr<IReadbackRequest> Framebuffer::requestBytesColorAttachment(
+    ICommandQueue& /* Not Used */,
+    size_t index,
+    const TextureRangeDesc& range) const {
+  IGL_PROFILER_FUNCTION();
+
+  const auto& itexture = getColorAttachment(index);
+  if (!IGL_VERIFY(itexture)) {
+    return nullptr;
+  }
+
+  const auto& vkTex = static_cast<Texture&>(*itexture);
+  const auto& properties = vkTex.getProperties();
+  const size_t bytesPerRow = properties.getBytesPerRow(range);
+  const size_t numRows = properties.getRows(range);
+
+  const VulkanContext& ctx = device_.getVulkanContext();
+
+  // every request holds its own region of the readback ring, so any number of requests can be in
+  // flight
+  VulkanStagingDevice::ReadbackRegion region =
+      ctx.stagingDevice_->acquireReadbackRegion(static_cast<uint32_t>(bytesPerRow * numRows));
+  if (!IGL_VERIFY(region.buffer_)) {
+    return nullptr;
+  }
+
+  const VkRect2D imageRegion = {
+      VkOffset2D{static_cast<int32_t>(range.x), static_cast<int32_t>(range.y)},
+      VkExtent2D{static_cast<uint32_t>(range.width), static_cast<uint32_t>(range.height)},
+  };
+
+  const auto handle = ctx.stagingDevice_->getImageData2DAsync(
+      vkTex.getVkImage(),
+      static_cast<uint32_t>(range.mipLevel),
+      static_cast<uint32_t>(range.layer), // layer (or face of a cubemap)
+      imageRegion,
+      vkTex.getVulkanTexture().getVulkanImage().imageLayout_,
+      region);
+
+  return std::make_shared<ReadbackRequest>(ctx, std::move(region), handle, bytesPerRow, numRows);
+}
+
 void Framebuffer::copyBytesDepthAttachment(ICommandQueue& /*cmdQueue*/,
                                            void* /*pixelBytes*/,
                                            const TextureRangeDesc& /*range*/,
@@ -48,6 +48,11 @@ class Framebuffer final : public IFramebuffer {
                                   const TextureRangeDesc& range,
                                   size_t bytesPerRow = 0) const override;
 
+  std::shared_ptr<IReadbackRequest> requestBytesColorAttachment(
+      ICommandQueue& /* Not Used */,
+      size_t index,
+      const TextureRangeDesc& range) const override;
+
   void copyTextureColorAttachment(ICommandQueue& cmdQueue,
                                   size_t index,
                                   std::shared_ptr<ITexture> destTexture,
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/vulkan/ParallelRenderCommandEncoder.h>
+
+#include <igl/vulkan/Buffer.h>
+#include <igl/vulkan/CommandBuffer.h>
+#include <igl/vulkan/EnhancedShaderDebuggingStore.h>
+#include <igl/vulkan/VulkanContext.h>
+#include <igl/vulkan/VulkanSecondaryCommandBuffers.h>
+
+namespace igl {
+namespace vulkan {
+
+ParallelRenderCommandEncoder::ParallelRenderCommandEncoder(
+    const std::shared_ptr<CommandBuffer>& commandBuffer,
+    VulkanContext& ctx,
+    std::unique_ptr<RenderCommandEncoder> primary) :
+  commandBuffer_(commandBuffer), ctx_(ctx), primary_(std::move(primary)) {
+  IGL_ASSERT(commandBuffer_);
+  IGL_ASSERT(primary_);
+
+  ctx_.numParallelEncoders_++;
+}
+
+std::unique_ptr<IRenderCommandEncoder> ParallelRenderCommandEncoder::createRenderCommandEncoder(
+    Result* IGL_NULLABLE outResult) {
+  IGL_PROFILER_FUNCTION();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if (!IGL_VERIFY(isEncoding_)) {
+    Result::setResult(outResult, Result::Code::InvalidOperation, "Encoding has already ended");
+    return nullptr;
+  }
+
+  const auto secondary = ctx_.secondaryCommandBuffers_->acquire();
+
+  secondaryIndices_.push_back(secondary.index);
+  secondaryCmdBuffers_.push_back(secondary.cmdBuf);
+
+  auto encoder =
+      RenderCommandEncoder::createSecondary(commandBuffer_, ctx_, *primary_, secondary.cmdBuf);
+
+  if (ctx_.enhancedShaderDebuggingStore_) {
+    encoder->binder().bindBuffer(
+        EnhancedShaderDebuggingStore::kBufferIndex,
+        static_cast<igl::vulkan::Buffer*>(ctx_.enhancedShaderDebuggingStore_->vertexBuffer().get()),
+        0);
+  }
+
+  Result::setOk(outResult);
+
+  return encoder;
+}
+
+void ParallelRenderCommandEncoder::endEncoding() {
+  IGL_PROFILER_FUNCTION();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if (!isEncoding_) {
+    return;
+  }
+
+  isEncoding_ = false;
+  ctx_.numParallelEncoders_--;
+
+  if (!secondaryCmdBuffers_.empty()) {
+    vkCmdExecuteCommands(primary_->getVkCommandBuffer(),
+                         static_cast<uint32_t>(secondaryCmdBuffers_.size()),
+                         secondaryCmdBuffers_.data());
+  }
+
+  primary_->endEncoding();
+
+  // the secondary command buffers are recycled after the command buffer is submitted and completed
+  commandBuffer_->secondaryCommandBuffers_.insert(commandBuffer_->secondaryCommandBuffers_.end(),
+                                                  secondaryIndices_.begin(),
+                                                  secondaryIndices_.end());
+  secondaryIndices_.clear();
+  secondaryCmdBuffers_.clear();
+}
+
+} // namespace vulkan
+} // namespace igl
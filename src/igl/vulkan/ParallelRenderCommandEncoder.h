@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <mutex>
+#include <vector>
+
+#include <igl/ParallelRenderCommandEncoder.h>
+#include <igl/vulkan/Common.h>
+#include <igl/vulkan/RenderCommandEncoder.h>
+
+namespace igl {
+namespace vulkan {
+
+class CommandBuffer;
+class VulkanContext;
+
+/// @brief Begins a render pass in the primary command buffer and records its contents into
+/// secondary command buffers, one per render command encoder. The secondary command buffers are
+/// executed in creation order when the parallel encoder ends encoding.
+class ParallelRenderCommandEncoder final : public IParallelRenderCommandEncoder {
+ public:
+  ParallelRenderCommandEncoder(const std::shared_ptr<CommandBuffer>& commandBuffer,
+                               VulkanContext& ctx,
+                               std::unique_ptr<RenderCommandEncoder> primary);
+
+  ~ParallelRenderCommandEncoder() override {
+    IGL_ASSERT(!isEncoding_); // did you forget to call endEncoding()?
+    endEncoding();
+  }
+
+  std::unique_ptr<IRenderCommandEncoder> createRenderCommandEncoder(
+      Result* IGL_NULLABLE outResult) override;
+
+  void endEncoding() override;
+
+ private:
+  std::shared_ptr<CommandBuffer> commandBuffer_;
+  VulkanContext& ctx_;
+  std::unique_ptr<RenderCommandEncoder> primary_;
+  bool isEncoding_ = true;
+
+  std::mutex mutex_;
+  // in creation order
+  std::vector<uint32_t> secondaryIndices_;
+  std::vector<VkCommandBuffer> secondaryCmdBuffers_;
+};
+
+} // namespace vulkan
+} // namespace igl
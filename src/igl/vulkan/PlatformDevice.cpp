@@ -10,6 +10,7 @@
 #include <igl/vulkan/PlatformDevice.h>
 #include <igl/vulkan/Texture.h>
 #include <igl/vulkan/VulkanContext.h>
+#include <igl/vulkan/VulkanStagingDevice.h>
 #include <igl/vulkan/VulkanSwapchain.h>
 
 namespace igl {
@@ -147,6 +148,33 @@ void PlatformDevice::waitOnSubmitHandle(SubmitHandle handle) const {
   immediateCommands->wait(VulkanImmediateCommands::SubmitHandle(handle));
 }
 
+bool PlatformDevice::isUploadComplete(UploadHandle handle) const {
+  if (handle.empty()) {
+    // uploads into host-visible memory do not produce any GPU work
+    return true;
+  }
+
+  const auto& ctx = device_.getVulkanContext();
+
+  return ctx.stagingDevice_->isReady(VulkanImmediateCommands::SubmitHandle(handle.handle));
+}
+
+void PlatformDevice::waitOnUpload(UploadHandle handle) const {
+  if (handle.empty()) {
+    return;
+  }
+
+  const auto& ctx = device_.getVulkanContext();
+
+  ctx.stagingDevice_->wait(VulkanImmediateCommands::SubmitHandle(handle.handle));
+}
+
+UploadHandle PlatformDevice::flushUploads() const {
+  const auto& ctx = device_.getVulkanContext();
+
+  return UploadHandle{ctx.stagingDevice_->flushPendingCopies().handle()};
+}
+
 #if defined(IGL_PLATFORM_ANDROID) && defined(VK_KHR_external_fence_fd)
 int PlatformDevice::getFenceFdFromSubmitHandle(SubmitHandle handle) const {
   if (handle == 0) {
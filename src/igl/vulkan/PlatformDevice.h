@@ -48,6 +48,23 @@ class PlatformDevice : public IPlatformDevice {
   /// @param handle The handle to the GPU Fence
   void waitOnSubmitHandle(SubmitHandle handle) const;
 
+  /// Checks whether an upload started by ITexture::uploadAsync() or IBuffer::uploadAsync() has
+  /// completed on the GPU. Never blocks
+  /// @param handle The handle returned by uploadAsync()
+  /// @return True if the upload has completed
+  [[nodiscard]] bool isUploadComplete(UploadHandle handle) const;
+
+  /// Waits until an upload started by ITexture::uploadAsync() or IBuffer::uploadAsync() has
+  /// completed on the GPU. Meant to be called lazily, right before the CPU needs the upload to be
+  /// finished (e.g. before releasing the source data of a streamed resource)
+  /// @param handle The handle returned by uploadAsync()
+  void waitOnUpload(UploadHandle handle) const;
+
+  /// Submits the buffer uploads accumulated when VulkanContextConfig::batchStagingBufferCopies is
+  /// enabled. They are also submitted automatically with the next command buffer
+  /// @return The handle of the submitted uploads, or an empty one if there was nothing to submit
+  UploadHandle flushUploads() const;
+
   /// Android only for now - Creates the file descriptor for the underlying VkFence
   /// @param handle The handle to the GPU Fence
   /// @return The fd for the Vulkan Fence associated with the handle
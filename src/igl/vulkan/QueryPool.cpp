@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/vulkan/QueryPool.h>
+
+#include <igl/vulkan/VulkanContext.h>
+
+namespace {
+
+VkQueryPipelineStatisticFlags pipelineStatisticsToVkQueryPipelineStatisticFlags(
+    igl::QueryPoolDesc::PipelineStatistics bits) {
+  VkQueryPipelineStatisticFlags flags = 0;
+
+  if (bits & igl::QueryPoolDesc::PipelineStatisticsBits::InputAssemblyPrimitives) {
+    flags |= VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_PRIMITIVES_BIT;
+  }
+  if (bits & igl::QueryPoolDesc::PipelineStatisticsBits::VertexShaderInvocations) {
+    flags |= VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT;
+  }
+  if (bits & igl::QueryPoolDesc::PipelineStatisticsBits::ClippingPrimitives) {
+    flags |= VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT;
+  }
+  if (bits & igl::QueryPoolDesc::PipelineStatisticsBits::FragmentShaderInvocations) {
+    flags |= VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT;
+  }
+  if (bits & igl::QueryPoolDesc::PipelineStatisticsBits::ComputeShaderInvocations) {
+    flags |= VK_QUERY_PIPELINE_STATISTIC_COMPUTE_SHADER_INVOCATIONS_BIT;
+  }
+
+  return flags;
+}
+
+uint32_t countBits(igl::QueryPoolDesc::PipelineStatistics bits) {
+  uint32_t count = 0;
+  for (; bits; bits &= bits - 1) {
+    count++;
+  }
+  return count;
+}
+
+} // namespace
+
+namespace igl {
+namespace vulkan {
+
+QueryPool::QueryPool(const VulkanContext& ctx, const QueryPoolDesc& desc) :
+  ctx_(ctx), type_(desc.type), queryCount_(desc.queryCount) {
+  IGL_PROFILER_FUNCTION_COLOR(IGL_PROFILER_COLOR_CREATE);
+
+  IGL_ASSERT(queryCount_ > 0);
+
+  VkQueryPoolCreateInfo ci = {};
+  ci.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+  ci.queryCount = queryCount_;
+
+  if (type_ == QueryType::PipelineStatistics) {
+    IGL_ASSERT_MSG(desc.pipelineStatistics != 0, "No pipeline statistics counters enabled");
+    ci.queryType = VK_QUERY_TYPE_PIPELINE_STATISTICS;
+    ci.pipelineStatistics =
+        pipelineStatisticsToVkQueryPipelineStatisticFlags(desc.pipelineStatistics);
+    // Vulkan writes the counters in the order of the bits of VkQueryPipelineStatisticFlagBits,
+    // which matches the order of QueryPoolDesc::PipelineStatisticsBits
+    valuesPerQuery_ = countBits(desc.pipelineStatistics);
+  } else {
+    ci.queryType = VK_QUERY_TYPE_OCCLUSION;
+  }
+
+  const VkDevice device = ctx_.getVkDevice();
+
+  VK_ASSERT(vkCreateQueryPool(device, &ci, nullptr, &vkQueryPool_));
+  VK_ASSERT(ivkSetDebugObjectName(
+      device, VK_OBJECT_TYPE_QUERY_POOL, (uint64_t)vkQueryPool_, desc.debugName.c_str()));
+}
+
+QueryPool::~QueryPool() {
+  IGL_PROFILER_FUNCTION_COLOR(IGL_PROFILER_COLOR_DESTROY);
+
+  ctx_.deferredTask(std::packaged_task<void()>(
+      [device = ctx_.getVkDevice(), queryPool = vkQueryPool_]() {
+        vkDestroyQueryPool(device, queryPool, nullptr);
+      }));
+}
+
+QueryType QueryPool::getType() const {
+  return type_;
+}
+
+uint32_t QueryPool::getQueryCount() const {
+  return queryCount_;
+}
+
+uint32_t QueryPool::getValuesPerQuery() const {
+  return valuesPerQuery_;
+}
+
+bool QueryPool::getResults(uint32_t firstQuery, uint32_t queryCount, uint64_t* outValues) const {
+  if (!IGL_VERIFY(outValues && firstQuery + queryCount <= queryCount_)) {
+    return false;
+  }
+  if (queryCount == 0) {
+    return true;
+  }
+
+  const VkDeviceSize stride = valuesPerQuery_ * sizeof(uint64_t);
+
+  // no VK_QUERY_RESULT_WAIT_BIT: never stall the CPU waiting for the GPU
+  const VkResult result = vkGetQueryPoolResults(ctx_.getVkDevice(),
+                                                vkQueryPool_,
+                                                firstQuery,
+                                                queryCount,
+                                                queryCount * stride,
+                                                outValues,
+                                                stride,
+                                                VK_QUERY_RESULT_64_BIT);
+  if (result == VK_NOT_READY) {
+    return false;
+  }
+
+  return IGL_VERIFY(result == VK_SUCCESS);
+}
+
+} // namespace vulkan
+} // namespace igl
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <igl/QueryPool.h>
+#include <igl/vulkan/Common.h>
+
+namespace igl {
+namespace vulkan {
+
+class VulkanContext;
+
+/**
+ * @brief Encapsulates a VkQueryPool of type VK_QUERY_TYPE_OCCLUSION or
+ * VK_QUERY_TYPE_PIPELINE_STATISTICS
+ */
+class QueryPool final : public IQueryPool {
+ public:
+  QueryPool(const VulkanContext& ctx, const QueryPoolDesc& desc);
+  ~QueryPool() override;
+
+  QueryPool(const QueryPool&) = delete;
+  QueryPool& operator=(const QueryPool&) = delete;
+
+  [[nodiscard]] QueryType getType() const override;
+  [[nodiscard]] uint32_t getQueryCount() const override;
+  [[nodiscard]] uint32_t getValuesPerQuery() const override;
+  [[nodiscard]] bool getResults(uint32_t firstQuery,
+                                uint32_t queryCount,
+                                uint64_t* outValues) const override;
+
+  VkQueryPool getVkQueryPool() const {
+    return vkQueryPool_;
+  }
+
+  /**
+   * @brief Returns the flags for vkCmdBeginQuery(): precise occlusion queries count samples
+   */
+  VkQueryControlFlags getVkQueryControlFlags() const {
+    return type_ == QueryType::Occlusion ? VK_QUERY_CONTROL_PRECISE_BIT : 0;
+  }
+
+ private:
+  const VulkanContext& ctx_;
+  VkQueryPool vkQueryPool_ = VK_NULL_HANDLE;
+  QueryType type_ = QueryType::Occlusion;
+  uint32_t queryCount_ = 0;
+  uint32_t valuesPerQuery_ = 1;
+};
+
+} // namespace vulkan
+} // namespace igl
@@ -15,6 +15,7 @@
 #include <igl/vulkan/Common.h>
 #include <igl/vulkan/DepthStencilState.h>
 #include <igl/vulkan/Framebuffer.h>
+#include <igl/vulkan/QueryPool.h>
 #include <igl/vulkan/RenderPipelineState.h>
 #include <igl/vulkan/SamplerState.h>
 #include <igl/vulkan/Texture.h>
@@ -113,11 +114,13 @@ namespace igl {
 namespace vulkan {
 
 RenderCommandEncoder::RenderCommandEncoder(const std::shared_ptr<CommandBuffer>& commandBuffer,
-                                           const VulkanContext& ctx) :
+                                           const VulkanContext& ctx,
+                                           VkCommandBuffer cmdBuffer) :
   IRenderCommandEncoder::IRenderCommandEncoder(commandBuffer),
   ctx_(ctx),
-  cmdBuffer_(commandBuffer ? commandBuffer->getVkCommandBuffer() : VK_NULL_HANDLE),
-  binder_(commandBuffer, ctx, VK_PIPELINE_BIND_POINT_GRAPHICS) {
+  commandBuffer_(commandBuffer.get()),
+  cmdBuffer_(cmdBuffer),
+  binder_(cmdBuffer, ctx, VK_PIPELINE_BIND_POINT_GRAPHICS) {
   IGL_PROFILER_FUNCTION();
   IGL_ASSERT(commandBuffer);
   IGL_ASSERT(cmdBuffer_ != VK_NULL_HANDLE);
@@ -125,6 +128,7 @@ RenderCommandEncoder::RenderCommandEncoder(const std::shared_ptr<CommandBuffer>&
 
 void RenderCommandEncoder::initialize(const RenderPassDesc& renderPass,
                                       const std::shared_ptr<IFramebuffer>& framebuffer,
+                                      VkSubpassContents contents,
                                       Result* outResult) {
   IGL_PROFILER_FUNCTION();
   framebuffer_ = framebuffer;
@@ -145,6 +149,8 @@ void RenderCommandEncoder::initialize(const RenderPassDesc& renderPass,
 
   VulkanRenderPassBuilder builder;
 
+  isMultiview_ = desc.mode != FramebufferMode::Mono;
+
   if (desc.mode != FramebufferMode::Mono) {
     if (desc.mode == FramebufferMode::Stereo) {
       builder.setMultiviewMasks(0x00000003, 0x00000003);
@@ -247,16 +253,35 @@ void RenderCommandEncoder::initialize(const RenderPassDesc& renderPass,
 
   const auto& fb = static_cast<vulkan::Framebuffer&>(*framebuffer);
 
-  auto renderPassHandle = ctx_.findRenderPass(builder);
+  const uint32_t width = std::max(fb.getWidth() >> mipLevel, 1u);
+  const uint32_t height = std::max(fb.getHeight() >> mipLevel, 1u);
+
+  useDynamicRendering_ = ctx_.useDynamicRendering_;
+  samples_ = samples;
 
-  dynamicState_.renderPassIndex_ = renderPassHandle.index;
   dynamicState_.depthBiasEnable_ = false;
+  dynamicState_.isStereo_ = desc.mode == FramebufferMode::Stereo;
 
-  const VkRenderPassBeginInfo bi = fb.getRenderPassBeginInfo(
-      renderPassHandle.pass, mipLevel, (uint32_t)clearValues.size(), clearValues.data());
+  VkRenderPassBeginInfo bi = {};
+
+  if (useDynamicRendering_) {
+    // pipelines are created against the attachment formats, so no render pass is looked up here
+    dynamicState_.renderPassIndex_ = 0;
+    renderArea_ = VkRect2D{VkOffset2D{0, 0}, VkExtent2D{width, height}};
+  } else {
+    auto renderPassHandle = ctx_.findRenderPass(builder);
+
+    dynamicState_.renderPassIndex_ = renderPassHandle.index;
+
+    bi = fb.getRenderPassBeginInfo(
+        renderPassHandle.pass, mipLevel, (uint32_t)clearValues.size(), clearValues.data());
+
+    // secondary encoders continue this render pass
+    vkRenderPass_ = bi.renderPass;
+    vkFramebuffer_ = bi.framebuffer;
+    renderArea_ = bi.renderArea;
+  }
 
-  const uint32_t width = std::max(fb.getWidth() >> mipLevel, 1u);
-  const uint32_t height = std::max(fb.getHeight() >> mipLevel, 1u);
   const igl::Viewport viewport = {0.0f, 0.0f, (float)width, (float)height, 0.0f, +1.0f};
   const igl::ScissorRect scissor = {0, 0, width, height};
 
@@ -266,30 +291,276 @@ void RenderCommandEncoder::initialize(const RenderPassDesc& renderPass,
   ctx_.checkAndUpdateDescriptorSets();
   ctx_.DUBs_->update(cmdBuffer_, VK_PIPELINE_BIND_POINT_GRAPHICS, nullptr);
 
-  vkCmdBeginRenderPass(cmdBuffer_, &bi, VK_SUBPASS_CONTENTS_INLINE);
+  // the render pass is timed from the outside so that its timestamps work with multiview
+  commandBuffer_->beginTimestampScope("RenderCommandEncoder");
+
+  if (useDynamicRendering_) {
+    beginRendering(renderPass, desc, mipLevel, contents);
+  } else {
+    vkCmdBeginRenderPass(cmdBuffer_, &bi, contents);
+  }
 
   isEncoding_ = true;
 
   Result::setOk(outResult);
 }
 
+void RenderCommandEncoder::beginRendering(const RenderPassDesc& renderPass,
+                                          const FramebufferDesc& desc,
+                                          uint32_t mipLevel,
+                                          VkSubpassContents contents) {
+#if defined(VK_KHR_dynamic_rendering)
+  IGL_PROFILER_FUNCTION();
+
+  // there is no render pass to transition the attachments, so this is done here. Only the rendered
+  // subresource of an attachment which is not loaded starts from VK_IMAGE_LAYOUT_UNDEFINED, just
+  // like its render pass counterpart. The layout is tracked for the whole image, so the other mip
+  // levels and layers are transitioned along with it while keeping their contents
+  const uint32_t numLayers = desc.mode == FramebufferMode::Stereo ? VK_REMAINING_ARRAY_LAYERS : 1u;
+  const auto transitionAttachment = [this, numLayers](const VulkanImage& image,
+                                                      bool load,
+                                                      uint32_t level,
+                                                      VkImageLayout layout,
+                                                      VkPipelineStageFlags srcStageMask,
+                                                      VkPipelineStageFlags dstStageMask) {
+    const bool isWholeImage = image.mipLevels_ == 1 &&
+                              (numLayers == VK_REMAINING_ARRAY_LAYERS || image.arrayLayers_ == 1);
+    if (!isWholeImage && image.imageLayout_ != layout) {
+      image.transitionLayout(cmdBuffer_,
+                             layout,
+                             srcStageMask,
+                             dstStageMask,
+                             VkImageSubresourceRange{image.getImageAspectFlags(),
+                                                     0,
+                                                     VK_REMAINING_MIP_LEVELS,
+                                                     0,
+                                                     VK_REMAINING_ARRAY_LAYERS});
+      return;
+    }
+    if (!load) {
+      image.imageLayout_ = VK_IMAGE_LAYOUT_UNDEFINED;
+    }
+    image.transitionLayout(
+        cmdBuffer_,
+        layout,
+        srcStageMask,
+        dstStageMask,
+        VkImageSubresourceRange{image.getImageAspectFlags(), level, 1u, 0, numLayers});
+  };
+
+  std::vector<VkRenderingAttachmentInfoKHR> colorAttachments;
+  colorAttachmentFormats_.clear();
+
+  size_t largestIndexPlusOne = 0;
+  for (const auto& attachment : desc.colorAttachments) {
+    largestIndexPlusOne = std::max(largestIndexPlusOne, attachment.first + 1);
+  }
+
+  for (size_t i = 0; i < largestIndexPlusOne; ++i) {
+    auto it = desc.colorAttachments.find(i);
+    if (it == desc.colorAttachments.end()) {
+      continue;
+    }
+
+    const auto& descColor = renderPass.colorAttachments[i];
+    const auto& colorTexture = static_cast<vulkan::Texture&>(*it->second.texture);
+
+    transitionAttachment(colorTexture.getVulkanTexture().getVulkanImage(),
+                         descColor.loadAction == igl::LoadAction::Load,
+                         mipLevel,
+                         VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+                         VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                         VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+
+    VkRenderingAttachmentInfoKHR attachment = {VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR};
+    attachment.imageView = colorTexture.getVkImageViewForFramebuffer(mipLevel, desc.mode);
+    attachment.imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    attachment.loadOp = loadActionToVkAttachmentLoadOp(descColor.loadAction);
+    attachment.storeOp = storeActionToVkAttachmentStoreOp(descColor.storeAction);
+    attachment.clearValue = ivkGetClearColorValue(descColor.clearColor.r,
+                                                  descColor.clearColor.g,
+                                                  descColor.clearColor.b,
+                                                  descColor.clearColor.a);
+
+    // handle MSAA
+    if (descColor.storeAction == StoreAction::MsaaResolve) {
+      const auto& colorResolveTexture = static_cast<vulkan::Texture&>(*it->second.resolveTexture);
+      transitionAttachment(colorResolveTexture.getVulkanTexture().getVulkanImage(),
+                           false,
+                           0,
+                           VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+                           VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                           VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+      attachment.resolveMode = VK_RESOLVE_MODE_AVERAGE_BIT_KHR;
+      attachment.resolveImageView = colorResolveTexture.getVkImageViewForFramebuffer(0, desc.mode);
+      attachment.resolveImageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    }
+
+    colorAttachments.push_back(attachment);
+    colorAttachmentFormats_.push_back(colorTexture.getVkFormat());
+  }
+
+  VkRenderingAttachmentInfoKHR depthAttachment = {VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR};
+  VkRenderingAttachmentInfoKHR stencilAttachment = {
+      VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR};
+  depthAttachmentFormat_ = VK_FORMAT_UNDEFINED;
+  stencilAttachmentFormat_ = VK_FORMAT_UNDEFINED;
+
+  if (desc.depthAttachment.texture) {
+    const RenderPassDesc::DepthAttachmentDesc& descDepth = renderPass.depthAttachment;
+    const RenderPassDesc::StencilAttachmentDesc& descStencil = renderPass.stencilAttachment;
+    const auto& depthTexture = static_cast<vulkan::Texture&>(*desc.depthAttachment.texture);
+    const VulkanImage& depthImage = depthTexture.getVulkanTexture().getVulkanImage();
+
+    transitionAttachment(depthImage,
+                         descDepth.loadAction == igl::LoadAction::Load ||
+                             descStencil.loadAction == igl::LoadAction::Load,
+                         0,
+                         VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+                         VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+                         VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
+                             VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT);
+
+    depthAttachment.imageView = depthTexture.getVkImageViewForFramebuffer(0, desc.mode);
+    depthAttachment.imageLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+    depthAttachment.loadOp = loadActionToVkAttachmentLoadOp(descDepth.loadAction);
+    depthAttachment.storeOp = storeActionToVkAttachmentStoreOp(descDepth.storeAction);
+    depthAttachment.clearValue =
+        ivkGetClearDepthStencilValue(descDepth.clearDepth, descStencil.clearStencil);
+
+    // combined depth-stencil images are bound as both attachments
+    if (depthImage.isDepthFormat_) {
+      depthAttachmentFormat_ = depthTexture.getVkFormat();
+    }
+    if (depthImage.isStencilFormat_) {
+      stencilAttachment = depthAttachment;
+      stencilAttachment.loadOp = loadActionToVkAttachmentLoadOp(descStencil.loadAction);
+      stencilAttachment.storeOp = storeActionToVkAttachmentStoreOp(descStencil.storeAction);
+      stencilAttachmentFormat_ = depthTexture.getVkFormat();
+    }
+  }
+
+  const VkRenderingInfoKHR renderingInfo = {
+      VK_STRUCTURE_TYPE_RENDERING_INFO_KHR,
+      nullptr,
+      contents == VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS
+          ? (VkRenderingFlagsKHR)VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT_KHR
+          : 0u,
+      renderArea_,
+      1u,
+      dynamicState_.isStereo_ ? 0x00000003u : 0u,
+      (uint32_t)colorAttachments.size(),
+      colorAttachments.data(),
+      depthAttachmentFormat_ != VK_FORMAT_UNDEFINED ? &depthAttachment : nullptr,
+      stencilAttachmentFormat_ != VK_FORMAT_UNDEFINED ? &stencilAttachment : nullptr,
+  };
+
+  vkCmdBeginRenderingKHR(cmdBuffer_, &renderingInfo);
+#else
+  (void)renderPass;
+  (void)desc;
+  (void)mipLevel;
+  (void)contents;
+  IGL_ASSERT_MSG(false, "VK_KHR_dynamic_rendering is not supported");
+#endif // VK_KHR_dynamic_rendering
+}
+
 std::unique_ptr<RenderCommandEncoder> RenderCommandEncoder::create(
     const std::shared_ptr<CommandBuffer>& commandBuffer,
     const VulkanContext& ctx,
     const RenderPassDesc& renderPass,
     const std::shared_ptr<IFramebuffer>& framebuffer,
+    VkSubpassContents contents,
     Result* outResult) {
   IGL_PROFILER_FUNCTION();
 
+  if (!IGL_VERIFY(commandBuffer)) {
+    Result::setResult(outResult, Result::Code::ArgumentNull, "commandBuffer is null");
+    return nullptr;
+  }
+
   Result ret;
 
-  std::unique_ptr<RenderCommandEncoder> encoder(new RenderCommandEncoder(commandBuffer, ctx));
-  encoder->initialize(renderPass, framebuffer, &ret);
+  std::unique_ptr<RenderCommandEncoder> encoder(
+      new RenderCommandEncoder(commandBuffer, ctx, commandBuffer->getVkCommandBuffer()));
+  encoder->initialize(renderPass, framebuffer, contents, &ret);
 
   Result::setResult(outResult, ret);
   return ret.isOk() ? std::move(encoder) : nullptr;
 }
 
+void RenderCommandEncoder::initializeSecondary(const RenderCommandEncoder& primary) {
+  IGL_PROFILER_FUNCTION();
+
+  IGL_ASSERT(primary.isEncoding_ && !primary.isSecondary_);
+
+  isSecondary_ = true;
+  framebuffer_ = primary.framebuffer_;
+  vkRenderPass_ = primary.vkRenderPass_;
+  vkFramebuffer_ = primary.vkFramebuffer_;
+  renderArea_ = primary.renderArea_;
+  useDynamicRendering_ = primary.useDynamicRendering_;
+  colorAttachmentFormats_ = primary.colorAttachmentFormats_;
+  depthAttachmentFormat_ = primary.depthAttachmentFormat_;
+  stencilAttachmentFormat_ = primary.stencilAttachmentFormat_;
+  samples_ = primary.samples_;
+  hasDepthAttachment_ = primary.hasDepthAttachment_;
+  isMultiview_ = primary.isMultiview_;
+  dynamicState_.renderPassIndex_ = primary.dynamicState_.renderPassIndex_;
+  dynamicState_.isStereo_ = primary.dynamicState_.isStereo_;
+  dynamicState_.depthBiasEnable_ = false;
+
+  if (useDynamicRendering_) {
+#if defined(VK_KHR_dynamic_rendering)
+    const VkCommandBufferInheritanceRenderingInfoKHR renderingInfo = {
+        VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO_KHR,
+        nullptr,
+        0,
+        dynamicState_.isStereo_ ? 0x00000003u : 0u,
+        (uint32_t)colorAttachmentFormats_.size(),
+        colorAttachmentFormats_.data(),
+        depthAttachmentFormat_,
+        stencilAttachmentFormat_,
+        samples_,
+    };
+    VK_ASSERT(ivkBeginSecondaryCommandBufferRendering(cmdBuffer_, &renderingInfo));
+#endif // VK_KHR_dynamic_rendering
+  } else {
+    VK_ASSERT(ivkBeginSecondaryCommandBuffer(cmdBuffer_, vkRenderPass_, 0, vkFramebuffer_));
+  }
+
+  // dynamic state is not inherited from the primary command buffer
+  const igl::Viewport viewport = {
+      0.0f, 0.0f, (float)renderArea_.extent.width, (float)renderArea_.extent.height, 0.0f, +1.0f};
+  const igl::ScissorRect scissor = {0, 0, renderArea_.extent.width, renderArea_.extent.height};
+
+  bindViewport(viewport);
+  bindScissorRect(scissor);
+
+  // descriptor sets were already updated by the primary encoder; only bind them here
+  ctx_.DUBs_->update(cmdBuffer_, VK_PIPELINE_BIND_POINT_GRAPHICS, nullptr);
+
+  isEncoding_ = true;
+}
+
+std::unique_ptr<RenderCommandEncoder> RenderCommandEncoder::createSecondary(
+    const std::shared_ptr<CommandBuffer>& commandBuffer,
+    const VulkanContext& ctx,
+    const RenderCommandEncoder& primary,
+    VkCommandBuffer cmdBuffer) {
+  IGL_PROFILER_FUNCTION();
+
+  if (!IGL_VERIFY(commandBuffer)) {
+    return nullptr;
+  }
+
+  std::unique_ptr<RenderCommandEncoder> encoder(
+      new RenderCommandEncoder(commandBuffer, ctx, cmdBuffer));
+  encoder->initializeSecondary(primary);
+
+  return encoder;
+}
+
 void RenderCommandEncoder::endEncoding() {
   IGL_PROFILER_FUNCTION();
 
@@ -299,14 +570,29 @@ void RenderCommandEncoder::endEncoding() {
 
   isEncoding_ = false;
 
-  vkCmdEndRenderPass(cmdBuffer_);
+  if (isSecondary_) {
+    // the render pass is ended by the primary encoder
+    VK_ASSERT(ivkEndCommandBuffer(cmdBuffer_));
+    return;
+  }
+
+  if (useDynamicRendering_) {
+#if defined(VK_KHR_dynamic_rendering)
+    vkCmdEndRenderingKHR(cmdBuffer_);
+#endif // VK_KHR_dynamic_rendering
+  } else {
+    vkCmdEndRenderPass(cmdBuffer_);
+  }
+
+  commandBuffer_->endTimestampScope();
 
   // set image layouts after the render pass
   const FramebufferDesc& desc = static_cast<const Framebuffer&>((*framebuffer_)).getDesc();
 
   for (const auto& attachment : desc.colorAttachments) {
     const vulkan::Texture& tex = static_cast<vulkan::Texture&>(*attachment.second.texture.get());
-    // this must match the final layout of the render pass
+    // this must match the final layout of the render pass (or the layout used for dynamic
+    // rendering)
     tex.getVulkanTexture().getVulkanImage().imageLayout_ = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
   }
 
@@ -321,6 +607,10 @@ void RenderCommandEncoder::endEncoding() {
 void RenderCommandEncoder::pushDebugGroupLabel(const std::string& label,
                                                const igl::Color& color) const {
   ivkCmdBeginDebugUtilsLabel(cmdBuffer_, label.c_str(), color.toFloatPtr());
+  // timestamps cannot be written from secondary command buffers recorded on other threads
+  if (!isMultiview_ && !isSecondary_) {
+    commandBuffer_->beginTimestampScope(label);
+  }
 }
 
 void RenderCommandEncoder::insertDebugEventLabel(const std::string& label,
@@ -329,6 +619,9 @@ void RenderCommandEncoder::insertDebugEventLabel(const std::string& label,
 }
 
 void RenderCommandEncoder::popDebugGroupLabel() const {
+  if (!isMultiview_ && !isSecondary_) {
+    commandBuffer_->endTimestampScope();
+  }
   ivkCmdEndDebugUtilsLabel(cmdBuffer_);
 }
 
@@ -452,7 +745,7 @@ void RenderCommandEncoder::bindBuffer(int index,
 
   if (buf->getBufferType() & BufferDesc::BufferTypeBits::Vertex) {
     IGL_ASSERT(target == BindTarget::kVertex);
-    const VkDeviceSize offset = bufferOffset;
+    const VkDeviceSize offset = buf->getVkBufferOffset() + bufferOffset;
     vkCmdBindVertexBuffers(cmdBuffer_, index, 1, &vkBuf, &offset);
   } else if (isUniformOrStorageBuffer) {
     if (ctx_.enhancedShaderDebuggingStore_) {
@@ -539,37 +832,98 @@ void RenderCommandEncoder::bindUniform(const UniformDesc& /*uniformDesc*/, const
   IGL_ASSERT_NOT_IMPLEMENTED();
 }
 
-void RenderCommandEncoder::bindPipeline() {
+bool RenderCommandEncoder::bindPipeline() {
   const igl::vulkan::RenderPipelineState* rps =
       static_cast<igl::vulkan::RenderPipelineState*>(currentPipeline_.get());
 
   if (!IGL_VERIFY(rps)) {
+    return false;
+  }
+
+  const VkPipeline pipeline =
+      rps->getVkPipeline(dynamicState_, !ctx_.config_.skipDrawsWithPendingPipelines);
+
+  if (pipeline == VK_NULL_HANDLE) {
+    // the pipeline is still being built on a worker thread
+    return false;
+  }
+
+  binder_.bindPipeline(pipeline);
+
+  if (ctx_.hasExtendedDynamicState_) {
+    bindExtendedDynamicState();
+  }
+
+  return true;
+}
+
+void RenderCommandEncoder::bindExtendedDynamicState() {
+#if defined(VK_EXT_extended_dynamic_state)
+  if (hasBoundDynamicState_ && boundDynamicState_ == dynamicState_) {
     return;
   }
 
-  binder_.bindPipeline(rps->getVkPipeline(dynamicState_));
+  // this must match RenderPipelineState::getPipelineKey() and
+  // VulkanPipelineBuilder::depthCompareOp()
+  vkCmdSetPrimitiveTopologyEXT(cmdBuffer_, dynamicState_.getTopology());
+  vkCmdSetDepthTestEnableEXT(
+      cmdBuffer_, dynamicState_.getDepthCompareOp() != VK_COMPARE_OP_ALWAYS ? VK_TRUE : VK_FALSE);
+  vkCmdSetDepthWriteEnableEXT(cmdBuffer_, dynamicState_.depthWriteEnable_ ? VK_TRUE : VK_FALSE);
+  vkCmdSetDepthCompareOpEXT(cmdBuffer_, dynamicState_.getDepthCompareOp());
+  for (const bool front : {true, false}) {
+    vkCmdSetStencilOpEXT(cmdBuffer_,
+                         front ? VK_STENCIL_FACE_FRONT_BIT : VK_STENCIL_FACE_BACK_BIT,
+                         dynamicState_.getStencilStateFailOp(front),
+                         dynamicState_.getStencilStatePassOp(front),
+                         dynamicState_.getStencilStateDepthFailOp(front),
+                         dynamicState_.getStencilStateComapreOp(front));
+  }
+#if defined(VK_EXT_extended_dynamic_state2)
+  if (ctx_.hasExtendedDynamicState2_) {
+    vkCmdSetDepthBiasEnableEXT(cmdBuffer_, dynamicState_.depthBiasEnable_ ? VK_TRUE : VK_FALSE);
+  }
+#endif // VK_EXT_extended_dynamic_state2
+
+  boundDynamicState_ = dynamicState_;
+  hasBoundDynamicState_ = true;
+#endif // VK_EXT_extended_dynamic_state
 }
 
 void RenderCommandEncoder::draw(PrimitiveType primitiveType,
                                 size_t vertexStart,
                                 size_t vertexCount) {
+  drawInstanced(primitiveType, vertexStart, vertexCount, 1);
+}
+
+void RenderCommandEncoder::drawInstanced(PrimitiveType primitiveType,
+                                         size_t vertexStart,
+                                         size_t vertexCount,
+                                         uint32_t instanceCount,
+                                         uint32_t baseInstance) {
   IGL_PROFILER_FUNCTION();
 
   ctx_.drawCallCount_ += drawCallCountEnabled_;
 
-  if (vertexCount == 0) {
+  if (vertexCount == 0 || instanceCount == 0) {
     return;
   }
 
-  binder_.updateBindings();
   dynamicState_.setTopology(primitiveTypeToVkPrimitiveTopology(primitiveType));
-  bindPipeline();
+  if (!bindPipeline()) {
+    return;
+  }
+  binder_.updateBindings();
 
 #if IGL_VULKAN_PRINT_COMMANDS
-  IGL_LOG_INFO("%p vkCmdDraw(%u, %u)\n", cmdBuffer_, (uint32_t)vertexCount, (uint32_t)vertexStart);
+  IGL_LOG_INFO("%p vkCmdDraw(%u, %u, %u, %u)\n",
+               cmdBuffer_,
+               (uint32_t)vertexCount,
+               instanceCount,
+               (uint32_t)vertexStart,
+               baseInstance);
 #endif // IGL_VULKAN_PRINT_COMMANDS
 
-  vkCmdDraw(cmdBuffer_, (uint32_t)vertexCount, 1, (uint32_t)vertexStart, 0);
+  vkCmdDraw(cmdBuffer_, (uint32_t)vertexCount, instanceCount, (uint32_t)vertexStart, baseInstance);
 }
 
 void RenderCommandEncoder::drawIndexed(PrimitiveType primitiveType,
@@ -577,17 +931,30 @@ void RenderCommandEncoder::drawIndexed(PrimitiveType primitiveType,
                                        IndexFormat indexFormat,
                                        IBuffer& indexBuffer,
                                        size_t indexBufferOffset) {
+  drawIndexedInstanced(primitiveType, indexCount, indexFormat, indexBuffer, indexBufferOffset, 1);
+}
+
+void RenderCommandEncoder::drawIndexedInstanced(PrimitiveType primitiveType,
+                                                size_t indexCount,
+                                                IndexFormat indexFormat,
+                                                IBuffer& indexBuffer,
+                                                size_t indexBufferOffset,
+                                                uint32_t instanceCount,
+                                                int32_t baseVertex,
+                                                uint32_t baseInstance) {
   IGL_PROFILER_FUNCTION();
 
   ctx_.drawCallCount_ += drawCallCountEnabled_;
 
-  if (indexCount == 0) {
+  if (indexCount == 0 || instanceCount == 0) {
     return;
   }
 
-  binder_.updateBindings();
   dynamicState_.setTopology(primitiveTypeToVkPrimitiveTopology(primitiveType));
-  bindPipeline();
+  if (!bindPipeline()) {
+    return;
+  }
+  binder_.updateBindings();
 
   const igl::vulkan::Buffer* buf = static_cast<igl::vulkan::Buffer*>(&indexBuffer);
 
@@ -595,12 +962,18 @@ void RenderCommandEncoder::drawIndexed(PrimitiveType primitiveType,
 #if IGL_VULKAN_PRINT_COMMANDS
   IGL_LOG_INFO("%p vkCmdBindIndexBuffer(%u)\n", cmdBuffer_, (uint32_t)indexBufferOffset);
 #endif // IGL_VULKAN_PRINT_COMMANDS
-  vkCmdBindIndexBuffer(cmdBuffer_, buf->getVkBuffer(), indexBufferOffset, type);
+  vkCmdBindIndexBuffer(
+      cmdBuffer_, buf->getVkBuffer(), buf->getVkBufferOffset() + indexBufferOffset, type);
 
 #if IGL_VULKAN_PRINT_COMMANDS
-  IGL_LOG_INFO("%p vkCmdDrawIndexed(%u)\n", cmdBuffer_, (uint32_t)indexCount);
+  IGL_LOG_INFO("%p vkCmdDrawIndexed(%u, %u, %i, %u)\n",
+               cmdBuffer_,
+               (uint32_t)indexCount,
+               instanceCount,
+               baseVertex,
+               baseInstance);
 #endif // IGL_VULKAN_PRINT_COMMANDS
-  vkCmdDrawIndexed(cmdBuffer_, (uint32_t)indexCount, 1, 0, 0, 0);
+  vkCmdDrawIndexed(cmdBuffer_, (uint32_t)indexCount, instanceCount, 0, baseVertex, baseInstance);
 }
 
 void RenderCommandEncoder::drawIndexedIndirect(PrimitiveType primitiveType,
@@ -621,9 +994,11 @@ void RenderCommandEncoder::multiDrawIndirect(PrimitiveType primitiveType,
                                              uint32_t stride) {
   IGL_PROFILER_FUNCTION();
 
-  binder_.updateBindings();
   dynamicState_.setTopology(primitiveTypeToVkPrimitiveTopology(primitiveType));
-  bindPipeline();
+  if (!bindPipeline()) {
+    return;
+  }
+  binder_.updateBindings();
 
   ctx_.drawCallCount_ += drawCallCountEnabled_;
 
@@ -631,7 +1006,7 @@ void RenderCommandEncoder::multiDrawIndirect(PrimitiveType primitiveType,
 
   vkCmdDrawIndirect(cmdBuffer_,
                     bufIndirect->getVkBuffer(),
-                    indirectBufferOffset,
+                    bufIndirect->getVkBufferOffset() + indirectBufferOffset,
                     drawCount,
                     stride ? stride : sizeof(VkDrawIndirectCommand));
 }
@@ -645,9 +1020,11 @@ void RenderCommandEncoder::multiDrawIndexedIndirect(PrimitiveType primitiveType,
                                                     uint32_t stride) {
   IGL_PROFILER_FUNCTION();
 
-  binder_.updateBindings();
   dynamicState_.setTopology(primitiveTypeToVkPrimitiveTopology(primitiveType));
-  bindPipeline();
+  if (!bindPipeline()) {
+    return;
+  }
+  binder_.updateBindings();
 
   ctx_.drawCallCount_ += drawCallCountEnabled_;
 
@@ -655,11 +1032,11 @@ void RenderCommandEncoder::multiDrawIndexedIndirect(PrimitiveType primitiveType,
   const igl::vulkan::Buffer* bufIndirect = static_cast<igl::vulkan::Buffer*>(&indirectBuffer);
 
   const VkIndexType type = indexFormatToVkIndexType(indexFormat);
-  vkCmdBindIndexBuffer(cmdBuffer_, bufIndex->getVkBuffer(), 0, type);
+  vkCmdBindIndexBuffer(cmdBuffer_, bufIndex->getVkBuffer(), bufIndex->getVkBufferOffset(), type);
 
   vkCmdDrawIndexedIndirect(cmdBuffer_,
                            bufIndirect->getVkBuffer(),
-                           indirectBufferOffset,
+                           bufIndirect->getVkBufferOffset() + indirectBufferOffset,
                            drawCount,
                            stride ? stride : sizeof(VkDrawIndexedIndirectCommand));
 }
@@ -682,6 +1059,22 @@ void RenderCommandEncoder::setDepthBias(float depthBias, float slopeScale, float
   vkCmdSetDepthBias(cmdBuffer_, depthBias, clamp, slopeScale);
 }
 
+void RenderCommandEncoder::beginQuery(IQueryPool& pool, uint32_t query) {
+  const auto& vkPool = static_cast<const QueryPool&>(pool);
+  if (!IGL_VERIFY(query < vkPool.getQueryCount())) {
+    return;
+  }
+  vkCmdBeginQuery(cmdBuffer_, vkPool.getVkQueryPool(), query, vkPool.getVkQueryControlFlags());
+}
+
+void RenderCommandEncoder::endQuery(IQueryPool& pool, uint32_t query) {
+  const auto& vkPool = static_cast<const QueryPool&>(pool);
+  if (!IGL_VERIFY(query < vkPool.getQueryCount())) {
+    return;
+  }
+  vkCmdEndQuery(cmdBuffer_, vkPool.getVkQueryPool(), query);
+}
+
 bool RenderCommandEncoder::setDrawCallCountEnabled(bool value) {
   const auto returnVal = drawCallCountEnabled_ > 0;
   drawCallCountEnabled_ = value;
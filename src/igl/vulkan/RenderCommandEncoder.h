@@ -27,8 +27,18 @@ class RenderCommandEncoder : public IRenderCommandEncoder {
       const VulkanContext& ctx,
       const RenderPassDesc& renderPass,
       const std::shared_ptr<IFramebuffer>& framebuffer,
+      VkSubpassContents contents,
       Result* outResult);
 
+  /// @brief Creates an encoder which records into the secondary command buffer `cmdBuffer` and
+  /// continues the render pass begun by `primary`. The primary encoder must have been created with
+  /// VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS.
+  static std::unique_ptr<RenderCommandEncoder> createSecondary(
+      const std::shared_ptr<CommandBuffer>& commandBuffer,
+      const VulkanContext& ctx,
+      const RenderCommandEncoder& primary,
+      VkCommandBuffer cmdBuffer);
+
   ~RenderCommandEncoder() override {
     IGL_ASSERT(!isEncoding_); // did you forget to call endEncoding()?
     endEncoding();
@@ -65,6 +75,19 @@ class RenderCommandEncoder : public IRenderCommandEncoder {
                    IndexFormat indexFormat,
                    IBuffer& indexBuffer,
                    size_t indexBufferOffset) override;
+  void drawInstanced(PrimitiveType primitiveType,
+                     size_t vertexStart,
+                     size_t vertexCount,
+                     uint32_t instanceCount,
+                     uint32_t baseInstance = 0) override;
+  void drawIndexedInstanced(PrimitiveType primitiveType,
+                            size_t indexCount,
+                            IndexFormat indexFormat,
+                            IBuffer& indexBuffer,
+                            size_t indexBufferOffset,
+                            uint32_t instanceCount,
+                            int32_t baseVertex = 0,
+                            uint32_t baseInstance = 0) override;
   void drawIndexedIndirect(PrimitiveType primitiveType,
                            IndexFormat indexFormat,
                            IBuffer& indexBuffer,
@@ -88,6 +111,10 @@ class RenderCommandEncoder : public IRenderCommandEncoder {
   void setBlendColor(Color color) override;
   void setDepthBias(float depthBias, float slopeScale, float clamp) override;
 
+  // In multiview render passes, a query uses one consecutive query per view
+  void beginQuery(IQueryPool& pool, uint32_t query) override;
+  void endQuery(IQueryPool& pool, uint32_t query) override;
+
   VkCommandBuffer getVkCommandBuffer() const {
     return cmdBuffer_;
   }
@@ -98,20 +125,47 @@ class RenderCommandEncoder : public IRenderCommandEncoder {
 
   bool setDrawCallCountEnabled(bool value);
 
+  /// @brief The current dynamic state. It can be passed to RenderPipelineState::prewarm() to
+  /// build pipelines for this render pass ahead of time
+  const RenderPipelineDynamicState& getDynamicState() const {
+    return dynamicState_;
+  }
+
  private:
-  void bindPipeline();
+  // returns false if the draw call should be skipped
+  bool bindPipeline();
+  // sets the states which are not part of the pipeline key with extended dynamic state
+  void bindExtendedDynamicState();
 
  private:
   const VulkanContext& ctx_;
+  const CommandBuffer* commandBuffer_ = nullptr;
   VkCommandBuffer cmdBuffer_ = VK_NULL_HANDLE;
   bool isEncoding_ = false;
+  // secondary encoders record into a secondary command buffer inside a render pass
+  bool isSecondary_ = false;
   bool hasDepthAttachment_ = false;
+  // timestamps written inside a multiview render pass occupy one query per view
+  bool isMultiview_ = false;
   std::shared_ptr<IFramebuffer> framebuffer_;
+  VkRenderPass vkRenderPass_ = VK_NULL_HANDLE;
+  VkFramebuffer vkFramebuffer_ = VK_NULL_HANDLE;
+  VkRect2D renderArea_ = {};
+  // with dynamic rendering there is no render pass and framebuffer; secondary encoders inherit the
+  // attachment formats instead
+  bool useDynamicRendering_ = false;
+  std::vector<VkFormat> colorAttachmentFormats_;
+  VkFormat depthAttachmentFormat_ = VK_FORMAT_UNDEFINED;
+  VkFormat stencilAttachmentFormat_ = VK_FORMAT_UNDEFINED;
+  VkSampleCountFlagBits samples_ = VK_SAMPLE_COUNT_1_BIT;
 
   igl::vulkan::ResourcesBinder binder_;
 
   std::shared_ptr<igl::IRenderPipelineState> currentPipeline_ = nullptr;
   RenderPipelineDynamicState dynamicState_;
+  // the dynamic state which was last set with vkCmdSet*() when extended dynamic state is used
+  RenderPipelineDynamicState boundDynamicState_;
+  bool hasBoundDynamicState_ = false;
 
   /* Used to increment the draw call count. Should either be 0 or 1
    *  0: When draw call count is disabled during auxiliary draw calls (shader debugging)
@@ -120,11 +174,19 @@ class RenderCommandEncoder : public IRenderCommandEncoder {
 
  private:
   RenderCommandEncoder(const std::shared_ptr<CommandBuffer>& commandBuffer,
-                       const VulkanContext& ctx);
+                       const VulkanContext& ctx,
+                       VkCommandBuffer cmdBuffer);
 
   void initialize(const RenderPassDesc& renderPass,
                   const std::shared_ptr<IFramebuffer>& framebuffer,
+                  VkSubpassContents contents,
                   Result* outResult);
+  void initializeSecondary(const RenderCommandEncoder& primary);
+  // transitions the attachments and begins dynamic rendering with vkCmdBeginRenderingKHR()
+  void beginRendering(const RenderPassDesc& renderPass,
+                      const FramebufferDesc& desc,
+                      uint32_t mipLevel,
+                      VkSubpassContents contents);
 };
 
 } // namespace vulkan
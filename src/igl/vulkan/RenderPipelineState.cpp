@@ -5,12 +5,20 @@
  * LICENSE file in the root directory of this source tree.
  */
 
-#include <igl/vulkan/Device.h>
 #include <igl/vulkan/RenderPipelineState.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <string>
+#include <type_traits>
+
+#include <igl/vulkan/Device.h>
 #include <igl/vulkan/ShaderModule.h>
 #include <igl/vulkan/VertexInputState.h>
 #include <igl/vulkan/VulkanContext.h>
 #include <igl/vulkan/VulkanDevice.h>
+#include <igl/vulkan/VulkanImage.h>
 #include <igl/vulkan/VulkanPipelineBuilder.h>
 #include <igl/vulkan/VulkanPipelineLayout.h>
 
@@ -210,6 +218,84 @@ VkBlendFactor blendFactorToVkBlendFactor(igl::BlendFactor value) {
   }
 }
 
+// with a dynamic primitive topology, the pipeline topology has to be of the same topology class
+VkPrimitiveTopology getPrimitiveTopologyClass(VkPrimitiveTopology topology) {
+  switch (topology) {
+  case VK_PRIMITIVE_TOPOLOGY_LINE_LIST:
+  case VK_PRIMITIVE_TOPOLOGY_LINE_STRIP:
+    return VK_PRIMITIVE_TOPOLOGY_LINE_LIST;
+  case VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST:
+  case VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP:
+  case VK_PRIMITIVE_TOPOLOGY_TRIANGLE_FAN:
+    return VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+  default:
+    return topology;
+  }
+}
+
+#if defined(VK_EXT_graphics_pipeline_library)
+// graphics pipeline libraries are keyed by the raw bytes of the state they are built from; only
+// Vulkan structures without padding are appended
+class LibraryKey final {
+ public:
+  LibraryKey(VkGraphicsPipelineLibraryFlagsEXT part, VkPipelineLayout layout) {
+    add(part).add(layout);
+  }
+
+  template<typename T>
+  LibraryKey& add(const T& value) {
+    static_assert(std::is_trivially_copyable<T>::value, "Only plain values can be keys");
+    key_.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    return *this;
+  }
+
+  template<typename T>
+  LibraryKey& add(const T* values, size_t count) {
+    add(count);
+    for (size_t i = 0; i != count; i++) {
+      add(values[i]);
+    }
+    return *this;
+  }
+
+  template<typename T>
+  LibraryKey& add(const std::vector<T>& values) {
+    return add(values.data(), values.size());
+  }
+
+  LibraryKey& add(const std::string& str) {
+    add(str.size());
+    key_.append(str);
+    return *this;
+  }
+
+  const std::string& get() const {
+    return key_;
+  }
+
+ private:
+  std::string key_;
+};
+#endif // VK_EXT_graphics_pipeline_library
+
+// destroys the pipeline once the command buffers identified by `handles` and the last submitted
+// one have completed
+void destroyPipelineDeferred(const igl::vulkan::VulkanContext& ctx,
+                             VkPipeline pipeline,
+                             std::vector<igl::vulkan::VulkanContext::SubmitHandle> handles) {
+  ctx.deferredTask(
+      std::packaged_task<void()>([&ctx, pipeline, handles = std::move(handles)]() mutable {
+        for (const auto& handle : handles) {
+          if (!ctx.immediate_->isReady(handle)) {
+            // a command buffer which was being encoded has not completed yet
+            destroyPipelineDeferred(ctx, pipeline, std::move(handles));
+            return;
+          }
+        }
+        vkDestroyPipeline(ctx.device_->getVkDevice(), pipeline, nullptr);
+      }));
+}
+
 } // namespace
 
 namespace igl {
@@ -247,6 +333,18 @@ RenderPipelineState::RenderPipelineState(const igl::vulkan::Device& device,
                                            : VK_VERTEX_INPUT_RATE_INSTANCE;
         vkBindings_.push_back(ivkGetVertexInputBindingDescription(
             (uint32_t)bufferIndex, (uint32_t)binding.stride, rate));
+
+        if (rate == VK_VERTEX_INPUT_RATE_INSTANCE && binding.sampleRate != 1) {
+#if defined(VK_EXT_vertex_attribute_divisor)
+          IGL_ASSERT_MSG(device_.getVulkanContext().hasVertexAttributeDivisor_,
+                         "VertexInputBinding::sampleRate requires "
+                         "VK_EXT_vertex_attribute_divisor");
+          vkBindingDivisors_.push_back(VkVertexInputBindingDivisorDescriptionEXT{
+              (uint32_t)bufferIndex, (uint32_t)binding.sampleRate});
+#else
+          IGL_ASSERT_MSG(false, "VertexInputBinding::sampleRate is not supported");
+#endif // VK_EXT_vertex_attribute_divisor
+        }
       }
     }
 
@@ -256,33 +354,319 @@ RenderPipelineState::RenderPipelineState(const igl::vulkan::Device& device,
     vertexInputStateCreateInfo_.vertexAttributeDescriptionCount =
         static_cast<uint32_t>(vstate->desc_.numAttributes);
     vertexInputStateCreateInfo_.pVertexAttributeDescriptions = vkAttributes_.data();
+
+#if defined(VK_EXT_vertex_attribute_divisor)
+    if (!vkBindingDivisors_.empty() && device_.getVulkanContext().hasVertexAttributeDivisor_) {
+      vertexInputDivisorStateCreateInfo_.sType =
+          VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_DIVISOR_STATE_CREATE_INFO_EXT;
+      vertexInputDivisorStateCreateInfo_.vertexBindingDivisorCount =
+          static_cast<uint32_t>(vkBindingDivisors_.size());
+      vertexInputDivisorStateCreateInfo_.pVertexBindingDivisors = vkBindingDivisors_.data();
+      vertexInputStateCreateInfo_.pNext = &vertexInputDivisorStateCreateInfo_;
+    }
+#endif // VK_EXT_vertex_attribute_divisor
   }
 }
 
 RenderPipelineState::~RenderPipelineState() {
-  VkDevice device = device_.getVulkanContext().device_->getVkDevice();
+  // wait until all the pipelines being prewarmed or optimized are built; finishing workers can
+  // schedule new ones. The futures returned by WorkerPool::schedule() do not block when destroyed
+  for (;;) {
+    std::vector<std::future<void>> workers;
+    {
+      std::lock_guard<std::mutex> lock(pipelinesMutex_);
+      workers.swap(workers_);
+    }
+    if (workers.empty()) {
+      break;
+    }
+    for (auto& worker : workers) {
+      worker.wait();
+    }
+  }
 
   for (auto p : pipelines_) {
     if (p.second != VK_NULL_HANDLE) {
-      device_.getVulkanContext().deferredTask(std::packaged_task<void()>(
-          [device, pipeline = p.second]() { vkDestroyPipeline(device, pipeline, nullptr); }));
+      retirePipeline(p.second);
     }
   }
 }
 
-VkPipeline RenderPipelineState::getVkPipeline(
+void RenderPipelineState::retirePipeline(VkPipeline pipeline) const {
+  const VulkanContext& ctx = device_.getVulkanContext();
+
+  // command buffers which are being encoded might still reference the pipeline
+  destroyPipelineDeferred(ctx, pipeline, ctx.immediate_->getEncodingSubmitHandles());
+}
+
+RenderPipelineDynamicState RenderPipelineState::getPipelineKey(
     const RenderPipelineDynamicState& dynamicState) const {
-  const auto it = pipelines_.find(dynamicState);
+  const VulkanContext& ctx = device_.getVulkanContext();
 
-  if (it != pipelines_.end()) {
-    return it->second;
+  if (!ctx.hasExtendedDynamicState_) {
+    return dynamicState;
   }
 
-  // build a new Vulkan pipeline
+  // these states are set by render command encoders with vkCmdSet*(), so they are reset to their
+  // defaults here and all their combinations share one pipeline
+  RenderPipelineDynamicState key = dynamicState;
+  key.setTopology(getPrimitiveTopologyClass(dynamicState.getTopology()));
+  key.setDepthCompareOp(VK_COMPARE_OP_ALWAYS);
+  key.depthWriteEnable_ = false;
+  for (const bool front : {true, false}) {
+    key.setStencilStateOps(
+        front, VK_STENCIL_OP_KEEP, VK_STENCIL_OP_KEEP, VK_STENCIL_OP_KEEP, VK_COMPARE_OP_ALWAYS);
+  }
+  if (ctx.hasExtendedDynamicState2_) {
+    key.depthBiasEnable_ = false;
+  }
+  return key;
+}
+
+VkPipeline RenderPipelineState::getVkPipeline(const RenderPipelineDynamicState& requestedState,
+                                              bool wait) const {
+  const RenderPipelineDynamicState dynamicState = getPipelineKey(requestedState);
+
+  const VulkanContext& ctx = device_.getVulkanContext();
+
+  std::shared_future<VkPipeline> future;
+  std::promise<VkPipeline> promise;
+  uint32_t generation = 0;
+
+  {
+    // pipelines can be requested by render command encoders recorded on different threads
+    std::lock_guard<std::mutex> lock(pipelinesMutex_);
+
+    retireStalePipelines();
+    generation = pipelinesGeneration_;
+
+    const auto it = pipelines_.find(dynamicState);
+
+    if (it != pipelines_.end()) {
+      return it->second;
+    }
+
+    const auto pending = pendingPipelines_.find(dynamicState);
+
+    if (pending != pendingPipelines_.end()) {
+      future = pending->second;
+    } else if (wait) {
+      // the pipeline is built on this thread without holding the lock
+      pendingPipelines_[dynamicState] = promise.get_future().share();
+    }
+  }
+
+  if (future.valid()) {
+    if (!wait && future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+      return VK_NULL_HANDLE;
+    }
+    return future.get();
+  }
+
+  if (!wait) {
+    prewarm({dynamicState});
+    return VK_NULL_HANDLE;
+  }
+
+  // there are no render passes with dynamic rendering
+  const VkPipeline pipeline = createVkPipeline(
+      dynamicState,
+      ctx.useDynamicRendering_ ? VK_NULL_HANDLE
+                               : ctx.getRenderPass(dynamicState.renderPassIndex_).pass,
+      ctx.pipelineLayoutGraphics_->getVkPipelineLayout(),
+      generation);
+
+  addPipeline(dynamicState, pipeline, promise, generation);
+
+  return pipeline;
+}
+
+void RenderPipelineState::prewarm(
+    const std::vector<RenderPipelineDynamicState>& dynamicStates) const {
+  IGL_PROFILER_FUNCTION();
 
   const VulkanContext& ctx = device_.getVulkanContext();
 
-  VkRenderPass renderPass = ctx.getRenderPass(dynamicState.renderPassIndex_).pass;
+  std::vector<PendingPipeline> pendingPipelines;
+
+  std::lock_guard<std::mutex> lock(pipelinesMutex_);
+
+  retireStalePipelines();
+
+  for (const auto& requestedState : dynamicStates) {
+    const RenderPipelineDynamicState dynamicState = getPipelineKey(requestedState);
+    if (pipelines_.count(dynamicState) || pendingPipelines_.count(dynamicState)) {
+      continue;
+    }
+    PendingPipeline pendingPipeline;
+    pendingPipeline.dynamicState = dynamicState;
+    pendingPipeline.renderPass = ctx.useDynamicRendering_
+                                     ? VK_NULL_HANDLE
+                                     : ctx.getRenderPass(dynamicState.renderPassIndex_).pass;
+    // the descriptor sets might grow on another thread; a pipeline built with a stale layout is
+    // retired once it is added
+    pendingPipeline.layout = ctx.getPipelineLayoutGraphics(pendingPipeline.generation);
+    pendingPipelines_[dynamicState] = pendingPipeline.promise.get_future().share();
+    pendingPipelines.push_back(std::move(pendingPipeline));
+  }
+
+  if (pendingPipelines.empty()) {
+    return;
+  }
+
+  // forget the finished tasks
+  workers_.erase(std::remove_if(workers_.begin(),
+                                workers_.end(),
+                                [](const std::future<void>& worker) {
+                                  return worker.wait_for(std::chrono::seconds(0)) ==
+                                         std::future_status::ready;
+                                }),
+                 workers_.end());
+
+  const size_t numWorkers =
+      std::min<size_t>(pendingPipelines.size(), ctx.workerPool_->getNumThreads());
+
+  std::vector<std::vector<PendingPipeline>> jobs(numWorkers);
+
+  for (size_t i = 0; i != pendingPipelines.size(); i++) {
+    jobs[i % numWorkers].push_back(std::move(pendingPipelines[i]));
+  }
+
+  for (auto& job : jobs) {
+    workers_.push_back(ctx.workerPool_->schedule(
+        std::packaged_task<void()>([this, job = std::move(job)]() mutable {
+          buildPipelines(std::move(job));
+        })));
+  }
+}
+
+void RenderPipelineState::buildPipelines(std::vector<PendingPipeline> pendingPipelines) const {
+  IGL_PROFILER_FUNCTION();
+
+  for (auto& p : pendingPipelines) {
+    addPipeline(p.dynamicState,
+                createVkPipeline(p.dynamicState, p.renderPass, p.layout, p.generation),
+                p.promise,
+                p.generation);
+  }
+}
+
+void RenderPipelineState::retireStalePipelines() const {
+  const uint32_t generation = device_.getVulkanContext().bindlessGeneration_;
+
+  if (generation == pipelinesGeneration_) {
+    return;
+  }
+
+  // the bindless descriptor sets have grown, so the pipeline layout has changed. Command buffers
+  // might still reference the old pipelines
+  for (const auto& p : pipelines_) {
+    if (p.second != VK_NULL_HANDLE) {
+      retirePipeline(p.second);
+    }
+  }
+  pipelines_.clear();
+  // the pipelines being built are retired once they are added
+  pendingPipelines_.clear();
+  pipelinesGeneration_ = generation;
+}
+
+void RenderPipelineState::addPipeline(const RenderPipelineDynamicState& dynamicState,
+                                      VkPipeline pipeline,
+                                      std::promise<VkPipeline>& promise,
+                                      uint32_t generation) const {
+  {
+    std::lock_guard<std::mutex> lock(pipelinesMutex_);
+    if (generation == pipelinesGeneration_) {
+      pipelines_[dynamicState] = pipeline;
+      pendingPipelines_.erase(dynamicState);
+    } else if (pipeline != VK_NULL_HANDLE) {
+      // the pipeline layout was replaced while this pipeline was being built
+      retirePipeline(pipeline);
+    }
+  }
+
+  // wake up all the threads waiting for this pipeline
+  promise.set_value(pipeline);
+}
+
+#if defined(VK_EXT_graphics_pipeline_library)
+void RenderPipelineState::scheduleOptimizedVkPipeline(
+    const RenderPipelineDynamicState& dynamicState,
+    std::vector<std::shared_ptr<const VulkanPipelineLibraryCache::Library>> libraries,
+    VkPipelineLayout layout,
+    uint32_t generation) const {
+  std::lock_guard<std::mutex> lock(pipelinesMutex_);
+
+  // the quickly linked pipeline is registered by the thread which requested it once it is returned
+  const auto pending = pendingPipelines_.find(dynamicState);
+  std::shared_future<VkPipeline> linked;
+  if (pending != pendingPipelines_.end()) {
+    linked = pending->second;
+  }
+
+  workers_.push_back(device_.getVulkanContext().workerPool_->schedule(std::packaged_task<void()>(
+      [this,
+       dynamicState,
+       libraries = std::move(libraries),
+       layout,
+       generation,
+       linked = std::move(linked)]() {
+        IGL_PROFILER_FUNCTION();
+
+        const VulkanContext& ctx = device_.getVulkanContext();
+        const VkPipelineCache pipelineCache = ctx.pipelineCache_->acquire();
+
+        std::vector<VkPipeline> vkLibraries;
+        vkLibraries.reserve(libraries.size());
+        for (const auto& library : libraries) {
+          vkLibraries.push_back(library->pipeline_);
+        }
+
+        VkPipeline optimized = VK_NULL_HANDLE;
+        const VkResult result =
+            VulkanPipelineBuilder::link(ctx.device_->getVkDevice(),
+                                        pipelineCache,
+                                        layout,
+                                        vkLibraries,
+                                        true,
+                                        &optimized,
+                                        desc_.debugName.toConstChar());
+
+        ctx.pipelineCache_->release(pipelineCache, result == VK_SUCCESS);
+
+        if (result != VK_SUCCESS) {
+          // keep using the quickly linked pipeline
+          return;
+        }
+
+        if (linked.valid()) {
+          linked.wait();
+        }
+
+        std::lock_guard<std::mutex> pipelinesLock(pipelinesMutex_);
+        if (generation != pipelinesGeneration_) {
+          // the pipeline layout was replaced in the meantime
+          retirePipeline(optimized);
+          return;
+        }
+        VkPipeline& pipeline = pipelines_[dynamicState];
+        // command buffers might still reference the quickly linked pipeline
+        if (pipeline != VK_NULL_HANDLE) {
+          retirePipeline(pipeline);
+        }
+        pipeline = optimized;
+      })));
+}
+#endif // VK_EXT_graphics_pipeline_library
+
+VkPipeline RenderPipelineState::createVkPipeline(const RenderPipelineDynamicState& dynamicState,
+                                                 VkRenderPass renderPass,
+                                                 VkPipelineLayout layout,
+                                                 uint32_t generation) const {
+  IGL_PROFILER_FUNCTION();
+
+  const VulkanContext& ctx = device_.getVulkanContext();
 
   VkPipeline pipeline = VK_NULL_HANDLE;
 
@@ -314,7 +698,61 @@ VkPipeline RenderPipelineState::getVkPipeline(
 
   const auto& vertexModule = desc_.shaderStages->getVertexModule();
   const auto& fragmentModule = desc_.shaderStages->getFragmentModule();
-  igl::vulkan::VulkanPipelineBuilder()
+
+  // the same constants are passed to every stage; IDs which a stage does not use are ignored
+  std::vector<VkSpecializationMapEntry> specializationEntries;
+  std::vector<uint32_t> specializationData;
+  VkSpecializationInfo specializationInfo = {};
+  const VkSpecializationInfo* specialization = getVkSpecializationInfo(
+      desc_.specializationConstants, specializationEntries, specializationData, specializationInfo);
+
+  igl::vulkan::VulkanPipelineBuilder builder;
+
+#if defined(VK_EXT_extended_dynamic_state)
+  if (ctx.hasExtendedDynamicState_) {
+    // see RenderCommandEncoder::bindExtendedDynamicState()
+    builder.dynamicStates({
+        VK_DYNAMIC_STATE_PRIMITIVE_TOPOLOGY_EXT,
+        VK_DYNAMIC_STATE_DEPTH_TEST_ENABLE_EXT,
+        VK_DYNAMIC_STATE_DEPTH_WRITE_ENABLE_EXT,
+        VK_DYNAMIC_STATE_DEPTH_COMPARE_OP_EXT,
+        VK_DYNAMIC_STATE_STENCIL_OP_EXT,
+    });
+  }
+#endif // VK_EXT_extended_dynamic_state
+#if defined(VK_EXT_extended_dynamic_state2)
+  if (ctx.hasExtendedDynamicState2_) {
+    builder.dynamicState(VK_DYNAMIC_STATE_DEPTH_BIAS_ENABLE_EXT);
+  }
+#endif // VK_EXT_extended_dynamic_state2
+
+  // the pipeline is compatible with any attachments of these formats with dynamic rendering, so
+  // there is no render pass
+  std::vector<VkFormat> colorAttachmentFormats;
+  VkFormat depthFormat = VK_FORMAT_UNDEFINED;
+  VkFormat stencilFormat = VK_FORMAT_UNDEFINED;
+  const uint32_t viewMask = dynamicState.isStereo_ ? 0x3 : 0;
+
+  if (ctx.useDynamicRendering_) {
+    colorAttachmentFormats.reserve(desc_.targetDesc.colorAttachments.size());
+    for (const auto& attachment : desc_.targetDesc.colorAttachments) {
+      if (attachment.textureFormat != TextureFormat::Invalid) {
+        colorAttachmentFormats.push_back(textureFormatToVkFormat(attachment.textureFormat));
+      }
+    }
+    if (desc_.targetDesc.depthAttachmentFormat != TextureFormat::Invalid) {
+      depthFormat = ctx.getClosestDepthStencilFormat(desc_.targetDesc.depthAttachmentFormat);
+    }
+    // combined depth-stencil attachments are bound as both depth and stencil attachments
+    if (VulkanImage::isStencilFormat(depthFormat)) {
+      stencilFormat = depthFormat;
+    } else if (desc_.targetDesc.stencilAttachmentFormat != TextureFormat::Invalid) {
+      stencilFormat = ctx.getClosestDepthStencilFormat(desc_.targetDesc.stencilAttachmentFormat);
+    }
+    builder.renderingFormats(colorAttachmentFormats, depthFormat, stencilFormat, viewMask);
+  }
+
+  builder
       .dynamicStates({
           // from Vulkan 1.0
           VK_DYNAMIC_STATE_VIEWPORT,
@@ -345,27 +783,160 @@ VkPipeline RenderPipelineState::getVkPipeline(
           ivkGetPipelineShaderStageCreateInfo(
               VK_SHADER_STAGE_VERTEX_BIT,
               igl::vulkan::ShaderModule::getVkShaderModule(vertexModule),
-              vertexModule->info().entryPoint.c_str()),
+              vertexModule->info().entryPoint.c_str(),
+              specialization),
           ivkGetPipelineShaderStageCreateInfo(
               VK_SHADER_STAGE_FRAGMENT_BIT,
               igl::vulkan::ShaderModule::getVkShaderModule(fragmentModule),
-              fragmentModule->info().entryPoint.c_str()),
+              fragmentModule->info().entryPoint.c_str(),
+              specialization),
       })
       .cullMode(cullModeToVkCullMode(desc_.cullMode))
       .frontFace(windingModeToVkFrontFace(desc_.frontFaceWinding))
       .vertexInputState(vertexInputStateCreateInfo_)
-      .colorBlendAttachmentStates(colorBlendAttachmentStates)
-      .build(ctx.device_->getVkDevice(),
-             // TODO: use ctx.pipelineCache_
-             // @fb-only
-             // @fb-only
-             VK_NULL_HANDLE,
-             ctx.pipelineLayoutGraphics_->getVkPipelineLayout(),
-             renderPass,
-             &pipeline,
-             desc_.debugName.toConstChar());
-
-  pipelines_[dynamicState] = pipeline;
+      .colorBlendAttachmentStates(colorBlendAttachmentStates);
+
+  const VkDevice device = ctx.device_->getVkDevice();
+
+  // every thread building pipelines uses its own pipeline cache
+  const VkPipelineCache pipelineCache = ctx.pipelineCache_->acquire();
+
+#if defined(VK_EXT_graphics_pipeline_library)
+  if (ctx.pipelineLibraries_) {
+    // the key parts shared by all the libraries which depend on the render pass or view mask
+    const auto addRenderTarget = [renderPass, viewMask](LibraryKey& key) -> LibraryKey& {
+      return key.add(renderPass).add(viewMask);
+    };
+    const auto addShaderStage = [specialization](LibraryKey& key,
+                                                 const std::shared_ptr<IShaderModule>& shaderModule)
+        -> LibraryKey& {
+      key.add(shaderModule.get())
+          .add(igl::vulkan::ShaderModule::getVkShaderModule(shaderModule))
+          .add(shaderModule->info().entryPoint);
+      if (specialization) {
+        key.add(specialization->pMapEntries, specialization->mapEntryCount)
+            .add(static_cast<const uint8_t*>(specialization->pData), specialization->dataSize);
+      }
+      return key;
+    };
+
+    LibraryKey vertexInputKey(VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT, layout);
+    vertexInputKey
+        .add(vertexInputStateCreateInfo_.pVertexBindingDescriptions,
+             vertexInputStateCreateInfo_.vertexBindingDescriptionCount)
+        .add(vertexInputStateCreateInfo_.pVertexAttributeDescriptions,
+             vertexInputStateCreateInfo_.vertexAttributeDescriptionCount)
+        .add(dynamicState.getTopology())
+        .add(ctx.hasExtendedDynamicState_);
+#if defined(VK_EXT_vertex_attribute_divisor)
+    vertexInputKey.add(vkBindingDivisors_);
+#endif // VK_EXT_vertex_attribute_divisor
+
+    LibraryKey preRasterizationKey(VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT,
+                                   layout);
+    addShaderStage(addRenderTarget(preRasterizationKey), vertexModule)
+        .add(polygonFillModeToVkPolygonMode(desc_.polygonFillMode))
+        .add(cullModeToVkCullMode(desc_.cullMode))
+        .add(windingModeToVkFrontFace(desc_.frontFaceWinding))
+        .add(dynamicState.depthBiasEnable_ != 0)
+        .add(ctx.hasExtendedDynamicState_)
+        .add(ctx.hasExtendedDynamicState2_);
+
+    LibraryKey fragmentShaderKey(VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT, layout);
+    addShaderStage(addRenderTarget(fragmentShaderKey), fragmentModule)
+        .add(getVulkanSampleCountFlags(desc_.sampleCount))
+        .add(dynamicState.getDepthCompareOp())
+        .add(dynamicState.depthWriteEnable_ != 0)
+        .add(ctx.hasExtendedDynamicState_);
+    for (const bool front : {true, false}) {
+      fragmentShaderKey.add(dynamicState.getStencilStateFailOp(front))
+          .add(dynamicState.getStencilStatePassOp(front))
+          .add(dynamicState.getStencilStateDepthFailOp(front))
+          .add(dynamicState.getStencilStateComapreOp(front));
+    }
+
+    LibraryKey fragmentOutputKey(VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT,
+                                 layout);
+    addRenderTarget(fragmentOutputKey)
+        .add(colorAttachmentFormats)
+        .add(depthFormat)
+        .add(stencilFormat)
+        .add(getVulkanSampleCountFlags(desc_.sampleCount))
+        .add(colorBlendAttachmentStates);
+
+    struct LibraryPart {
+      VkGraphicsPipelineLibraryFlagsEXT flags;
+      const LibraryKey& key;
+      // shader modules whose handles are a part of the key
+      std::shared_ptr<const void> owner;
+    };
+    const LibraryPart parts[] = {
+        {VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT, vertexInputKey, nullptr},
+        {VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT,
+         preRasterizationKey,
+         vertexModule},
+        {VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT, fragmentShaderKey, fragmentModule},
+        {VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT,
+         fragmentOutputKey,
+         nullptr},
+    };
+
+    std::vector<std::shared_ptr<const VulkanPipelineLibraryCache::Library>> libraries;
+    std::vector<VkPipeline> vkLibraries;
+    libraries.reserve(std::size(parts));
+    vkLibraries.reserve(std::size(parts));
+
+    for (const auto& part : parts) {
+      auto library = ctx.pipelineLibraries_->getOrCreate(
+          part.key.get(),
+          [&]() {
+            VkPipeline lib = VK_NULL_HANDLE;
+            builder.buildLibrary(device,
+                                 pipelineCache,
+                                 layout,
+                                 renderPass,
+                                 part.flags,
+                                 &lib,
+                                 desc_.debugName.toConstChar());
+            return lib;
+          },
+          part.owner);
+      if (!library) {
+        break;
+      }
+      vkLibraries.push_back(library->pipeline_);
+      libraries.push_back(std::move(library));
+    }
+
+    VkResult result = VK_ERROR_INITIALIZATION_FAILED;
+
+    if (libraries.size() == std::size(parts)) {
+      // fast linking lets the pipeline be used right away; an optimized one replaces it later
+      result = VulkanPipelineBuilder::link(device,
+                                           pipelineCache,
+                                           layout,
+                                           vkLibraries,
+                                           false,
+                                           &pipeline,
+                                           desc_.debugName.toConstChar());
+    }
+
+    ctx.pipelineCache_->release(pipelineCache, result == VK_SUCCESS);
+
+    if (result == VK_SUCCESS) {
+      scheduleOptimizedVkPipeline(dynamicState, std::move(libraries), layout, generation);
+    }
+
+    // @fb-only
+    // @lint-ignore CLANGTIDY
+    return pipeline;
+  }
+#endif // VK_EXT_graphics_pipeline_library
+
+  const VkResult result = builder.build(
+      device, pipelineCache, layout, renderPass, &pipeline, desc_.debugName.toConstChar());
+
+  ctx.pipelineCache_->release(pipelineCache, result == VK_SUCCESS);
 
   // @fb-only
   // @lint-ignore CLANGTIDY
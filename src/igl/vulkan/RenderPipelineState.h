@@ -10,7 +10,11 @@
 #include <igl/RenderPipelineState.h>
 #include <igl/vulkan/Common.h>
 #include <igl/vulkan/RenderPipelineReflection.h>
+#include <igl/vulkan/VulkanPipelineLibraryCache.h>
+#include <future>
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 
 namespace igl {
 namespace vulkan {
@@ -56,6 +60,10 @@ class alignas(sizeof(uint64_t)) RenderPipelineDynamicState {
   // Ignore modernize-use-default-member-init
   // @lint-ignore CLANGTIDY
   uint32_t depthWriteEnable_ : 1;
+  // Ignore modernize-use-default-member-init
+  // @lint-ignore CLANGTIDY
+  // with dynamic rendering, this replaces the view mask of the render pass
+  uint32_t isStereo_ : 1;
 
   RenderPipelineDynamicState() {
     // memset makes sure all padding bits are zero
@@ -75,6 +83,7 @@ class alignas(sizeof(uint64_t)) RenderPipelineDynamicState {
     renderPassIndex_ = 0;
     depthBiasEnable_ = false;
     depthWriteEnable_ = false;
+    isStereo_ = false;
   }
 
   VkPrimitiveTopology getTopology() const {
@@ -154,7 +163,17 @@ class RenderPipelineState final : public IRenderPipelineState {
   RenderPipelineState(const igl::vulkan::Device& device, RenderPipelineDesc desc);
   ~RenderPipelineState() override;
 
-  VkPipeline getVkPipeline(const RenderPipelineDynamicState& dynamicState) const;
+  /// @brief Returns the Vulkan pipeline for the dynamic state, building it if necessary. When the
+  /// pipeline is not ready and `wait` is false, this returns VK_NULL_HANDLE instead of blocking and
+  /// the pipeline is built on a worker thread. With extended dynamic state, dynamic states which
+  /// differ only in states set with vkCmdSet*() share one pipeline. Thread-safe
+  VkPipeline getVkPipeline(const RenderPipelineDynamicState& dynamicState, bool wait = true) const;
+
+  /// @brief Builds the Vulkan pipelines for the dynamic states on worker threads, so draw calls do
+  /// not stall when they use these states for the first time. Pipelines which are already built,
+  /// or being built, are skipped. The render pass indices must come from render command encoders
+  /// (see RenderCommandEncoder::getDynamicState()). Thread-safe
+  void prewarm(const std::vector<RenderPipelineDynamicState>& dynamicStates) const;
 
   const RenderPipelineDesc& getRenderPipelineDesc() const {
     return desc_;
@@ -170,6 +189,41 @@ class RenderPipelineState final : public IRenderPipelineState {
   void setRenderPipelineReflection(
       const IRenderPipelineReflection& renderPipelineReflection) override;
 
+ private:
+  struct PendingPipeline {
+    RenderPipelineDynamicState dynamicState;
+    VkRenderPass renderPass = VK_NULL_HANDLE;
+    VkPipelineLayout layout = VK_NULL_HANDLE;
+    uint32_t generation = 0;
+    std::promise<VkPipeline> promise;
+  };
+
+  // clears the states which are set dynamically with extended dynamic state, so all their values
+  // map to one pipeline
+  RenderPipelineDynamicState getPipelineKey(const RenderPipelineDynamicState& dynamicState) const;
+  VkPipeline createVkPipeline(const RenderPipelineDynamicState& dynamicState,
+                              VkRenderPass renderPass,
+                              VkPipelineLayout layout,
+                              uint32_t generation) const;
+  void buildPipelines(std::vector<PendingPipeline> pendingPipelines) const;
+  void addPipeline(const RenderPipelineDynamicState& dynamicState,
+                   VkPipeline pipeline,
+                   std::promise<VkPipeline>& promise,
+                   uint32_t generation) const;
+  // forgets the pipelines built with an outdated pipeline layout; requires pipelinesMutex_
+  void retireStalePipelines() const;
+  // destroys a pipeline once no command buffer can reference it anymore
+  void retirePipeline(VkPipeline pipeline) const;
+#if defined(VK_EXT_graphics_pipeline_library)
+  // links an optimized pipeline from graphics pipeline libraries on a worker thread and replaces
+  // the quickly linked one with it. The libraries are kept alive until the link is done
+  void scheduleOptimizedVkPipeline(
+      const RenderPipelineDynamicState& dynamicState,
+      std::vector<std::shared_ptr<const VulkanPipelineLibraryCache::Library>> libraries,
+      VkPipelineLayout layout,
+      uint32_t generation) const;
+#endif // VK_EXT_graphics_pipeline_library
+
  private:
   const igl::vulkan::Device& device_;
 
@@ -179,6 +233,11 @@ class RenderPipelineState final : public IRenderPipelineState {
 
   std::vector<VkVertexInputBindingDescription> vkBindings_;
   std::vector<VkVertexInputAttributeDescription> vkAttributes_;
+#if defined(VK_EXT_vertex_attribute_divisor)
+  // per-instance bindings with VertexInputBinding::sampleRate != 1
+  std::vector<VkVertexInputBindingDivisorDescriptionEXT> vkBindingDivisors_;
+  VkPipelineVertexInputDivisorStateCreateInfoEXT vertexInputDivisorStateCreateInfo_ = {};
+#endif // VK_EXT_vertex_attribute_divisor
 
   // This is empty for now.
   std::shared_ptr<RenderPipelineReflection> reflection_;
@@ -187,6 +246,17 @@ class RenderPipelineState final : public IRenderPipelineState {
                              VkPipeline,
                              RenderPipelineDynamicState::HashFunction>
       pipelines_;
+  // pipelines which are being built; requests for them wait for the result instead of building them
+  mutable std::unordered_map<RenderPipelineDynamicState,
+                             std::shared_future<VkPipeline>,
+                             RenderPipelineDynamicState::HashFunction>
+      pendingPipelines_;
+  // VulkanContext::bindlessGeneration_ of the pipelines in pipelines_
+  mutable uint32_t pipelinesGeneration_ = 0;
+  // prewarming and optimization tasks scheduled on VulkanContext::workerPool_; the destructor
+  // waits for them to finish
+  mutable std::vector<std::future<void>> workers_;
+  mutable std::mutex pipelinesMutex_;
 };
 
 } // namespace vulkan
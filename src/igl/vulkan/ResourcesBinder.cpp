@@ -16,10 +16,10 @@ namespace igl {
 
 namespace vulkan {
 
-ResourcesBinder::ResourcesBinder(const std::shared_ptr<CommandBuffer>& commandBuffer,
+ResourcesBinder::ResourcesBinder(VkCommandBuffer cmdBuffer,
                                  const VulkanContext& ctx,
                                  VkPipelineBindPoint bindPoint) :
-  ctx_(ctx), cmdBuffer_(commandBuffer->getVkCommandBuffer()), bindPoint_(bindPoint) {}
+  ctx_(ctx), cmdBuffer_(cmdBuffer), bindPoint_(bindPoint) {}
 
 void ResourcesBinder::bindBuffer(uint32_t index, igl::vulkan::Buffer* buffer, size_t bufferOffset) {
   IGL_PROFILER_FUNCTION();
@@ -86,12 +86,40 @@ void ResourcesBinder::updateBindings() {
     return;
   }
 
-  ctx_.DUBs_->update(cmdBuffer_, bindPoint_, &bindings_);
-
   isBindingsUpdateRequired_ = false;
+
+  if (hasBoundBindings_ && bindings_ == boundBindings_) {
+    // the same resources were bound again: the bindings uploaded last time are still bound
+    return;
+  }
+
+  // the descriptors of textures and samplers beyond the capacity of the bindless descriptor sets
+  // are written once the sets have grown; until then, the dummy texture and sampler are bound
+  Bindings bindings = bindings_;
+  for (auto& slot : bindings.slots) {
+    if (slot.texture >= ctx_.bindlessTexturesCapacity_) {
+      slot.texture = 0;
+    }
+    if (slot.sampler >= ctx_.bindlessSamplersCapacity_) {
+      slot.sampler = 0;
+    }
+  }
+
+  ctx_.DUBs_->update(cmdBuffer_, bindPoint_, &bindings);
+
+  boundBindings_ = bindings_;
+  boundBindlessGeneration_ = ctx_.bindlessGeneration_;
+  hasBoundBindings_ = true;
 }
 
 void ResourcesBinder::bindPipeline(VkPipeline pipeline) {
+  if (hasBoundBindings_ && boundBindlessGeneration_ != ctx_.bindlessGeneration_) {
+    // the bindless descriptor sets have grown: the pipeline uses the new pipeline layout, which is
+    // not compatible with the one the descriptor sets were bound with
+    hasBoundBindings_ = false;
+    isBindingsUpdateRequired_ = true;
+  }
+
   if (lastPipelineBound_ == pipeline) {
     return;
   }
@@ -66,7 +66,7 @@ static_assert(sizeof(Bindings) == 256);
 
 class ResourcesBinder final {
  public:
-  ResourcesBinder(const std::shared_ptr<CommandBuffer>& commandBuffer,
+  ResourcesBinder(VkCommandBuffer cmdBuffer,
                   const VulkanContext& ctx,
                   VkPipelineBindPoint bindPoint);
 
@@ -93,6 +93,11 @@ class ResourcesBinder final {
   VkPipeline lastPipelineBound_ = VK_NULL_HANDLE;
   bool isBindingsUpdateRequired_ = true;
   Bindings bindings_;
+  // the bindings which were uploaded into a DUB and bound to `cmdBuffer_` last
+  bool hasBoundBindings_ = false;
+  Bindings boundBindings_;
+  // VulkanContext::bindlessGeneration_ when the bindings were bound last
+  uint32_t boundBindlessGeneration_ = 0;
   VkPipelineBindPoint bindPoint_ = VK_PIPELINE_BIND_POINT_GRAPHICS;
 };
 
@@ -27,17 +27,25 @@ uint32_t SyncManager::maxResourceCount() const noexcept {
   return maxResourceCount_;
 }
 
+uint64_t SyncManager::frameNumber() const noexcept {
+  return frameNumber_;
+}
+
 void SyncManager::acquireNext() noexcept {
   currentIndex_ = (currentIndex_ + 1) % maxResourceCount_;
+  frameNumber_++;
 
   // Wait for the current buffer to become available
   ctx_.immediate_->wait(submitHandles_[currentIndex_]);
 }
 
-void SyncManager::markSubmit(SubmitHandle handle) noexcept {
+void SyncManager::markSubmit(SubmitHandle handle, bool endOfFrame) noexcept {
+  // submits complete in order, so the last one is enough to know when the frame is done
   submitHandles_[currentIndex_] = handle;
 
-  acquireNext();
+  if (endOfFrame) {
+    acquireNext();
+  }
 }
 
 } // namespace igl::vulkan
@@ -17,6 +17,9 @@ namespace vulkan {
 
 class VulkanContext;
 
+/// @brief Paces the CPU so that it records at most `maxResourceCount` frames ahead of the GPU.
+/// Every frame in flight owns one slot of the ring buffers; the slot of a frame can be reused once
+/// the last command buffer submitted in that frame has completed.
 class SyncManager final {
  public:
   using SubmitHandle = VulkanImmediateCommands::SubmitHandle;
@@ -27,14 +30,20 @@ class SyncManager final {
 
   [[nodiscard]] uint32_t maxResourceCount() const noexcept;
 
+  /// @brief The number of frames started so far. The slot currentIndex() belongs to this frame
+  [[nodiscard]] uint64_t frameNumber() const noexcept;
+
   void acquireNext() noexcept;
 
-  void markSubmit(SubmitHandle handle) noexcept;
+  /// @brief Records a submitted command buffer. The next frame is started (waiting for its slot to
+  /// become available) only if the command buffer ends the current frame
+  void markSubmit(SubmitHandle handle, bool endOfFrame) noexcept;
 
  private:
   const VulkanContext& ctx_;
   const uint32_t maxResourceCount_ = 1u;
   uint32_t currentIndex_ = 0u;
+  uint64_t frameNumber_ = 0u;
   std::vector<SubmitHandle> submitHandles_;
 };
 
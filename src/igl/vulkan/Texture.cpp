@@ -181,6 +181,24 @@ Result Texture::create(const TextureDesc& desc) {
 }
 
 Result Texture::upload(const TextureRangeDesc& range, const void* data, size_t bytesPerRow) const {
+  return uploadInternal(range, data, bytesPerRow, false, nullptr);
+}
+
+UploadHandle Texture::uploadAsync(const TextureRangeDesc& range,
+                                  const void* data,
+                                  size_t bytesPerRow,
+                                  Result* outResult) const {
+  UploadHandle handle;
+  const Result result = uploadInternal(range, data, bytesPerRow, true, &handle);
+  Result::setResult(outResult, result);
+  return handle;
+}
+
+Result Texture::uploadInternal(const TextureRangeDesc& range,
+                               const void* data,
+                               size_t bytesPerRow,
+                               bool nonBlocking,
+                               UploadHandle* outHandle) const {
   if (!data) {
     return igl::Result();
   }
@@ -229,25 +247,33 @@ Result Texture::upload(const TextureRangeDesc& range, const void* data, size_t b
 
     const VkImageType type = texture_->getVulkanImage().type_;
 
+    VulkanStagingDevice::SubmitHandle handle;
+
     if (type == VK_IMAGE_TYPE_3D) {
-      ctx.stagingDevice_->imageData3D(
+      handle = ctx.stagingDevice_->imageData3D(
           texture_->getVulkanImage(),
           VkOffset3D{(int32_t)range.x, (int32_t)range.y, (int32_t)range.z},
           VkExtent3D{(uint32_t)range.width, (uint32_t)range.height, (uint32_t)range.depth},
           getProperties(),
           getVkFormat(),
-          uploadData);
+          uploadData,
+          nonBlocking);
     } else {
       const VkRect2D imageRegion = ivkGetRect2D(
           (uint32_t)range.x, (uint32_t)range.y, (uint32_t)range.width, (uint32_t)range.height);
-      ctx.stagingDevice_->imageData2D(texture_->getVulkanImage(),
-                                      imageRegion,
-                                      (uint32_t)range.mipLevel,
-                                      (uint32_t)range.numMipLevels,
-                                      (uint32_t)range.layer + i,
-                                      getProperties(),
-                                      getVkFormat(),
-                                      uploadData);
+      handle = ctx.stagingDevice_->imageData2D(texture_->getVulkanImage(),
+                                               imageRegion,
+                                               (uint32_t)range.mipLevel,
+                                               (uint32_t)range.numMipLevels,
+                                               (uint32_t)range.layer + i,
+                                               getProperties(),
+                                               getVkFormat(),
+                                               uploadData,
+                                               nonBlocking);
+    }
+
+    if (outHandle) {
+      *outHandle = UploadHandle{handle.handle()};
     }
 
     data = static_cast<const uint8_t*>(data) + byteIncrement;
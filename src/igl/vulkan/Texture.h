@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <igl/CommandQueue.h>
 #include <igl/Common.h>
 #include <igl/Framebuffer.h>
 #include <igl/Texture.h>
@@ -45,6 +46,14 @@ class Texture final : public ITexture {
                     const void* data,
                     size_t bytesPerRow = 0) const override;
 
+  /// Never waits for the GPU to free up the staging memory. The returned handle belongs to the
+  /// staging device and can be queried with PlatformDevice::isUploadComplete() or waited on with
+  /// PlatformDevice::waitOnUpload()
+  UploadHandle uploadAsync(const TextureRangeDesc& range,
+                           const void* data,
+                           size_t bytesPerRow = 0,
+                           Result* outResult = nullptr) const override;
+
   // Accessors
   Dimensions getDimensions() const override;
   size_t getNumLayers() const override;
@@ -71,6 +80,11 @@ class Texture final : public ITexture {
 
  private:
   Result create(const TextureDesc& desc);
+  Result uploadInternal(const TextureRangeDesc& range,
+                        const void* data,
+                        size_t bytesPerRow,
+                        bool nonBlocking,
+                        UploadHandle* outHandle) const;
 
  protected:
   const igl::vulkan::Device& device_;
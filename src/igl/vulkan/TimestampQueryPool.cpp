@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/vulkan/TimestampQueryPool.h>
+
+#include <igl/vulkan/VulkanContext.h>
+#include <vector>
+
+namespace igl {
+namespace vulkan {
+
+TimestampQueryPool::TimestampQueryPool(const VulkanContext& ctx,
+                                       uint32_t queryCount,
+                                       uint32_t timestampValidBits,
+                                       const char* debugName) :
+  ctx_(ctx),
+  queryCount_(queryCount),
+  validBitsMask_(timestampValidBits >= 64 ? ~0ull : (1ull << timestampValidBits) - 1),
+  timestampPeriod_(ctx.getVkPhysicalDeviceProperties().limits.timestampPeriod) {
+  IGL_PROFILER_FUNCTION_COLOR(IGL_PROFILER_COLOR_CREATE);
+
+  IGL_ASSERT(queryCount_ > 0);
+  IGL_ASSERT(timestampValidBits > 0);
+
+  VkQueryPoolCreateInfo ci = {};
+  ci.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+  ci.queryType = VK_QUERY_TYPE_TIMESTAMP;
+  ci.queryCount = queryCount_;
+
+  const VkDevice device = ctx_.getVkDevice();
+
+  VK_ASSERT(vkCreateQueryPool(device, &ci, nullptr, &vkQueryPool_));
+  VK_ASSERT(ivkSetDebugObjectName(
+      device, VK_OBJECT_TYPE_QUERY_POOL, (uint64_t)vkQueryPool_, debugName));
+}
+
+TimestampQueryPool::~TimestampQueryPool() {
+  IGL_PROFILER_FUNCTION_COLOR(IGL_PROFILER_COLOR_DESTROY);
+
+  ctx_.deferredTask(std::packaged_task<void()>(
+      [device = ctx_.getVkDevice(), queryPool = vkQueryPool_]() {
+        vkDestroyQueryPool(device, queryPool, nullptr);
+      }));
+}
+
+uint32_t TimestampQueryPool::getQueryCount() const {
+  return queryCount_;
+}
+
+bool TimestampQueryPool::getResults(uint32_t firstQuery,
+                                    uint32_t queryCount,
+                                    uint64_t* outTimestampsNs) const {
+  if (!IGL_VERIFY(outTimestampsNs && firstQuery + queryCount <= queryCount_)) {
+    return false;
+  }
+  if (queryCount == 0) {
+    return true;
+  }
+
+  std::vector<uint64_t> timestamps(queryCount);
+
+  // no VK_QUERY_RESULT_WAIT_BIT: never stall the CPU waiting for the GPU
+  const VkResult result = vkGetQueryPoolResults(ctx_.getVkDevice(),
+                                                vkQueryPool_,
+                                                firstQuery,
+                                                queryCount,
+                                                timestamps.size() * sizeof(uint64_t),
+                                                timestamps.data(),
+                                                sizeof(uint64_t),
+                                                VK_QUERY_RESULT_64_BIT);
+  if (result == VK_NOT_READY) {
+    return false;
+  }
+  if (!IGL_VERIFY(result == VK_SUCCESS)) {
+    return false;
+  }
+
+  for (uint32_t i = 0; i != queryCount; i++) {
+    outTimestampsNs[i] =
+        static_cast<uint64_t>(static_cast<double>(timestamps[i] & validBitsMask_) *
+                              timestampPeriod_);
+  }
+
+  return true;
+}
+
+void TimestampQueryPool::reset(VkCommandBuffer cmdBuf) {
+  vkCmdResetQueryPool(cmdBuf, vkQueryPool_, 0, queryCount_);
+  resetScopes();
+}
+
+void TimestampQueryPool::writeTimestamp(VkCommandBuffer cmdBuf,
+                                        VkPipelineStageFlagBits stage,
+                                        uint32_t query) const {
+  if (!IGL_VERIFY(query < queryCount_)) {
+    return;
+  }
+  vkCmdWriteTimestamp(cmdBuf, stage, vkQueryPool_, query);
+}
+
+} // namespace vulkan
+} // namespace igl
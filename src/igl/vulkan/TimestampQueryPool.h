@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <igl/TimestampQueryPool.h>
+#include <igl/vulkan/Common.h>
+
+namespace igl {
+namespace vulkan {
+
+class VulkanContext;
+
+/**
+ * @brief Encapsulates a VkQueryPool of type VK_QUERY_TYPE_TIMESTAMP
+ */
+class TimestampQueryPool final : public ITimestampQueryPool {
+ public:
+  /**
+   * @brief Creates a pool with `queryCount` timestamp queries. `timestampValidBits` is the number
+   * of valid bits in the timestamps written by the queue the pool is used with.
+   */
+  TimestampQueryPool(const VulkanContext& ctx,
+                     uint32_t queryCount,
+                     uint32_t timestampValidBits,
+                     const char* debugName = nullptr);
+  ~TimestampQueryPool() override;
+
+  TimestampQueryPool(const TimestampQueryPool&) = delete;
+  TimestampQueryPool& operator=(const TimestampQueryPool&) = delete;
+
+  [[nodiscard]] uint32_t getQueryCount() const override;
+  [[nodiscard]] bool getResults(uint32_t firstQuery,
+                                uint32_t queryCount,
+                                uint64_t* outTimestampsNs) const override;
+
+  /**
+   * @brief Resets all queries of the pool and forgets all recorded scopes. Must be recorded before
+   * any timestamps are written into the pool.
+   */
+  void reset(VkCommandBuffer cmdBuf);
+  void writeTimestamp(VkCommandBuffer cmdBuf, VkPipelineStageFlagBits stage, uint32_t query) const;
+
+  VkQueryPool getVkQueryPool() const {
+    return vkQueryPool_;
+  }
+
+ private:
+  const VulkanContext& ctx_;
+  VkQueryPool vkQueryPool_ = VK_NULL_HANDLE;
+  uint32_t queryCount_ = 0;
+  uint64_t validBitsMask_ = 0;
+  // nanoseconds per timestamp tick
+  double timestampPeriod_ = 1.0;
+};
+
+} // namespace vulkan
+} // namespace igl
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/vulkan/TransientAllocator.h>
+
+#include <algorithm>
+#include <string>
+
+#include <igl/vulkan/Buffer.h>
+#include <igl/vulkan/Device.h>
+#include <igl/vulkan/SyncManager.h>
+#include <igl/vulkan/VulkanContext.h>
+
+namespace igl {
+namespace vulkan {
+
+TransientAllocator::TransientAllocator(const Device& device, size_t bufferSize) :
+  device_(device), bufferSize_(bufferSize) {
+  const VulkanContext& ctx = device_.getVulkanContext();
+  const VkPhysicalDeviceLimits& limits = ctx.getVkPhysicalDeviceProperties().limits;
+
+  // allocations can be bound as uniform and storage buffers and accessed via buffer device
+  // addresses, which have to be 8 bytes aligned
+  alignment_ = std::max<size_t>({alignment_,
+                                 static_cast<size_t>(limits.minUniformBufferOffsetAlignment),
+                                 static_cast<size_t>(limits.minStorageBufferOffsetAlignment)});
+
+  frames_.resize(ctx.syncManager_->maxResourceCount());
+}
+
+TransientAllocation TransientAllocator::allocate(BufferDesc::BufferType type,
+                                                 size_t size,
+                                                 Result* outResult) {
+  IGL_PROFILER_FUNCTION();
+
+  if (type == 0 || size == 0) {
+    Result::setResult(outResult, Result::Code::ArgumentInvalid, "Invalid type or size");
+    return {};
+  }
+
+  const SyncManager& syncManager = *device_.getVulkanContext().syncManager_;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  Frame& frame = frames_[syncManager.currentIndex()];
+
+  if (frame.frameNumber != syncManager.frameNumber()) {
+    beginFrame(frame, syncManager.frameNumber());
+  }
+
+  for (;;) {
+    if (frame.currentPage == frame.pages.size()) {
+      Page page;
+      page.size = std::max(bufferSize_, size);
+      Result result;
+      auto buffer = device_.createBuffer(
+          BufferDesc(BufferDesc::BufferTypeBits::Index | BufferDesc::BufferTypeBits::Vertex |
+                         BufferDesc::BufferTypeBits::Uniform |
+                         BufferDesc::BufferTypeBits::Storage,
+                     nullptr,
+                     page.size,
+                     ResourceStorage::Shared,
+                     0,
+                     "Buffer: transient " + std::to_string(frame.pages.size())),
+          &result);
+      if (!IGL_VERIFY(result.isOk())) {
+        Result::setResult(outResult, std::move(result));
+        return {};
+      }
+      page.data = static_cast<Buffer&>(*buffer).getMappedPtr();
+      IGL_ASSERT(page.data);
+      page.buffer = std::move(buffer);
+      frame.pages.push_back(std::move(page));
+    }
+
+    const Page& page = frame.pages[frame.currentPage];
+    const size_t offset = (frame.offset + alignment_ - 1) & ~(alignment_ - 1);
+
+    if (offset + size <= page.size) {
+      frame.offset = offset + size;
+      Result::setOk(outResult);
+      return TransientAllocation{page.data + offset, page.buffer, offset, size};
+    }
+
+    // continue in the next buffer
+    frame.currentPage++;
+    frame.offset = 0;
+  }
+}
+
+void TransientAllocator::beginFrame(Frame& frame, uint64_t frameNumber) {
+  const VulkanContext& ctx = device_.getVulkanContext();
+
+  if (activeFrame_) {
+    // every command buffer which existed during the previous frame is either still being encoded
+    // or has been submitted no later than the last submit
+    activeFrame_->handles = ctx.immediate_->getEncodingSubmitHandles();
+    activeFrame_->handles.push_back(ctx.immediate_->getLastSubmitHandle());
+  }
+  activeFrame_ = &frame;
+
+  while (!retiredPages_.empty() && isReady(retiredPages_.front().handles)) {
+    retiredPages_.pop_front();
+  }
+
+  if (!isReady(frame.handles)) {
+    // a command buffer which might access the previous allocations of this slot is still pending
+    retiredPages_.push_back(RetiredPages{std::move(frame.pages), std::move(frame.handles)});
+    frame.pages.clear();
+  } else if (frame.frameNumber != UINT64_MAX && frame.currentPage + 1 < frame.pages.size()) {
+    // release the buffers which the previous frame of this slot did not need
+    frame.pages.resize(frame.currentPage + 1);
+  }
+
+  frame.frameNumber = frameNumber;
+  frame.handles.clear();
+  frame.currentPage = 0;
+  frame.offset = 0;
+}
+
+bool TransientAllocator::isReady(const std::vector<SubmitHandle>& handles) const {
+  const VulkanContext& ctx = device_.getVulkanContext();
+
+  for (const SubmitHandle& handle : handles) {
+    if (!ctx.immediate_->isReady(handle)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+size_t TransientAllocator::getNumPages() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  size_t numPages = 0;
+  for (const Frame& frame : frames_) {
+    numPages += frame.pages.size();
+  }
+
+  return numPages;
+}
+
+} // namespace vulkan
+} // namespace igl
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <igl/Buffer.h>
+#include <igl/vulkan/Common.h>
+#include <igl/vulkan/VulkanImmediateCommands.h>
+
+namespace igl {
+namespace vulkan {
+
+class Device;
+
+/// @brief Linear allocator behind Device::allocateTransient(). Every frame in flight owns a list of
+/// persistently mapped host-visible buffers; allocations bump a pointer through them. When a frame
+/// slot is reused (see SyncManager), its buffers are reused from the beginning once all command
+/// buffers which might access them have completed; like the DUBs, these include the command
+/// buffers which were still being encoded when the frame ended. Otherwise, the buffers are retired
+/// and the slot starts with new ones. A slot keeps only as many buffers as its previous frame used,
+/// so the memory shrinks again after a spike. Thread-safe
+class TransientAllocator final {
+ public:
+  TransientAllocator(const Device& device, size_t bufferSize);
+
+  TransientAllocation allocate(BufferDesc::BufferType type, size_t size, Result* outResult);
+
+  /// @brief The number of buffers owned by all frame slots, excluding the retired ones
+  size_t getNumPages() const;
+
+ private:
+  using SubmitHandle = VulkanImmediateCommands::SubmitHandle;
+
+  struct Page {
+    std::shared_ptr<IBuffer> buffer;
+    uint8_t* data = nullptr;
+    size_t size = 0;
+  };
+  struct Frame {
+    uint64_t frameNumber = UINT64_MAX;
+    std::vector<Page> pages;
+    size_t currentPage = 0;
+    size_t offset = 0;
+    // the command buffers which might access the allocations of this frame
+    std::vector<SubmitHandle> handles;
+  };
+  // buffers of a reused frame slot which command buffers might still access
+  struct RetiredPages {
+    std::vector<Page> pages;
+    std::vector<SubmitHandle> handles;
+  };
+
+  void beginFrame(Frame& frame, uint64_t frameNumber);
+  bool isReady(const std::vector<SubmitHandle>& handles) const;
+
+  const Device& device_;
+  const size_t bufferSize_;
+  size_t alignment_ = 16;
+
+  mutable std::mutex mutex_;
+  std::vector<Frame> frames_;
+  // the frame slot of the most recent allocation
+  Frame* activeFrame_ = nullptr;
+  std::deque<RetiredPages> retiredPages_;
+};
+
+} // namespace vulkan
+} // namespace igl
@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/vulkan/VulkanBufferArena.h>
+
+#include <future>
+#include <iterator>
+#include <map>
+#include <utility>
+
+#include <igl/vulkan/VulkanBuffer.h>
+#include <igl/vulkan/VulkanContext.h>
+
+namespace igl {
+namespace vulkan {
+
+struct VulkanBufferArena::Page {
+  std::shared_ptr<VulkanBuffer> buffer;
+  VkMemoryPropertyFlags memFlags = 0;
+
+  // guards `freeRanges`, which are also returned by deferred tasks
+  std::mutex mutex;
+  // offset -> size; adjacent ranges are always merged
+  std::map<VkDeviceSize, VkDeviceSize> freeRanges;
+
+  bool allocate(VkDeviceSize size, VkDeviceSize& outOffset) {
+    std::lock_guard<std::mutex> lock(mutex);
+    // first fit: all sizes are multiples of the alignment, so all offsets are aligned
+    for (auto it = freeRanges.begin(); it != freeRanges.end(); ++it) {
+      if (it->second < size) {
+        continue;
+      }
+      outOffset = it->first;
+      const VkDeviceSize remaining = it->second - size;
+      freeRanges.erase(it);
+      if (remaining) {
+        freeRanges.emplace(outOffset + size, remaining);
+      }
+      return true;
+    }
+    return false;
+  }
+
+  void release(VkDeviceSize offset, VkDeviceSize size) {
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto result = freeRanges.emplace(offset, size);
+    IGL_ASSERT_MSG(result.second, "Range released twice");
+    auto it = result.first;
+    // merge with the next range
+    const auto next = std::next(it);
+    if (next != freeRanges.end() && it->first + it->second == next->first) {
+      it->second += next->second;
+      freeRanges.erase(next);
+    }
+    // merge with the previous range
+    if (it != freeRanges.begin()) {
+      const auto prev = std::prev(it);
+      if (prev->first + prev->second == it->first) {
+        prev->second += it->second;
+        freeRanges.erase(it);
+      }
+    }
+  }
+
+  bool isEmpty() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return freeRanges.size() == 1 && freeRanges.begin()->second == buffer->getSize();
+  }
+};
+
+VulkanBufferArena::VulkanBufferArena(const VulkanContext& ctx,
+                                     VkDeviceSize pageSize,
+                                     VkDeviceSize alignment) :
+  ctx_(ctx), pageSize_(pageSize), alignment_(alignment) {
+  IGL_ASSERT(pageSize_ > 0);
+  IGL_ASSERT_MSG(alignment_ && (alignment_ & (alignment_ - 1)) == 0,
+                 "The alignment should be a power of two");
+}
+
+VulkanBufferArena::~VulkanBufferArena() {
+  // pending releases hold only weak references to their pages
+  pages_.clear();
+}
+
+VkBufferUsageFlags VulkanBufferArena::getUsageFlags() {
+  return VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT |
+         VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT |
+         VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT_KHR;
+}
+
+VulkanBufferArena::Allocation VulkanBufferArena::allocate(VkDeviceSize size,
+                                                          VkMemoryPropertyFlags memFlags,
+                                                          Result* outResult) {
+  IGL_PROFILER_FUNCTION();
+
+  Allocation allocation;
+
+  if (!IGL_VERIFY(size > 0 && size <= pageSize_)) {
+    Result::setResult(
+        outResult, Result::Code::ArgumentOutOfRange, "The size does not fit into an arena page");
+    return allocation;
+  }
+
+  const VkDeviceSize alignedSize = (size + alignment_ - 1) & ~(alignment_ - 1);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  for (const auto& page : pages_) {
+    if (page->memFlags == memFlags && page->allocate(alignedSize, allocation.offset)) {
+      allocation.page = page;
+      break;
+    }
+  }
+
+  if (!allocation.page) {
+    auto page = std::make_shared<Page>();
+    page->buffer = std::make_shared<VulkanBuffer>(
+        ctx_,
+        ctx_.getVkDevice(),
+        pageSize_,
+        getUsageFlags(),
+        memFlags,
+        IGL_FORMAT("Buffer: arena page {}", pages_.size()).c_str());
+    page->memFlags = memFlags;
+    page->freeRanges.emplace(0, pageSize_);
+    const bool allocated = page->allocate(alignedSize, allocation.offset);
+    IGL_ASSERT(allocated);
+    (void)allocated;
+    pages_.push_back(page);
+    allocation.page = std::move(page);
+  }
+
+  // first fit fills the pages in order, so empty pages pile up at the end of the list: keep one of
+  // them around to avoid recreating a page every time a few buffers are destroyed and created again
+  bool keepEmptyPage = true;
+  for (auto it = pages_.begin(); it != pages_.end();) {
+    const auto& page = *it;
+    if (page == allocation.page || page->memFlags != memFlags || !page->isEmpty()) {
+      ++it;
+    } else if (keepEmptyPage) {
+      keepEmptyPage = false;
+      ++it;
+    } else {
+      it = pages_.erase(it);
+    }
+  }
+
+  allocation.buffer = allocation.page->buffer;
+  allocation.size = size;
+
+  Result::setOk(outResult);
+
+  return allocation;
+}
+
+void VulkanBufferArena::release(Allocation&& allocation) const {
+  if (!allocation.page) {
+    return;
+  }
+
+  const VkDeviceSize alignedSize = (allocation.size + alignment_ - 1) & ~(alignment_ - 1);
+
+  ctx_.deferredTask(std::packaged_task<void()>(
+      [page = std::weak_ptr<Page>(allocation.page), offset = allocation.offset, alignedSize]() {
+        if (auto p = page.lock()) {
+          p->release(offset, alignedSize);
+        }
+      }));
+
+  allocation = Allocation();
+}
+
+size_t VulkanBufferArena::getNumPages() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return pages_.size();
+}
+
+} // namespace vulkan
+} // namespace igl
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <igl/vulkan/Common.h>
+
+namespace igl {
+namespace vulkan {
+
+class VulkanBuffer;
+class VulkanContext;
+
+/// @brief Sub-allocates small buffers from large shared VkBuffers ("pages"), so that many small
+/// vertex, index and uniform buffers do not each need their own VkBuffer and memory allocation.
+/// Pages are created on demand, one set per memory property flags, and are released once they do
+/// not contain any allocations anymore.
+///
+/// Allocations are released with a delay, after the command buffers submitted before the release
+/// have completed, so that the GPU does not see their memory being reused.
+class VulkanBufferArena final {
+ private:
+  struct Page;
+
+ public:
+  struct Allocation {
+    /// The shared buffer of the page this allocation belongs to
+    std::shared_ptr<VulkanBuffer> buffer;
+    VkDeviceSize offset = 0;
+    VkDeviceSize size = 0;
+
+   private:
+    friend class VulkanBufferArena;
+    std::shared_ptr<Page> page;
+  };
+
+  /// @param pageSize The size of the shared buffers
+  /// @param alignment The alignment of all allocations. Must be a power of two
+  VulkanBufferArena(const VulkanContext& ctx, VkDeviceSize pageSize, VkDeviceSize alignment);
+  ~VulkanBufferArena();
+
+  VulkanBufferArena(const VulkanBufferArena&) = delete;
+  VulkanBufferArena& operator=(const VulkanBufferArena&) = delete;
+
+  /// @brief Returns a range of `size` bytes in a page whose memory has the properties `memFlags`.
+  /// Sizes larger than the page size cannot be sub-allocated. Thread-safe
+  Allocation allocate(VkDeviceSize size, VkMemoryPropertyFlags memFlags, Result* outResult);
+
+  /// @brief Returns the range to its page once the GPU is done with the command buffers which were
+  /// submitted so far
+  void release(Allocation&& allocation) const;
+
+  /// @brief The usage flags of the shared buffers
+  static VkBufferUsageFlags getUsageFlags();
+
+  VkDeviceSize getPageSize() const {
+    return pageSize_;
+  }
+  size_t getNumPages() const;
+
+ private:
+  const VulkanContext& ctx_;
+  const VkDeviceSize pageSize_;
+  const VkDeviceSize alignment_;
+  mutable std::mutex mutex_;
+  std::vector<std::shared_ptr<Page>> pages_;
+};
+
+} // namespace vulkan
+} // namespace igl
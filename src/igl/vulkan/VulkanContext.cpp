@@ -5,8 +5,10 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <algorithm>
 #include <array>
 #include <cstring>
+#include <numeric>
 #include <set>
 #include <vector>
 
@@ -44,8 +46,15 @@
 
 namespace {
 
-const uint32_t kMaxDynamicUniformBuffers = 128;
+// the ring of dynamic uniform buffers holds this many buffers per frame in flight
+const uint32_t kDynamicUniformBuffersPerFrame = 48;
 const uint32_t kBindPoint_Bindless = 0;
+// maxPushConstantsSize is guaranteed to be at least 128 bytes
+const uint32_t kPushConstantsSize = 128;
+
+uint32_t getNumDynamicUniformBuffers(const igl::vulkan::VulkanContextConfig& config) {
+  return std::max(config.maxResourceCount, 1u) * kDynamicUniformBuffersPerFrame;
+}
 
 /*
  These bindings should match GLSL declarations injected into shaders in
@@ -223,6 +232,9 @@ VulkanContext::VulkanContext(const VulkanContextConfig& config,
 VulkanContext::~VulkanContext() {
   IGL_PROFILER_FUNCTION();
 
+  // run the remaining background tasks while everything they use is alive
+  workerPool_.reset(nullptr);
+
   if (device_) {
     waitIdle();
   }
@@ -234,6 +246,7 @@ VulkanContext::~VulkanContext() {
 
   // This will free an internal buffer that was allocated by VMA
   stagingDevice_.reset(nullptr);
+  bufferArena_.reset(nullptr);
 
   VkDevice device = device_ ? device_->getVkDevice() : VK_NULL_HANDLE;
   if (device_) {
@@ -247,16 +260,27 @@ VulkanContext::~VulkanContext() {
   dslBindless_.reset(nullptr);
   pipelineLayoutGraphics_.reset(nullptr);
   pipelineLayoutCompute_.reset(nullptr);
+  retiredBindlessLayouts_.clear();
+  retiredPipelineLayouts_.clear();
   swapchain_.reset(nullptr); // Swapchain has to be destroyed prior to Surface
 
   waitDeferredTasks();
 
   immediate_.reset(nullptr);
+  secondaryCommandBuffers_.reset(nullptr);
+
+  // saves the pipeline cache to disk
+  pipelineCache_.reset(nullptr);
+  pipelineLibraries_.reset(nullptr);
 
   if (device_) {
-    vkDestroyDescriptorPool(device, dpDynamicUniformBuffer_, nullptr);
+    for (VkDescriptorPool pool : dpDynamicUniformBuffers_) {
+      vkDestroyDescriptorPool(device, pool, nullptr);
+    }
     vkDestroyDescriptorPool(device, dpBindless_, nullptr);
-    vkDestroyPipelineCache(device, pipelineCache_, nullptr);
+    for (const auto& retired : retiredBindlessDescriptorPools_) {
+      vkDestroyDescriptorPool(device, retired.pool, nullptr);
+    }
   }
 
   vkDestroySurfaceKHR(vkInstance_, vkSurface_, nullptr);
@@ -422,6 +446,84 @@ igl::Result VulkanContext::initContext(const HWDeviceDesc& desc,
     extensions_.enable(extraDeviceExtensions[i], VulkanExtensions::ExtensionType::Device);
   }
 
+#if defined(VK_EXT_vertex_attribute_divisor)
+  if (extensions_.enabled(VK_EXT_VERTEX_ATTRIBUTE_DIVISOR_EXTENSION_NAME)) {
+    VkPhysicalDeviceVertexAttributeDivisorFeaturesEXT divisorFeatures = {
+        VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VERTEX_ATTRIBUTE_DIVISOR_FEATURES_EXT, nullptr};
+    VkPhysicalDeviceFeatures2 features = {VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
+                                          &divisorFeatures};
+    vkGetPhysicalDeviceFeatures2(vkPhysicalDevice_, &features);
+    hasVertexAttributeDivisor_ = divisorFeatures.vertexAttributeInstanceRateDivisor == VK_TRUE;
+  }
+#endif // VK_EXT_vertex_attribute_divisor
+
+#if defined(VK_KHR_dynamic_rendering)
+  if (config_.enableDynamicRendering &&
+      extensions_.enable(VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME,
+                         VulkanExtensions::ExtensionType::Device)) {
+    // dependencies of VK_KHR_dynamic_rendering which are core in Vulkan 1.2
+    extensions_.enable(VK_KHR_CREATE_RENDERPASS_2_EXTENSION_NAME,
+                       VulkanExtensions::ExtensionType::Device);
+    extensions_.enable(VK_KHR_DEPTH_STENCIL_RESOLVE_EXTENSION_NAME,
+                       VulkanExtensions::ExtensionType::Device);
+    VkPhysicalDeviceDynamicRenderingFeaturesKHR dynamicRenderingFeatures = {
+        VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR, nullptr};
+    VkPhysicalDeviceFeatures2 features = {VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
+                                          &dynamicRenderingFeatures};
+    vkGetPhysicalDeviceFeatures2(vkPhysicalDevice_, &features);
+    useDynamicRendering_ = dynamicRenderingFeatures.dynamicRendering == VK_TRUE;
+  }
+#endif // VK_KHR_dynamic_rendering
+
+#if defined(VK_EXT_extended_dynamic_state)
+  if (config_.enableExtendedDynamicState &&
+      extensions_.enable(VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME,
+                         VulkanExtensions::ExtensionType::Device)) {
+    VkPhysicalDeviceExtendedDynamicStateFeaturesEXT extendedDynamicStateFeatures = {
+        VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_FEATURES_EXT, nullptr};
+    VkPhysicalDeviceFeatures2 features = {VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
+                                          &extendedDynamicStateFeatures};
+    vkGetPhysicalDeviceFeatures2(vkPhysicalDevice_, &features);
+    hasExtendedDynamicState_ = extendedDynamicStateFeatures.extendedDynamicState == VK_TRUE;
+  }
+#endif // VK_EXT_extended_dynamic_state
+
+#if defined(VK_EXT_extended_dynamic_state2)
+  if (hasExtendedDynamicState_ &&
+      extensions_.enable(VK_EXT_EXTENDED_DYNAMIC_STATE_2_EXTENSION_NAME,
+                         VulkanExtensions::ExtensionType::Device)) {
+    VkPhysicalDeviceExtendedDynamicState2FeaturesEXT extendedDynamicState2Features = {
+        VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_2_FEATURES_EXT, nullptr};
+    VkPhysicalDeviceFeatures2 features = {VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
+                                          &extendedDynamicState2Features};
+    vkGetPhysicalDeviceFeatures2(vkPhysicalDevice_, &features);
+    hasExtendedDynamicState2_ = extendedDynamicState2Features.extendedDynamicState2 == VK_TRUE;
+  }
+#endif // VK_EXT_extended_dynamic_state2
+
+  bool hasGraphicsPipelineLibrary = false;
+#if defined(VK_EXT_graphics_pipeline_library)
+  if (config_.enableGraphicsPipelineLibrary &&
+      extensions_.enable(VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME,
+                         VulkanExtensions::ExtensionType::Device) &&
+      extensions_.enable(VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME,
+                         VulkanExtensions::ExtensionType::Device)) {
+    VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT libraryFeatures = {
+        VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_FEATURES_EXT, nullptr};
+    VkPhysicalDeviceFeatures2 features = {VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
+                                          &libraryFeatures};
+    vkGetPhysicalDeviceFeatures2(vkPhysicalDevice_, &features);
+    VkPhysicalDeviceGraphicsPipelineLibraryPropertiesEXT libraryProperties = {
+        VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_PROPERTIES_EXT, nullptr};
+    VkPhysicalDeviceProperties2 properties = {VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2,
+                                              &libraryProperties};
+    vkGetPhysicalDeviceProperties2(vkPhysicalDevice_, &properties);
+    // without fast linking, monolithic pipelines are not slower to create
+    hasGraphicsPipelineLibrary = libraryFeatures.graphicsPipelineLibrary == VK_TRUE &&
+                                 libraryProperties.graphicsPipelineLibraryFastLinking == VK_TRUE;
+  }
+#endif // VK_EXT_graphics_pipeline_library
+
   VulkanQueuePool queuePool(vkPhysicalDevice_);
 
   // Reserve IGL Vulkan queues
@@ -466,6 +568,22 @@ igl::Result VulkanContext::initContext(const HWDeviceDesc& desc,
     queuePool.reserveQueue(descriptor);
   }
 
+  // Reserve a dedicated transfer queue for the staging device. Prefer transfer-only queue families
+  // (DMA engines) and fall back to any non-graphics queue family supporting transfers
+  if (config_.enableDedicatedTransferQueue) {
+    auto transferQueueDescriptor = queuePool.findDedicatedQueueDescriptor(
+        VK_QUEUE_TRANSFER_BIT, VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT);
+    if (!transferQueueDescriptor.isValid()) {
+      transferQueueDescriptor =
+          queuePool.findDedicatedQueueDescriptor(VK_QUEUE_TRANSFER_BIT, VK_QUEUE_GRAPHICS_BIT);
+    }
+    if (transferQueueDescriptor.isValid()) {
+      deviceQueues_.transferQueueFamilyIndex = transferQueueDescriptor.familyIndex;
+      deviceQueues_.transferQueueIndex = transferQueueDescriptor.queueIndex;
+      queuePool.reserveQueue(transferQueueDescriptor);
+    }
+  }
+
   const auto qcis = queuePool.getQueueCreationInfos();
 
   VkDevice device;
@@ -477,6 +595,13 @@ igl::Result VulkanContext::initContext(const HWDeviceDesc& desc,
                       extensions_.allEnabled(VulkanExtensions::ExtensionType::Device).data(),
                       vkPhysicalDeviceMultiviewFeatures_.multiview,
                       vkPhysicalDeviceShaderFloat16Int8Features_.shaderFloat16,
+                      vkPhysicalDeviceFeatures2_.features.occlusionQueryPrecise,
+                      vkPhysicalDeviceFeatures2_.features.pipelineStatisticsQuery,
+                      hasVertexAttributeDivisor_ ? VK_TRUE : VK_FALSE,
+                      useDynamicRendering_ ? VK_TRUE : VK_FALSE,
+                      hasExtendedDynamicState_ ? VK_TRUE : VK_FALSE,
+                      hasExtendedDynamicState2_ ? VK_TRUE : VK_FALSE,
+                      hasGraphicsPipelineLibrary ? VK_TRUE : VK_FALSE,
                       &device));
   if (!config_.enableConcurrentVkDevicesSupport) {
     volkLoadDevice(device);
@@ -484,24 +609,39 @@ igl::Result VulkanContext::initContext(const HWDeviceDesc& desc,
 
   vkGetDeviceQueue(device, deviceQueues_.graphicsQueueFamilyIndex, 0, &deviceQueues_.graphicsQueue);
   vkGetDeviceQueue(device, deviceQueues_.computeQueueFamilyIndex, 0, &deviceQueues_.computeQueue);
+  if (deviceQueues_.transferQueueFamilyIndex != DeviceQueues::INVALID) {
+    vkGetDeviceQueue(device,
+                     deviceQueues_.transferQueueFamilyIndex,
+                     deviceQueues_.transferQueueIndex,
+                     &deviceQueues_.transferQueue);
+  }
 
   device_ = std::make_unique<igl::vulkan::VulkanDevice>(device, "Device: VulkanContext::device_");
   immediate_ = std::make_unique<igl::vulkan::VulkanImmediateCommands>(
       device, deviceQueues_.graphicsQueueFamilyIndex, "VulkanContext::immediate_");
+  secondaryCommandBuffers_ = std::make_unique<igl::vulkan::VulkanSecondaryCommandBuffers>(
+      device, deviceQueues_.graphicsQueueFamilyIndex);
   syncManager_ = std::make_unique<SyncManager>(*this, config_.maxResourceCount);
+  if (config_.enableShaderCache) {
+    shaderCache_ = std::make_unique<igl::vulkan::VulkanShaderCache>(
+        config_.shaderCacheDirectory, config_.shaderCacheMaxEntries);
+  }
 
-  // create Vulkan pipeline cache
-  {
-    const VkPipelineCacheCreateInfo ci = {
-        VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
-        nullptr,
-        VkPipelineCacheCreateFlags(0),
-        config_.pipelineCacheDataSize,
-        config_.pipelineCacheData,
-    };
-    vkCreatePipelineCache(device, &ci, nullptr, &pipelineCache_);
+  pipelineCache_ =
+      std::make_unique<igl::vulkan::VulkanPipelineCache>(device,
+                                                          getVkPhysicalDeviceProperties(),
+                                                          config_.pipelineCacheData,
+                                                          config_.pipelineCacheDataSize,
+                                                          config_.pipelineCacheFile,
+                                                          config_.pipelineCacheSaveInterval);
+
+  if (hasGraphicsPipelineLibrary) {
+    pipelineLibraries_ = std::make_unique<igl::vulkan::VulkanPipelineLibraryCache>(
+        device, config_.pipelineLibraryCacheMaxEntries);
   }
 
+  workerPool_ = std::make_unique<igl::vulkan::WorkerPool>(config_.numWorkerThreads);
+
   // Create Vulkan Memory Allocator
   if (IGL_VULKAN_USE_VMA) {
     VK_ASSERT_RETURN(ivkVmaCreateAllocator(
@@ -512,6 +652,13 @@ igl::Result VulkanContext::initContext(const HWDeviceDesc& desc,
   // to happen after VMA has been initialized.
   stagingDevice_ = std::make_unique<igl::vulkan::VulkanStagingDevice>(*this);
 
+  // sub-allocated buffers can be bound as uniform buffers and accessed via buffer device addresses
+  bufferArena_ = std::make_unique<igl::vulkan::VulkanBufferArena>(
+      *this,
+      config_.bufferArenaPageSize,
+      std::max<VkDeviceSize>(
+          getVkPhysicalDeviceProperties().limits.minUniformBufferOffsetAlignment, 16));
+
   // default texture
   IGL_ASSERT(textures_.size() == 1);
   {
@@ -578,6 +725,11 @@ igl::Result VulkanContext::initContext(const HWDeviceDesc& desc,
                                                               0.0f),
                                       "Sampler: default");
 
+  // the default texture and sampler are written by the first descriptor set update
+  dirtyIndicesTextures_.push_back(0);
+  dirtyIndicesSamplers_.push_back(0);
+  awaitingCreation_ = true;
+
   if (!IGL_VERIFY(
           config_.maxSamplers <=
           vkPhysicalDeviceDescriptorIndexingProperties_.maxDescriptorSetUpdateAfterBindSamplers)) {
@@ -612,95 +764,19 @@ igl::Result VulkanContext::initContext(const HWDeviceDesc& desc,
         bindings.data(),
         bindingFlags.data(),
         "Descriptor Set Layout: VulkanContext::dslDynamicUniformBuffer_");
-    // create default descriptor pool for dynamic uniform buffers
-    const std::array<VkDescriptorPoolSize, numBindings> poolSizes = {
-        VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, kMaxDynamicUniformBuffers},
-    };
-    VK_ASSERT_RETURN(ivkCreateDescriptorPool(device,
-                                             kMaxDynamicUniformBuffers,
-                                             static_cast<uint32_t>(poolSizes.size()),
-                                             poolSizes.data(),
-                                             &dpDynamicUniformBuffer_));
-  }
-  {
-    // create default descriptor set layout which is going to be shared by graphics pipelines
-    constexpr uint32_t numBindings = 7;
-    const std::array<VkDescriptorSetLayoutBinding, numBindings> bindings = {
-        ivkGetDescriptorSetLayoutBinding(
-            kBinding_Texture2D, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, config_.maxTextures),
-        ivkGetDescriptorSetLayoutBinding(
-            kBinding_Texture2DArray, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, config_.maxTextures),
-        ivkGetDescriptorSetLayoutBinding(
-            kBinding_Texture3D, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, config_.maxTextures),
-        ivkGetDescriptorSetLayoutBinding(
-            kBinding_TextureCube, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, config_.maxTextures),
-        ivkGetDescriptorSetLayoutBinding(
-            kBinding_Sampler, VK_DESCRIPTOR_TYPE_SAMPLER, config_.maxSamplers),
-        ivkGetDescriptorSetLayoutBinding(
-            kBinding_SamplerShadow, VK_DESCRIPTOR_TYPE_SAMPLER, config_.maxSamplers),
-        ivkGetDescriptorSetLayoutBinding(
-            kBinding_StorageImages, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, config_.maxTextures),
-    };
-    const uint32_t flags = VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT |
-                           VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT |
-                           VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT;
-    const std::array<VkDescriptorBindingFlags, numBindings> bindingFlags = {
-        flags, flags, flags, flags, flags, flags, flags};
-    dslBindless_ = std::make_unique<VulkanDescriptorSetLayout>(
-        device,
-        numBindings,
-        bindings.data(),
-        bindingFlags.data(),
-        "Descriptor Set Layout: VulkanContext::dslBindless_");
-
-    // create default descriptor pool and allocate 1 descriptor set
-    const uint32_t numSets = 1;
-    IGL_ASSERT(numSets > 0);
-    const std::array<VkDescriptorPoolSize, numBindings> poolSizes = {
-        VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, numSets * config_.maxTextures},
-        VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, numSets * config_.maxTextures},
-        VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, numSets * config_.maxTextures},
-        VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, numSets * config_.maxTextures},
-        VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_SAMPLER, numSets * config_.maxSamplers},
-        VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_SAMPLER, numSets * config_.maxSamplers},
-        VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, numSets * config_.maxTextures},
-    };
-    bindlessDSets_.resize(numSets);
-    VK_ASSERT_RETURN(ivkCreateDescriptorPool(
-        device, numSets, static_cast<uint32_t>(poolSizes.size()), poolSizes.data(), &dpBindless_));
-    for (size_t i = 0; i != numSets; i++) {
-      VK_ASSERT_RETURN(ivkAllocateDescriptorSet(
-          device, dpBindless_, dslBindless_->getVkDescriptorSetLayout(), &bindlessDSets_[i].ds));
-    }
   }
-
-  // maxPushConstantsSize is guaranteed to be at least 128 bytes
   // https://www.khronos.org/registry/vulkan/specs/1.3/html/vkspec.html#features-limits
   // Table 32. Required Limits
-  const uint32_t kPushConstantsSize = 128;
   if (!IGL_VERIFY(kPushConstantsSize <= limits.maxPushConstantsSize)) {
     IGL_LOG_ERROR("Push constants size exceeded %u (max %u bytes)",
                   kPushConstantsSize,
                   limits.maxPushConstantsSize);
   }
 
-  const std::vector<VkDescriptorSetLayout> DSLs = {
-      dslBindless_->getVkDescriptorSetLayout(),
-      dslDynamicUniformBuffer_->getVkDescriptorSetLayout()};
-
-  // create pipeline layout
-  pipelineLayoutGraphics_ = std::make_unique<VulkanPipelineLayout>(
-      device,
-      DSLs,
-      ivkGetPushConstantRange(
-          VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, kPushConstantsSize),
-      "Pipeline Layout: VulkanContext::pipelineLayoutGraphics_");
-
-  pipelineLayoutCompute_ = std::make_unique<VulkanPipelineLayout>(
-      device,
-      DSLs,
-      ivkGetPushConstantRange(VK_SHADER_STAGE_COMPUTE_BIT, 0, kPushConstantsSize),
-      "Pipeline Layout: VulkanContext::pipelineLayoutCompute_");
+  const Result result = createBindlessDescriptorSets(config_.maxTextures, config_.maxSamplers);
+  if (!IGL_VERIFY(result.isOk())) {
+    return result;
+  }
 
   querySurfaceCapabilities();
 
@@ -741,6 +817,10 @@ Result VulkanContext::waitIdle() const {
     VK_ASSERT_RETURN(vkQueueWaitIdle(queue));
   }
 
+  if (deviceQueues_.transferQueue != VK_NULL_HANDLE) {
+    VK_ASSERT_RETURN(vkQueueWaitIdle(deviceQueues_.transferQueue));
+  }
+
   return getResultFromVkResult(VK_SUCCESS);
 }
 
@@ -845,6 +925,163 @@ std::shared_ptr<VulkanImage> VulkanContext::createImageFromFileDescriptor(
                                        debugName);
 }
 
+igl::Result VulkanContext::createBindlessDescriptorSets(uint32_t maxTextures,
+                                                        uint32_t maxSamplers) const {
+  IGL_PROFILER_FUNCTION();
+
+  VkDevice device = device_->getVkDevice();
+
+  if (dslBindless_) {
+    // command buffers which are being encoded or executed might still use the current descriptor
+    // sets; pipelines which are being built on other threads might still use the layouts
+    RetiredBindlessDescriptorPool retired;
+    retired.pool = dpBindless_;
+    retired.handles = immediate_->getEncodingSubmitHandles();
+    retired.handles.push_back(immediate_->getLastSubmitHandle());
+    retiredBindlessDescriptorPools_.push_back(std::move(retired));
+    retiredBindlessLayouts_.push_back(std::move(dslBindless_));
+    retiredPipelineLayouts_.push_back(std::move(pipelineLayoutGraphics_));
+    retiredPipelineLayouts_.push_back(std::move(pipelineLayoutCompute_));
+    dpBindless_ = VK_NULL_HANDLE;
+  }
+
+  // create the descriptor set layout which is going to be shared by all pipelines
+  constexpr uint32_t numBindings = 7;
+  const std::array<VkDescriptorSetLayoutBinding, numBindings> bindings = {
+      ivkGetDescriptorSetLayoutBinding(
+          kBinding_Texture2D, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, maxTextures),
+      ivkGetDescriptorSetLayoutBinding(
+          kBinding_Texture2DArray, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, maxTextures),
+      ivkGetDescriptorSetLayoutBinding(
+          kBinding_Texture3D, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, maxTextures),
+      ivkGetDescriptorSetLayoutBinding(
+          kBinding_TextureCube, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, maxTextures),
+      ivkGetDescriptorSetLayoutBinding(kBinding_Sampler, VK_DESCRIPTOR_TYPE_SAMPLER, maxSamplers),
+      ivkGetDescriptorSetLayoutBinding(
+          kBinding_SamplerShadow, VK_DESCRIPTOR_TYPE_SAMPLER, maxSamplers),
+      ivkGetDescriptorSetLayoutBinding(
+          kBinding_StorageImages, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, maxTextures),
+  };
+  const uint32_t flags = VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT |
+                         VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT |
+                         VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT;
+  const std::array<VkDescriptorBindingFlags, numBindings> bindingFlags = {
+      flags, flags, flags, flags, flags, flags, flags};
+  dslBindless_ = std::make_unique<VulkanDescriptorSetLayout>(
+      device,
+      numBindings,
+      bindings.data(),
+      bindingFlags.data(),
+      "Descriptor Set Layout: VulkanContext::dslBindless_");
+
+  // create default descriptor pool and allocate 1 descriptor set
+  const uint32_t numSets = 1;
+  IGL_ASSERT(numSets > 0);
+  const std::array<VkDescriptorPoolSize, numBindings> poolSizes = {
+      VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, numSets * maxTextures},
+      VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, numSets * maxTextures},
+      VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, numSets * maxTextures},
+      VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, numSets * maxTextures},
+      VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_SAMPLER, numSets * maxSamplers},
+      VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_SAMPLER, numSets * maxSamplers},
+      VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, numSets * maxTextures},
+  };
+  bindlessDSets_.resize(numSets);
+  VK_ASSERT_RETURN(ivkCreateDescriptorPool(
+      device, numSets, static_cast<uint32_t>(poolSizes.size()), poolSizes.data(), &dpBindless_));
+  for (size_t i = 0; i != numSets; i++) {
+    VK_ASSERT_RETURN(ivkAllocateDescriptorSet(
+        device, dpBindless_, dslBindless_->getVkDescriptorSetLayout(), &bindlessDSets_[i].ds));
+  }
+
+  const std::vector<VkDescriptorSetLayout> DSLs = {
+      dslBindless_->getVkDescriptorSetLayout(),
+      dslDynamicUniformBuffer_->getVkDescriptorSetLayout()};
+
+  // create pipeline layout
+  pipelineLayoutGraphics_ = std::make_unique<VulkanPipelineLayout>(
+      device,
+      DSLs,
+      ivkGetPushConstantRange(
+          VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, kPushConstantsSize),
+      "Pipeline Layout: VulkanContext::pipelineLayoutGraphics_");
+
+  pipelineLayoutCompute_ = std::make_unique<VulkanPipelineLayout>(
+      device,
+      DSLs,
+      ivkGetPushConstantRange(VK_SHADER_STAGE_COMPUTE_BIT, 0, kPushConstantsSize),
+      "Pipeline Layout: VulkanContext::pipelineLayoutCompute_");
+
+  bindlessTexturesCapacity_ = maxTextures;
+  bindlessSamplersCapacity_ = maxSamplers;
+
+  return Result();
+}
+
+void VulkanContext::growBindlessDescriptorSets() const {
+  const auto& props = vkPhysicalDeviceDescriptorIndexingProperties_;
+
+  // the 4 sampled image bindings and the storage image binding share one capacity
+  const uint32_t maxTextures = std::min({
+      props.maxDescriptorSetUpdateAfterBindSampledImages / 4,
+      props.maxDescriptorSetUpdateAfterBindStorageImages,
+      props.maxPerStageDescriptorUpdateAfterBindSampledImages / 4,
+      props.maxPerStageDescriptorUpdateAfterBindStorageImages,
+  });
+  const uint32_t maxSamplers = std::min(props.maxDescriptorSetUpdateAfterBindSamplers / 2,
+                                        props.maxPerStageDescriptorUpdateAfterBindSamplers / 2);
+
+  const auto getCapacity = [](uint32_t capacity, size_t required, uint32_t limit) {
+    capacity = std::max(capacity, 1u);
+    while (capacity < required && capacity < limit) {
+      capacity = capacity < limit / 2 ? 2 * capacity : limit;
+    }
+    return capacity;
+  };
+
+  const uint32_t numTextures =
+      getCapacity(bindlessTexturesCapacity_, textures_.size(), std::max(maxTextures, 1u));
+  const uint32_t numSamplers =
+      getCapacity(bindlessSamplersCapacity_, samplers_.size(), std::max(maxSamplers, 1u));
+
+  if (numTextures == bindlessTexturesCapacity_ && numSamplers == bindlessSamplersCapacity_) {
+    IGL_ASSERT_MSG(false, "The bindless descriptor sets cannot grow beyond the device limits");
+    return;
+  }
+
+  IGL_LOG_INFO("Growing bindless descriptor sets: %u -> %u textures, %u -> %u samplers\n",
+               bindlessTexturesCapacity_,
+               numTextures,
+               bindlessSamplersCapacity_,
+               numSamplers);
+
+  {
+    // the pipeline layouts are read along with the generation by RenderPipelineState::prewarm()
+    std::lock_guard<std::mutex> lock(bindlessLayoutMutex_);
+
+    if (!IGL_VERIFY(createBindlessDescriptorSets(numTextures, numSamplers).isOk())) {
+      return;
+    }
+
+    // pipelines have to be recreated with the new pipeline layouts
+    bindlessGeneration_++;
+  }
+
+  // the new descriptor sets are empty
+  dirtyIndicesTextures_.resize(textures_.size());
+  std::iota(dirtyIndicesTextures_.begin(), dirtyIndicesTextures_.end(), 0u);
+  dirtyIndicesSamplers_.resize(samplers_.size());
+  std::iota(dirtyIndicesSamplers_.begin(), dirtyIndicesSamplers_.end(), 0u);
+}
+
+VkPipelineLayout VulkanContext::getPipelineLayoutGraphics(uint32_t& outGeneration) const {
+  std::lock_guard<std::mutex> lock(bindlessLayoutMutex_);
+
+  outGeneration = bindlessGeneration_;
+
+  return pipelineLayoutGraphics_->getVkPipelineLayout();
+}
+
 void VulkanContext::checkAndUpdateDescriptorSets() const {
   if (awaitingDeletion_) {
     // Our descriptor set was created with VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT which
@@ -857,6 +1094,9 @@ void VulkanContext::checkAndUpdateDescriptorSets() const {
     awaitingDeletion_ = false;
   }
 
+  // free indices must not reference destroyed image views
+  recycleBindlessIndices(false);
+
   if (!awaitingCreation_) {
     // nothing to update here
     return;
@@ -865,42 +1105,101 @@ void VulkanContext::checkAndUpdateDescriptorSets() const {
   // newly created resources can be used immediately - make sure they are put into descriptor sets
   IGL_PROFILER_FUNCTION();
 
-  // here we remove deleted textures - everything which has only 1 reference is owned by this
-  // context and can be released safely
+  // here we release deleted textures - everything which has only 1 reference is owned by this
+  // context and can be released safely. Their indices are reused once the GPU is done with them
+  ReleasedBindlessIndices released;
   for (uint32_t i = 1; i < (uint32_t)textures_.size(); i++) {
     if (textures_[i] && textures_[i].use_count() == 1) {
-      if (i == textures_.size() - 1) {
-        textures_.pop_back();
-      } else {
-        textures_[i].reset();
-        freeIndicesTextures_.push_back(i);
-      }
+      textures_[i].reset();
+      released.textures.push_back(i);
     }
   }
   for (uint32_t i = 1; i < (uint32_t)samplers_.size(); i++) {
     if (samplers_[i] && samplers_[i].use_count() == 1) {
-      if (i == samplers_.size() - 1) {
-        samplers_.pop_back();
-      } else {
-        samplers_[i].reset();
-        freeIndicesSamplers_.push_back(i);
-      }
+      samplers_[i].reset();
+      released.samplers.push_back(i);
     }
   }
+  if (!released.textures.empty() || !released.samplers.empty()) {
+    released.handles = immediate_->getEncodingSubmitHandles();
+    released.handles.push_back(immediate_->getLastSubmitHandle());
+    releasedBindlessIndices_.push_back(std::move(released));
+  }
 
-  // update Vulkan descriptor set here
+  // destroy the descriptor pools which were replaced by larger ones once the GPU is done with them
+  while (!retiredBindlessDescriptorPools_.empty()) {
+    const RetiredBindlessDescriptorPool& retired = retiredBindlessDescriptorPools_.front();
+    if (!std::all_of(retired.handles.begin(),
+                     retired.handles.end(),
+                     [this](SubmitHandle handle) { return immediate_->isReady(handle); })) {
+      break;
+    }
+    vkDestroyDescriptorPool(device_->getVkDevice(), retired.pool, nullptr);
+    retiredBindlessDescriptorPools_.pop_front();
+  }
+
+  bindlessTexturesHighWaterMark_ =
+      std::max(bindlessTexturesHighWaterMark_, (uint32_t)textures_.size());
+  bindlessSamplersHighWaterMark_ =
+      std::max(bindlessSamplersHighWaterMark_, (uint32_t)samplers_.size());
+
+  if (textures_.size() > bindlessTexturesCapacity_ ||
+      samplers_.size() > bindlessSamplersCapacity_) {
+    if (!config_.growableBindlessTables) {
+      IGL_ASSERT_MSG(textures_.size() <= bindlessTexturesCapacity_, "Too many textures");
+      IGL_ASSERT_MSG(samplers_.size() <= bindlessSamplersCapacity_, "Too many samplers");
+    } else if (numParallelEncoders_ == 0) {
+      // other open command buffers keep the replaced descriptor sets alive (see
+      // createBindlessDescriptorSets()) and rebind the new ones with rebuilt pipelines before their
+      // next draw or dispatch. Encoders on other threads read the descriptor sets and pipeline
+      // layouts without locking, so the sets grow only while no parallel encoding is in progress
+      growBindlessDescriptorSets();
+    }
+  }
+
+  // indices beyond the capacity cannot be written; with growable descriptor sets, they are written
+  // once the descriptor sets have grown. Until then, ResourcesBinder binds the dummy texture and
+  // sampler instead of them
+  const auto takeIndicesAbove = [](std::vector<uint32_t>& indices, uint32_t capacity) {
+    const auto it = std::partition(
+        indices.begin(), indices.end(), [capacity](uint32_t index) { return index < capacity; });
+    std::vector<uint32_t> taken(it, indices.end());
+    indices.erase(it, indices.end());
+    return taken;
+  };
+  std::vector<uint32_t> deferredIndicesTextures =
+      takeIndicesAbove(dirtyIndicesTextures_, bindlessTexturesCapacity_);
+  std::vector<uint32_t> deferredIndicesSamplers =
+      takeIndicesAbove(dirtyIndicesSamplers_, bindlessSamplersCapacity_);
+  if (!config_.growableBindlessTables) {
+    deferredIndicesTextures.clear();
+    deferredIndicesSamplers.clear();
+  }
+
+  // update Vulkan descriptor sets here. Only the descriptors of newly created textures and samplers
+  // are written: their indices are not accessed by any pending command buffers, so they can be
+  // updated in place thanks to VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT. Descriptors
+  // of released resources are left as they are (VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT) until
+  // their indices are recycled; then they are rewritten with the dummy texture and sampler
+  const auto sortDirtyIndices = [](std::vector<uint32_t>& indices) {
+    std::sort(indices.begin(), indices.end());
+    indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+  };
+  sortDirtyIndices(dirtyIndicesTextures_);
+  sortDirtyIndices(dirtyIndicesSamplers_);
 
   // 1. Sampled and storage images
   std::vector<VkDescriptorImageInfo> infoSampledImages;
   std::vector<VkDescriptorImageInfo> infoStorageImages;
   IGL_ASSERT(textures_.size() >= 1); // make sure the guard value is always there
-  infoSampledImages.reserve(textures_.size());
-  infoStorageImages.reserve(textures_.size());
+  infoSampledImages.reserve(dirtyIndicesTextures_.size());
+  infoStorageImages.reserve(dirtyIndicesTextures_.size());
 
   // use the dummy texture to avoid sparse array
   VkImageView dummyImageView = textures_[0]->imageView_->getVkImageView();
 
-  for (const auto& texture : textures_) {
+  for (const uint32_t index : dirtyIndicesTextures_) {
+    const auto& texture = textures_[index];
     // multisampled images cannot be directly accessed from shaders
     const bool isTextureAvailable =
         texture && ((texture->image_->samples_ & VK_SAMPLE_COUNT_1_BIT) == VK_SAMPLE_COUNT_1_BIT);
@@ -920,9 +1219,10 @@ void VulkanContext::checkAndUpdateDescriptorSets() const {
   // 2. Samplers
   std::vector<VkDescriptorImageInfo> infoSamplers;
   IGL_ASSERT(samplers_.size() >= 1); // make sure the guard value is always there
-  infoSamplers.reserve(samplers_.size());
+  infoSamplers.reserve(dirtyIndicesSamplers_.size());
 
-  for (const auto& sampler : samplers_) {
+  for (const uint32_t index : dirtyIndicesSamplers_) {
+    const auto& sampler = samplers_[index];
     infoSamplers.push_back({(sampler ? sampler : samplers_[0])->getVkSampler(),
                             VK_NULL_HANDLE,
                             VK_IMAGE_LAYOUT_UNDEFINED});
@@ -930,56 +1230,92 @@ void VulkanContext::checkAndUpdateDescriptorSets() const {
 
   std::vector<VkWriteDescriptorSet> write;
 
-  // we want to update the next available descriptor set
-  const uint32_t nextDSetIndex = (currentDSetIndex_ + 1) % bindlessDSets_.size();
-  auto& dsetToUpdate = bindlessDSets_[nextDSetIndex];
+  // one write per range of consecutive indices and binding
+  const auto writeRanges = [&write](VkDescriptorSet ds,
+                                    uint32_t binding,
+                                    VkDescriptorType type,
+                                    const std::vector<uint32_t>& indices,
+                                    const std::vector<VkDescriptorImageInfo>& infos) {
+    IGL_ASSERT(indices.size() == infos.size());
+    for (size_t first = 0; first != indices.size();) {
+      size_t last = first + 1;
+      while (last != indices.size() && indices[last] == indices[last - 1] + 1) {
+        last++;
+      }
+      write.push_back(ivkGetWriteDescriptorSet_ImageInfo(
+          ds, binding, type, uint32_t(last - first), infos.data() + first));
+      write.back().dstArrayElement = indices[first];
+      first = last;
+    }
+  };
 
-  if (!infoSampledImages.empty()) {
+  for (const auto& dset : bindlessDSets_) {
     // use the same indexing for every texture type
     for (uint32_t i = kBinding_Texture2D; i != kBinding_TextureCube + 1; i++) {
-      write.push_back(ivkGetWriteDescriptorSet_ImageInfo(dsetToUpdate.ds,
-                                                         i,
-                                                         VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
-                                                         (uint32_t)infoSampledImages.size(),
-                                                         infoSampledImages.data()));
+      writeRanges(
+          dset.ds, i, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, dirtyIndicesTextures_, infoSampledImages);
     }
-  };
-
-  if (!infoSamplers.empty()) {
     for (uint32_t i = kBinding_Sampler; i != kBinding_SamplerShadow + 1; i++) {
-      write.push_back(ivkGetWriteDescriptorSet_ImageInfo(dsetToUpdate.ds,
-                                                         i,
-                                                         VK_DESCRIPTOR_TYPE_SAMPLER,
-                                                         (uint32_t)infoSamplers.size(),
-                                                         infoSamplers.data()));
+      writeRanges(dset.ds, i, VK_DESCRIPTOR_TYPE_SAMPLER, dirtyIndicesSamplers_, infoSamplers);
     }
+    writeRanges(dset.ds,
+                kBinding_StorageImages,
+                VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+                dirtyIndicesTextures_,
+                infoStorageImages);
   }
 
-  if (!infoStorageImages.empty()) {
-    write.push_back(ivkGetWriteDescriptorSet_ImageInfo(dsetToUpdate.ds,
-                                                       kBinding_StorageImages,
-                                                       VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
-                                                       (uint32_t)infoStorageImages.size(),
-                                                       infoStorageImages.data()));
-  };
-
-  // do not switch to the next descriptor set if there is nothing to update
   if (!write.empty()) {
 #if IGL_VULKAN_PRINT_COMMANDS
-    IGL_LOG_INFO("Updating descriptor set %u\n", nextDSetIndex);
+    IGL_LOG_INFO("Updating descriptor sets: %u textures, %u samplers\n",
+                 (uint32_t)dirtyIndicesTextures_.size(),
+                 (uint32_t)dirtyIndicesSamplers_.size());
 #endif // IGL_VULKAN_PRINT_COMMANDS
-    currentDSetIndex_ = nextDSetIndex;
-    immediate_->wait(std::exchange(dsetToUpdate.handle, immediate_->getLastSubmitHandle()));
+    for (const auto& w : write) {
+      numBindlessDescriptorsWritten_ += w.descriptorCount;
+    }
     vkUpdateDescriptorSets(
         device_->getVkDevice(), static_cast<uint32_t>(write.size()), write.data(), 0, nullptr);
   }
 
-  awaitingCreation_ = false;
+  dirtyIndicesTextures_ = std::move(deferredIndicesTextures);
+  dirtyIndicesSamplers_ = std::move(deferredIndicesSamplers);
+
+  awaitingCreation_ = !dirtyIndicesTextures_.empty() || !dirtyIndicesSamplers_.empty();
   awaitingDeletion_ = false;
 
   lastDeletionFrame_ = getFrameNumber();
 }
 
+void VulkanContext::recycleBindlessIndices(bool wait) const {
+  if (wait && !releasedBindlessIndices_.empty()) {
+    // all the indices are in use - wait for the oldest released ones
+    for (const SubmitHandle& handle : releasedBindlessIndices_.front().handles) {
+      immediate_->wait(handle);
+    }
+  }
+
+  while (!releasedBindlessIndices_.empty()) {
+    const ReleasedBindlessIndices& released = releasedBindlessIndices_.front();
+    for (const SubmitHandle& handle : released.handles) {
+      if (!immediate_->isReady(handle)) {
+        return;
+      }
+    }
+    freeIndicesTextures_.insert(
+        freeIndicesTextures_.end(), released.textures.begin(), released.textures.end());
+    freeIndicesSamplers_.insert(
+        freeIndicesSamplers_.end(), released.samplers.begin(), released.samplers.end());
+    // no command buffer accesses these descriptors anymore, so they can be reset
+    dirtyIndicesTextures_.insert(
+        dirtyIndicesTextures_.end(), released.textures.begin(), released.textures.end());
+    dirtyIndicesSamplers_.insert(
+        dirtyIndicesSamplers_.end(), released.samplers.begin(), released.samplers.end());
+    awaitingCreation_ = true;
+    releasedBindlessIndices_.pop_front();
+  }
+}
+
 std::shared_ptr<VulkanTexture> VulkanContext::createTexture(
     std::shared_ptr<VulkanImage> image,
     std::shared_ptr<VulkanImageView> imageView) const {
@@ -987,6 +1323,9 @@ std::shared_ptr<VulkanTexture> VulkanContext::createTexture(
   if (!IGL_VERIFY(texture)) {
     return nullptr;
   }
+  // growable tables never wait for released indices
+  recycleBindlessIndices(!config_.growableBindlessTables && freeIndicesTextures_.empty() &&
+                         textures_.size() >= config_.maxTextures);
   if (!freeIndicesTextures_.empty()) {
     // reuse an empty slot
     texture->textureId_ = freeIndicesTextures_.back();
@@ -997,8 +1336,10 @@ std::shared_ptr<VulkanTexture> VulkanContext::createTexture(
     textures_.emplace_back(texture);
   }
 
-  IGL_ASSERT(textures_.size() <= config_.maxTextures);
+  // the descriptor sets grow before the new descriptor is written
+  IGL_ASSERT(config_.growableBindlessTables || textures_.size() <= config_.maxTextures);
 
+  dirtyIndicesTextures_.push_back(texture->textureId_);
   awaitingCreation_ = true;
 
   return texture;
@@ -1012,6 +1353,8 @@ std::shared_ptr<VulkanSampler> VulkanContext::createSampler(const VkSamplerCreat
     Result::setResult(outResult, Result::Code::InvalidOperation);
     return nullptr;
   }
+  recycleBindlessIndices(!config_.growableBindlessTables && freeIndicesSamplers_.empty() &&
+                         samplers_.size() >= config_.maxSamplers);
   if (!freeIndicesSamplers_.empty()) {
     // reuse an empty slot
     sampler->samplerId_ = freeIndicesSamplers_.back();
@@ -1022,8 +1365,9 @@ std::shared_ptr<VulkanSampler> VulkanContext::createSampler(const VkSamplerCreat
     samplers_.emplace_back(sampler);
   }
 
-  IGL_ASSERT(samplers_.size() <= config_.maxSamplers);
+  IGL_ASSERT(config_.growableBindlessTables || samplers_.size() <= config_.maxSamplers);
 
+  dirtyIndicesSamplers_.push_back(sampler->samplerId_);
   awaitingCreation_ = true;
 
   return sampler;
@@ -1096,6 +1440,8 @@ VkFormat VulkanContext::getClosestDepthStencilFormat(igl::TextureFormat desiredF
 }
 
 VulkanContext::RenderPassHandle VulkanContext::getRenderPass(uint8_t index) const {
+  std::lock_guard<std::mutex> lock(renderPassesMutex_);
+
   return RenderPassHandle{renderPasses_[index], index};
 }
 
@@ -1103,6 +1449,8 @@ VulkanContext::RenderPassHandle VulkanContext::findRenderPass(
     const VulkanRenderPassBuilder& builder) const {
   IGL_PROFILER_FUNCTION();
 
+  std::lock_guard<std::mutex> lock(renderPassesMutex_);
+
   auto it = renderPassesHash_.find(builder);
 
   if (it != renderPassesHash_.end()) {
@@ -1125,18 +1473,7 @@ VulkanContext::RenderPassHandle VulkanContext::findRenderPass(
 }
 
 std::vector<uint8_t> VulkanContext::getPipelineCacheData() const {
-  VkDevice device = device_->getVkDevice();
-
-  size_t size = 0;
-  vkGetPipelineCacheData(device, pipelineCache_, &size, nullptr);
-
-  std::vector<uint8_t> data(size);
-
-  if (size) {
-    vkGetPipelineCacheData(device, pipelineCache_, &size, data.data());
-  }
-
-  return data;
+  return pipelineCache_->getData();
 }
 
 uint64_t VulkanContext::getFrameNumber() const {
@@ -1151,57 +1488,100 @@ VulkanContext::DynamicUniformsBufferSet::DynamicUniformsBufferSet(VulkanContext&
   bufferSizeAligned_ = (ResourcesBinder::kDUBBufferSize + kMinAlignment - 1) & ~(kMinAlignment - 1);
   IGL_ASSERT(bufferSizeAligned_ <= ctx_.dynamicUniformBufferSize_);
 
-  // Pre-allocate all Dynamic Uniform Buffers
-  for (uint32_t index = 0u; index < kMaxDynamicUniformBuffers; ++index) {
-    allocateDynamicUniformsBuffer();
+  // Pre-allocate the initial ring of Dynamic Uniform Buffers
+  const uint32_t numDUBs = getNumDynamicUniformBuffers(ctx_.config_);
+  DUBs_.reserve(numDUBs);
+  for (uint32_t index = 0u; index < numDUBs; ++index) {
+    allocateDynamicUniformsBuffer(DUBs_.size());
   }
 
   currentDUB_ = &DUBs_[currentDUBIndex_];
 }
 
-void VulkanContext::DynamicUniformsBufferSet::acquireNextDUB() {
-  currentDUBIndex_ = (currentDUBIndex_ + 1) % kMaxDynamicUniformBuffers;
+void VulkanContext::DynamicUniformsBufferSet::acquireNextDUB(SubmitHandle submittedHandle) {
+  // several command buffers can be encoded at the same time, so the current DUB can be reused only
+  // once all of them have completed
+  currentDUB_->handles_ = ctx_.immediate_->getEncodingSubmitHandles();
+  if (!submittedHandle.empty()) {
+    currentDUB_->handles_.push_back(submittedHandle);
+  }
+
+  const size_t nextDUBIndex = (currentDUBIndex_ + 1) % DUBs_.size();
 
-  IGL_ASSERT_MSG(currentDUBIndex_ != lastSubmittedDUBIndex_,
-                 "You are trying to re-use a DUB that has not been submitted for processing yet. "
-                 "This means you have too many bindings per submit. "
-                 "Increase the maximum number of DUBs kMaxDynamicUniformBuffers.");
+  if (isAvailable(DUBs_[nextDUBIndex])) {
+    currentDUBIndex_ = nextDUBIndex;
+  } else {
+    // the next DUB is still used by the GPU or by a command buffer which is being encoded. Instead
+    // of waiting for it (which deadlocks when a single submit needs more DUBs than the ring holds),
+    // grow the ring by inserting a new DUB right after the current one
+    currentDUBIndex_++;
+    allocateDynamicUniformsBuffer(currentDUBIndex_);
+  }
 
   currentDUB_ = &DUBs_[currentDUBIndex_];
-  // wait for the next DUB to become available
-  ctx_.immediate_->wait(currentDUB_->handle_);
   currentDUB_->reset();
 }
 
+bool VulkanContext::DynamicUniformsBufferSet::isAvailable(const DynamicUniformBuffer& buf) const {
+  for (const SubmitHandle& handle : buf.handles_) {
+    if (!ctx_.immediate_->isReady(handle)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+size_t VulkanContext::DynamicUniformsBufferSet::getNumDUBs() {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  return DUBs_.size();
+}
+
 void VulkanContext::DynamicUniformsBufferSet::update(VkCommandBuffer cmdBuf,
                                                      VkPipelineBindPoint bindPoint,
                                                      const Bindings* data) {
-  IGL_ASSERT(currentDUB_);
+  VulkanBuffer* buffer = nullptr;
+  VkDescriptorSet ds = VK_NULL_HANDLE;
+  uint32_t offset = 0;
 
-  const bool canFitIntoCurrentDUB =
-      (currentDUB_->offset_ + bufferSizeAligned_ <= ctx_.dynamicUniformBufferSize_);
+  {
+    // only the allocation is serialized; encoders on other threads write into other ranges. The
+    // ring can grow on other threads, so nothing may point into `DUBs_` outside of the lock
+    std::lock_guard<std::mutex> lock(mutex_);
 
-  if (!canFitIntoCurrentDUB) {
-    acquireNextDUB();
-  }
+    IGL_ASSERT(currentDUB_);
 
-  DynamicUniformBuffer* buf = currentDUB_;
+    const bool canFitIntoCurrentDUB =
+        (currentDUB_->offset_ + bufferSizeAligned_ <= ctx_.dynamicUniformBufferSize_);
+
+    if (!canFitIntoCurrentDUB) {
+      acquireNextDUB();
+    }
 
-  IGL_ASSERT(buf->buffer_->getMappedPtr());
-  IGL_ASSERT(buf->offset_ + bufferSizeAligned_ <= ctx_.dynamicUniformBufferSize_);
+    buffer = currentDUB_->buffer_.get();
+    ds = currentDUB_->ds_;
+    offset = currentDUB_->offset_;
+
+    if (data) {
+      currentDUB_->offset_ += (uint32_t)bufferSizeAligned_;
+    }
+  }
+
+  IGL_ASSERT(buffer->getMappedPtr());
+  IGL_ASSERT(offset + bufferSizeAligned_ <= ctx_.dynamicUniformBufferSize_);
 
   if (data) {
-    checked_memcpy(buf->buffer_->getMappedPtr() + buf->offset_,
-                   ctx_.dynamicUniformBufferSize_ - buf->offset_,
+    checked_memcpy(buffer->getMappedPtr() + offset,
+                   ctx_.dynamicUniformBufferSize_ - offset,
                    data,
                    ResourcesBinder::kDUBBufferSize);
-    buf->buffer_->flushMappedMemory(buf->offset_, ResourcesBinder::kDUBBufferSize);
+    buffer->flushMappedMemory(offset, ResourcesBinder::kDUBBufferSize);
   }
 
   const bool isGraphics = bindPoint == VK_PIPELINE_BIND_POINT_GRAPHICS;
 
   // @lint-ignore CLANGTIDY
-  const VkDescriptorSet sets[] = {ctx_.bindlessDSets_[ctx_.currentDSetIndex_].ds, buf->ds_};
+  const VkDescriptorSet sets[] = {ctx_.bindlessDSets_[ctx_.currentDSetIndex_].ds, ds};
 
 #if IGL_VULKAN_PRINT_COMMANDS
   IGL_LOG_INFO("%p vkCmdBindDescriptorSets(%u, %llu) - DSet: %u\n",
@@ -1218,16 +1598,24 @@ void VulkanContext::DynamicUniformsBufferSet::update(VkCommandBuffer cmdBuf,
                           IGL_ARRAY_NUM_ELEMENTS(sets),
                           sets,
                           1,
-                          &buf->offset_);
-
-  if (data) {
-    buf->offset_ += (uint32_t)bufferSizeAligned_;
-  }
+                          &offset);
 }
 
-void VulkanContext::DynamicUniformsBufferSet::allocateDynamicUniformsBuffer() {
+void VulkanContext::DynamicUniformsBufferSet::allocateDynamicUniformsBuffer(size_t index) {
   igl::Result result;
 
+  VkDevice device = ctx_.device_->getVkDevice();
+
+  // the ring starts with one pool and gets another one whenever all existing pools are full
+  const uint32_t numDUBsPerPool = getNumDynamicUniformBuffers(ctx_.config_);
+  if (DUBs_.size() == ctx_.dpDynamicUniformBuffers_.size() * numDUBsPerPool) {
+    const VkDescriptorPoolSize poolSize = {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
+                                           numDUBsPerPool};
+    VkDescriptorPool pool = VK_NULL_HANDLE;
+    VK_ASSERT(ivkCreateDescriptorPool(device, numDUBsPerPool, 1, &poolSize, &pool));
+    ctx_.dpDynamicUniformBuffers_.push_back(pool);
+  }
+
   DynamicUniformBuffer buf;
   buf.buffer_ = ctx_.createBuffer(
       ctx_.dynamicUniformBufferSize_,
@@ -1238,8 +1626,8 @@ void VulkanContext::DynamicUniformsBufferSet::allocateDynamicUniformsBuffer() {
 
   IGL_ASSERT(result.isOk());
 
-  VK_ASSERT(ivkAllocateDescriptorSet(ctx_.device_->getVkDevice(),
-                                     ctx_.dpDynamicUniformBuffer_,
+  VK_ASSERT(ivkAllocateDescriptorSet(device,
+                                     ctx_.dpDynamicUniformBuffers_.back(),
                                      ctx_.dslDynamicUniformBuffer_->getVkDescriptorSetLayout(),
                                      &buf.ds_));
 
@@ -1247,37 +1635,33 @@ void VulkanContext::DynamicUniformsBufferSet::allocateDynamicUniformsBuffer() {
       buf.buffer_->getVkBuffer(), 0, sizeof(ResourcesBinder::bindings_)};
   const VkWriteDescriptorSet set = ivkGetWriteDescriptorSet_BufferInfo(
       buf.ds_, 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1, &bufferInfo);
-  vkUpdateDescriptorSets(ctx_.device_->getVkDevice(), 1, &set, 0, nullptr);
+  vkUpdateDescriptorSets(device, 1, &set, 0, nullptr);
 
-  DUBs_.push_back(buf);
+  DUBs_.insert(DUBs_.begin() + static_cast<std::ptrdiff_t>(index), std::move(buf));
 }
 
 void VulkanContext::DynamicUniformsBufferSet::markSubmit(
     const VulkanImmediateCommands::SubmitHandle& handle) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
   IGL_ASSERT(currentDUB_);
 
-  if (lastSubmittedDUBIndex_ == currentDUBIndex_ && !currentDUB_->offset_) {
-    // the current DUB contains no data, so we can just safely do nothing and reuse the current DUB
+  if (!currentDUB_->offset_) {
+    // the current DUB contains no data, so we can just safely do nothing and reuse the current DUB;
+    // the previous DUBs were assigned all the command buffers which could have used them
     return;
   }
 
-  currentDUB_->handle_ = handle;
-
-  // assign this submit handle to all previous DUBs which are a part of this submit
-  while (lastSubmittedDUBIndex_ != currentDUBIndex_) {
-    lastSubmittedDUBIndex_ = (lastSubmittedDUBIndex_ + 1) % kMaxDynamicUniformBuffers;
-    DUBs_[lastSubmittedDUBIndex_].handle_ = handle;
-  }
-
   // force a move to the next DUB in `udpateDynamicUniforms` - acquire here so that multiple
   // sequential calls to markSubmit() work as expected
-  acquireNextDUB();
+  acquireNextDUB(handle);
 }
 
 void VulkanContext::deferredTask(std::packaged_task<void()>&& task, SubmitHandle handle) const {
   if (handle.empty()) {
     handle = immediate_->getLastSubmitHandle();
   }
+  std::lock_guard<std::mutex> lock(deferredTasksMutex_);
   deferredTasks_.emplace_back(std::move(task), handle);
 }
 
@@ -1290,18 +1674,35 @@ void* VulkanContext::getVmaAllocator() const {
 }
 
 void VulkanContext::processDeferredTasks() const {
-  while (!deferredTasks_.empty() && immediate_->isReady(deferredTasks_.front().handle_, true)) {
-    deferredTasks_.front().task_();
-    deferredTasks_.pop_front();
+  // the tasks run without holding the lock because they can schedule new deferred tasks
+  std::deque<DeferredTask> tasks;
+  {
+    std::lock_guard<std::mutex> lock(deferredTasksMutex_);
+    while (!deferredTasks_.empty() && immediate_->isReady(deferredTasks_.front().handle_, true)) {
+      tasks.push_back(std::move(deferredTasks_.front()));
+      deferredTasks_.pop_front();
+    }
+  }
+  for (auto& task : tasks) {
+    task.task_();
   }
 }
 
 void VulkanContext::waitDeferredTasks() {
-  for (auto& task : deferredTasks_) {
-    immediate_->wait(task.handle_);
-    task.task_();
+  for (;;) {
+    std::deque<DeferredTask> tasks;
+    {
+      std::lock_guard<std::mutex> lock(deferredTasksMutex_);
+      tasks.swap(deferredTasks_);
+    }
+    if (tasks.empty()) {
+      break;
+    }
+    for (auto& task : tasks) {
+      immediate_->wait(task.handle_);
+      task.task_();
+    }
   }
-  deferredTasks_.clear();
 }
 
 } // namespace vulkan
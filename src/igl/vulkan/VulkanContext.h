@@ -7,20 +7,29 @@
 
 #pragma once
 
+#include <atomic>
 #include <deque>
 #include <future>
 #include <memory>
+#include <mutex>
+#include <string>
 #include <unordered_map>
 
 #include <igl/HWDevice.h>
 #include <igl/vulkan/Common.h>
 #include <igl/vulkan/VulkanDevice.h>
 #include <igl/vulkan/VulkanExtensions.h>
+#include <igl/vulkan/VulkanBufferArena.h>
 #include <igl/vulkan/VulkanHelpers.h>
 #include <igl/vulkan/VulkanImmediateCommands.h>
+#include <igl/vulkan/VulkanPipelineCache.h>
+#include <igl/vulkan/VulkanPipelineLibraryCache.h>
 #include <igl/vulkan/VulkanQueuePool.h>
 #include <igl/vulkan/VulkanRenderPassBuilder.h>
+#include <igl/vulkan/VulkanSecondaryCommandBuffers.h>
+#include <igl/vulkan/VulkanShaderCache.h>
 #include <igl/vulkan/VulkanStagingDevice.h>
+#include <igl/vulkan/WorkerPool.h>
 
 namespace igl {
 namespace vulkan {
@@ -49,9 +58,13 @@ struct DeviceQueues {
   const static uint32_t INVALID = 0xFFFFFFFF;
   uint32_t graphicsQueueFamilyIndex = INVALID;
   uint32_t computeQueueFamilyIndex = INVALID;
+  // a dedicated (non-graphics) transfer queue used by the staging device; INVALID if not available
+  uint32_t transferQueueFamilyIndex = INVALID;
+  uint32_t transferQueueIndex = 0;
 
   VkQueue graphicsQueue = VK_NULL_HANDLE;
   VkQueue computeQueue = VK_NULL_HANDLE;
+  VkQueue transferQueue = VK_NULL_HANDLE;
 
   DeviceQueues() = default;
 };
@@ -61,6 +74,12 @@ struct VulkanContextConfig {
   // macOS: MVK_CONFIG_USE_METAL_ARGUMENT_BUFFERS is required when using this with MoltenVK
   uint32_t maxTextures = 512;
   uint32_t maxSamplers = 512;
+  // grow the bindless descriptor sets on demand, up to the device limits; `maxTextures` and
+  // `maxSamplers` are their initial sizes then. Growing recreates the pipeline layouts, so all
+  // pipelines are rebuilt. The descriptor sets only grow when a command encoder is created while
+  // no other command buffer is being encoded; until then, the textures and samplers beyond the
+  // current capacity cannot be accessed. When disabled, the descriptor sets have a fixed size
+  bool growableBindlessTables = true;
   bool terminateOnValidationError = false; // invoke std::terminate() on any validation error
 
   // enable/disable enhanced shader debugging capabilities (line drawing)
@@ -75,11 +94,96 @@ struct VulkanContextConfig {
 
   std::vector<CommandQueueType> userQueues;
 
+  // upload staging data via a dedicated transfer queue (when the device exposes one) and hand the
+  // uploaded resources over to the graphics queue using queue family ownership transfers. Every
+  // chunk uploaded this way costs up to 3 submits, so only uploads of at least
+  // `minDedicatedTransferQueueUploadSize` bytes use the transfer queue
+  bool enableDedicatedTransferQueue = false;
+  uint32_t minDedicatedTransferQueueUploadSize = 4u * 1024u * 1024u;
+
+  // size of the staging ring buffer used for uploads and readbacks (clamped to the device limits).
+  // Larger uploads are split into chunks which are streamed through the ring
+  uint32_t stagingBufferSize = 256u * 1024u * 1024u;
+
+  // size of the ring buffer which asynchronous readbacks copy into. Readbacks which do not fit into
+  // it get a dedicated buffer
+  uint32_t readbackBufferSize = 16u * 1024u * 1024u;
+
+  // accumulate the staging buffer copies into one command buffer which is submitted with the next
+  // ICommandQueue::submit(), on demand, or once `maxBatchedStagingCopies` copies are pending,
+  // instead of submitting every copy separately
+  bool batchStagingBufferCopies = false;
+  uint32_t maxBatchedStagingCopies = 1024;
+
+  // the number of frames in flight: ring buffers have one copy per frame and the CPU waits for the
+  // GPU to finish the frame recorded `maxResourceCount` frames ago before it starts a new one. This
+  // also sizes the initial ring of dynamic uniform buffers, which grows on demand
   uint32_t maxResourceCount = 3u;
 
-  // owned by the application - should be alive until initContext() returns
+  // when false, every ICommandQueue::submit() ends a frame. When true, a frame ends only with a
+  // submit which is marked with `endOfFrame` or presents a swapchain image, so a frame can consist
+  // of several command buffers
+  bool explicitFramePacing = false;
+
+  // cache the SPIR-V binaries compiled from GLSL by Device::createShaderModule(), keyed by the
+  // content of the patched source, the shader stage, the glslang resource limits and the glslang
+  // version. At most `shaderCacheMaxEntries` binaries are kept in memory. When
+  // `shaderCacheDirectory` is not empty, the binaries are also stored in that (existing) directory
+  // and reused across application runs
+  bool enableShaderCache = false;
+  std::string shaderCacheDirectory;
+  size_t shaderCacheMaxEntries = VulkanShaderCache::kDefaultMaxNumEntries;
+
+  // when true, draw calls whose render pipeline is not built yet are skipped instead of blocking
+  // the encoding thread; the missing pipeline is built on a worker thread. See
+  // RenderPipelineState::prewarm()
+  bool skipDrawsWithPendingPipelines = false;
+
+  // the number of threads which build and link pipelines in the background and compile batches of
+  // shader modules; 0 uses one less than the number of hardware threads
+  uint32_t numWorkerThreads = 0;
+
+  // owned by the application - should be alive until initContext() returns. The data is ignored
+  // if its header does not match the physical device (vendor, device and pipeline cache UUID)
   const void* pipelineCacheData = nullptr;
   size_t pipelineCacheDataSize = 0;
+
+  // a file which keeps the pipeline cache between application runs. When it is not empty, the
+  // cache is loaded from it on init (unless `pipelineCacheData` is provided) and saved back in the
+  // background at the end of a frame once new pipelines were created, but not more often than
+  // every `pipelineCacheSaveInterval` frames. It is also saved when the context is destroyed
+  std::string pipelineCacheFile;
+  uint32_t pipelineCacheSaveInterval = 60;
+
+  // use VK_KHR_dynamic_rendering (when the device supports it) to begin render passes directly from
+  // the attachments' image views: no VkRenderPass and VkFramebuffer objects are created and
+  // graphics pipelines are created against the attachment formats of their RenderPipelineDesc
+  bool enableDynamicRendering = true;
+
+  // use VK_EXT_extended_dynamic_state and VK_EXT_extended_dynamic_state2 (when the device supports
+  // them) to set the primitive topology, depth and stencil states and the depth bias enable with
+  // vkCmdSet*() commands. These states are then not part of the pipeline key, so fewer pipelines
+  // are created
+  bool enableExtendedDynamicState = true;
+
+  // build graphics pipelines from libraries (VK_EXT_graphics_pipeline_library, when the device
+  // supports fast linking): the vertex input, pre-rasterization, fragment shader and fragment
+  // output parts are created separately, shared between render pipeline states and quickly linked
+  // when a pipeline is needed. Optimized pipelines are linked on worker threads and replace the
+  // quickly linked ones once they are ready. At most `pipelineLibraryCacheMaxEntries` libraries
+  // are cached
+  bool enableGraphicsPipelineLibrary = true;
+  size_t pipelineLibraryCacheMaxEntries = VulkanPipelineLibraryCache::kDefaultMaxNumLibraries;
+
+  // buffers created with BufferDesc::BufferAPIHintBits::Pooled are sub-allocated from shared
+  // VkBuffers of `bufferArenaPageSize` bytes when they are not larger than
+  // `maxBufferArenaAllocationSize` bytes. Only vertex, index and uniform buffers are pooled
+  uint32_t bufferArenaPageSize = 4u * 1024u * 1024u;
+  uint32_t maxBufferArenaAllocationSize = 64u * 1024u;
+
+  // size of the host-visible buffers which back IDevice::allocateTransient(). Every frame in flight
+  // has its own buffers; more are created when a frame needs more memory
+  uint32_t transientBufferSize = 4u * 1024u * 1024u;
 };
 
 class VulkanContext final {
@@ -176,6 +280,10 @@ class VulkanContext final {
 
   uint64_t getFrameNumber() const;
 
+  // returns the current graphics pipeline layout and the bindless generation it belongs to; both
+  // change when the bindless descriptor sets grow. Thread-safe
+  VkPipelineLayout getPipelineLayoutGraphics(uint32_t& outGeneration) const;
+
   using SubmitHandle = VulkanImmediateCommands::SubmitHandle;
 
   // execute a task some time in the future after the submit handle finished processing
@@ -188,7 +296,13 @@ class VulkanContext final {
  private:
   void createInstance(const size_t numExtraExtensions, const char** extraExtensions);
   void createSurface(void* window, void* display);
+  igl::Result createBindlessDescriptorSets(uint32_t maxTextures, uint32_t maxSamplers) const;
+  void growBindlessDescriptorSets() const;
   void checkAndUpdateDescriptorSets() const;
+  // moves the released bindless indices which are no longer accessed by the GPU to the free lists
+  // and marks them dirty, so their descriptors are rewritten with the dummy texture and sampler;
+  // with `wait`, waits for the oldest released indices first
+  void recycleBindlessIndices(bool wait) const;
   void querySurfaceCapabilities();
   void allocateDynamicUniformsBuffer() const;
   void processDeferredTasks() const;
@@ -250,26 +364,67 @@ class VulkanContext final {
   std::unique_ptr<igl::vulkan::VulkanDevice> device_;
   std::unique_ptr<igl::vulkan::VulkanSwapchain> swapchain_;
   std::unique_ptr<igl::vulkan::VulkanImmediateCommands> immediate_;
+  // secondary command buffers recorded concurrently by parallel render command encoders
+  std::unique_ptr<igl::vulkan::VulkanSecondaryCommandBuffers> secondaryCommandBuffers_;
   std::unique_ptr<igl::vulkan::VulkanStagingDevice> stagingDevice_;
+  // nullptr if VulkanContextConfig::enableShaderCache is false
+  std::unique_ptr<igl::vulkan::VulkanShaderCache> shaderCache_;
   std::unique_ptr<igl::vulkan::VulkanDescriptorSetLayout> dslDynamicUniformBuffer_;
-  std::unique_ptr<igl::vulkan::VulkanDescriptorSetLayout> dslBindless_;
-  VkDescriptorPool dpDynamicUniformBuffer_ = VK_NULL_HANDLE;
-  VkDescriptorPool dpBindless_ = VK_NULL_HANDLE;
+  // the bindless descriptor set layout, pool and pipeline layouts are replaced when the bindless
+  // descriptor sets grow
+  mutable std::unique_ptr<igl::vulkan::VulkanDescriptorSetLayout> dslBindless_;
+  // every pool holds the descriptor sets of a fixed number of DUBs; more pools are added as the
+  // ring of DUBs grows
+  std::vector<VkDescriptorPool> dpDynamicUniformBuffers_;
+  mutable VkDescriptorPool dpBindless_ = VK_NULL_HANDLE;
   struct BindlessDescriptorSet {
     VkDescriptorSet ds = VK_NULL_HANDLE;
-    SubmitHandle handle =
-        SubmitHandle(); // a handle of the last submit this descriptor set was a part of
   };
   mutable std::vector<BindlessDescriptorSet> bindlessDSets_;
   mutable uint32_t currentDSetIndex_ = 0;
-  std::unique_ptr<igl::vulkan::VulkanPipelineLayout> pipelineLayoutGraphics_;
-  std::unique_ptr<igl::vulkan::VulkanPipelineLayout> pipelineLayoutCompute_;
+  mutable std::unique_ptr<igl::vulkan::VulkanPipelineLayout> pipelineLayoutGraphics_;
+  mutable std::unique_ptr<igl::vulkan::VulkanPipelineLayout> pipelineLayoutCompute_;
+  // the number of texture and sampler descriptors in the bindless descriptor sets
+  mutable uint32_t bindlessTexturesCapacity_ = 0;
+  mutable uint32_t bindlessSamplersCapacity_ = 0;
+  // the largest numbers of texture and sampler slots which have been in use at once
+  mutable uint32_t bindlessTexturesHighWaterMark_ = 0;
+  mutable uint32_t bindlessSamplersHighWaterMark_ = 0;
+  // incremented whenever the bindless descriptor sets grow; pipelines created with older pipeline
+  // layouts have to be rebuilt
+  mutable std::atomic<uint32_t> bindlessGeneration_{0};
+  // guards replacing the pipeline layouts against getPipelineLayoutGraphics()
+  mutable std::mutex bindlessLayoutMutex_;
+  // descriptor pools replaced by larger ones; destroyed once these command buffers have completed
+  struct RetiredBindlessDescriptorPool {
+    VkDescriptorPool pool = VK_NULL_HANDLE;
+    std::vector<SubmitHandle> handles;
+  };
+  mutable std::deque<RetiredBindlessDescriptorPool> retiredBindlessDescriptorPools_;
+  // replaced layouts are kept alive because pipelines might be built with them on other threads
+  mutable std::vector<std::unique_ptr<igl::vulkan::VulkanDescriptorSetLayout>>
+      retiredBindlessLayouts_;
+  mutable std::vector<std::unique_ptr<igl::vulkan::VulkanPipelineLayout>> retiredPipelineLayouts_;
   // don't use staging on devices with shared host-visible memory
   bool useStaging_ = true;
+  // VK_EXT_vertex_attribute_divisor: per-instance vertex bindings can advance every N instances
+  bool hasVertexAttributeDivisor_ = false;
+  // VK_KHR_dynamic_rendering: render command encoders do not use VkRenderPass/VkFramebuffer
+  bool useDynamicRendering_ = false;
+  // VK_EXT_extended_dynamic_state: topology, depth and stencil states are set with vkCmdSet*()
+  bool hasExtendedDynamicState_ = false;
+  // VK_EXT_extended_dynamic_state2: depth bias enable is set with vkCmdSetDepthBiasEnableEXT()
+  bool hasExtendedDynamicState2_ = false;
 
   std::unique_ptr<VulkanContextImpl> pimpl_;
 
-  VkPipelineCache pipelineCache_ = VK_NULL_HANDLE;
+  std::unique_ptr<igl::vulkan::VulkanPipelineCache> pipelineCache_;
+  // VK_EXT_graphics_pipeline_library: null when graphics pipelines are built monolithically
+  std::unique_ptr<igl::vulkan::VulkanPipelineLibraryCache> pipelineLibraries_;
+  // runs the background tasks of pipelines; destroyed before anything those tasks use
+  std::unique_ptr<igl::vulkan::WorkerPool> workerPool_;
+  // small buffers created with BufferDesc::BufferAPIHintBits::Pooled
+  std::unique_ptr<igl::vulkan::VulkanBufferArena> bufferArena_;
 
   // 1. Textures can be safely deleted once they are not in use by GPU, hence our Vulkan context
   // owns all allocated textures (images+image views). The IGL interface vulkan::Texture does not
@@ -284,14 +439,35 @@ class VulkanContext final {
   mutable std::vector<uint32_t> freeIndicesTextures_;
   // contains a list of free indices inside the sparse array `samplers_`
   mutable std::vector<uint32_t> freeIndicesSamplers_;
-  // a texture/sampler was created since the last descriptor set update
+  // Indices of released textures and samplers. Their descriptors might still be accessed by
+  // command buffers which are being encoded or executed, so they become free only once all these
+  // command buffers have completed. Until then, the descriptors keep referencing the image views
+  // of the released textures; once free, they are rewritten with the dummy texture and sampler.
+  struct ReleasedBindlessIndices {
+    std::vector<uint32_t> textures;
+    std::vector<uint32_t> samplers;
+    std::vector<SubmitHandle> handles;
+  };
+  mutable std::deque<ReleasedBindlessIndices> releasedBindlessIndices_;
+  // indices whose descriptors are written by the next descriptor set update
+  mutable std::vector<uint32_t> dirtyIndicesTextures_;
+  mutable std::vector<uint32_t> dirtyIndicesSamplers_;
+  // the total number of descriptors written into the bindless descriptor sets
+  mutable uint64_t numBindlessDescriptorsWritten_ = 0;
+  // a texture/sampler was created or an index was recycled since the last descriptor set update
   mutable bool awaitingCreation_ = false;
   // a texture/sampler was deleted since the last descriptor set update
   mutable bool awaitingDeletion_ = false;
   mutable uint64_t lastDeletionFrame_ = 0;
 
-  mutable size_t drawCallCount_ = 0;
+  // incremented concurrently by the encoders of parallel render command encoders
+  mutable std::atomic<size_t> drawCallCount_{0};
+  // parallel render command encoders which are recording secondary command buffers; their encoders
+  // read the bindless descriptor sets on other threads, so the sets cannot grow meanwhile
+  mutable std::atomic<uint32_t> numParallelEncoders_{0};
 
+  // render passes are looked up by encoders and pipelines recorded on other threads
+  mutable std::mutex renderPassesMutex_;
   // stores an index into renderPasses_
   mutable std::
       unordered_map<VulkanRenderPassBuilder, uint8_t, VulkanRenderPassBuilder::HashFunction>
@@ -305,35 +481,40 @@ class VulkanContext final {
   std::unique_ptr<EnhancedShaderDebuggingStore> enhancedShaderDebuggingStore_;
 
   struct DynamicUniformBuffer {
-    SubmitHandle handle_;
+    // all the command buffers which might have written into this buffer
+    std::vector<SubmitHandle> handles_;
     uint32_t offset_ = 0;
     VkDescriptorSet ds_ = VK_NULL_HANDLE;
     std::shared_ptr<VulkanBuffer> buffer_;
     void reset() {
-      handle_ = SubmitHandle();
+      handles_.clear();
       offset_ = 0;
     }
   };
 
-  /// @brief Manages a circular buffer of Dynamic Uniforms Buffers (DUBs)
+  /// @brief Manages a circular buffer of Dynamic Uniforms Buffers (DUBs). When the next DUB in the
+  /// ring is still in use, a new DUB is inserted instead of waiting for it
   class DynamicUniformsBufferSet {
    public:
     explicit DynamicUniformsBufferSet(VulkanContext& ctx);
 
     void update(VkCommandBuffer cmdBuf, VkPipelineBindPoint bindPoint, const Bindings* data);
     void markSubmit(const SubmitHandle& handle);
+    [[nodiscard]] size_t getNumDUBs();
 
    private:
-    void allocateDynamicUniformsBuffer();
-    void acquireNextDUB();
+    void allocateDynamicUniformsBuffer(size_t index);
+    [[nodiscard]] bool isAvailable(const DynamicUniformBuffer& buf) const;
+    void acquireNextDUB(SubmitHandle submittedHandle = SubmitHandle());
 
     std::vector<DynamicUniformBuffer> DUBs_;
     DynamicUniformBuffer* currentDUB_ = nullptr;
 
     VulkanContext& ctx_;
+    // update() is called concurrently by the encoders of parallel render command encoders
+    std::mutex mutex_;
     VkDeviceSize bufferSizeAligned_ = 0;
     size_t currentDUBIndex_ = 0;
-    size_t lastSubmittedDUBIndex_ = 0;
   };
 
   mutable std::unique_ptr<DynamicUniformsBufferSet> DUBs_;
@@ -346,6 +527,8 @@ class VulkanContext final {
   };
 
   mutable std::deque<DeferredTask> deferredTasks_;
+  // pipelines built on worker threads retire the pipelines they replace with deferred tasks
+  mutable std::mutex deferredTasksMutex_;
 
   std::unique_ptr<SyncManager> syncManager_;
 };
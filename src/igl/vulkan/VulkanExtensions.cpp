@@ -157,6 +157,9 @@ void VulkanExtensions::enableCommonExtensions(ExtensionType extensionType, bool
     enable(VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME, ExtensionType::Device);
 #endif
     enable(VK_KHR_GET_MEMORY_REQUIREMENTS_2_EXTENSION_NAME, ExtensionType::Device);
+#if defined(VK_EXT_vertex_attribute_divisor)
+    enable(VK_EXT_VERTEX_ATTRIBUTE_DIVISOR_EXTENSION_NAME, ExtensionType::Device);
+#endif // VK_EXT_vertex_attribute_divisor
   } else {
     IGL_ASSERT_MSG(false, "Unrecognized extension type when enabling commong extensions.");
   }
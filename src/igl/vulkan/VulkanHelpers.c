@@ -193,6 +193,20 @@ VkResult ivkAllocateCommandBuffer(VkDevice device,
   return vkAllocateCommandBuffers(device, &ai, outCommandBuffer);
 }
 
+VkResult ivkAllocateSecondaryCommandBuffer(VkDevice device,
+                                           VkCommandPool commandPool,
+                                           VkCommandBuffer* outCommandBuffer) {
+  const VkCommandBufferAllocateInfo ai = {
+      .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+      .pNext = NULL,
+      .commandPool = commandPool,
+      .level = VK_COMMAND_BUFFER_LEVEL_SECONDARY,
+      .commandBufferCount = 1,
+  };
+
+  return vkAllocateCommandBuffers(device, &ai, outCommandBuffer);
+}
+
 VkResult ivkAllocateMemory(VkPhysicalDevice physDev,
                            VkDevice device,
                            const VkMemoryRequirements* memRequirements,
@@ -292,6 +306,13 @@ VkResult ivkCreateDevice(VkPhysicalDevice physicalDevice,
                          const char** deviceExtensions,
                          VkBool32 enableMultiview,
                          VkBool32 enableShaderFloat16,
+                         VkBool32 enableOcclusionQueryPrecise,
+                         VkBool32 enablePipelineStatisticsQuery,
+                         VkBool32 enableVertexAttributeDivisor,
+                         VkBool32 enableDynamicRendering,
+                         VkBool32 enableExtendedDynamicState,
+                         VkBool32 enableExtendedDynamicState2,
+                         VkBool32 enableGraphicsPipelineLibrary,
                          VkDevice* outDevice) {
   assert(numQueueCreateInfos >= 1);
   const VkPhysicalDeviceFeatures deviceFeatures = {
@@ -299,6 +320,8 @@ VkResult ivkCreateDevice(VkPhysicalDevice physicalDevice,
       .drawIndirectFirstInstance = VK_TRUE,
       .depthBiasClamp = VK_TRUE,
       .fillModeNonSolid = VK_TRUE,
+      .occlusionQueryPrecise = enableOcclusionQueryPrecise,
+      .pipelineStatisticsQuery = enablePipelineStatisticsQuery,
       .shaderInt16 = VK_TRUE,
   };
   VkDeviceCreateInfo ci = {
@@ -353,6 +376,56 @@ VkResult ivkCreateDevice(VkPhysicalDevice physicalDevice,
   }
 #endif // defined(VK_KHR_multiview)
 
+#if defined(VK_EXT_vertex_attribute_divisor)
+  VkPhysicalDeviceVertexAttributeDivisorFeaturesEXT vertexAttributeDivisorFeature = {
+      .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VERTEX_ATTRIBUTE_DIVISOR_FEATURES_EXT,
+      .vertexAttributeInstanceRateDivisor = VK_TRUE,
+  };
+  if (enableVertexAttributeDivisor == VK_TRUE) {
+    ivkAddNext(&ci, &vertexAttributeDivisorFeature);
+  }
+#endif // defined(VK_EXT_vertex_attribute_divisor)
+
+#if defined(VK_KHR_dynamic_rendering)
+  VkPhysicalDeviceDynamicRenderingFeaturesKHR dynamicRenderingFeature = {
+      .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR,
+      .dynamicRendering = VK_TRUE,
+  };
+  if (enableDynamicRendering == VK_TRUE) {
+    ivkAddNext(&ci, &dynamicRenderingFeature);
+  }
+#endif // defined(VK_KHR_dynamic_rendering)
+
+#if defined(VK_EXT_extended_dynamic_state)
+  VkPhysicalDeviceExtendedDynamicStateFeaturesEXT extendedDynamicStateFeature = {
+      .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_FEATURES_EXT,
+      .extendedDynamicState = VK_TRUE,
+  };
+  if (enableExtendedDynamicState == VK_TRUE) {
+    ivkAddNext(&ci, &extendedDynamicStateFeature);
+  }
+#endif // defined(VK_EXT_extended_dynamic_state)
+
+#if defined(VK_EXT_extended_dynamic_state2)
+  VkPhysicalDeviceExtendedDynamicState2FeaturesEXT extendedDynamicState2Feature = {
+      .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_2_FEATURES_EXT,
+      .extendedDynamicState2 = VK_TRUE,
+  };
+  if (enableExtendedDynamicState2 == VK_TRUE) {
+    ivkAddNext(&ci, &extendedDynamicState2Feature);
+  }
+#endif // defined(VK_EXT_extended_dynamic_state2)
+
+#if defined(VK_EXT_graphics_pipeline_library)
+  VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT graphicsPipelineLibraryFeature = {
+      .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_FEATURES_EXT,
+      .graphicsPipelineLibrary = VK_TRUE,
+  };
+  if (enableGraphicsPipelineLibrary == VK_TRUE) {
+    ivkAddNext(&ci, &graphicsPipelineLibraryFeature);
+  }
+#endif // defined(VK_EXT_graphics_pipeline_library)
+
   return vkCreateDevice(physicalDevice, &ci, NULL, outDevice);
 }
 
@@ -801,6 +874,55 @@ VkResult ivkBeginCommandBuffer(VkCommandBuffer buffer) {
   return vkBeginCommandBuffer(buffer, &bi);
 }
 
+VkResult ivkBeginSecondaryCommandBuffer(VkCommandBuffer buffer,
+                                        VkRenderPass renderPass,
+                                        uint32_t subpass,
+                                        VkFramebuffer framebuffer) {
+  const VkCommandBufferInheritanceInfo ii = {
+      .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO,
+      .pNext = NULL,
+      .renderPass = renderPass,
+      .subpass = subpass,
+      .framebuffer = framebuffer,
+      .occlusionQueryEnable = VK_FALSE,
+      .queryFlags = 0,
+      .pipelineStatistics = 0,
+  };
+  const VkCommandBufferBeginInfo bi = {
+      .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+      .pNext = NULL,
+      .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT |
+               VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT,
+      .pInheritanceInfo = &ii,
+  };
+  return vkBeginCommandBuffer(buffer, &bi);
+}
+
+#if defined(VK_KHR_dynamic_rendering)
+VkResult ivkBeginSecondaryCommandBufferRendering(
+    VkCommandBuffer buffer,
+    const VkCommandBufferInheritanceRenderingInfoKHR* renderingInfo) {
+  const VkCommandBufferInheritanceInfo ii = {
+      .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO,
+      .pNext = renderingInfo,
+      .renderPass = VK_NULL_HANDLE,
+      .subpass = 0,
+      .framebuffer = VK_NULL_HANDLE,
+      .occlusionQueryEnable = VK_FALSE,
+      .queryFlags = 0,
+      .pipelineStatistics = 0,
+  };
+  const VkCommandBufferBeginInfo bi = {
+      .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+      .pNext = NULL,
+      .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT |
+               VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT,
+      .pInheritanceInfo = &ii,
+  };
+  return vkBeginCommandBuffer(buffer, &bi);
+}
+#endif // VK_KHR_dynamic_rendering
+
 VkResult ivkEndCommandBuffer(VkCommandBuffer buffer) {
   return vkEndCommandBuffer(buffer);
 }
@@ -1132,16 +1254,18 @@ VkPushConstantRange ivkGetPushConstantRange(VkShaderStageFlags stageFlags,
   return range;
 }
 
-VkPipelineShaderStageCreateInfo ivkGetPipelineShaderStageCreateInfo(VkShaderStageFlagBits stage,
-                                                                    VkShaderModule shaderModule,
-                                                                    const char* entryPoint) {
+VkPipelineShaderStageCreateInfo ivkGetPipelineShaderStageCreateInfo(
+    VkShaderStageFlagBits stage,
+    VkShaderModule shaderModule,
+    const char* entryPoint,
+    const VkSpecializationInfo* specializationInfo) {
   const VkPipelineShaderStageCreateInfo ci = {
       .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
       .flags = 0,
       .stage = stage,
       .module = shaderModule,
       .pName = entryPoint ? entryPoint : "main",
-      .pSpecializationInfo = NULL,
+      .pSpecializationInfo = specializationInfo,
   };
   return ci;
 }
@@ -1233,6 +1357,7 @@ VkResult ivkCreateShaderModuleFromSPIRV(VkDevice device,
 
 VkResult ivkCreateGraphicsPipeline(VkDevice device,
                                    VkPipelineCache pipelineCache,
+                                   VkPipelineCreateFlags flags,
                                    uint32_t numShaderStages,
                                    const VkPipelineShaderStageCreateInfo* shaderStages,
                                    const VkPipelineVertexInputStateCreateInfo* vertexInputState,
@@ -1246,11 +1371,12 @@ VkResult ivkCreateGraphicsPipeline(VkDevice device,
                                    const VkPipelineDynamicStateCreateInfo* dynamicState,
                                    VkPipelineLayout pipelineLayout,
                                    VkRenderPass renderPass,
+                                   const void* next,
                                    VkPipeline* outPipeline) {
   const VkGraphicsPipelineCreateInfo ci = {
       .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
-      .pNext = NULL,
-      .flags = 0,
+      .pNext = next,
+      .flags = flags,
       .stageCount = numShaderStages,
       .pStages = shaderStages,
       .pVertexInputState = vertexInputState,
@@ -1330,6 +1456,52 @@ void ivkBufferMemoryBarrier(VkCommandBuffer cmdBuffer,
   vkCmdPipelineBarrier(cmdBuffer, srcStageMask, dstStageMask, 0, 0, NULL, 1, &barrier, 0, NULL);
 }
 
+void ivkBufferOwnershipBarrier(VkCommandBuffer cmdBuffer,
+                               VkBuffer buffer,
+                               VkAccessFlags srcAccessMask,
+                               VkAccessFlags dstAccessMask,
+                               uint32_t srcQueueFamilyIndex,
+                               uint32_t dstQueueFamilyIndex,
+                               VkPipelineStageFlags srcStageMask,
+                               VkPipelineStageFlags dstStageMask) {
+  const VkBufferMemoryBarrier barrier = {
+      .sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+      .srcAccessMask = srcAccessMask,
+      .dstAccessMask = dstAccessMask,
+      .srcQueueFamilyIndex = srcQueueFamilyIndex,
+      .dstQueueFamilyIndex = dstQueueFamilyIndex,
+      .buffer = buffer,
+      .offset = 0,
+      .size = VK_WHOLE_SIZE,
+  };
+  vkCmdPipelineBarrier(cmdBuffer, srcStageMask, dstStageMask, 0, 0, NULL, 1, &barrier, 0, NULL);
+}
+
+void ivkImageOwnershipBarrier(VkCommandBuffer cmdBuffer,
+                              VkImage image,
+                              VkAccessFlags srcAccessMask,
+                              VkAccessFlags dstAccessMask,
+                              VkImageLayout oldImageLayout,
+                              VkImageLayout newImageLayout,
+                              uint32_t srcQueueFamilyIndex,
+                              uint32_t dstQueueFamilyIndex,
+                              VkPipelineStageFlags srcStageMask,
+                              VkPipelineStageFlags dstStageMask,
+                              VkImageSubresourceRange subresourceRange) {
+  const VkImageMemoryBarrier barrier = {
+      .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+      .srcAccessMask = srcAccessMask,
+      .dstAccessMask = dstAccessMask,
+      .oldLayout = oldImageLayout,
+      .newLayout = newImageLayout,
+      .srcQueueFamilyIndex = srcQueueFamilyIndex,
+      .dstQueueFamilyIndex = dstQueueFamilyIndex,
+      .image = image,
+      .subresourceRange = subresourceRange,
+  };
+  vkCmdPipelineBarrier(cmdBuffer, srcStageMask, dstStageMask, 0, 0, NULL, 0, NULL, 1, &barrier);
+}
+
 void ivkCmdBlitImage(VkCommandBuffer buffer,
                      VkImage srcImage,
                      VkImage dstImage,
@@ -64,6 +64,13 @@ VkResult ivkCreateDevice(VkPhysicalDevice physicalDevice,
                          const char** deviceExtensions,
                          VkBool32 enableMultiview,
                          VkBool32 enableShaderFloat16,
+                         VkBool32 enableOcclusionQueryPrecise,
+                         VkBool32 enablePipelineStatisticsQuery,
+                         VkBool32 enableVertexAttributeDivisor,
+                         VkBool32 enableDynamicRendering,
+                         VkBool32 enableExtendedDynamicState,
+                         VkBool32 enableExtendedDynamicState2,
+                         VkBool32 enableGraphicsPipelineLibrary,
                          VkDevice* outDevice);
 
 VkResult ivkCreateHeadlessSurface(VkInstance instance, VkSurfaceKHR* surface);
@@ -115,6 +122,10 @@ VkResult ivkAllocateCommandBuffer(VkDevice device,
                                   VkCommandPool commandPool,
                                   VkCommandBuffer* outCommandBuffer);
 
+VkResult ivkAllocateSecondaryCommandBuffer(VkDevice device,
+                                           VkCommandPool commandPool,
+                                           VkCommandBuffer* outCommandBuffer);
+
 VkResult ivkAllocateMemory(VkPhysicalDevice physDev,
                            VkDevice device,
                            const VkMemoryRequirements* memRequirements,
@@ -146,6 +157,7 @@ VkResult ivkCreateShaderModuleFromSPIRV(VkDevice device,
 
 VkResult ivkCreateGraphicsPipeline(VkDevice device,
                                    VkPipelineCache pipelineCache,
+                                   VkPipelineCreateFlags flags,
                                    uint32_t numShaderStages,
                                    const VkPipelineShaderStageCreateInfo* shaderStages,
                                    const VkPipelineVertexInputStateCreateInfo* vertexInputState,
@@ -159,6 +171,7 @@ VkResult ivkCreateGraphicsPipeline(VkDevice device,
                                    const VkPipelineDynamicStateCreateInfo* dynamicState,
                                    VkPipelineLayout pipelineLayout,
                                    VkRenderPass renderPass,
+                                   const void* next,
                                    VkPipeline* outPipeline);
 
 VkResult ivkCreateComputePipeline(VkDevice device,
@@ -210,6 +223,21 @@ VkResult ivkCreateDescriptorPool(VkDevice device,
 
 VkResult ivkBeginCommandBuffer(VkCommandBuffer buffer);
 
+/// @brief Begins a secondary command buffer which is executed inside the subpass `subpass` of
+/// `renderPass`
+VkResult ivkBeginSecondaryCommandBuffer(VkCommandBuffer buffer,
+                                        VkRenderPass renderPass,
+                                        uint32_t subpass,
+                                        VkFramebuffer framebuffer);
+
+#if defined(VK_KHR_dynamic_rendering)
+/// @brief Begins a secondary command buffer which is executed inside a render pass started with
+/// vkCmdBeginRenderingKHR() with the attachment formats described by `renderingInfo`
+VkResult ivkBeginSecondaryCommandBufferRendering(
+    VkCommandBuffer buffer,
+    const VkCommandBufferInheritanceRenderingInfoKHR* renderingInfo);
+#endif // VK_KHR_dynamic_rendering
+
 VkResult ivkEndCommandBuffer(VkCommandBuffer buffer);
 
 VkSubmitInfo ivkGetSubmitInfo(const VkCommandBuffer* buffer,
@@ -311,9 +339,11 @@ VkViewport ivkGetViewport(float x, float y, float width, float height);
 
 VkRect2D ivkGetRect2D(int32_t x, int32_t y, uint32_t width, uint32_t height);
 
-VkPipelineShaderStageCreateInfo ivkGetPipelineShaderStageCreateInfo(VkShaderStageFlagBits stage,
-                                                                    VkShaderModule shaderModule,
-                                                                    const char* entryPoint);
+VkPipelineShaderStageCreateInfo ivkGetPipelineShaderStageCreateInfo(
+    VkShaderStageFlagBits stage,
+    VkShaderModule shaderModule,
+    const char* entryPoint,
+    const VkSpecializationInfo* specializationInfo);
 
 VkImageCopy ivkGetImageCopy2D(VkOffset2D srcDstOffset,
                               VkImageSubresourceLayers srcDstImageSubresource,
@@ -350,6 +380,30 @@ void ivkBufferMemoryBarrier(VkCommandBuffer cmdBuffer,
                             VkPipelineStageFlags srcStageMask,
                             VkPipelineStageFlags dstStageMask);
 
+// Records a queue family ownership transfer barrier. The same barrier has to be recorded twice: as
+// a release operation on the source queue family and as an acquire operation on the destination
+// queue family
+void ivkBufferOwnershipBarrier(VkCommandBuffer cmdBuffer,
+                               VkBuffer buffer,
+                               VkAccessFlags srcAccessMask,
+                               VkAccessFlags dstAccessMask,
+                               uint32_t srcQueueFamilyIndex,
+                               uint32_t dstQueueFamilyIndex,
+                               VkPipelineStageFlags srcStageMask,
+                               VkPipelineStageFlags dstStageMask);
+
+void ivkImageOwnershipBarrier(VkCommandBuffer cmdBuffer,
+                              VkImage image,
+                              VkAccessFlags srcAccessMask,
+                              VkAccessFlags dstAccessMask,
+                              VkImageLayout oldImageLayout,
+                              VkImageLayout newImageLayout,
+                              uint32_t srcQueueFamilyIndex,
+                              uint32_t dstQueueFamilyIndex,
+                              VkPipelineStageFlags srcStageMask,
+                              VkPipelineStageFlags dstStageMask,
+                              VkImageSubresourceRange subresourceRange);
+
 void ivkCmdBlitImage(VkCommandBuffer buffer,
                      VkImage srcImage,
                      VkImage dstImage,
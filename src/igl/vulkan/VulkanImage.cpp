@@ -667,6 +667,8 @@ void VulkanImage::transitionLayout(VkCommandBuffer commandBuffer,
   case VK_PIPELINE_STAGE_TRANSFER_BIT:
   case VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT:
   case VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT:
+  case VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT:
+  case VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT:
     break;
   default:
     IGL_ASSERT_MSG(
@@ -680,9 +682,17 @@ void VulkanImage::transitionLayout(VkCommandBuffer commandBuffer,
     dstAccessMask |= VK_ACCESS_SHADER_READ_BIT;
     dstAccessMask |= VK_ACCESS_SHADER_WRITE_BIT;
   }
+  if (dstStageMask & VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT) {
+    dstAccessMask |= VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT;
+    dstAccessMask |= VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+  }
   if (dstStageMask & VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT) {
     dstAccessMask |= VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
   }
+  if (dstStageMask & VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT) {
+    dstAccessMask |= VK_ACCESS_COLOR_ATTACHMENT_READ_BIT;
+    dstAccessMask |= VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+  }
   if (dstStageMask & VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT) {
     dstAccessMask |= VK_ACCESS_SHADER_READ_BIT;
     dstAccessMask |= VK_ACCESS_INPUT_ATTACHMENT_READ_BIT;
@@ -7,6 +7,7 @@
 
 #include "VulkanImmediateCommands.h"
 
+#include <algorithm>
 #include <igl/vulkan/Common.h>
 #include <utility>
 
@@ -15,7 +16,8 @@ namespace vulkan {
 
 VulkanImmediateCommands::VulkanImmediateCommands(VkDevice device,
                                                  uint32_t queueFamilyIndex,
-                                                 const char* debugName) :
+                                                 const char* debugName,
+                                                 uint32_t queueIndex) :
   device_(device),
   commandPool_(device_,
                VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT |
@@ -25,7 +27,7 @@ VulkanImmediateCommands::VulkanImmediateCommands(VkDevice device,
   debugName_(debugName) {
   IGL_PROFILER_FUNCTION();
 
-  vkGetDeviceQueue(device, queueFamilyIndex, 0, &queue_);
+  vkGetDeviceQueue(device, queueFamilyIndex, queueIndex, &queue_);
 
   buffers_.reserve(kMaxCommandBuffers);
 
@@ -70,6 +72,8 @@ void VulkanImmediateCommands::purge() {
 const VulkanImmediateCommands::CommandBufferWrapper& VulkanImmediateCommands::acquire() {
   IGL_PROFILER_FUNCTION();
 
+  std::lock_guard<std::mutex> lock(mutex_);
+
   if (!numAvailableCommandBuffers_) {
     purge();
   }
@@ -98,9 +102,16 @@ const VulkanImmediateCommands::CommandBufferWrapper& VulkanImmediateCommands::ac
   IGL_ASSERT_MSG(current, "No available command buffers");
   IGL_ASSERT(current->cmdBufAllocated_ != VK_NULL_HANDLE);
 
-  current->handle_.submitId_ = submitCounter_;
+  // submit ids are assigned on acquisition so that the handles of command buffers which are encoded
+  // at the same time are unique
+  current->handle_.submitId_ = submitCounter_++;
   numAvailableCommandBuffers_--;
 
+  if (!submitCounter_) {
+    // skip the 0 value - when uint32_t wraps around (null SubmitHandle)
+    submitCounter_++;
+  }
+
   current->cmdBuf_ = current->cmdBufAllocated_;
   current->isEncoding_ = true;
   VK_ASSERT(ivkBeginCommandBuffer(current->cmdBuf_));
@@ -109,7 +120,9 @@ const VulkanImmediateCommands::CommandBufferWrapper& VulkanImmediateCommands::ac
 }
 
 void VulkanImmediateCommands::wait(const SubmitHandle handle) {
-  if (isReady(handle)) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if (isReadyLocked(handle, false)) {
     return;
   }
 
@@ -128,6 +141,8 @@ void VulkanImmediateCommands::wait(const SubmitHandle handle) {
 void VulkanImmediateCommands::waitAll() {
   IGL_PROFILER_FUNCTION_COLOR(IGL_PROFILER_COLOR_WAIT);
 
+  std::lock_guard<std::mutex> lock(mutex_);
+
   // @lint-ignore CLANGTIDY
   VkFence fences[kMaxCommandBuffers];
 
@@ -147,6 +162,13 @@ void VulkanImmediateCommands::waitAll() {
 }
 
 bool VulkanImmediateCommands::isReady(const SubmitHandle handle, bool fastCheckNoVulkan) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  return isReadyLocked(handle, fastCheckNoVulkan);
+}
+
+bool VulkanImmediateCommands::isReadyLocked(const SubmitHandle handle,
+                                            bool fastCheckNoVulkan) const {
   IGL_ASSERT(handle.bufferIndex_ < kMaxCommandBuffers);
 
   if (handle.empty()) {
@@ -175,12 +197,29 @@ bool VulkanImmediateCommands::isReady(const SubmitHandle handle, bool fastCheckN
   return vkWaitForFences(device_, 1, &buf.fence_.vkFence_, VK_TRUE, 0) == VK_SUCCESS;
 }
 
+void VulkanImmediateCommands::discard(const CommandBufferWrapper& wrapper) {
+  IGL_PROFILER_FUNCTION();
+  IGL_ASSERT(wrapper.isEncoding_);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  VK_ASSERT(vkEndCommandBuffer(wrapper.cmdBuf_));
+  VK_ASSERT(vkResetCommandBuffer(wrapper.cmdBuf_, VkCommandBufferResetFlags{0}));
+
+  CommandBufferWrapper& buf = const_cast<CommandBufferWrapper&>(wrapper);
+  buf.cmdBuf_ = VK_NULL_HANDLE;
+  buf.isEncoding_ = false;
+  numAvailableCommandBuffers_++;
+}
+
 VulkanImmediateCommands::SubmitHandle VulkanImmediateCommands::submit(
     const CommandBufferWrapper& wrapper) {
   IGL_PROFILER_FUNCTION_COLOR(IGL_PROFILER_COLOR_SUBMIT);
   IGL_ASSERT(wrapper.isEncoding_);
   VK_ASSERT(ivkEndCommandBuffer(wrapper.cmdBuf_));
 
+  std::lock_guard<std::mutex> lock(mutex_);
+
   // @lint-ignore CLANGTIDY
   const VkPipelineStageFlags waitStageMasks[] = {VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
                                                  VK_PIPELINE_STAGE_ALL_COMMANDS_BIT};
@@ -214,34 +253,58 @@ VulkanImmediateCommands::SubmitHandle VulkanImmediateCommands::submit(
 
   // reset
   const_cast<CommandBufferWrapper&>(wrapper).isEncoding_ = false;
-  submitCounter_++;
-
-  if (!submitCounter_) {
-    // skip the 0 value - when uint32_t wraps around (null SubmitHandle)
-    submitCounter_++;
-  }
 
   return lastSubmitHandle_;
 }
 
 void VulkanImmediateCommands::waitSemaphore(VkSemaphore semaphore) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
   IGL_ASSERT(waitSemaphore_ == VK_NULL_HANDLE);
 
   waitSemaphore_ = semaphore;
 }
 
 VkSemaphore VulkanImmediateCommands::acquireLastSubmitSemaphore() {
+  std::lock_guard<std::mutex> lock(mutex_);
+
   return std::exchange(lastSubmitSemaphore_, VK_NULL_HANDLE);
 }
 
 VulkanImmediateCommands::SubmitHandle VulkanImmediateCommands::getLastSubmitHandle() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+
   return lastSubmitHandle_;
 }
 
+std::vector<VulkanImmediateCommands::SubmitHandle>
+VulkanImmediateCommands::getEncodingSubmitHandles() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  std::vector<SubmitHandle> handles;
+
+  for (const auto& buf : buffers_) {
+    if (buf.isEncoding_) {
+      handles.push_back(buf.handle_);
+    }
+  }
+
+  return handles;
+}
+
+uint32_t VulkanImmediateCommands::getNumEncodingCommandBuffers() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  return static_cast<uint32_t>(std::count_if(
+      buffers_.begin(), buffers_.end(), [](const auto& buf) { return buf.isEncoding_; }));
+}
+
 VkFence VulkanImmediateCommands::getVkFenceFromSubmitHandle(SubmitHandle handle) {
   IGL_ASSERT(handle.bufferIndex_ < buffers_.size());
 
-  if (isReady(handle, true)) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if (isReadyLocked(handle, true)) {
     return VK_NULL_HANDLE;
   }
 
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <mutex>
 #include <vector>
 
 #include <igl/vulkan/Common.h>
@@ -18,13 +19,18 @@
 namespace igl {
 namespace vulkan {
 
+/// @brief Thread-safe: encoders recorded on other threads query submit handles while the thread
+/// which owns the queue acquires and submits command buffers.
 class VulkanImmediateCommands final {
  public:
   // the maximum number of command buffers which can similtaneously exist in the system; when we run
   // out of buffers, we stall and wait until an existing buffer becomes available
   static constexpr uint32_t kMaxCommandBuffers = 16;
 
-  VulkanImmediateCommands(VkDevice device, uint32_t queueFamilyIndex, const char* debugName);
+  VulkanImmediateCommands(VkDevice device,
+                          uint32_t queueFamilyIndex,
+                          const char* debugName,
+                          uint32_t queueIndex = 0);
   ~VulkanImmediateCommands();
   VulkanImmediateCommands(const VulkanImmediateCommands&) = delete;
   VulkanImmediateCommands& operator=(const VulkanImmediateCommands&) = delete;
@@ -61,16 +67,23 @@ class VulkanImmediateCommands final {
   // returns the current command buffer (creates one if it does not exist)
   const CommandBufferWrapper& acquire();
   SubmitHandle submit(const CommandBufferWrapper& wrapper);
+  // recycles a command buffer which was acquired but will never be submitted
+  void discard(const CommandBufferWrapper& wrapper);
   void waitSemaphore(VkSemaphore semaphore);
   VkSemaphore acquireLastSubmitSemaphore();
   SubmitHandle getLastSubmitHandle() const;
+  // handles of the command buffers which have been acquired but not submitted yet
+  std::vector<SubmitHandle> getEncodingSubmitHandles() const;
+  uint32_t getNumEncodingCommandBuffers() const;
   bool isReady(SubmitHandle handle, bool fastCheckNoVulkan = false) const;
   void wait(SubmitHandle handle);
   void waitAll();
   VkFence getVkFenceFromSubmitHandle(SubmitHandle handle);
 
  private:
+  // these expect `mutex_` to be locked
   void purge();
+  bool isReadyLocked(SubmitHandle handle, bool fastCheckNoVulkan) const;
 
  private:
   VkDevice device_ = VK_NULL_HANDLE;
@@ -83,6 +96,8 @@ class VulkanImmediateCommands final {
   VkSemaphore waitSemaphore_ = VK_NULL_HANDLE;
   uint32_t numAvailableCommandBuffers_ = kMaxCommandBuffers;
   uint32_t submitCounter_ = 1;
+  // guards all the members above
+  mutable std::mutex mutex_;
 };
 
 } // namespace vulkan
@@ -10,7 +10,7 @@
 namespace igl {
 namespace vulkan {
 
-uint32_t VulkanPipelineBuilder::numPipelinesCreated_ = 0;
+std::atomic<uint32_t> VulkanPipelineBuilder::numPipelinesCreated_{0};
 uint32_t VulkanComputePipelineBuilder::numPipelinesCreated_ = 0;
 
 VulkanPipelineBuilder::VulkanPipelineBuilder() :
@@ -119,12 +119,123 @@ VulkanPipelineBuilder& VulkanPipelineBuilder::stencilStateOps(VkStencilFaceFlags
   return *this;
 }
 
+VulkanPipelineBuilder& VulkanPipelineBuilder::renderingFormats(
+    const std::vector<VkFormat>& colorAttachmentFormats,
+    VkFormat depthAttachmentFormat,
+    VkFormat stencilAttachmentFormat,
+    uint32_t viewMask) {
+  useDynamicRendering_ = true;
+  colorAttachmentFormats_ = colorAttachmentFormats;
+  depthAttachmentFormat_ = depthAttachmentFormat;
+  stencilAttachmentFormat_ = stencilAttachmentFormat;
+  viewMask_ = viewMask;
+  return *this;
+}
+
 VkResult VulkanPipelineBuilder::build(VkDevice device,
                                       VkPipelineCache pipelineCache,
                                       VkPipelineLayout pipelineLayout,
                                       VkRenderPass renderPass,
                                       VkPipeline* outPipeline,
                                       const char* debugName) noexcept {
+  const VkResult result =
+      createPipeline(device, pipelineCache, pipelineLayout, renderPass, 0, 0, outPipeline);
+
+  if (!IGL_VERIFY(result == VK_SUCCESS)) {
+    return result;
+  }
+
+  numPipelinesCreated_++;
+
+  // set debug name
+  return ivkSetDebugObjectName(device, VK_OBJECT_TYPE_PIPELINE, (uint64_t)*outPipeline, debugName);
+}
+
+#if defined(VK_EXT_graphics_pipeline_library)
+VkResult VulkanPipelineBuilder::buildLibrary(VkDevice device,
+                                             VkPipelineCache pipelineCache,
+                                             VkPipelineLayout pipelineLayout,
+                                             VkRenderPass renderPass,
+                                             VkGraphicsPipelineLibraryFlagsEXT parts,
+                                             VkPipeline* outLibrary,
+                                             const char* debugName) noexcept {
+  IGL_ASSERT(parts != 0);
+
+  // the optimization info is retained so the libraries can be linked into optimized pipelines
+  const VkResult result =
+      createPipeline(device,
+                     pipelineCache,
+                     pipelineLayout,
+                     renderPass,
+                     VK_PIPELINE_CREATE_LIBRARY_BIT_KHR |
+                         VK_PIPELINE_CREATE_RETAIN_LINK_TIME_OPTIMIZATION_INFO_BIT_EXT,
+                     parts,
+                     outLibrary);
+
+  if (!IGL_VERIFY(result == VK_SUCCESS)) {
+    return result;
+  }
+
+  // set debug name
+  return ivkSetDebugObjectName(device, VK_OBJECT_TYPE_PIPELINE, (uint64_t)*outLibrary, debugName);
+}
+
+VkResult VulkanPipelineBuilder::link(VkDevice device,
+                                     VkPipelineCache pipelineCache,
+                                     VkPipelineLayout pipelineLayout,
+                                     const std::vector<VkPipeline>& libraries,
+                                     bool optimize,
+                                     VkPipeline* outPipeline,
+                                     const char* debugName) noexcept {
+  const VkPipelineLibraryCreateInfoKHR libraryInfo = {
+      VK_STRUCTURE_TYPE_PIPELINE_LIBRARY_CREATE_INFO_KHR,
+      nullptr,
+      (uint32_t)libraries.size(),
+      libraries.data(),
+  };
+
+  // all the state comes from the libraries
+  const VkResult result =
+      ivkCreateGraphicsPipeline(device,
+                                pipelineCache,
+                                optimize ? VK_PIPELINE_CREATE_LINK_TIME_OPTIMIZATION_BIT_EXT : 0,
+                                0,
+                                nullptr,
+                                nullptr,
+                                nullptr,
+                                nullptr,
+                                nullptr,
+                                nullptr,
+                                nullptr,
+                                nullptr,
+                                nullptr,
+                                nullptr,
+                                pipelineLayout,
+                                VK_NULL_HANDLE,
+                                &libraryInfo,
+                                outPipeline);
+
+  if (!IGL_VERIFY(result == VK_SUCCESS)) {
+    return result;
+  }
+
+  // optimized pipelines replace the ones which were linked first
+  if (!optimize) {
+    numPipelinesCreated_++;
+  }
+
+  // set debug name
+  return ivkSetDebugObjectName(device, VK_OBJECT_TYPE_PIPELINE, (uint64_t)*outPipeline, debugName);
+}
+#endif // VK_EXT_graphics_pipeline_library
+
+VkResult VulkanPipelineBuilder::createPipeline(VkDevice device,
+                                               VkPipelineCache pipelineCache,
+                                               VkPipelineLayout pipelineLayout,
+                                               VkRenderPass renderPass,
+                                               VkPipelineCreateFlags flags,
+                                               VkFlags libraryParts,
+                                               VkPipeline* outPipeline) const noexcept {
   const VkPipelineDynamicStateCreateInfo dynamicState =
       ivkGetPipelineDynamicStateCreateInfo((uint32_t)dynamicStates_.size(), dynamicStates_.data());
   // viewport and scissor are always dynamic
@@ -134,31 +245,69 @@ VkResult VulkanPipelineBuilder::build(VkDevice device,
       ivkGetPipelineColorBlendStateCreateInfo(uint32_t(colorBlendAttachmentStates_.size()),
                                               colorBlendAttachmentStates_.data());
 
-  const auto result = ivkCreateGraphicsPipeline(device,
-                                                pipelineCache,
-                                                (uint32_t)shaderStages_.size(),
-                                                shaderStages_.data(),
-                                                &vertexInputState_,
-                                                &inputAssembly_,
-                                                nullptr,
-                                                &viewportState,
-                                                &rasterizationState_,
-                                                &multisampleState_,
-                                                &depthStencilState_,
-                                                &colorBlendState,
-                                                &dynamicState,
-                                                pipelineLayout,
-                                                renderPass,
-                                                outPipeline);
-
-  if (!IGL_VERIFY(result == VK_SUCCESS)) {
-    return result;
+  const void* next = nullptr;
+#if defined(VK_KHR_dynamic_rendering)
+  const VkPipelineRenderingCreateInfoKHR renderingInfo = {
+      VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO_KHR,
+      nullptr,
+      viewMask_,
+      (uint32_t)colorAttachmentFormats_.size(),
+      colorAttachmentFormats_.data(),
+      depthAttachmentFormat_,
+      stencilAttachmentFormat_,
+  };
+  if (useDynamicRendering_) {
+    IGL_ASSERT(renderPass == VK_NULL_HANDLE);
+    next = &renderingInfo;
   }
+#else
+  IGL_ASSERT_MSG(!useDynamicRendering_, "VK_KHR_dynamic_rendering is not supported");
+#endif // VK_KHR_dynamic_rendering
 
-  numPipelinesCreated_++;
+  const std::vector<VkPipelineShaderStageCreateInfo>* stages = &shaderStages_;
 
-  // set debug name
-  return ivkSetDebugObjectName(device, VK_OBJECT_TYPE_PIPELINE, (uint64_t)*outPipeline, debugName);
+#if defined(VK_EXT_graphics_pipeline_library)
+  const VkGraphicsPipelineLibraryCreateInfoEXT libraryInfo = {
+      VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_LIBRARY_CREATE_INFO_EXT,
+      next,
+      libraryParts,
+  };
+  // a library contains only the shader stages of its parts
+  std::vector<VkPipelineShaderStageCreateInfo> libraryStages;
+  if (libraryParts) {
+    next = &libraryInfo;
+    for (const auto& stage : shaderStages_) {
+      if ((stage.stage == VK_SHADER_STAGE_VERTEX_BIT &&
+           (libraryParts & VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT)) ||
+          (stage.stage == VK_SHADER_STAGE_FRAGMENT_BIT &&
+           (libraryParts & VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT))) {
+        libraryStages.push_back(stage);
+      }
+    }
+    stages = &libraryStages;
+  }
+#else
+  IGL_ASSERT_MSG(!libraryParts, "VK_EXT_graphics_pipeline_library is not supported");
+#endif // VK_EXT_graphics_pipeline_library
+
+  return ivkCreateGraphicsPipeline(device,
+                                   pipelineCache,
+                                   flags,
+                                   (uint32_t)stages->size(),
+                                   stages->data(),
+                                   &vertexInputState_,
+                                   &inputAssembly_,
+                                   nullptr,
+                                   &viewportState,
+                                   &rasterizationState_,
+                                   &multisampleState_,
+                                   &depthStencilState_,
+                                   &colorBlendState,
+                                   &dynamicState,
+                                   pipelineLayout,
+                                   renderPass,
+                                   next,
+                                   outPipeline);
 }
 
 VulkanComputePipelineBuilder& VulkanComputePipelineBuilder::shaderStage(
@@ -8,6 +8,7 @@
 #pragma once
 
 #include <igl/vulkan/Common.h>
+#include <atomic>
 #include <igl/vulkan/VulkanHelpers.h>
 #include <vector>
 
@@ -39,7 +40,13 @@ class VulkanPipelineBuilder final {
   VulkanPipelineBuilder& vertexInputState(const VkPipelineVertexInputStateCreateInfo& state);
   VulkanPipelineBuilder& colorBlendAttachmentStates(
       std::vector<VkPipelineColorBlendAttachmentState>& states);
+  // creates the pipeline for dynamic rendering (VK_KHR_dynamic_rendering) instead of a render pass
+  VulkanPipelineBuilder& renderingFormats(const std::vector<VkFormat>& colorAttachmentFormats,
+                                          VkFormat depthAttachmentFormat,
+                                          VkFormat stencilAttachmentFormat,
+                                          uint32_t viewMask);
 
+  /// @param renderPass Must be VK_NULL_HANDLE when renderingFormats() was used.
   VkResult build(VkDevice device,
                  VkPipelineCache pipelineCache,
                  VkPipelineLayout pipelineLayout,
@@ -47,10 +54,43 @@ class VulkanPipelineBuilder final {
                  VkPipeline* outPipeline,
                  const char* debugName = nullptr) noexcept;
 
+#if defined(VK_EXT_graphics_pipeline_library)
+  /// @brief Builds a graphics pipeline library (VK_EXT_graphics_pipeline_library) which contains
+  /// only the `parts` of a pipeline. The state which does not belong to these parts is ignored
+  VkResult buildLibrary(VkDevice device,
+                        VkPipelineCache pipelineCache,
+                        VkPipelineLayout pipelineLayout,
+                        VkRenderPass renderPass,
+                        VkGraphicsPipelineLibraryFlagsEXT parts,
+                        VkPipeline* outLibrary,
+                        const char* debugName = nullptr) noexcept;
+
+  /// @brief Links libraries which contain all the parts of a graphics pipeline. Without `optimize`
+  /// linking is fast; with `optimize` the pipeline is compiled with link time optimizations
+  static VkResult link(VkDevice device,
+                       VkPipelineCache pipelineCache,
+                       VkPipelineLayout pipelineLayout,
+                       const std::vector<VkPipeline>& libraries,
+                       bool optimize,
+                       VkPipeline* outPipeline,
+                       const char* debugName = nullptr) noexcept;
+#endif // VK_EXT_graphics_pipeline_library
+
+  /// @brief The number of complete pipelines built or linked (optimized relinks are not counted)
   static uint32_t getNumPipelinesCreated() {
     return numPipelinesCreated_;
   }
 
+ private:
+  // `libraryParts` is 0 for a complete pipeline
+  VkResult createPipeline(VkDevice device,
+                          VkPipelineCache pipelineCache,
+                          VkPipelineLayout pipelineLayout,
+                          VkRenderPass renderPass,
+                          VkPipelineCreateFlags flags,
+                          VkFlags libraryParts,
+                          VkPipeline* outPipeline) const noexcept;
+
  private:
   std::vector<VkDynamicState> dynamicStates_;
   std::vector<VkPipelineShaderStageCreateInfo> shaderStages_;
@@ -60,7 +100,13 @@ class VulkanPipelineBuilder final {
   VkPipelineMultisampleStateCreateInfo multisampleState_;
   VkPipelineDepthStencilStateCreateInfo depthStencilState_;
   std::vector<VkPipelineColorBlendAttachmentState> colorBlendAttachmentStates_;
-  static uint32_t numPipelinesCreated_;
+  bool useDynamicRendering_ = false;
+  std::vector<VkFormat> colorAttachmentFormats_;
+  VkFormat depthAttachmentFormat_ = VK_FORMAT_UNDEFINED;
+  VkFormat stencilAttachmentFormat_ = VK_FORMAT_UNDEFINED;
+  uint32_t viewMask_ = 0;
+  // graphics pipelines can be built on worker threads
+  static std::atomic<uint32_t> numPipelinesCreated_;
 };
 
 class VulkanComputePipelineBuilder final {
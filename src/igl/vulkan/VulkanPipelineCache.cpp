@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/vulkan/VulkanPipelineCache.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <igl/CacheFile.h>
+#include <iterator>
+
+namespace {
+
+std::vector<uint8_t> readFile(const std::string& fileName) {
+  std::ifstream file(fileName, std::ios::binary);
+  if (!file) {
+    return {};
+  }
+  return std::vector<uint8_t>(std::istreambuf_iterator<char>(file),
+                              std::istreambuf_iterator<char>());
+}
+
+} // namespace
+
+namespace igl {
+namespace vulkan {
+
+VulkanPipelineCache::VulkanPipelineCache(VkDevice device,
+                                         const VkPhysicalDeviceProperties& properties,
+                                         const void* data,
+                                         size_t size,
+                                         std::string fileName,
+                                         uint32_t saveInterval) :
+  device_(device), fileName_(std::move(fileName)), saveInterval_(saveInterval) {
+  IGL_PROFILER_FUNCTION();
+
+  std::vector<uint8_t> fileData;
+
+  if (!data && !fileName_.empty()) {
+    fileData = readFile(fileName_);
+    data = fileData.data();
+    size = fileData.size();
+  }
+
+  if (data && size) {
+    hasInitialData_ = isCompatible(data, size, properties);
+    if (!hasInitialData_) {
+      IGL_LOG_INFO("Ignoring the pipeline cache data created for a different device or driver\n");
+    }
+  }
+
+  const VkPipelineCacheCreateInfo ci = {
+      VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+      nullptr,
+      VkPipelineCacheCreateFlags(0),
+      hasInitialData_ ? size : 0,
+      hasInitialData_ ? data : nullptr,
+  };
+  VK_ASSERT(vkCreatePipelineCache(device_, &ci, nullptr, &vkPipelineCache_));
+}
+
+VulkanPipelineCache::~VulkanPipelineCache() {
+  if (pendingWrite_.valid()) {
+    pendingWrite_.wait();
+  }
+
+  if (isDirty_ && !fileName_.empty()) {
+    save();
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  IGL_ASSERT_MSG(usedThreadCaches_.empty(), "Pipeline caches are still in use");
+
+  for (const ThreadCache& threadCache : freeThreadCaches_) {
+    vkDestroyPipelineCache(device_, threadCache.cache, nullptr);
+  }
+  vkDestroyPipelineCache(device_, vkPipelineCache_, nullptr);
+}
+
+bool VulkanPipelineCache::isCompatible(const void* data,
+                                       size_t size,
+                                       const VkPhysicalDeviceProperties& properties) {
+  // VkPipelineCacheHeaderVersionOne
+  constexpr size_t kHeaderSize = 4 * sizeof(uint32_t) + VK_UUID_SIZE;
+
+  if (!data || size < kHeaderSize) {
+    return false;
+  }
+
+  uint32_t header[4] = {};
+  memcpy(header, data, sizeof(header));
+
+  const uint32_t headerSize = header[0];
+  const uint32_t headerVersion = header[1];
+  const uint32_t vendorID = header[2];
+  const uint32_t deviceID = header[3];
+  const auto* uuid = static_cast<const uint8_t*>(data) + sizeof(header);
+
+  return headerSize >= kHeaderSize && headerSize <= size &&
+         headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+         vendorID == properties.vendorID && deviceID == properties.deviceID &&
+         memcmp(uuid, properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
+
+VkPipelineCache VulkanPipelineCache::acquire() {
+  IGL_PROFILER_FUNCTION();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if (!freeThreadCaches_.empty()) {
+    usedThreadCaches_.push_back(freeThreadCaches_.back());
+    freeThreadCaches_.pop_back();
+    return usedThreadCaches_.back().cache;
+  }
+
+  const VkPipelineCacheCreateInfo ci = {
+      VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+      nullptr,
+      VkPipelineCacheCreateFlags(0),
+      0,
+      nullptr,
+  };
+
+  VkPipelineCache cache = VK_NULL_HANDLE;
+  VK_ASSERT(vkCreatePipelineCache(device_, &ci, nullptr, &cache));
+
+  // seed the new cache with everything the main cache knows; the main cache is only a source here.
+  // Thread caches are never destroyed, so this happens once per concurrently building thread
+  VK_ASSERT(vkMergePipelineCaches(device_, cache, 1, &vkPipelineCache_));
+
+  usedThreadCaches_.push_back(ThreadCache{cache, getDataSize(cache), false});
+
+  return cache;
+}
+
+void VulkanPipelineCache::release(VkPipelineCache cache, bool hasCreatedPipelines) {
+  IGL_PROFILER_FUNCTION();
+
+  // the cache is still owned by the calling thread, so its size can be queried without the lock
+  const size_t size = hasCreatedPipelines ? getDataSize(cache) : 0;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  const auto it =
+      std::find_if(usedThreadCaches_.begin(),
+                   usedThreadCaches_.end(),
+                   [cache](const ThreadCache& threadCache) { return threadCache.cache == cache; });
+
+  if (!IGL_VERIFY(it != usedThreadCaches_.end())) {
+    return;
+  }
+
+  ThreadCache threadCache = *it;
+  usedThreadCaches_.erase(it);
+
+  // pipelines found in the cache do not change it
+  if (hasCreatedPipelines && size > threadCache.size) {
+    threadCache.size = size;
+    threadCache.hasNewPipelines = true;
+    isDirty_ = true;
+  }
+
+  freeThreadCaches_.push_back(threadCache);
+}
+
+void VulkanPipelineCache::mergeThreadCaches() {
+  std::vector<VkPipelineCache> caches;
+
+  for (ThreadCache& threadCache : freeThreadCaches_) {
+    if (threadCache.hasNewPipelines) {
+      caches.push_back(threadCache.cache);
+      threadCache.hasNewPipelines = false;
+    }
+  }
+
+  if (caches.empty()) {
+    return;
+  }
+
+  // the caches still in use are merged after they are released; the merged ones are kept, so
+  // acquire() does not have to seed new caches with the whole main cache
+  VK_ASSERT(vkMergePipelineCaches(
+      device_, vkPipelineCache_, static_cast<uint32_t>(caches.size()), caches.data()));
+}
+
+size_t VulkanPipelineCache::getDataSize(VkPipelineCache cache) const {
+  size_t size = 0;
+  VK_ASSERT(vkGetPipelineCacheData(device_, cache, &size, nullptr));
+  return size;
+}
+
+std::vector<uint8_t> VulkanPipelineCache::getData() {
+  IGL_PROFILER_FUNCTION();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  mergeThreadCaches();
+
+  size_t size = 0;
+  vkGetPipelineCacheData(device_, vkPipelineCache_, &size, nullptr);
+
+  std::vector<uint8_t> data(size);
+
+  if (size) {
+    vkGetPipelineCacheData(device_, vkPipelineCache_, &size, data.data());
+  }
+
+  return data;
+}
+
+void VulkanPipelineCache::autosave() {
+  IGL_PROFILER_FUNCTION();
+
+  if (fileName_.empty()) {
+    return;
+  }
+
+  framesSinceSave_++;
+
+  if (!isDirty_ || framesSinceSave_ < saveInterval_) {
+    return;
+  }
+
+  if (pendingWrite_.valid() &&
+      pendingWrite_.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+    // try again next frame
+    return;
+  }
+
+  framesSinceSave_ = 0;
+  isDirty_ = false;
+
+  // merging and serializing the caches can take a while, so they stay off the calling thread
+  pendingWrite_ =
+      std::async(std::launch::async, [this]() { return writeFile(fileName_, getData()); });
+}
+
+bool VulkanPipelineCache::save() {
+  IGL_PROFILER_FUNCTION();
+
+  if (fileName_.empty()) {
+    return false;
+  }
+
+  if (pendingWrite_.valid()) {
+    pendingWrite_.wait();
+  }
+
+  isDirty_ = false;
+
+  return writeFile(fileName_, getData());
+}
+
+bool VulkanPipelineCache::writeFile(const std::string& fileName, const std::vector<uint8_t>& data) {
+  if (data.empty()) {
+    return false;
+  }
+
+  // the data is written into a temporary file first, so a crash never leaves a truncated cache
+  return writeCacheFile(fileName, {{data.data(), data.size()}});
+}
+
+} // namespace vulkan
+} // namespace igl
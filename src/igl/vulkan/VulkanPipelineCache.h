@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <igl/vulkan/Common.h>
+
+namespace igl {
+namespace vulkan {
+
+/// @brief Owns the Vulkan pipeline cache of a context and manages its lifetime:
+/// 1. The initial data is validated against the physical device before it is used;
+/// 2. Every thread which builds pipelines gets its own pipeline cache (seeded with the main one),
+/// so threads do not contend for the main cache. The per-thread caches are kept for reuse; only
+/// the ones which received new pipelines are merged into the main cache with
+/// vkMergePipelineCaches(), and only when the data is requested;
+/// 3. When a file name is provided, the cache is loaded from it and saved back, in the background,
+/// after new pipelines were created.
+class VulkanPipelineCache final {
+ public:
+  /// @param data Initial cache data owned by the application. When it is null, the data is loaded
+  /// from `fileName`
+  /// @param fileName A file where the cache is saved. Saving is disabled when it is empty
+  /// @param saveInterval The minimal number of frames between two saves
+  VulkanPipelineCache(VkDevice device,
+                      const VkPhysicalDeviceProperties& properties,
+                      const void* data,
+                      size_t size,
+                      std::string fileName,
+                      uint32_t saveInterval);
+  ~VulkanPipelineCache();
+
+  VulkanPipelineCache(const VulkanPipelineCache&) = delete;
+  VulkanPipelineCache& operator=(const VulkanPipelineCache&) = delete;
+
+  /// @brief Returns true if the data starts with a pipeline cache header which matches the vendor,
+  /// the device and the pipeline cache UUID of the physical device
+  static bool isCompatible(const void* data,
+                           size_t size,
+                           const VkPhysicalDeviceProperties& properties);
+
+  /// @brief Returns a pipeline cache which can be used only by the calling thread until it is
+  /// released. Thread-safe
+  VkPipelineCache acquire();
+  /// @brief Returns the cache to the pool. Thread-safe
+  /// @param hasCreatedPipelines true if pipelines were created with this cache. They are new
+  /// (cache misses) only if the cache data has grown
+  void release(VkPipelineCache cache, bool hasCreatedPipelines);
+
+  /// @brief Merges all the per-thread caches and returns the serialized data. Thread-safe
+  std::vector<uint8_t> getData();
+
+  /// @brief Called once per frame: saves the cache to disk in the background when there are new
+  /// pipelines and at least `saveInterval` frames have passed since the last save. Merging and
+  /// serializing the caches happen in the background too
+  void autosave();
+  /// @brief Saves the cache to disk and waits until the data is written. Must not be called
+  /// concurrently with autosave()
+  bool save();
+
+  /// @brief Returns true if the initial data was valid and used to populate the cache
+  bool hasInitialData() const {
+    return hasInitialData_;
+  }
+
+ private:
+  struct ThreadCache {
+    VkPipelineCache cache = VK_NULL_HANDLE;
+    // the size of the cache data when the cache was created or last merged
+    size_t size = 0;
+    // pipelines were added since the cache was last merged into the main cache
+    bool hasNewPipelines = false;
+  };
+
+  // must be called with mutex_ locked
+  void mergeThreadCaches();
+  size_t getDataSize(VkPipelineCache cache) const;
+  static bool writeFile(const std::string& fileName, const std::vector<uint8_t>& data);
+
+ private:
+  VkDevice device_ = VK_NULL_HANDLE;
+  VkPipelineCache vkPipelineCache_ = VK_NULL_HANDLE;
+  std::string fileName_;
+  uint32_t saveInterval_ = 0;
+  uint32_t framesSinceSave_ = 0;
+  bool hasInitialData_ = false;
+  // pipelines were created since the last save
+  std::atomic<bool> isDirty_{false};
+
+  std::mutex mutex_;
+  // per-thread caches which are not in use
+  std::vector<ThreadCache> freeThreadCaches_;
+  // per-thread caches which are in use
+  std::vector<ThreadCache> usedThreadCaches_;
+  // the last background write
+  std::future<bool> pendingWrite_;
+};
+
+} // namespace vulkan
+} // namespace igl
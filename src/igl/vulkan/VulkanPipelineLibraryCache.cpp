@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/vulkan/VulkanPipelineLibraryCache.h>
+
+#include <utility>
+
+namespace igl {
+namespace vulkan {
+
+VulkanPipelineLibraryCache::Library::~Library() {
+  // linked pipelines do not depend on the libraries they were linked from
+  vkDestroyPipeline(device_, pipeline_, nullptr);
+}
+
+VulkanPipelineLibraryCache::VulkanPipelineLibraryCache(VkDevice device, size_t maxNumLibraries) :
+  device_(device), maxNumLibraries_(maxNumLibraries) {
+  IGL_ASSERT(device_ != VK_NULL_HANDLE);
+  IGL_ASSERT(maxNumLibraries_ > 0);
+}
+
+std::shared_ptr<const VulkanPipelineLibraryCache::Library> VulkanPipelineLibraryCache::getOrCreate(
+    const std::string& key,
+    const std::function<VkPipeline()>& createLibrary,
+    const std::shared_ptr<const void>& owner) {
+  IGL_PROFILER_FUNCTION();
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto it = index_.find(key);
+    if (it != index_.end() && !it->second->isExpired()) {
+      // mark the library as the most recently used one
+      entries_.splice(entries_.begin(), entries_, it->second);
+      return it->second->library;
+    }
+  }
+
+  const VkPipeline pipeline = createLibrary();
+
+  if (pipeline == VK_NULL_HANDLE) {
+    return nullptr;
+  }
+
+  auto library = std::make_shared<const Library>(device_, pipeline);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  const auto it = index_.find(key);
+  if (it != index_.end()) {
+    if (!it->second->isExpired()) {
+      // another thread has created the same library in the meantime
+      entries_.splice(entries_.begin(), entries_, it->second);
+      return it->second->library;
+    }
+    entries_.erase(it->second);
+    index_.erase(it);
+  }
+
+  entries_.push_front(Entry{key, library, owner, owner != nullptr});
+  index_[key] = entries_.begin();
+
+  evict();
+
+  return library;
+}
+
+void VulkanPipelineLibraryCache::evict() {
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (it->isExpired()) {
+      index_.erase(it->key);
+      it = entries_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  while (entries_.size() > maxNumLibraries_) {
+    index_.erase(entries_.back().key);
+    entries_.pop_back();
+  }
+}
+
+size_t VulkanPipelineLibraryCache::getNumLibraries() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_.size();
+}
+
+} // namespace vulkan
+} // namespace igl
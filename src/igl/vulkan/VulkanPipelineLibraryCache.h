@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <igl/vulkan/Common.h>
+
+namespace igl {
+namespace vulkan {
+
+/// @brief Graphics pipeline libraries (VK_EXT_graphics_pipeline_library) shared by all render
+/// pipeline states of a context. Each library contains one part of a graphics pipeline (vertex
+/// input, pre-rasterization shaders, fragment shader or fragment output interface) and is keyed by
+/// the complete state this part is built from, so pipelines which differ only in other parts (e.g.
+/// the same material used with different vertex formats) reuse it and are only linked.
+///
+/// The cache holds at most `maxNumLibraries` libraries and evicts the least recently used ones.
+/// Libraries are reference counted: an evicted library is destroyed once the last pipeline link
+/// using it is done. Objects whose handles are part of a key (like shader modules) are only weakly
+/// referenced; once such an object is destroyed, its libraries are evicted, so a handle reused by
+/// another object never finds a stale library.
+class VulkanPipelineLibraryCache final {
+ public:
+  static constexpr size_t kDefaultMaxNumLibraries = 1024;
+
+  /// @brief A graphics pipeline library which is destroyed with its last reference
+  struct Library final {
+    Library(VkDevice device, VkPipeline pipeline) : device_(device), pipeline_(pipeline) {}
+    ~Library();
+
+    Library(const Library&) = delete;
+    Library& operator=(const Library&) = delete;
+
+    VkDevice device_ = VK_NULL_HANDLE;
+    VkPipeline pipeline_ = VK_NULL_HANDLE;
+  };
+
+  explicit VulkanPipelineLibraryCache(VkDevice device,
+                                      size_t maxNumLibraries = kDefaultMaxNumLibraries);
+
+  VulkanPipelineLibraryCache(const VulkanPipelineLibraryCache&) = delete;
+  VulkanPipelineLibraryCache& operator=(const VulkanPipelineLibraryCache&) = delete;
+
+  /// @brief Returns the library for `key` or creates it with `createLibrary`. Libraries are created
+  /// without holding a lock, so concurrent requests for different libraries do not block each
+  /// other. Returns null if the library cannot be created. Thread-safe
+  /// @param owner An object referenced by the key. The library is evicted once it is destroyed
+  std::shared_ptr<const Library> getOrCreate(const std::string& key,
+                                             const std::function<VkPipeline()>& createLibrary,
+                                             const std::shared_ptr<const void>& owner = nullptr);
+
+  size_t getNumLibraries() const;
+
+ private:
+  struct Entry {
+    std::string key;
+    std::shared_ptr<const Library> library;
+    std::weak_ptr<const void> owner;
+    bool hasOwner = false;
+
+    bool isExpired() const {
+      return hasOwner && owner.expired();
+    }
+  };
+
+  // drops the libraries of destroyed owners and the least recently used ones above the limit
+  void evict();
+
+  VkDevice device_ = VK_NULL_HANDLE;
+  const size_t maxNumLibraries_;
+  mutable std::mutex mutex_;
+  // the most recently used libraries come first
+  std::list<Entry> entries_;
+  std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+};
+
+} // namespace vulkan
+} // namespace igl
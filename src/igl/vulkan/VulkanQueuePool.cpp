@@ -93,6 +93,19 @@ VulkanQueueDescriptor VulkanQueuePool::findQueueDescriptor(VkQueueFlags flags) c
   return {};
 }
 
+VulkanQueueDescriptor VulkanQueuePool::findDedicatedQueueDescriptor(
+    VkQueueFlags flags,
+    VkQueueFlags avoidFlags) const {
+  for (const auto& queueDescriptor : availableDescriptors_) {
+    const bool isSuitable = (queueDescriptor.queueFlags & flags) == flags;
+    const bool isDedicated = (queueDescriptor.queueFlags & avoidFlags) == 0;
+    if (isSuitable && isDedicated) {
+      return queueDescriptor;
+    }
+  }
+  return {};
+}
+
 void VulkanQueuePool::reserveQueue(const VulkanQueueDescriptor& queueDescriptor) {
   if (availableDescriptors_.erase(queueDescriptor) != 0) {
     reservedDescriptors_.insert(queueDescriptor);
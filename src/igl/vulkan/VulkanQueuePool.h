@@ -46,6 +46,13 @@ class VulkanQueuePool final {
   /* Find a queue descriptor that conforms to give queue flags. */
   VulkanQueueDescriptor findQueueDescriptor(VkQueueFlags flags) const;
 
+  /* Find a queue descriptor that supports the given queue flags and none of the avoided flags.
+   * Unlike findQueueDescriptor(), there is no fallback and an invalid descriptor is returned if
+   * there is no such queue.
+   */
+  VulkanQueueDescriptor findDedicatedQueueDescriptor(VkQueueFlags flags,
+                                                     VkQueueFlags avoidFlags) const;
+
   /* Reserve the given queue. Reserved queues will not be visible in future
    * find requests and they will participate in resulting queue creation infos.
    */
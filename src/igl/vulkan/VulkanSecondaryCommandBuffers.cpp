@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/vulkan/VulkanSecondaryCommandBuffers.h>
+
+#include <igl/vulkan/VulkanHelpers.h>
+
+namespace igl {
+namespace vulkan {
+
+VulkanSecondaryCommandBuffers::VulkanSecondaryCommandBuffers(VkDevice device,
+                                                             uint32_t queueFamilyIndex) :
+  device_(device), queueFamilyIndex_(queueFamilyIndex) {}
+
+VulkanSecondaryCommandBuffers::SecondaryCommandBuffer VulkanSecondaryCommandBuffers::acquire() {
+  IGL_PROFILER_FUNCTION();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if (!freeIndices_.empty()) {
+    const uint32_t index = freeIndices_.back();
+    freeIndices_.pop_back();
+    return SecondaryCommandBuffer{index, entries_[index].cmdBuf};
+  }
+
+  const auto index = static_cast<uint32_t>(entries_.size());
+
+  Entry entry;
+  entry.pool = std::make_unique<VulkanCommandPool>(
+      device_,
+      VK_COMMAND_POOL_CREATE_TRANSIENT_BIT,
+      queueFamilyIndex_,
+      IGL_FORMAT("VulkanSecondaryCommandBuffers ({})", index).c_str());
+  VK_ASSERT(
+      ivkAllocateSecondaryCommandBuffer(device_, entry.pool->getVkCommandPool(), &entry.cmdBuf));
+  entries_.push_back(std::move(entry));
+
+  return SecondaryCommandBuffer{index, entries_.back().cmdBuf};
+}
+
+void VulkanSecondaryCommandBuffers::release(uint32_t index) {
+  IGL_PROFILER_FUNCTION();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if (!IGL_VERIFY(index < entries_.size())) {
+    return;
+  }
+
+  // the pool is not used by any other thread while its command buffer is being released
+  VK_ASSERT(vkResetCommandPool(device_, entries_[index].pool->getVkCommandPool(), 0));
+
+  freeIndices_.push_back(index);
+}
+
+uint32_t VulkanSecondaryCommandBuffers::getNumAllocatedCommandBuffers() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  return static_cast<uint32_t>(entries_.size());
+}
+
+} // namespace vulkan
+} // namespace igl
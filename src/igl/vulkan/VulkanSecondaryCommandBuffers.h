@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <igl/vulkan/Common.h>
+#include <igl/vulkan/VulkanCommandPool.h>
+
+namespace igl {
+namespace vulkan {
+
+/// @brief A thread-safe cache of secondary command buffers which can be recorded concurrently.
+/// Every secondary command buffer is allocated from its own command pool, so it can be recorded on
+/// any thread without synchronizing with the other command buffers. Command buffers are recycled
+/// (and their pools are reset) once they are released after the GPU has finished executing them.
+class VulkanSecondaryCommandBuffers final {
+ public:
+  struct SecondaryCommandBuffer {
+    uint32_t index = 0;
+    VkCommandBuffer cmdBuf = VK_NULL_HANDLE;
+  };
+
+  VulkanSecondaryCommandBuffers(VkDevice device, uint32_t queueFamilyIndex);
+  VulkanSecondaryCommandBuffers(const VulkanSecondaryCommandBuffers&) = delete;
+  VulkanSecondaryCommandBuffers& operator=(const VulkanSecondaryCommandBuffers&) = delete;
+
+  /// @brief Returns a secondary command buffer which is not in use. Thread-safe
+  SecondaryCommandBuffer acquire();
+  /// @brief Makes the command buffer available for reuse. Must only be called after the GPU has
+  /// finished executing it. Thread-safe
+  void release(uint32_t index);
+
+  uint32_t getNumAllocatedCommandBuffers() const;
+
+ private:
+  struct Entry {
+    std::unique_ptr<VulkanCommandPool> pool;
+    VkCommandBuffer cmdBuf = VK_NULL_HANDLE;
+  };
+
+  VkDevice device_ = VK_NULL_HANDLE;
+  uint32_t queueFamilyIndex_ = 0;
+  mutable std::mutex mutex_;
+  std::vector<Entry> entries_;
+  std::vector<uint32_t> freeIndices_;
+};
+
+} // namespace vulkan
+} // namespace igl
@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/vulkan/VulkanShaderCache.h>
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <igl/CacheFile.h>
+
+namespace {
+
+// bump this whenever the compilation options or the patched shader header change
+constexpr uint32_t kCacheVersion = 2;
+constexpr uint32_t kCacheFileMagic = 0x53474C49; // 'IGLS'
+constexpr uint32_t kSPIRVMagic = 0x07230203;
+
+struct CacheFileHeader {
+  uint32_t magic = kCacheFileMagic;
+  uint32_t version = kCacheVersion;
+  uint64_t key = 0;
+  uint32_t numWords = 0;
+  // the source follows the header and precedes the SPIR-V binary
+  uint32_t sourceSize = 0;
+};
+
+} // namespace
+
+namespace igl {
+namespace vulkan {
+
+VulkanShaderCache::VulkanShaderCache(std::string directory, size_t maxNumEntries) :
+  directory_(std::move(directory)), maxNumEntries_(maxNumEntries) {
+  IGL_ASSERT(maxNumEntries_ > 0);
+
+  if (!directory_.empty() && directory_.back() != '/' && directory_.back() != '\\') {
+    directory_ += '/';
+  }
+}
+
+uint64_t VulkanShaderCache::computeKey(VkShaderStageFlagBits stage,
+                                       const char* source,
+                                       const glslang_resource_t& glslangResource) {
+  IGL_PROFILER_FUNCTION();
+
+  glslang_version_t glslangVersion = {};
+  glslang_get_version(&glslangVersion);
+
+  const size_t sourceSize = strlen(source);
+
+  uint64_t hash = kCacheHashOffsetBasis;
+
+  hash = hashCacheBytes(hash, &kCacheVersion, sizeof(kCacheVersion));
+  hash = hashCacheBytes(hash, &glslangVersion.major, sizeof(glslangVersion.major));
+  hash = hashCacheBytes(hash, &glslangVersion.minor, sizeof(glslangVersion.minor));
+  hash = hashCacheBytes(hash, &glslangVersion.patch, sizeof(glslangVersion.patch));
+  hash = hashCacheBytes(hash, &stage, sizeof(stage));
+  // all the integer limits followed by the boolean `limits` struct; skip the trailing padding
+  hash = hashCacheBytes(
+      hash, &glslangResource, offsetof(glslang_resource_t, limits) + sizeof(glslang_limits_t));
+  hash = hashCacheBytes(hash, &sourceSize, sizeof(sourceSize));
+  hash = hashCacheBytes(hash, source, sourceSize);
+
+  return hash;
+}
+
+bool VulkanShaderCache::find(uint64_t key, const char* source, std::vector<uint32_t>& outSPIRV) {
+  IGL_PROFILER_FUNCTION();
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    const auto it = index_.find(key);
+    if (it != index_.end() && it->second->source == source) {
+      // mark the entry as the most recently used one
+      entries_.splice(entries_.begin(), entries_, it->second);
+      outSPIRV = it->second->spirv;
+      numHits_++;
+      return true;
+    }
+  }
+
+  // the file is read without holding the lock
+  if (load(key, source, outSPIRV)) {
+    add(Entry{key, source, outSPIRV});
+    numHits_++;
+    return true;
+  }
+
+  numMisses_++;
+
+  return false;
+}
+
+void VulkanShaderCache::insert(uint64_t key,
+                               const char* source,
+                               const std::vector<uint32_t>& spirv) {
+  IGL_PROFILER_FUNCTION();
+
+  if (spirv.empty()) {
+    return;
+  }
+
+  Entry entry{key, source, spirv};
+
+  if (!directory_.empty()) {
+    store(entry);
+  }
+
+  add(std::move(entry));
+}
+
+bool VulkanShaderCache::add(Entry entry) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  const auto it = index_.find(entry.key);
+  if (it != index_.end()) {
+    if (it->second->source == entry.source) {
+      // another thread has compiled the same shader
+      return false;
+    }
+    // a hash collision: the newest source wins
+    entries_.erase(it->second);
+    index_.erase(it);
+  }
+
+  entries_.push_front(std::move(entry));
+  index_[entries_.front().key] = entries_.begin();
+
+  while (entries_.size() > maxNumEntries_) {
+    index_.erase(entries_.back().key);
+    entries_.pop_back();
+  }
+
+  return true;
+}
+
+std::string VulkanShaderCache::getFileName(uint64_t key) const {
+  char name[20];
+  snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(key));
+  return directory_ + name + ".spv";
+}
+
+bool VulkanShaderCache::load(uint64_t key,
+                             const char* source,
+                             std::vector<uint32_t>& outSPIRV) const {
+  if (directory_.empty()) {
+    return false;
+  }
+
+  std::ifstream file(getFileName(key), std::ios::binary);
+  if (!file) {
+    return false;
+  }
+
+  CacheFileHeader header;
+  if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+    return false;
+  }
+
+  const size_t sourceSize = strlen(source);
+
+  if (header.magic != kCacheFileMagic || header.version != kCacheVersion || header.key != key ||
+      header.numWords == 0 || header.sourceSize != sourceSize) {
+    IGL_LOG_INFO("Ignoring an incompatible SPIR-V cache file for key %016llx\n",
+                 static_cast<unsigned long long>(key));
+    return false;
+  }
+
+  std::string cachedSource(sourceSize, '\0');
+  if (!file.read(cachedSource.data(), cachedSource.size())) {
+    IGL_LOG_INFO("Ignoring a truncated SPIR-V cache file for key %016llx\n",
+                 static_cast<unsigned long long>(key));
+    return false;
+  }
+
+  if (cachedSource != source) {
+    IGL_LOG_INFO("Ignoring a SPIR-V cache file compiled from another source for key %016llx\n",
+                 static_cast<unsigned long long>(key));
+    return false;
+  }
+
+  std::vector<uint32_t> spirv(header.numWords);
+  if (!file.read(reinterpret_cast<char*>(spirv.data()), spirv.size() * sizeof(uint32_t)) ||
+      spirv[0] != kSPIRVMagic) {
+    IGL_LOG_INFO("Ignoring a truncated SPIR-V cache file for key %016llx\n",
+                 static_cast<unsigned long long>(key));
+    return false;
+  }
+
+  outSPIRV = std::move(spirv);
+
+  return true;
+}
+
+void VulkanShaderCache::store(const Entry& entry) const {
+  CacheFileHeader header;
+  header.key = entry.key;
+  header.numWords = static_cast<uint32_t>(entry.spirv.size());
+  header.sourceSize = static_cast<uint32_t>(entry.source.size());
+
+  writeCacheFile(getFileName(entry.key),
+                 {
+                     {&header, sizeof(header)},
+                     {entry.source.data(), entry.source.size()},
+                     {entry.spirv.data(), entry.spirv.size() * sizeof(uint32_t)},
+                 });
+}
+
+} // namespace vulkan
+} // namespace igl
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <igl/vulkan/Common.h>
+#include <igl/vulkan/VulkanHelpers.h>
+
+namespace igl {
+namespace vulkan {
+
+/// @brief A thread-safe content-addressed cache of SPIR-V binaries compiled from GLSL. Entries are
+/// addressed by a hash of everything which affects the compilation result: the final (patched)
+/// shader source, the shader stage, the glslang resource limits and the glslang version. Every
+/// entry also keeps its source, which is compared on lookup, so hash collisions never return the
+/// wrong binary. The in-memory layer holds at most `maxNumEntries` entries and evicts the least
+/// recently used ones. It can be backed by an on-disk directory, so compiled shaders survive
+/// application restarts.
+class VulkanShaderCache final {
+ public:
+  static constexpr size_t kDefaultMaxNumEntries = 256;
+
+  /// @param directory An existing directory where SPIR-V binaries are stored as `<key>.spv` files.
+  /// The on-disk layer is disabled when it is empty
+  explicit VulkanShaderCache(std::string directory,
+                             size_t maxNumEntries = kDefaultMaxNumEntries);
+  VulkanShaderCache(const VulkanShaderCache&) = delete;
+  VulkanShaderCache& operator=(const VulkanShaderCache&) = delete;
+
+  /// @brief Returns the key for the shader source compiled for the stage with the resource limits
+  static uint64_t computeKey(VkShaderStageFlagBits stage,
+                             const char* source,
+                             const glslang_resource_t& glslangResource);
+
+  /// @brief Looks up the key in memory and then on disk. Thread-safe
+  /// @return true if the SPIR-V binary compiled from `source` was found and copied into `outSPIRV`
+  bool find(uint64_t key, const char* source, std::vector<uint32_t>& outSPIRV);
+  /// @brief Adds the SPIR-V binary to the in-memory layer and writes it to disk. Thread-safe
+  void insert(uint64_t key, const char* source, const std::vector<uint32_t>& spirv);
+
+  uint32_t getNumHits() const {
+    return numHits_;
+  }
+  uint32_t getNumMisses() const {
+    return numMisses_;
+  }
+  size_t getNumEntries() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+  }
+
+ private:
+  struct Entry {
+    uint64_t key = 0;
+    std::string source;
+    std::vector<uint32_t> spirv;
+  };
+
+  std::string getFileName(uint64_t key) const;
+  bool load(uint64_t key, const char* source, std::vector<uint32_t>& outSPIRV) const;
+  void store(const Entry& entry) const;
+  // adds the entry as the most recently used one and evicts the least recently used ones. Returns
+  // false if the key is already cached
+  bool add(Entry entry);
+
+ private:
+  std::string directory_;
+  const size_t maxNumEntries_;
+  mutable std::mutex mutex_;
+  // the most recently used entries are at the front
+  std::list<Entry> entries_;
+  std::unordered_map<uint64_t, std::list<Entry>::iterator> index_;
+  std::atomic<uint32_t> numHits_{0};
+  std::atomic<uint32_t> numMisses_{0};
+};
+
+} // namespace vulkan
+} // namespace igl
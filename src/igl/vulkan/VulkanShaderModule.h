@@ -8,6 +8,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include <igl/vulkan/Common.h>
 #include <igl/vulkan/VulkanHelpers.h>
@@ -21,6 +22,12 @@ Result compileShader(VkDevice device,
                      VkShaderModule* outShaderModule,
                      const glslang_resource_t* glslLangResource = nullptr);
 
+/** @brief Compiles GLSL into a SPIR-V binary without creating a shader module */
+Result compileShader(VkShaderStageFlagBits stage,
+                     const char* code,
+                     std::vector<uint32_t>& outSPIRV,
+                     const glslang_resource_t* glslLangResource = nullptr);
+
 /**
  * @brief RAII wrapper for a Vulkan shader module.
  */
@@ -7,6 +7,9 @@
 
 #include <igl/vulkan/VulkanStagingDevice.h>
 
+#include <algorithm>
+#include <utility>
+
 #include <igl/IGLSafeC.h>
 #include <igl/vulkan/Common.h>
 #include <igl/vulkan/VulkanBuffer.h>
@@ -43,11 +46,14 @@ VulkanStagingDevice::VulkanStagingDevice(VulkanContext& ctx) : ctx_(ctx) {
 
   const auto& limits = ctx_.getVkPhysicalDeviceProperties().limits;
 
-  // Use default value of 256 MB, and clamp it to the max limits
-  stagingBufferSize_ = std::min(limits.maxStorageBufferRange, 256u * 1024u * 1024u);
+  // Use the configured size (256 MB by default), and clamp it to the max limits
+  stagingBufferSize_ = std::min(limits.maxStorageBufferRange, ctx_.config_.stagingBufferSize);
+  IGL_ASSERT(stagingBufferSize_ >= stagingBufferAlignment_);
 
   bufferCapacity_ = stagingBufferSize_;
 
+  readbackBufferSize_ = ctx_.config_.readbackBufferSize & ~(stagingBufferAlignment_ - 1);
+
   stagingBuffer_ =
       ctx_.createBuffer(stagingBufferSize_,
                         VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
@@ -61,41 +67,84 @@ VulkanStagingDevice::VulkanStagingDevice(VulkanContext& ctx) : ctx_(ctx) {
       ctx_.deviceQueues_.graphicsQueueFamilyIndex,
       "VulkanStagingDevice::immediate_");
   IGL_ASSERT(immediate_.get());
+
+  if (ctx_.deviceQueues_.transferQueueFamilyIndex != DeviceQueues::INVALID) {
+    transferImmediate_ = std::make_unique<igl::vulkan::VulkanImmediateCommands>(
+        ctx_.device_->getVkDevice(),
+        ctx_.deviceQueues_.transferQueueFamilyIndex,
+        "VulkanStagingDevice::transferImmediate_",
+        ctx_.deviceQueues_.transferQueueIndex);
+    IGL_ASSERT(transferImmediate_.get());
+  }
 }
 
-void VulkanStagingDevice::bufferSubData(VulkanBuffer& buffer,
-                                        size_t dstOffset,
-                                        size_t size,
-                                        const void* data) {
+VulkanSubmitHandle VulkanStagingDevice::bufferSubData(VulkanBuffer& buffer,
+                                                      size_t dstOffset,
+                                                      size_t size,
+                                                      const void* data,
+                                                      bool nonBlocking,
+                                                      bool isUnusedByGpu) {
   IGL_PROFILER_FUNCTION();
   if (buffer.isMapped()) {
     buffer.bufferSubData(dstOffset, size, data);
-    return;
+    return {};
   }
 
   size_t chunkDstOffset = dstOffset;
   void* copyData = const_cast<void*>(data);
 
+  VulkanSubmitHandle lastFenceId;
+
   while (size) {
     // get next staging buffer free offset
-    const MemoryRegionDesc desc = getNextFreeOffset((uint32_t)size);
+    MemoryRegionDesc desc = getNextFreeOffset((uint32_t)size, nonBlocking);
     const uint32_t chunkSize = std::min((uint32_t)size, desc.alignedSize_);
+    VulkanBuffer& srcBuffer = desc.transientBuffer_ ? *desc.transientBuffer_ : *stagingBuffer_;
 
     // copy data into staging buffer
-    stagingBuffer_->bufferSubData(desc.srcOffset_, chunkSize, copyData);
+    srcBuffer.bufferSubData(desc.srcOffset_, chunkSize, copyData);
 
     // do the transfer
     const VkBufferCopy copy = {desc.srcOffset_, chunkDstOffset, chunkSize};
 
-    auto& wrapper = immediate_->acquire();
-    vkCmdCopyBuffer(wrapper.cmdBuf_, stagingBuffer_->getVkBuffer(), buffer.getVkBuffer(), 1, &copy);
-    const VulkanSubmitHandle fenceId = immediate_->submit(wrapper);
-    outstandingFences_[fenceId.handle()] = desc;
+    // Only uploads replacing the entire buffer can go through the dedicated transfer queue: the
+    // graphics queue does not release the buffer, so its previous contents are not preserved.
+    // Batched copies always go through the graphics queue
+    const bool useTransferQueue = chunkDstOffset == 0 && chunkSize == buffer.getSize() &&
+                                  shouldUseTransferQueue(chunkSize);
+
+    if (ctx_.config_.batchStagingBufferCopies) {
+      lastFenceId = enqueueBufferCopy(srcBuffer.getVkBuffer(), buffer.getVkBuffer(), copy);
+    } else if (useTransferQueue) {
+      const uint32_t transferFamily = ctx_.deviceQueues_.transferQueueFamilyIndex;
+      const uint32_t graphicsFamily = ctx_.deviceQueues_.graphicsQueueFamilyIndex;
+      auto& wrapper = transferImmediate_->acquire();
+      vkCmdCopyBuffer(wrapper.cmdBuf_, srcBuffer.getVkBuffer(), buffer.getVkBuffer(), 1, &copy);
+      const auto ownershipBarrier = [&](VkCommandBuffer cmdBuf, bool isRelease) {
+        ivkBufferOwnershipBarrier(
+            cmdBuf,
+            buffer.getVkBuffer(),
+            isRelease ? VK_ACCESS_TRANSFER_WRITE_BIT : 0,
+            isRelease ? 0 : VK_ACCESS_MEMORY_READ_BIT,
+            transferFamily,
+            graphicsFamily,
+            isRelease ? VK_PIPELINE_STAGE_TRANSFER_BIT : VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+            isRelease ? VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT : VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+      };
+      lastFenceId = submitTransfer(wrapper, !isUnusedByGpu, ownershipBarrier);
+    } else {
+      auto& wrapper = immediate_->acquire();
+      vkCmdCopyBuffer(wrapper.cmdBuf_, srcBuffer.getVkBuffer(), buffer.getVkBuffer(), 1, &copy);
+      lastFenceId = immediate_->submit(wrapper);
+    }
+    markRegionInUse(lastFenceId, std::move(desc));
 
     size -= chunkSize;
     copyData = (uint8_t*)copyData + chunkSize;
     chunkDstOffset += chunkSize;
   }
+
+  return lastFenceId;
 }
 
 void VulkanStagingDevice::getBufferSubData(VulkanBuffer& buffer,
@@ -103,6 +152,10 @@ void VulkanStagingDevice::getBufferSubData(VulkanBuffer& buffer,
                                            size_t size,
                                            void* data) {
   IGL_PROFILER_FUNCTION();
+
+  // keep the order of operations with respect to the batched copies
+  flushPendingCopies();
+
   if (buffer.isMapped()) {
     buffer.getBufferSubData(srcOffset, size, data);
     return;
@@ -124,7 +177,7 @@ void VulkanStagingDevice::getBufferSubData(VulkanBuffer& buffer,
     vkCmdCopyBuffer(wrapper.cmdBuf_, buffer.getVkBuffer(), stagingBuffer_->getVkBuffer(), 1, &copy);
 
     VulkanSubmitHandle fenceId = immediate_->submit(wrapper);
-    outstandingFences_[fenceId.handle()] = desc;
+    outstandingFences_.emplace(fenceId.handle(), desc);
 
     // Wait for command to finish
     flushOutstandingFences();
@@ -139,199 +192,333 @@ void VulkanStagingDevice::getBufferSubData(VulkanBuffer& buffer,
   }
 }
 
-void VulkanStagingDevice::imageData2D(VulkanImage& image,
-                                      const VkRect2D& imageRegion,
-                                      uint32_t baseMipLevel,
-                                      uint32_t numMipLevels,
-                                      uint32_t layer,
-                                      TextureFormatProperties properties,
-                                      VkFormat format,
-                                      const void* data) {
+VulkanSubmitHandle VulkanStagingDevice::imageData2D(VulkanImage& image,
+                                                    const VkRect2D& imageRegion,
+                                                    uint32_t baseMipLevel,
+                                                    uint32_t numMipLevels,
+                                                    uint32_t layer,
+                                                    TextureFormatProperties properties,
+                                                    VkFormat format,
+                                                    const void* data,
+                                                    bool nonBlocking) {
   IGL_PROFILER_FUNCTION();
-  // cache the dimensions of each mip level for later
-  std::vector<uint32_t> mipSizes;
-  mipSizes.reserve(numMipLevels);
 
-  // divide the width and height by 2 until we get to the size of level 'baseMipLevel'
-  auto width = image.extent_.width >> baseMipLevel;
-  auto height = image.extent_.height >> baseMipLevel;
+  // keep the order of operations with respect to the batched copies
+  flushPendingCopies();
 
-  IGL_ASSERT_MSG(
-      imageRegion.offset.x == 0 && imageRegion.offset.y == 0 && imageRegion.extent.width == width &&
-          imageRegion.extent.height == height,
+  IGL_ASSERT(baseMipLevel + numMipLevels <= image.mipLevels_);
 
-      "Uploading mip levels with an image region that is smaller than the base mip level is "
-      "not supported");
+  const auto range = TextureRangeDesc::new2D(0, 0, image.extent_.width, image.extent_.height);
+  const auto baseRange = range.atMipLevel(baseMipLevel);
+
+  IGL_ASSERT_MSG(imageRegion.offset.x == 0 && imageRegion.offset.y == 0 &&
+                     imageRegion.extent.width == baseRange.width &&
+                     imageRegion.extent.height == baseRange.height,
+                 "Uploading mip levels with an image region that is smaller than the base mip "
+                 "level is not supported");
+
+  // cache the layout of each mip level for later; the pixel data of all levels is tightly packed
+  std::vector<MipLevelLayout> mipLevels;
+  mipLevels.reserve(numMipLevels);
 
   // find the storage size for all mip levels being uploaded
-  const auto range = TextureRangeDesc::new2D(0, 0, image.extent_.width, image.extent_.height);
   uint32_t storageSize = 0;
-  for (size_t i = 0; i < numMipLevels; ++i) {
-    const uint32_t mipSize =
-        static_cast<uint32_t>(properties.getBytesPerRange(range.atMipLevel(i)));
-
-    storageSize += mipSize;
-    mipSizes.push_back(mipSize);
-    width = width <= 1 ? 1 : width >> 1; // divide the width by 2
-    height = height <= 1 ? 1 : height >> 1; // divide the height by 2
+  for (uint32_t mipLevel = 0; mipLevel < numMipLevels; ++mipLevel) {
+    mipLevels.push_back(getMipLevelLayout(range.atMipLevel(baseMipLevel + mipLevel), properties));
+    storageSize += mipLevels.back().getSize();
   }
 
-  IGL_ASSERT(storageSize <= stagingBufferSize_);
+  const bool useTransferQueue = shouldUseTransferQueue(storageSize);
+  // the contents of images which have never been used by the GPU are undefined
+  const bool waitForGraphicsQueue = image.imageLayout_ != VK_IMAGE_LAYOUT_UNDEFINED;
+  const auto* srcData = static_cast<const uint8_t*>(data);
 
-  // get next staging buffer free offset
-  MemoryRegionDesc desc = getNextFreeOffset(storageSize);
+  VulkanSubmitHandle fenceId;
 
-  // currently, no support for copying image in multiple smaller chunk sizes.
-  // If we get smaller buffer size than storageSize, we will wait for gpu idle and get bigger chunk.
-  if (desc.alignedSize_ < storageSize) {
-    flushOutstandingFences();
-    desc = getNextFreeOffset(storageSize);
-  }
+  // the upload position: the mip level and its first row (of texel blocks) not uploaded yet
+  uint32_t mipLevel = 0;
+  uint32_t row = 0;
 
-  IGL_ASSERT(desc.alignedSize_ >= storageSize);
+  // Every iteration fills one staging memory region with as many whole mip levels and bands of
+  // rows as it can hold, so uploads of any size are streamed through the bounded staging ring
+  while (mipLevel < numMipLevels) {
+    MemoryRegionDesc desc = getNextFreeOffset(storageSize, nonBlocking);
 
-  // 1. Copy the pixel data into the host visible staging buffer
-  stagingBuffer_->bufferSubData(desc.srcOffset_, storageSize, data);
+    // If we cannot fit even a single row, we will wait for gpu idle and get bigger chunk.
+    if (desc.alignedSize_ < mipLevels[mipLevel].bytesPerRow) {
+      flushOutstandingFences();
+      desc = getNextFreeOffset(storageSize);
+    }
 
-  auto& wrapper = immediate_->acquire();
+    IGL_ASSERT(desc.alignedSize_ >= mipLevels[mipLevel].bytesPerRow);
 
-  uint32_t mipLevelOffset = 0;
+    VulkanBuffer& srcBuffer = desc.transientBuffer_ ? *desc.transientBuffer_ : *stagingBuffer_;
 
-  for (uint32_t mipLevel = 0; mipLevel < numMipLevels; ++mipLevel) {
-    const auto currentMipLevel = baseMipLevel + mipLevel;
+    auto& wrapper = useTransferQueue ? transferImmediate_->acquire() : immediate_->acquire();
 
-    IGL_ASSERT(currentMipLevel < image.mipLevels_);
-    IGL_ASSERT(mipLevel < image.mipLevels_);
+    // the mip levels which are completely uploaded by this chunk
+    const uint32_t firstCompletedMipLevel = baseMipLevel + mipLevel;
+    uint32_t numCompletedMipLevels = 0;
 
-    // 1. Transition initial image layout into TRANSFER_DST_OPTIMAL
-    ivkImageMemoryBarrier(
-        wrapper.cmdBuf_,
-        image.getVkImage(),
-        0,
-        VK_ACCESS_TRANSFER_WRITE_BIT,
-        VK_IMAGE_LAYOUT_UNDEFINED,
-        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-        VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
-        VK_PIPELINE_STAGE_TRANSFER_BIT,
-        VkImageSubresourceRange{VK_IMAGE_ASPECT_COLOR_BIT, currentMipLevel, 1, layer, 1});
-
-    // 2. Copy the pixel data from the staging buffer into the image
-    const VkRect2D region = ivkGetRect2D(imageRegion.offset.x >> mipLevel,
-                                         imageRegion.offset.y >> mipLevel,
-                                         std::max(1u, imageRegion.extent.width >> mipLevel),
-                                         std::max(1u, imageRegion.extent.height >> mipLevel));
+    uint32_t regionOffset = 0;
 
-    const VkBufferImageCopy copy = ivkGetBufferImageCopy2D(
-        desc.srcOffset_ + mipLevelOffset, // the offset for this level is at the start of all mip
-                                          // levels + the size of all previous mip levels being
-                                          // uploaded
-        region,
-        VkImageSubresourceLayers{VK_IMAGE_ASPECT_COLOR_BIT, currentMipLevel, layer, 1});
+    while (mipLevel < numMipLevels) {
+      const MipLevelLayout& mip = mipLevels[mipLevel];
+      const uint32_t numRows =
+          std::min(mip.numRows - row, (desc.alignedSize_ - regionOffset) / mip.bytesPerRow);
+      if (numRows == 0) {
+        break;
+      }
+      const uint32_t chunkSize = numRows * mip.bytesPerRow;
+      const uint32_t currentMipLevel = baseMipLevel + mipLevel;
+      const bool isLastChunk = row + numRows == mip.numRows;
+
+      // 1. Copy the pixel data into the host visible staging buffer
+      srcBuffer.bufferSubData(desc.srcOffset_ + regionOffset, chunkSize, srcData);
+
+      // 2. Transition initial image layout into TRANSFER_DST_OPTIMAL
+      if (row == 0) {
+        ivkImageMemoryBarrier(
+            wrapper.cmdBuf_,
+            image.getVkImage(),
+            0,
+            VK_ACCESS_TRANSFER_WRITE_BIT,
+            VK_IMAGE_LAYOUT_UNDEFINED,
+            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VkImageSubresourceRange{VK_IMAGE_ASPECT_COLOR_BIT, currentMipLevel, 1, layer, 1});
+      }
+
+      // 3. Copy the pixel data from the staging buffer into the image
+      const uint32_t y = row * mip.rowHeight;
+      const VkRect2D region = ivkGetRect2D(
+          0, y, mip.width, isLastChunk ? mip.height - y : numRows * mip.rowHeight);
+
+      const VkBufferImageCopy copy = ivkGetBufferImageCopy2D(
+          desc.srcOffset_ + regionOffset,
+          region,
+          VkImageSubresourceLayers{VK_IMAGE_ASPECT_COLOR_BIT, currentMipLevel, layer, 1});
 #if IGL_VULKAN_PRINT_COMMANDS
-    IGL_LOG_INFO("%p vkCmdCopyBufferToImage()\n", wrapper.cmdBuf_);
+      IGL_LOG_INFO("%p vkCmdCopyBufferToImage()\n", wrapper.cmdBuf_);
 #endif // IGL_VULKAN_PRINT_COMMANDS
-    vkCmdCopyBufferToImage(wrapper.cmdBuf_,
-                           stagingBuffer_->getVkBuffer(),
-                           image.getVkImage(),
-                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                           1,
-                           &copy);
+      vkCmdCopyBufferToImage(wrapper.cmdBuf_,
+                             srcBuffer.getVkBuffer(),
+                             image.getVkImage(),
+                             VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                             1,
+                             &copy);
+
+      // 4. Transition TRANSFER_DST_OPTIMAL into SHADER_READ_ONLY_OPTIMAL once the whole level is
+      // uploaded (the dedicated transfer queue does this as a part of the queue family ownership
+      // transfer below)
+      if (isLastChunk && !useTransferQueue) {
+        ivkImageMemoryBarrier(
+            wrapper.cmdBuf_,
+            image.getVkImage(),
+            VK_ACCESS_TRANSFER_READ_BIT, // VK_ACCESS_TRANSFER_WRITE_BIT,
+            VK_ACCESS_SHADER_READ_BIT,
+            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+            VkImageSubresourceRange{VK_IMAGE_ASPECT_COLOR_BIT, currentMipLevel, 1, layer, 1});
+      }
 
-    // 3. Transition TRANSFER_DST_OPTIMAL into SHADER_READ_ONLY_OPTIMAL
-    ivkImageMemoryBarrier(
-        wrapper.cmdBuf_,
-        image.getVkImage(),
-        VK_ACCESS_TRANSFER_READ_BIT, // VK_ACCESS_TRANSFER_WRITE_BIT,
-        VK_ACCESS_SHADER_READ_BIT,
-        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-        VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-        VK_PIPELINE_STAGE_TRANSFER_BIT,
-        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
-        VkImageSubresourceRange{VK_IMAGE_ASPECT_COLOR_BIT, currentMipLevel, 1, layer, 1});
+      regionOffset += chunkSize;
+      srcData += chunkSize;
+      storageSize -= chunkSize;
+      row += numRows;
+
+      if (isLastChunk) {
+        numCompletedMipLevels++;
+        mipLevel++;
+        row = 0;
+      }
+    }
 
-    // Compute the offset for the next level
-    mipLevelOffset += mipSizes[mipLevel];
+    if (useTransferQueue) {
+      // the levels which are still being uploaded stay owned by the transfer queue family
+      const auto ownershipBarrier = [&](VkCommandBuffer cmdBuf, bool isRelease) {
+        if (numCompletedMipLevels == 0) {
+          return;
+        }
+        ivkImageOwnershipBarrier(
+            cmdBuf,
+            image.getVkImage(),
+            isRelease ? VK_ACCESS_TRANSFER_WRITE_BIT : 0,
+            isRelease ? 0 : VK_ACCESS_SHADER_READ_BIT,
+            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+            ctx_.deviceQueues_.transferQueueFamilyIndex,
+            ctx_.deviceQueues_.graphicsQueueFamilyIndex,
+            isRelease ? VK_PIPELINE_STAGE_TRANSFER_BIT : VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+            isRelease ? VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT : VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+            VkImageSubresourceRange{VK_IMAGE_ASPECT_COLOR_BIT,
+                                    firstCompletedMipLevel,
+                                    numCompletedMipLevels,
+                                    layer,
+                                    1});
+      };
+      fenceId = submitTransfer(wrapper, waitForGraphicsQueue, ownershipBarrier);
+    } else {
+      fenceId = immediate_->submit(wrapper);
+    }
+    markRegionInUse(fenceId, std::move(desc));
   }
 
   image.imageLayout_ = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
 
-  VulkanSubmitHandle fenceId = immediate_->submit(wrapper);
-  outstandingFences_[fenceId.handle()] = desc;
+  return fenceId;
 }
 
-void VulkanStagingDevice::imageData3D(VulkanImage& image,
-                                      const VkOffset3D& offset,
-                                      const VkExtent3D& extent,
-                                      TextureFormatProperties properties,
-                                      VkFormat format,
-                                      const void* data) {
+VulkanSubmitHandle VulkanStagingDevice::imageData3D(VulkanImage& image,
+                                                    const VkOffset3D& offset,
+                                                    const VkExtent3D& extent,
+                                                    TextureFormatProperties properties,
+                                                    VkFormat format,
+                                                    const void* data,
+                                                    bool nonBlocking) {
   IGL_PROFILER_FUNCTION();
+
+  // keep the order of operations with respect to the batched copies
+  flushPendingCopies();
+
   IGL_ASSERT_MSG(image.mipLevels_ == 1, "Can handle only 3D images with exactly 1 mip-level");
   IGL_ASSERT_MSG((offset.x == 0) && (offset.y == 0) && (offset.z == 0),
                  "Can upload only full-size 3D images");
 
-  const auto range = TextureRangeDesc::new3D(0, 0, 0, extent.width, extent.height, extent.depth);
-  const uint32_t storageSize =
-      static_cast<uint32_t>(properties.getBytesPerRange(range.atMipLevel(0)));
+  // every slice is laid out as a 2D image; the slices are tightly packed
+  const MipLevelLayout slice =
+      getMipLevelLayout(TextureRangeDesc::new2D(0, 0, extent.width, extent.height), properties);
+  const uint32_t sliceSize = slice.getSize();
 
-  IGL_ASSERT(storageSize <= stagingBufferSize_);
+  uint32_t storageSize = sliceSize * extent.depth;
 
-  // get next staging buffer free offset
-  MemoryRegionDesc desc = getNextFreeOffset(storageSize);
+  const bool useTransferQueue = shouldUseTransferQueue(storageSize);
+  // the contents of images which have never been used by the GPU are undefined
+  const bool waitForGraphicsQueue = image.imageLayout_ != VK_IMAGE_LAYOUT_UNDEFINED;
+  const auto* srcData = static_cast<const uint8_t*>(data);
 
-  // currently, no support for copying image in multiple smaller chunk sizes.
-  // If we get smaller buffer size than storageSize, we will wait for gpu idle and get bigger chunk.
-  if (desc.alignedSize_ < storageSize) {
-    flushOutstandingFences();
-    desc = getNextFreeOffset(storageSize);
-  }
+  VulkanSubmitHandle fenceId;
 
-  IGL_ASSERT(desc.alignedSize_ >= storageSize);
+  // the upload position: the slice and its first row (of texel blocks) not uploaded yet
+  uint32_t z = 0;
+  uint32_t row = 0;
 
-  // 1. Copy the pixel data into the host visible staging buffer
-  stagingBuffer_->bufferSubData(desc.srcOffset_, storageSize, data);
+  // Every iteration fills one staging memory region with as many whole slices as it can hold, or
+  // with a band of rows of a single slice when not even one slice fits into the staging ring
+  while (z < extent.depth) {
+    MemoryRegionDesc desc = getNextFreeOffset(storageSize, nonBlocking);
 
-  auto& wrapper = immediate_->acquire();
+    // If we cannot fit even a single row, we will wait for gpu idle and get bigger chunk.
+    if (desc.alignedSize_ < slice.bytesPerRow) {
+      flushOutstandingFences();
+      desc = getNextFreeOffset(storageSize);
+    }
 
-  // 1. Transition initial image layout into TRANSFER_DST_OPTIMAL
-  ivkImageMemoryBarrier(wrapper.cmdBuf_,
-                        image.getVkImage(),
-                        0,
-                        VK_ACCESS_TRANSFER_WRITE_BIT,
-                        VK_IMAGE_LAYOUT_UNDEFINED,
-                        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                        VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
-                        VK_PIPELINE_STAGE_TRANSFER_BIT,
-                        VkImageSubresourceRange{VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1});
-
-  // 2. Copy the pixel data from the staging buffer into the image
-  const VkBufferImageCopy copy =
-      ivkGetBufferImageCopy3D(desc.srcOffset_,
-                              offset,
-                              extent,
-                              VkImageSubresourceLayers{VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1});
-  vkCmdCopyBufferToImage(wrapper.cmdBuf_,
-                         stagingBuffer_->getVkBuffer(),
-                         image.getVkImage(),
-                         VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                         1,
-                         &copy);
+    IGL_ASSERT(desc.alignedSize_ >= slice.bytesPerRow);
 
-  // 3. Transition TRANSFER_DST_OPTIMAL into SHADER_READ_ONLY_OPTIMAL
-  ivkImageMemoryBarrier(wrapper.cmdBuf_,
-                        image.getVkImage(),
-                        VK_ACCESS_TRANSFER_READ_BIT, // VK_ACCESS_TRANSFER_WRITE_BIT,
-                        VK_ACCESS_SHADER_READ_BIT,
-                        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                        VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-                        VK_PIPELINE_STAGE_TRANSFER_BIT,
-                        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
-                        VkImageSubresourceRange{VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1});
+    VulkanBuffer& srcBuffer = desc.transientBuffer_ ? *desc.transientBuffer_ : *stagingBuffer_;
+
+    auto& wrapper = useTransferQueue ? transferImmediate_->acquire() : immediate_->acquire();
+
+    // 1. Transition initial image layout into TRANSFER_DST_OPTIMAL
+    if (z == 0 && row == 0) {
+      ivkImageMemoryBarrier(wrapper.cmdBuf_,
+                            image.getVkImage(),
+                            0,
+                            VK_ACCESS_TRANSFER_WRITE_BIT,
+                            VK_IMAGE_LAYOUT_UNDEFINED,
+                            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                            VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                            VK_PIPELINE_STAGE_TRANSFER_BIT,
+                            VkImageSubresourceRange{VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1});
+    }
+
+    VkOffset3D chunkOffset = {0, 0, static_cast<int32_t>(z)};
+    VkExtent3D chunkExtent = extent;
+    uint32_t chunkSize = 0;
+
+    const uint32_t numSlices = std::min(extent.depth - z, desc.alignedSize_ / sliceSize);
+    if (row == 0 && numSlices > 0) {
+      chunkExtent.depth = numSlices;
+      chunkSize = numSlices * sliceSize;
+      z += numSlices;
+    } else {
+      const uint32_t numRows = std::min(slice.numRows - row, desc.alignedSize_ / slice.bytesPerRow);
+      const uint32_t y = row * slice.rowHeight;
+      const bool isLastChunk = row + numRows == slice.numRows;
+      chunkOffset.y = static_cast<int32_t>(y);
+      chunkExtent.height = isLastChunk ? slice.height - y : numRows * slice.rowHeight;
+      chunkExtent.depth = 1;
+      chunkSize = numRows * slice.bytesPerRow;
+      row = isLastChunk ? 0 : row + numRows;
+      z += isLastChunk ? 1 : 0;
+    }
+
+    // 2. Copy the pixel data into the host visible staging buffer
+    srcBuffer.bufferSubData(desc.srcOffset_, chunkSize, srcData);
+    srcData += chunkSize;
+    storageSize -= chunkSize;
+
+    // 3. Copy the pixel data from the staging buffer into the image
+    const VkBufferImageCopy copy =
+        ivkGetBufferImageCopy3D(desc.srcOffset_,
+                                chunkOffset,
+                                chunkExtent,
+                                VkImageSubresourceLayers{VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1});
+    vkCmdCopyBufferToImage(wrapper.cmdBuf_,
+                           srcBuffer.getVkBuffer(),
+                           image.getVkImage(),
+                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                           1,
+                           &copy);
+
+    const bool isComplete = z == extent.depth;
+
+    if (useTransferQueue) {
+      // 4. Transition TRANSFER_DST_OPTIMAL into SHADER_READ_ONLY_OPTIMAL as a part of the queue
+      // family ownership transfer once the whole image is uploaded
+      const auto ownershipBarrier = [&](VkCommandBuffer cmdBuf, bool isRelease) {
+        if (!isComplete) {
+          return;
+        }
+        ivkImageOwnershipBarrier(
+            cmdBuf,
+            image.getVkImage(),
+            isRelease ? VK_ACCESS_TRANSFER_WRITE_BIT : 0,
+            isRelease ? 0 : VK_ACCESS_SHADER_READ_BIT,
+            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+            ctx_.deviceQueues_.transferQueueFamilyIndex,
+            ctx_.deviceQueues_.graphicsQueueFamilyIndex,
+            isRelease ? VK_PIPELINE_STAGE_TRANSFER_BIT : VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+            isRelease ? VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT : VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+            VkImageSubresourceRange{VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1});
+      };
+      fenceId = submitTransfer(wrapper, waitForGraphicsQueue, ownershipBarrier);
+    } else {
+      // 4. Transition TRANSFER_DST_OPTIMAL into SHADER_READ_ONLY_OPTIMAL
+      if (isComplete) {
+        ivkImageMemoryBarrier(wrapper.cmdBuf_,
+                              image.getVkImage(),
+                              VK_ACCESS_TRANSFER_READ_BIT, // VK_ACCESS_TRANSFER_WRITE_BIT,
+                              VK_ACCESS_SHADER_READ_BIT,
+                              VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                              VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                              VK_PIPELINE_STAGE_TRANSFER_BIT,
+                              VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                              VkImageSubresourceRange{VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1});
+      }
+      fenceId = immediate_->submit(wrapper);
+    }
+    markRegionInUse(fenceId, std::move(desc));
+  }
 
   image.imageLayout_ = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
 
-  VulkanSubmitHandle fenceId = immediate_->submit(wrapper);
-  outstandingFences_[fenceId.handle()] = desc;
+  return fenceId;
 }
 
 void VulkanStagingDevice::getImageData2D(VkImage srcImage,
@@ -345,32 +532,127 @@ void VulkanStagingDevice::getImageData2D(VkImage srcImage,
                                          uint32_t dataBytesPerRow,
                                          bool flipImageVertical) {
   IGL_PROFILER_FUNCTION();
+
+  // keep the order of operations with respect to the batched copies
+  flushPendingCopies();
+
   IGL_ASSERT(layout != VK_IMAGE_LAYOUT_UNDEFINED);
 
   const auto range =
       TextureRangeDesc::new2D(0, 0, imageRegion.extent.width, imageRegion.extent.height);
-  const uint32_t storageSize =
-      static_cast<uint32_t>(properties.getBytesPerRange(range.atMipLevel(0)));
-  IGL_ASSERT(storageSize <= stagingBufferSize_);
 
   IGL_ASSERT(dataBytesPerRow == properties.getBytesPerRow(range.atMipLevel(0)));
 
-  // get next staging buffer free offset
-  MemoryRegionDesc desc = getNextFreeOffset(storageSize);
+  if (!IGL_VERIFY(stagingBuffer_->getMappedPtr())) {
+    return;
+  }
+
+  const MipLevelLayout mip = getMipLevelLayout(range, properties);
+
+  uint8_t* dst = static_cast<uint8_t*>(data);
+
+  // the first row (of texel blocks) not read back yet
+  uint32_t row = 0;
+
+  // Every iteration reads back as many rows as fit into one staging memory region, so images of
+  // any size are streamed through the bounded staging ring
+  while (row < mip.numRows) {
+    const uint32_t storageSize = (mip.numRows - row) * mip.bytesPerRow;
+
+    MemoryRegionDesc desc = getNextFreeOffset(storageSize);
+
+    // If we cannot fit even a single row, we will wait for gpu idle and get bigger chunk.
+    if (desc.alignedSize_ < mip.bytesPerRow) {
+      flushOutstandingFences();
+      desc = getNextFreeOffset(storageSize);
+    }
+
+    IGL_ASSERT(desc.alignedSize_ >= mip.bytesPerRow);
+
+    const uint32_t numRows = std::min(mip.numRows - row, desc.alignedSize_ / mip.bytesPerRow);
+    const uint32_t chunkSize = numRows * mip.bytesPerRow;
+    const bool isLastChunk = row + numRows == mip.numRows;
+
+    auto& wrapper = immediate_->acquire();
+
+    // 1. Transition to VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
+    if (row == 0) {
+      ivkImageMemoryBarrier(wrapper.cmdBuf_,
+                            srcImage,
+                            0, // srcAccessMask
+                            VK_ACCESS_TRANSFER_READ_BIT, // dstAccessMask
+                            layout,
+                            VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                            VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, // wait for any previous operation
+                            VK_PIPELINE_STAGE_TRANSFER_BIT, // dstStageMask
+                            VkImageSubresourceRange{VK_IMAGE_ASPECT_COLOR_BIT, level, 1, layer, 1});
+    }
+
+    // 2. Copy a band of rows from the image into the staging buffer
+    const uint32_t y = row * mip.rowHeight;
+    const VkRect2D region = ivkGetRect2D(imageRegion.offset.x,
+                                         imageRegion.offset.y + static_cast<int32_t>(y),
+                                         mip.width,
+                                         isLastChunk ? mip.height - y : numRows * mip.rowHeight);
+    const VkBufferImageCopy copy = ivkGetBufferImageCopy2D(
+        desc.srcOffset_,
+        region,
+        VkImageSubresourceLayers{VK_IMAGE_ASPECT_COLOR_BIT, level, layer, 1});
+    vkCmdCopyImageToBuffer(wrapper.cmdBuf_,
+                           srcImage,
+                           VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                           stagingBuffer_->getVkBuffer(),
+                           1,
+                           &copy);
+
+    // 3. Transition back to the initial image layout once the last band is copied
+    if (isLastChunk) {
+      ivkImageMemoryBarrier(wrapper.cmdBuf_,
+                            srcImage,
+                            VK_ACCESS_TRANSFER_READ_BIT, // srcAccessMask
+                            0, // dstAccessMask
+                            VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                            layout,
+                            VK_PIPELINE_STAGE_TRANSFER_BIT, // srcStageMask
+                            VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, // dstStageMask
+                            VkImageSubresourceRange{VK_IMAGE_ASPECT_COLOR_BIT, level, 1, layer, 1});
+    }
+
+    const VulkanSubmitHandle fenceId = immediate_->submit(wrapper);
+    outstandingFences_.emplace(fenceId.handle(), desc);
 
-  // If we get smaller buffer size than storageSize, we will wait for gpu idle
-  // and get bigger chunk.
-  if (desc.alignedSize_ < storageSize) {
     flushOutstandingFences();
-    desc = getNextFreeOffset(storageSize);
+
+    // 4. Copy data from staging buffer into data; a flipped band goes to the mirrored rows
+    const uint8_t* src = stagingBuffer_->getMappedPtr() + desc.srcOffset_;
+
+    if (flipImageVertical) {
+      flipBMP(dst + (mip.numRows - row - numRows) * mip.bytesPerRow, src, numRows, mip.bytesPerRow);
+    } else {
+      checked_memcpy(dst + row * mip.bytesPerRow, chunkSize, src, chunkSize);
+    }
+
+    row += numRows;
   }
+}
 
-  IGL_ASSERT(desc.alignedSize_ >= storageSize);
+VulkanSubmitHandle VulkanStagingDevice::getImageData2DAsync(VkImage srcImage,
+                                                            uint32_t level,
+                                                            uint32_t layer,
+                                                            const VkRect2D& imageRegion,
+                                                            VkImageLayout layout,
+                                                            const ReadbackRegion& dstRegion) {
+  IGL_PROFILER_FUNCTION();
+  IGL_ASSERT(layout != VK_IMAGE_LAYOUT_UNDEFINED);
+  IGL_ASSERT(dstRegion.buffer_ && dstRegion.buffer_->isMapped());
 
-  auto& wrapper1 = immediate_->acquire();
+  // keep the order of operations with respect to the batched copies
+  flushPendingCopies();
+
+  auto& wrapper = immediate_->acquire();
 
   // 1. Transition to VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
-  ivkImageMemoryBarrier(wrapper1.cmdBuf_,
+  ivkImageMemoryBarrier(wrapper.cmdBuf_,
                         srcImage,
                         0, // srcAccessMask
                         VK_ACCESS_TRANSFER_READ_BIT, // dstAccessMask
@@ -380,41 +662,30 @@ void VulkanStagingDevice::getImageData2D(VkImage srcImage,
                         VK_PIPELINE_STAGE_TRANSFER_BIT, // dstStageMask
                         VkImageSubresourceRange{VK_IMAGE_ASPECT_COLOR_BIT, level, 1, layer, 1});
 
-  // 2.  Copy the pixel data from the image into the staging buffer
+  // 2. Copy the pixel data from the image into the destination region
   const VkBufferImageCopy copy =
-      ivkGetBufferImageCopy2D(desc.srcOffset_,
+      ivkGetBufferImageCopy2D(dstRegion.offset_,
                               imageRegion,
                               VkImageSubresourceLayers{VK_IMAGE_ASPECT_COLOR_BIT, level, layer, 1});
-  vkCmdCopyImageToBuffer(wrapper1.cmdBuf_,
+  vkCmdCopyImageToBuffer(wrapper.cmdBuf_,
                          srcImage,
                          VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-                         stagingBuffer_->getVkBuffer(),
+                         dstRegion.buffer_->getVkBuffer(),
                          1,
                          &copy);
 
-  VulkanSubmitHandle fenceId = immediate_->submit(wrapper1);
-  outstandingFences_[fenceId.handle()] = desc;
-
-  flushOutstandingFences();
-
-  // 3. Copy data from staging buffer into data
-  if (!IGL_VERIFY(stagingBuffer_->getMappedPtr())) {
-    return;
-  }
-
-  const uint8_t* src = stagingBuffer_->getMappedPtr() + desc.srcOffset_;
-  uint8_t* dst = static_cast<uint8_t*>(data);
-
-  if (flipImageVertical) {
-    flipBMP(dst, src, imageRegion.extent.height, properties.getBytesPerRow(range.atMipLevel(0)));
-  } else {
-    checked_memcpy(dst, storageSize, src, storageSize);
-  }
+  // 3. Make the copied data visible to the host
+  ivkBufferMemoryBarrier(wrapper.cmdBuf_,
+                         dstRegion.buffer_->getVkBuffer(),
+                         VK_ACCESS_TRANSFER_WRITE_BIT,
+                         VK_ACCESS_HOST_READ_BIT,
+                         dstRegion.offset_,
+                         dstRegion.size_,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         VK_PIPELINE_STAGE_HOST_BIT);
 
   // 4. Transition back to the initial image layout
-  auto& wrapper2 = immediate_->acquire();
-
-  ivkImageMemoryBarrier(wrapper2.cmdBuf_,
+  ivkImageMemoryBarrier(wrapper.cmdBuf_,
                         srcImage,
                         VK_ACCESS_TRANSFER_READ_BIT, // srcAccessMask
                         0, // dstAccessMask
@@ -424,42 +695,262 @@ void VulkanStagingDevice::getImageData2D(VkImage srcImage,
                         VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, // dstStageMask
                         VkImageSubresourceRange{VK_IMAGE_ASPECT_COLOR_BIT, level, 1, layer, 1});
 
-  fenceId = immediate_->submit(wrapper2);
-  outstandingFences_[fenceId.handle()] = desc;
+  return immediate_->submit(wrapper);
+}
+
+VulkanStagingDevice::ReadbackRegion VulkanStagingDevice::acquireReadbackRegion(uint32_t size) {
+  IGL_PROFILER_FUNCTION();
+
+  const uint32_t alignedSize = getAlignedSize(size);
+
+  // find free space after the front of the ring, or wrap around to its beginning
+  const uint32_t backOffset = readbackRegions_.empty() ? 0 : readbackRegions_.front().offset_;
+  const bool isWrapped = !readbackRegions_.empty() && readbackBufferFrontOffset_ <= backOffset;
+
+  if (readbackRegions_.empty()) {
+    readbackBufferFrontOffset_ = 0;
+  }
+
+  uint32_t offset = UINT32_MAX;
+  if (isWrapped) {
+    if (backOffset - readbackBufferFrontOffset_ >= alignedSize) {
+      offset = readbackBufferFrontOffset_;
+    }
+  } else if (readbackBufferSize_ - readbackBufferFrontOffset_ >= alignedSize) {
+    offset = readbackBufferFrontOffset_;
+  } else if (backOffset >= alignedSize) {
+    offset = 0;
+  }
+
+  if (offset == UINT32_MAX) {
+#if IGL_VULKAN_DEBUG_STAGING_DEVICE
+    IGL_LOG_INFO("Allocating dedicated readback buffer: %u bytes\n", size);
+#endif
+    ReadbackRegion region;
+    region.buffer_ = ctx_.createBuffer(size,
+                                       VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                       VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT,
+                                       nullptr,
+                                       "Buffer: dedicated readback buffer");
+    IGL_ASSERT(region.buffer_.get());
+    region.size_ = size;
+    region.isDedicated_ = true;
+    return region;
+  }
+
+  if (!readbackBuffer_) {
+    readbackBuffer_ = ctx_.createBuffer(readbackBufferSize_,
+                                        VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT,
+                                        nullptr,
+                                        "Buffer: readback buffer");
+    IGL_ASSERT(readbackBuffer_.get());
+  }
+
+  readbackBufferFrontOffset_ = offset + alignedSize;
+  readbackRegions_.push_back({offset, alignedSize});
+
+  return {readbackBuffer_, offset, size};
+}
+
+void VulkanStagingDevice::releaseReadbackRegion(const ReadbackRegion& region) {
+  if (region.isDedicated_) {
+    return;
+  }
+
+  const auto it = std::find_if(readbackRegions_.begin(),
+                               readbackRegions_.end(),
+                               [&region](const ReadbackRingEntry& entry) {
+                                 return !entry.isReleased_ && entry.offset_ == region.offset_;
+                               });
+  if (!IGL_VERIFY(it != readbackRegions_.end())) {
+    return;
+  }
+  it->isReleased_ = true;
+
+  while (!readbackRegions_.empty() && readbackRegions_.front().isReleased_) {
+    readbackRegions_.pop_front();
+  }
+}
+
+bool VulkanStagingDevice::shouldUseTransferQueue(size_t size) const {
+  return transferImmediate_ && size >= ctx_.config_.minDedicatedTransferQueueUploadSize;
+}
+
+VulkanSubmitHandle VulkanStagingDevice::submitTransfer(
+    const VulkanImmediateCommands::CommandBufferWrapper& wrapper,
+    bool waitForGraphicsQueue,
+    const std::function<void(VkCommandBuffer cmdBuf, bool isRelease)>& ownershipBarrier) {
+  IGL_PROFILER_FUNCTION_COLOR(IGL_PROFILER_COLOR_SUBMIT);
+  IGL_ASSERT(transferImmediate_);
+
+  // 0. The destination resources might still be read by work submitted to the graphics queue. A
+  // semaphore signal waits for all the commands submitted to its queue before it, so an empty
+  // graphics submit orders the transfer after all of them
+  if (waitForGraphicsQueue) {
+    auto& fenceWrapper = immediate_->acquire();
+    immediate_->submit(fenceWrapper);
+    transferImmediate_->waitSemaphore(immediate_->acquireLastSubmitSemaphore());
+  }
+
+  // 1. Release the resources on the transfer queue
+  ownershipBarrier(wrapper.cmdBuf_, true);
+  transferImmediate_->submit(wrapper);
+
+  // 2. Acquire the resources on the graphics queue once the transfer queue is done. All subsequent
+  // submits to the graphics queue are ordered after this one
+  immediate_->waitSemaphore(transferImmediate_->acquireLastSubmitSemaphore());
+
+  auto& acquireWrapper = immediate_->acquire();
+  ownershipBarrier(acquireWrapper.cmdBuf_, false);
+
+  return immediate_->submit(acquireWrapper);
+}
+
+VulkanStagingDevice::MipLevelLayout VulkanStagingDevice::getMipLevelLayout(
+    const TextureRangeDesc& range,
+    const TextureFormatProperties& properties) {
+  MipLevelLayout layout;
+  layout.width = static_cast<uint32_t>(range.width);
+  layout.height = static_cast<uint32_t>(range.height);
+  layout.numRows = static_cast<uint32_t>(properties.getRows(range));
+  layout.bytesPerRow = static_cast<uint32_t>(properties.getBytesPerRow(range));
+  layout.rowHeight = properties.isCompressed() ? properties.blockHeight : 1u;
+
+  // levels padded to a minimum number of blocks cannot be split into bands of rows
+  if (layout.numRows * layout.rowHeight >= layout.height + layout.rowHeight) {
+    layout.bytesPerRow *= layout.numRows;
+    layout.numRows = 1;
+    layout.rowHeight = layout.height;
+  }
+
+  return layout;
 }
 
 uint32_t VulkanStagingDevice::getAlignedSize(uint32_t size) const {
   return (size + stagingBufferAlignment_ - 1) & ~(stagingBufferAlignment_ - 1);
 }
 
-VulkanStagingDevice::MemoryRegionDesc VulkanStagingDevice::getNextFreeOffset(uint32_t size) {
+bool VulkanStagingDevice::isReady(VulkanSubmitHandle handle) const {
+  return immediate_->isReady(handle);
+}
+
+void VulkanStagingDevice::wait(VulkanSubmitHandle handle) {
+  IGL_PROFILER_FUNCTION_COLOR(IGL_PROFILER_COLOR_WAIT);
+
+  if (pendingWrapper_ && pendingWrapper_->handle_.handle() == handle.handle()) {
+    // the batched copies have to be submitted before we can wait for them
+    flushPendingCopies();
+  }
+
+  immediate_->wait(handle);
+}
+
+VulkanSubmitHandle VulkanStagingDevice::getLastSubmitHandle() const {
+  return immediate_->getLastSubmitHandle();
+}
+
+VulkanSubmitHandle VulkanStagingDevice::enqueueBufferCopy(VkBuffer srcBuffer,
+                                                          VkBuffer dstBuffer,
+                                                          const VkBufferCopy& copy) {
+  IGL_PROFILER_FUNCTION();
+
+  auto it = pendingCopies_.find(dstBuffer);
+
+  if (it != pendingCopies_.end()) {
+    // all regions of a single vkCmdCopyBuffer() must come from the same source buffer and must not
+    // overlap in the destination buffer
+    const auto overlaps = [&copy](const VkBufferCopy& region) {
+      return copy.dstOffset < region.dstOffset + region.size &&
+             region.dstOffset < copy.dstOffset + copy.size;
+    };
+    if (it->second.srcBuffer_ != srcBuffer ||
+        std::any_of(it->second.regions_.begin(), it->second.regions_.end(), overlaps)) {
+      flushPendingCopies();
+    }
+  }
+
+  if (!pendingWrapper_) {
+    pendingWrapper_ = &immediate_->acquire();
+  }
+
+  const VulkanSubmitHandle handle = pendingWrapper_->handle_;
+
+  PendingBufferCopies& pending = pendingCopies_[dstBuffer];
+  pending.srcBuffer_ = srcBuffer;
+  pending.regions_.push_back(copy);
+
+  if (++numPendingCopies_ >= ctx_.config_.maxBatchedStagingCopies) {
+    flushPendingCopies();
+  }
+
+  return handle;
+}
+
+VulkanSubmitHandle VulkanStagingDevice::flushPendingCopies() {
+  if (!pendingWrapper_) {
+    return {};
+  }
+
+  IGL_PROFILER_FUNCTION_COLOR(IGL_PROFILER_COLOR_SUBMIT);
+
+  for (const auto& [dstBuffer, pending] : pendingCopies_) {
+#if IGL_VULKAN_PRINT_COMMANDS
+    IGL_LOG_INFO("%p vkCmdCopyBuffer(%u regions)\n",
+                 pendingWrapper_->cmdBuf_,
+                 (uint32_t)pending.regions_.size());
+#endif // IGL_VULKAN_PRINT_COMMANDS
+    vkCmdCopyBuffer(pendingWrapper_->cmdBuf_,
+                    pending.srcBuffer_,
+                    dstBuffer,
+                    (uint32_t)pending.regions_.size(),
+                    pending.regions_.data());
+  }
+
+  pendingCopies_.clear();
+  numPendingCopies_ = 0;
+
+  return immediate_->submit(*std::exchange(pendingWrapper_, nullptr));
+}
+
+VulkanStagingDevice::MemoryRegionDesc VulkanStagingDevice::getNextFreeOffset(uint32_t size,
+                                                                             bool nonBlocking) {
   IGL_PROFILER_FUNCTION();
   uint32_t alignedSize = getAlignedSize(size);
 
+  releaseTransientBuffers();
+
   // track maximum previously used region
-  MemoryRegionDesc maxRegionDesc;
-  VulkanSubmitHandle maxRegionFence = VulkanSubmitHandle();
+  auto maxRegion = outstandingFences_.end();
 
   // check if we can reuse any of previously used memory region
-  for (auto [handle, desc] : outstandingFences_) {
-    if (immediate_->isReady(VulkanSubmitHandle(handle))) {
+  for (auto it = outstandingFences_.begin(); it != outstandingFences_.end(); ++it) {
+    const MemoryRegionDesc& desc = it->second;
+    if (immediate_->isReady(VulkanSubmitHandle(it->first))) {
       if (desc.alignedSize_ >= alignedSize) {
-        outstandingFences_.erase(handle);
+        const MemoryRegionDesc reusedDesc = desc;
+        outstandingFences_.erase(it);
 #if IGL_VULKAN_DEBUG_STAGING_DEVICE
-        IGL_LOG_INFO("Reusing memory region %u bytes\n", desc.alignedSize_);
+        IGL_LOG_INFO("Reusing memory region %u bytes\n", reusedDesc.alignedSize_);
 #endif
-        return desc;
+        return reusedDesc;
       }
 
-      if (maxRegionDesc.alignedSize_ < desc.alignedSize_) {
-        maxRegionDesc = desc;
-        maxRegionFence = VulkanSubmitHandle(handle);
+      if (maxRegion == outstandingFences_.end() ||
+          maxRegion->second.alignedSize_ < desc.alignedSize_) {
+        maxRegion = it;
       }
     }
   }
 
-  if (!maxRegionFence.empty() && bufferCapacity_ < maxRegionDesc.alignedSize_) {
-    outstandingFences_.erase(maxRegionFence.handle());
+  if (nonBlocking && bufferCapacity_ < alignedSize) {
+    // the staging ring cannot fit the whole region without waiting for the GPU
+    return createTransientRegion(alignedSize);
+  }
+
+  if (maxRegion != outstandingFences_.end() && bufferCapacity_ < maxRegion->second.alignedSize_) {
+    const MemoryRegionDesc maxRegionDesc = maxRegion->second;
+    outstandingFences_.erase(maxRegion);
 #if IGL_VULKAN_DEBUG_STAGING_DEVICE
     IGL_LOG_INFO("Reusing memory region %u bytes\n", maxRegionDesc.alignedSize_);
 #endif
@@ -484,19 +975,59 @@ VulkanStagingDevice::MemoryRegionDesc VulkanStagingDevice::getNextFreeOffset(uin
   return {srcOffset, alignedSize};
 }
 
+VulkanStagingDevice::MemoryRegionDesc VulkanStagingDevice::createTransientRegion(uint32_t size) {
+  IGL_PROFILER_FUNCTION_COLOR(IGL_PROFILER_COLOR_CREATE);
+
+#if IGL_VULKAN_DEBUG_STAGING_DEVICE
+  IGL_LOG_INFO("Allocating transient staging buffer: %u bytes\n", size);
+#endif
+
+  MemoryRegionDesc desc;
+  desc.alignedSize_ = size;
+  desc.transientBuffer_ = ctx_.createBuffer(size,
+                                            VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                                            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT,
+                                            nullptr,
+                                            "Buffer: transient staging buffer");
+  IGL_ASSERT(desc.transientBuffer_.get());
+
+  return desc;
+}
+
+void VulkanStagingDevice::markRegionInUse(VulkanSubmitHandle handle, MemoryRegionDesc&& desc) {
+  if (desc.transientBuffer_) {
+    transientBuffers_.emplace_back(handle, std::move(desc.transientBuffer_));
+  } else {
+    outstandingFences_.emplace(handle.handle(), desc);
+  }
+}
+
+void VulkanStagingDevice::releaseTransientBuffers() {
+  // transient buffers are released in the order of their submission
+  while (!transientBuffers_.empty() && immediate_->isReady(transientBuffers_.front().first)) {
+    transientBuffers_.pop_front();
+  }
+}
+
 void VulkanStagingDevice::flushOutstandingFences() {
   IGL_PROFILER_FUNCTION_COLOR(IGL_PROFILER_COLOR_WAIT);
 
 #if IGL_VULKAN_DEBUG_STAGING_DEVICE
   IGL_LOG_INFO("StagingDevice - Wait for Idle\n");
 #endif
+  flushPendingCopies();
+
   std::for_each(outstandingFences_.begin(),
                 outstandingFences_.end(),
-                [this](std::pair<uint64_t, MemoryRegionDesc> const& pair) {
+                [this](std::pair<const uint64_t, MemoryRegionDesc> const& pair) {
                   immediate_->wait(VulkanSubmitHandle(pair.first));
                 });
+  for (const auto& [handle, _] : transientBuffers_) {
+    immediate_->wait(handle);
+  }
 
   outstandingFences_.clear();
+  transientBuffers_.clear();
   stagingBufferFrontOffset_ = 0;
   bufferCapacity_ = stagingBufferSize_;
 }
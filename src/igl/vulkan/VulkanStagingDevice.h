@@ -7,12 +7,15 @@
 
 #pragma once
 
+#include <deque>
+#include <functional>
 #include <memory>
 #include <unordered_map>
 #include <vector>
 
 #include <igl/vulkan/Common.h>
 #include <igl/vulkan/VulkanHelpers.h>
+#include <igl/vulkan/VulkanImmediateCommands.h>
 
 namespace igl {
 namespace vulkan {
@@ -20,7 +23,6 @@ namespace vulkan {
 class VulkanBuffer;
 class VulkanContext;
 class VulkanImage;
-class VulkanImmediateCommands;
 
 class VulkanStagingDevice final {
  public:
@@ -30,22 +32,36 @@ class VulkanStagingDevice final {
   VulkanStagingDevice(const VulkanStagingDevice&) = delete;
   VulkanStagingDevice& operator=(const VulkanStagingDevice&) = delete;
 
-  void bufferSubData(VulkanBuffer& buffer, size_t dstOffset, size_t size, const void* data);
+  using SubmitHandle = VulkanImmediateCommands::SubmitHandle;
+
+  /// The upload functions return the handle of the last submit which reads from the staging memory.
+  /// A non-blocking upload never waits for the GPU to free up the staging ring: if the ring cannot
+  /// fit the data, a transient staging buffer is allocated for this upload instead. Uploads into
+  /// buffers which have never been used by the GPU should set `isUnusedByGpu` to skip waiting for
+  /// the graphics queue when the upload goes through the dedicated transfer queue
+  SubmitHandle bufferSubData(VulkanBuffer& buffer,
+                             size_t dstOffset,
+                             size_t size,
+                             const void* data,
+                             bool nonBlocking = false,
+                             bool isUnusedByGpu = false);
   void getBufferSubData(VulkanBuffer& buffer, size_t srcOffset, size_t size, void* data);
-  void imageData2D(VulkanImage& image,
-                   const VkRect2D& imageRegion,
-                   uint32_t baseMipLevel,
-                   uint32_t numMipLevels,
-                   uint32_t layer,
-                   TextureFormatProperties properties,
-                   VkFormat format,
-                   const void* data);
-  void imageData3D(VulkanImage& image,
-                   const VkOffset3D& offset,
-                   const VkExtent3D& extent,
-                   TextureFormatProperties properties,
-                   VkFormat format,
-                   const void* data);
+  SubmitHandle imageData2D(VulkanImage& image,
+                           const VkRect2D& imageRegion,
+                           uint32_t baseMipLevel,
+                           uint32_t numMipLevels,
+                           uint32_t layer,
+                           TextureFormatProperties properties,
+                           VkFormat format,
+                           const void* data,
+                           bool nonBlocking = false);
+  SubmitHandle imageData3D(VulkanImage& image,
+                           const VkOffset3D& offset,
+                           const VkExtent3D& extent,
+                           TextureFormatProperties properties,
+                           VkFormat format,
+                           const void* data,
+                           bool nonBlocking = false);
   void getImageData2D(VkImage srcImage,
                       const uint32_t level,
                       const uint32_t layer,
@@ -56,26 +72,124 @@ class VulkanStagingDevice final {
                       void* data,
                       uint32_t dataBytesPerRow,
                       bool flipImageVertical);
+  /// A region of host-visible memory which an asynchronous readback copies into
+  struct ReadbackRegion {
+    std::shared_ptr<VulkanBuffer> buffer_;
+    uint32_t offset_ = 0;
+    uint32_t size_ = 0;
+    // set for readbacks which did not fit into the readback ring and got a buffer of their own
+    bool isDedicated_ = false;
+  };
+
+  /// Reserves `size` bytes of the pooled readback ring until releaseReadbackRegion() is called. If
+  /// the ring cannot fit them, a dedicated host-visible buffer is allocated instead
+  ReadbackRegion acquireReadbackRegion(uint32_t size);
+  /// Returns a region to the readback ring. The GPU must not be copying into it anymore
+  void releaseReadbackRegion(const ReadbackRegion& region);
+
+  /// Copies an image region into `dstRegion` without waiting for the GPU. The image is transitioned
+  /// back into `layout` afterwards. The returned handle signals when the data can be read
+  SubmitHandle getImageData2DAsync(VkImage srcImage,
+                                   uint32_t level,
+                                   uint32_t layer,
+                                   const VkRect2D& imageRegion,
+                                   VkImageLayout layout,
+                                   const ReadbackRegion& dstRegion);
+
+  /// Checks whether the upload identified by `handle` has completed without waiting
+  bool isReady(SubmitHandle handle) const;
+  /// Waits until the upload identified by `handle` has completed
+  void wait(SubmitHandle handle);
+
+  /// Submits the buffer copies accumulated when VulkanContextConfig::batchStagingBufferCopies is
+  /// enabled. Returns an empty handle if there was nothing to submit
+  SubmitHandle flushPendingCopies();
+  SubmitHandle getLastSubmitHandle() const;
 
  private:
   struct MemoryRegionDesc {
     uint32_t srcOffset_ = 0;
     uint32_t alignedSize_ = 0;
+    // set only for non-blocking uploads which did not fit into the staging ring
+    std::shared_ptr<VulkanBuffer> transientBuffer_;
+  };
+
+  /// The layout of a single 2D mip level (or a slice of a 3D image) in the staging memory. Uploads
+  /// which do not fit into the staging ring are split into bands of `bytesPerRow`-sized rows
+  struct MipLevelLayout {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t numRows = 0; // rows of texel blocks
+    uint32_t bytesPerRow = 0;
+    uint32_t rowHeight = 1; // texels
+    uint32_t getSize() const {
+      return numRows * bytesPerRow;
+    }
   };
 
+  static MipLevelLayout getMipLevelLayout(const TextureRangeDesc& range,
+                                          const TextureFormatProperties& properties);
+
   uint32_t getAlignedSize(uint32_t size) const;
-  MemoryRegionDesc getNextFreeOffset(uint32_t size);
+  MemoryRegionDesc getNextFreeOffset(uint32_t size, bool nonBlocking = false);
+  MemoryRegionDesc createTransientRegion(uint32_t size);
+  void markRegionInUse(SubmitHandle handle, MemoryRegionDesc&& desc);
+  void releaseTransientBuffers();
   void flushOutstandingFences();
 
+  /// Adds a copy to the pending command buffer and returns the handle it will be submitted with
+  SubmitHandle enqueueBufferCopy(VkBuffer srcBuffer, VkBuffer dstBuffer, const VkBufferCopy& copy);
+
+  /// Returns true if an upload of `size` bytes should go through the dedicated transfer queue
+  bool shouldUseTransferQueue(size_t size) const;
+
+  /// Submits the copy commands recorded into a command buffer from `transferImmediate_` and hands
+  /// the ownership of the destination resources over to the graphics queue family. If
+  /// `waitForGraphicsQueue` is set, the copies start only after all the work submitted to the
+  /// graphics queue before them has completed; resources which have never been used by the GPU do
+  /// not need this. `ownershipBarrier(cmdBuf, isRelease)` is invoked twice: to record the release
+  /// barriers on the transfer queue and to record the matching acquire barriers on the graphics
+  /// queue. The returned handle belongs to `immediate_` and signals when both operations are done
+  SubmitHandle submitTransfer(
+      const VulkanImmediateCommands::CommandBufferWrapper& wrapper,
+      bool waitForGraphicsQueue,
+      const std::function<void(VkCommandBuffer cmdBuf, bool isRelease)>& ownershipBarrier);
+
  private:
   VulkanContext& ctx_;
   std::shared_ptr<VulkanBuffer> stagingBuffer_;
   std::unique_ptr<VulkanImmediateCommands> immediate_;
+  // only created when the device has a dedicated transfer queue
+  std::unique_ptr<VulkanImmediateCommands> transferImmediate_;
   uint32_t stagingBufferFrontOffset_ = 0;
   uint32_t stagingBufferAlignment_ = 16; // updated to support BC7 compressed image
   uint32_t stagingBufferSize_;
   uint32_t bufferCapacity_;
-  std::unordered_map<uint64_t, MemoryRegionDesc> outstandingFences_;
+  // several regions can be released by the same submit when the copies are batched
+  std::unordered_multimap<uint64_t, MemoryRegionDesc> outstandingFences_;
+  std::deque<std::pair<SubmitHandle, std::shared_ptr<VulkanBuffer>>> transientBuffers_;
+
+  // Readback regions are released in any order; the space of a released region is reclaimed once
+  // all the regions allocated before it are released as well
+  struct ReadbackRingEntry {
+    uint32_t offset_ = 0;
+    uint32_t size_ = 0;
+    bool isReleased_ = false;
+  };
+  std::shared_ptr<VulkanBuffer> readbackBuffer_; // created on first use
+  uint32_t readbackBufferSize_ = 0;
+  uint32_t readbackBufferFrontOffset_ = 0;
+  std::deque<ReadbackRingEntry> readbackRegions_; // in the order of allocation
+
+  struct PendingBufferCopies {
+    VkBuffer srcBuffer_ = VK_NULL_HANDLE;
+    std::vector<VkBufferCopy> regions_;
+  };
+
+  // batched copies grouped by their destination buffer; recorded into `pendingWrapper_` on submit
+  std::unordered_map<VkBuffer, PendingBufferCopies> pendingCopies_;
+  const VulkanImmediateCommands::CommandBufferWrapper* pendingWrapper_ = nullptr;
+  uint32_t numPendingCopies_ = 0;
 };
 
 } // namespace vulkan
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/vulkan/WorkerPool.h>
+
+#include <algorithm>
+#include <igl/vulkan/Common.h>
+
+namespace igl {
+namespace vulkan {
+
+WorkerPool::WorkerPool(uint32_t numThreads) {
+  if (!numThreads) {
+    // leave one hardware thread to the application
+    numThreads = std::max(1u, std::thread::hardware_concurrency()) - 1;
+  }
+
+  numThreads = std::max(1u, numThreads);
+
+  threads_.reserve(numThreads);
+  for (uint32_t i = 0; i != numThreads; i++) {
+    threads_.emplace_back([this]() { run(); });
+  }
+}
+
+WorkerPool::~WorkerPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    isStopping_ = true;
+  }
+
+  condition_.notify_all();
+
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+
+  IGL_ASSERT(tasks_.empty());
+}
+
+std::future<void> WorkerPool::schedule(std::packaged_task<void()> task) {
+  std::future<void> future = task.get_future();
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    IGL_ASSERT_MSG(!isStopping_, "Tasks cannot be scheduled while the worker pool is destroyed");
+    tasks_.push_back(std::move(task));
+  }
+
+  condition_.notify_one();
+
+  return future;
+}
+
+void WorkerPool::run() {
+  for (;;) {
+    std::packaged_task<void()> task;
+
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      condition_.wait(lock, [this]() { return isStopping_ || !tasks_.empty(); });
+      if (tasks_.empty()) {
+        // stopping and all the scheduled tasks have run
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+
+    task();
+  }
+}
+
+} // namespace vulkan
+} // namespace igl
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace igl {
+namespace vulkan {
+
+/// @brief A fixed number of threads which run background tasks of a context (e.g. building and
+/// linking pipelines) in the order they were scheduled. Tasks must not wait for tasks which were
+/// scheduled after them. The destructor runs all the scheduled tasks before joining the threads.
+class WorkerPool final {
+ public:
+  /// @param numThreads The number of threads; 0 uses one less than the number of hardware threads
+  explicit WorkerPool(uint32_t numThreads = 0);
+  ~WorkerPool();
+
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+
+  /// @brief Schedules the task to run on one of the threads. Thread-safe
+  /// @return A future which becomes ready once the task has run
+  std::future<void> schedule(std::packaged_task<void()> task);
+
+  uint32_t getNumThreads() const {
+    return static_cast<uint32_t>(threads_.size());
+  }
+
+ private:
+  void run();
+
+ private:
+  std::vector<std::thread> threads_;
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  std::deque<std::packaged_task<void()>> tasks_;
+  bool isStopping_ = false;
+};
+
+} // namespace vulkan
+} // namespace igl